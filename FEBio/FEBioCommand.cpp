@@ -35,6 +35,7 @@ SOFTWARE.*/
 #include <FECore/CompactMatrix.h>
 #include <FECore/FEAnalysis.h>
 #include <FECore/FEGlobalMatrix.h>
+#include <FEBioXML/FEBioMeshFile.h>
 #include "FEBioCommand.h"
 #include "console.h"
 #include <FEBioLib/cmdoptions.h>
@@ -86,6 +87,7 @@ REGISTER_COMMAND(FEBioCmd_UnLoadPlugin , "unload" , "unload a plugin");
 REGISTER_COMMAND(FEBioCmd_Version      , "version", "print version information");
 REGISTER_COMMAND(FEBioCmd_where        , "where"  , "current callback event");
 REGISTER_COMMAND(FEBioCmd_list         , "list"   , "list factory classes");
+REGISTER_COMMAND(FEBioCmd_mesh         , "mesh"   , "write the mesh to a binary mesh file");
 
 int need_active_model()
 {
@@ -524,6 +526,32 @@ int FEBioCmd_svg::run(int nargs, char **argv)
 	return 0;
 }
 
+//-----------------------------------------------------------------------------
+int FEBioCmd_mesh::run(int nargs, char** argv)
+{
+	FEBioModel* fem = GetFEM();
+	if (fem == nullptr) return need_active_model();
+
+	// the file name is either given, or derived from the model's file name
+	std::string file;
+	if (nargs > 1) file = argv[1];
+	else if (fem->GetFileTitle().empty() == false)
+	{
+		file = fem->GetFileTitle();
+		size_t n = file.rfind('.');
+		if (n != std::string::npos) file.erase(n);
+		file += ".febm";
+	}
+	else { cout << "ERROR: No file name specified.\n"; return 0; }
+
+	if (FEBioMeshFile::Write(fem->GetMesh(), file.c_str()))
+		cout << "\nFile written " << file << endl;
+	else
+		cout << "ERROR: Failed writing binary mesh file " << file << endl;
+
+	return 0;
+}
+
 //-----------------------------------------------------------------------------
 int FEBioCmd_out::run(int nargs, char **argv)
 {
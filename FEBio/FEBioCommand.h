@@ -207,6 +207,14 @@ public:
 	DECLARE_COMMAND(FEBioCmd_svg);
 };
 
+//-----------------------------------------------------------------------------
+class FEBioCmd_mesh : public FEBioCommand
+{
+public:
+	int run(int nargs, char** argv);
+	DECLARE_COMMAND(FEBioCmd_mesh);
+};
+
 //-----------------------------------------------------------------------------
 class FEBioCmd_out : public FEBioCommand
 {
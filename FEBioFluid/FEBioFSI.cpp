@@ -30,6 +30,7 @@ SOFTWARE.*/
 #include "FEBioFSI.h"
 #include <FECore/FECoreKernel.h>
 #include "FEFluidFSISolver.h"
+#include "FEFSIPartitionedSolver.h"
 #include "FEFluidFSI.h"
 #include "FEFluidFSIDomain3D.h"
 #include "FEFluidFSITraction.h"
@@ -91,6 +92,7 @@ void FEBioFSI::InitModule()
 
 	//-----------------------------------------------------------------------------
 	REGISTER_FECORE_CLASS(FEFluidFSISolver, "fluid-FSI");
+	REGISTER_FECORE_CLASS(FEFSIPartitionedSolver, "fsi partitioned");
 
 	REGISTER_FECORE_CLASS(FEFluidFSI, "fluid-FSI");
 
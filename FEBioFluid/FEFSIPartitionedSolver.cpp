@@ -0,0 +1,317 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+#include "stdafx.h"
+#include "FEFSIPartitionedSolver.h"
+#include "FEBioFSI.h"
+#include <FECore/CompactUnSymmMatrix.h>
+#include <FECore/FECoreKernel.h>
+#include <FECore/FEModel.h>
+#include <FECore/log.h>
+#include <algorithm>
+
+//-----------------------------------------------------------------------------
+BEGIN_FECORE_CLASS(FEFSIPartitionedSolver, FEFluidSplitSolver)
+	ADD_PARAMETER(m_accel  , "acceleration", 0, "Aitken\0IQN-ILS\0");
+	ADD_PARAMETER(m_maxiter, "max_iter");
+	ADD_PARAMETER(m_tol    , "tol");
+	ADD_PARAMETER(m_omega0 , "omega");
+	ADD_PARAMETER(m_maxcols, "max_columns");
+	ADD_PARAMETER(m_fail_max_iter, "fail_max_iters");
+
+	ADD_PROPERTY(m_solidSolver, "structure_solver")->SetFlags(FEProperty::Optional);
+	ADD_PROPERTY(m_fluidSolver, "fluid_solver")->SetFlags(FEProperty::Optional);
+END_FECORE_CLASS();
+
+//-----------------------------------------------------------------------------
+FEFSIPartitionedSolver::FEFSIPartitionedSolver(FEModel* fem) : FEFluidSplitSolver(fem)
+{
+	m_accel = IQN_ILS;
+	m_maxiter = 50;
+	m_tol = 1e-8;
+	m_omega0 = 0.5;
+	m_maxcols = 20;
+	m_fail_max_iter = true;
+
+	m_solidSolver = nullptr;
+	m_fluidSolver = nullptr;
+}
+
+//-----------------------------------------------------------------------------
+FEFSIPartitionedSolver::~FEFSIPartitionedSolver()
+{
+	Destroy();
+	delete m_solidSolver;
+	delete m_fluidSolver;
+}
+
+//-----------------------------------------------------------------------------
+void FEFSIPartitionedSolver::SetStructureSolver(LinearSolver* ls)
+{
+	if (ls == m_solidSolver) return;
+	delete m_solidSolver;
+	m_solidSolver = ls;
+}
+
+//-----------------------------------------------------------------------------
+bool FEFSIPartitionedSolver::PreProcess()
+{
+	if (m_K == nullptr) return false;
+
+	// allocate the field solvers if they were not defined
+	FEModel* fem = GetFEModel();
+	FECoreKernel& fecore = FECoreKernel::GetInstance();
+	if (m_solidSolver == nullptr) m_solidSolver = fecore.CreateDefaultLinearSolver(fem);
+	if (m_fluidSolver == nullptr) m_fluidSolver = fecore.CreateDefaultLinearSolver(fem);
+	if ((m_solidSolver == nullptr) || (m_fluidSolver == nullptr)) return false;
+	m_solidSolver->SetFEModel(fem);
+	m_fluidSolver->SetFEModel(fem);
+
+	// the fluid field is made up of the relative fluid velocity and dilatation
+	std::vector<int> dofs;
+	const char* szw = FEBioFSI::GetVariableName(FEBioFSI::RELATIVE_FLUID_VELOCITY);
+	for (int j = 0; j < 3; ++j) dofs.push_back(fem->GetDOFIndex(szw, j));
+	dofs.push_back(fem->GetDOFIndex(FEBioFSI::GetVariableName(FEBioFSI::FLUID_DILATATION), 0));
+	if (SplitEquations(dofs) == false)
+	{
+		feLogError("The partitioned FSI solver requires structure and fluid equations.");
+		return false;
+	}
+
+	BuildBlocks();
+
+	// the interface consists of the structure equations the fluid depends on
+	const int ns = FieldEquations(0);
+	const int nf = FieldEquations(1);
+	std::vector<bool> tag(ns, false);
+	for (int j : m_split.C().indices()) tag[j] = true;
+	m_itf.clear();
+	for (int i = 0; i < ns; ++i) if (tag[i]) m_itf.push_back(i);
+	feLogInfo("Partitioned FSI: %d structure, %d fluid and %d interface equations", ns, nf, (int)m_itf.size());
+
+	if ((m_solidSolver->SetSparseMatrix(m_split.A()) == false) || (m_fluidSolver->SetSparseMatrix(m_split.D()) == false))
+	{
+		feLogError("The linear solvers of the partitioned FSI solver must accept a compact (CRS) matrix.");
+		return false;
+	}
+	if (m_solidSolver->PreProcess() == false) return false;
+	if (m_fluidSolver->PreProcess() == false) return false;
+
+	int ni = (int)m_itf.size();
+	m_rs.resize(ns); m_xs.resize(ns); m_ts.resize(ns); m_ys.assign(ns, 0.0);
+	m_rf.resize(nf); m_xf.resize(nf); m_tf.resize(nf);
+	m_h.resize(ni); m_res.resize(ni); m_hp.resize(ni); m_resp.resize(ni);
+	m_V.clear();
+	m_W.clear();
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+bool FEFSIPartitionedSolver::Factor()
+{
+	if ((m_K == nullptr) || (m_split.A() == nullptr) || (m_split.D() == nullptr)) return false;
+
+	UpdateBlocks();
+
+	if (m_solidSolver->Factor() == false) return false;
+	if (m_fluidSolver->Factor() == false) return false;
+
+	// the quasi-Newton history belongs to the previous matrix
+	m_V.clear();
+	m_W.clear();
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+void FEFSIPartitionedSolver::CouplingMap(const std::vector<double>& yi)
+{
+	const int ns = FieldEquations(0);
+	const int nf = FieldEquations(1);
+	const int ni = (int)m_itf.size();
+
+	// fluid solve for the given interface motion
+	for (int i = 0; i < ni; ++i) m_ys[m_itf[i]] = yi[i];
+	m_split.C().multv(&m_ys[0], &m_tf[0]);
+	for (int i = 0; i < nf; ++i) m_tf[i] = m_rf[i] - m_tf[i];
+	m_fluidSolver->BackSolve(&m_xf[0], &m_tf[0]);
+
+	// structure solve for the resulting fluid loads
+	m_split.B().multv(&m_xf[0], &m_ts[0]);
+	for (int i = 0; i < ns; ++i) m_ts[i] = m_rs[i] - m_ts[i];
+	m_solidSolver->BackSolve(&m_xs[0], &m_ts[0]);
+
+	for (int i = 0; i < ni; ++i)
+	{
+		m_h[i] = m_xs[m_itf[i]];
+		m_res[i] = m_h[i] - yi[i];
+	}
+}
+
+//-----------------------------------------------------------------------------
+// Find c that minimizes |V*c + res| and set yi = h + W*c. The least-squares 
+// problem is solved with a QR decomposition (modified Gram-Schmidt). Columns
+// that are (nearly) linearly dependent on newer ones are removed.
+void FEFSIPartitionedSolver::QuasiNewtonUpdate(std::vector<double>& yi)
+{
+	const int ni = (int)m_itf.size();
+
+	std::vector< std::vector<double> > Q;
+	matrix R;
+	bool bdone = false;
+	while (!bdone)
+	{
+		bdone = true;
+		int m = (int)m_V.size();
+		Q.assign(m, std::vector<double>());
+		R.resize(m, m);
+		R.zero();
+		for (int j = 0; j < m; ++j)
+		{
+			std::vector<double>& q = Q[j];
+			q = m_V[j];
+			double vnorm = sqrt(q*q);
+			for (int l = 0; l < j; ++l)
+			{
+				double r = Q[l] * q;
+				for (int i = 0; i < ni; ++i) q[i] -= r * Q[l][i];
+				R[l][j] = r;
+			}
+			double qnorm = sqrt(q*q);
+			if (qnorm <= 1e-10*vnorm)
+			{
+				m_V.erase(m_V.begin() + j);
+				m_W.erase(m_W.begin() + j);
+				bdone = false;
+				break;
+			}
+			for (int i = 0; i < ni; ++i) q[i] /= qnorm;
+			R[j][j] = qnorm;
+		}
+	}
+
+	// c = -inv(R)*Q^T*res
+	int m = (int)m_V.size();
+	std::vector<double> c(m);
+	for (int j = m - 1; j >= 0; --j)
+	{
+		double s = -(Q[j] * m_res);
+		for (int l = j + 1; l < m; ++l) s -= R[j][l] * c[l];
+		c[j] = s / R[j][j];
+	}
+
+	yi = m_h;
+	for (int j = 0; j < m; ++j)
+	{
+		const std::vector<double>& w = m_W[j];
+		for (int i = 0; i < ni; ++i) yi[i] += c[j] * w[i];
+	}
+}
+
+//-----------------------------------------------------------------------------
+bool FEFSIPartitionedSolver::BackSolve(double* x, double* y)
+{
+	Gather(y, m_rs, m_rf);
+
+	const int ni = (int)m_itf.size();
+	std::vector<double> yi(ni, 0.0);
+	double omega = m_omega0;
+	bool bconv = false;
+	int niter = 0;
+	while (niter < m_maxiter)
+	{
+		CouplingMap(yi);
+		niter++;
+
+		double rnorm = sqrt(m_res*m_res);
+		double hnorm = sqrt(m_h*m_h);
+		if (rnorm <= m_tol*hnorm) { bconv = true; break; }
+
+		if (m_accel == AITKEN)
+		{
+			if (niter > 1)
+			{
+				double num = 0.0, den = 0.0;
+				for (int i = 0; i < ni; ++i)
+				{
+					double dr = m_res[i] - m_resp[i];
+					num += m_resp[i] * dr;
+					den += dr * dr;
+				}
+				if (den > 0.0) omega = -omega * num / den;
+			}
+			for (int i = 0; i < ni; ++i) yi[i] += omega * m_res[i];
+		}
+		else
+		{
+			if (niter > 1)
+			{
+				std::vector<double> v(ni), w(ni);
+				for (int i = 0; i < ni; ++i)
+				{
+					v[i] = m_res[i] - m_resp[i];
+					w[i] = m_h[i] - m_hp[i];
+				}
+				m_V.insert(m_V.begin(), v);
+				m_W.insert(m_W.begin(), w);
+				if ((int)m_V.size() > m_maxcols) { m_V.pop_back(); m_W.pop_back(); }
+			}
+			m_hp = m_h;
+
+			if (m_V.empty()) { for (int i = 0; i < ni; ++i) yi[i] += m_omega0 * m_res[i]; }
+			else QuasiNewtonUpdate(yi);
+		}
+		m_resp = m_res;
+	}
+
+	Scatter(m_xs, m_xf, x);
+
+	UpdateStats(niter);
+
+	if (bconv == false)
+	{
+		// returning false lets the solver cut back the time step
+		if (m_fail_max_iter)
+		{
+			feLogError("Partitioned FSI coupling did not converge in %d iterations.", niter);
+			return false;
+		}
+		feLogWarning("Partitioned FSI coupling did not converge in %d iterations.", niter);
+	}
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+void FEFSIPartitionedSolver::Destroy()
+{
+	if (m_solidSolver) m_solidSolver->Destroy();
+	if (m_fluidSolver) m_fluidSolver->Destroy();
+	FEFluidSplitSolver::Destroy();
+}
@@ -0,0 +1,98 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+#pragma once
+#include "FEFluidSplitSolver.h"
+
+//-----------------------------------------------------------------------------
+//! Partitioned solver for the linearized fluid-FSI equations.
+//! The system is split into the structure (solid and mesh motion, A) and the
+//! fluid (relative fluid velocity and dilatation, D) fields:
+//!
+//!   | A  B | |xs|   |rs|
+//!   | C  D | |xf| = |rf|
+//!
+//! Each coupling iteration solves the fluid for the current interface motion,
+//! then the structure for the resulting fluid loads (Dirichlet-Neumann). 
+//! The coupling is iterated on the interface displacements (the columns of C)
+//! and accelerated with Aitken relaxation or interface quasi-Newton (IQN-ILS).
+//! Each field is solved with its own linear solver.
+class FEBIOFLUID_API FEFSIPartitionedSolver : public FEFluidSplitSolver
+{
+public:
+	enum Acceleration {
+		AITKEN,
+		IQN_ILS
+	};
+
+public:
+	FEFSIPartitionedSolver(FEModel* fem);
+	~FEFSIPartitionedSolver();
+
+	//! set the solver for the structure field
+	void SetStructureSolver(LinearSolver* ls);
+
+public:
+	bool PreProcess() override;
+
+	bool Factor() override;
+
+	bool BackSolve(double* x, double* y) override;
+
+	void Destroy() override;
+
+private:
+	//! evaluate the fixed-point map for the interface displacements yi
+	void CouplingMap(const std::vector<double>& yi);
+
+	//! IQN-ILS update of the interface displacements
+	void QuasiNewtonUpdate(std::vector<double>& yi);
+
+private:
+	int		m_accel;		//!< acceleration method
+	int		m_maxiter;		//!< max nr of coupling iterations per solve
+	double	m_tol;			//!< relative tolerance on the interface residual
+	double	m_omega0;		//!< initial (or maximum) relaxation factor
+	int		m_maxcols;		//!< max nr of IQN-ILS columns
+	bool	m_fail_max_iter;	//!< fail the solve if the coupling does not converge
+
+	LinearSolver*	m_solidSolver;	//!< solver for the structure field
+	LinearSolver*	m_fluidSolver;	//!< solver for the fluid field
+
+private:
+	std::vector<int>	m_itf;		//!< interface equations (local to the structure field)
+
+	std::vector<double>	m_rs, m_rf, m_xs, m_xf, m_ts, m_tf;
+	std::vector<double>	m_h, m_res, m_hp, m_resp, m_ys;
+
+	// IQN-ILS history (differences of residuals and of map values)
+	// Since the map is affine, these remain valid until the next factorization.
+	std::vector< std::vector<double> >	m_V, m_W;
+
+	DECLARE_FECORE_CLASS();
+};
@@ -36,6 +36,7 @@ SOFTWARE.*/
 #include <FECore/sys.h>
 #include "FEBioFluid.h"
 #include <FECore/FELinearSystem.h>
+#include <FECore/FEElementWorkspace.h>
 
 //-----------------------------------------------------------------------------
 //! constructor
@@ -142,8 +143,9 @@ void FEFluidDomain3D::InternalForces(FEGlobalVector& R)
     for (int i=0; i<NE; ++i)
     {
         // element force vector
-        vector<double> fe;
-        vector<int> lm;
+        FEScopedWorkspace ws;
+        vector<double>& fe = ws->fe;
+        vector<int>& lm = ws->lm;
         
         // get the element
         FESolidElement& el = m_Elem[i];
@@ -240,8 +242,9 @@ void FEFluidDomain3D::BodyForce(FEGlobalVector& R, FEBodyForce& BF)
     int NE = (int)m_Elem.size();
     for (int i=0; i<NE; ++i)
     {
-        vector<double> fe;
-        vector<int> lm;
+        FEScopedWorkspace ws;
+        vector<double>& fe = ws->fe;
+        vector<int>& lm = ws->lm;
         
         // get the element
         FESolidElement& el = m_Elem[i];
@@ -459,20 +462,19 @@ void FEFluidDomain3D::StiffnessMatrix(FELinearSystem& LS)
 		FESolidElement& el = m_Elem[iel];
 
         // element stiffness matrix
-        FEElementMatrix ke(el);
+        FEScopedWorkspace ws;
         
         // create the element's stiffness matrix
         int ndof = 4*el.Nodes();
-        ke.resize(ndof, ndof);
-        ke.zero();
+        FEElementMatrix& ke = ws->ElementMatrix(el, ndof, ndof);
         
         // calculate material stiffness
         ElementStiffness(el, ke);
         
         // get the element's LM vector
-		vector<int> lm;
+		vector<int>& lm = ws->lm;
 		UnpackLM(el, lm);
-		ke.SetIndices(lm);
+		ke.SwapIndices(lm);
 
         // assemble element matrix in global stiffness matrix
 		LS.Assemble(ke);
@@ -491,20 +493,19 @@ void FEFluidDomain3D::MassMatrix(FELinearSystem& LS)
 		FESolidElement& el = m_Elem[iel];
 
         // element stiffness matrix
-		FEElementMatrix ke(el);
+        FEScopedWorkspace ws;
         
         // create the element's stiffness matrix
         int ndof = 4*el.Nodes();
-        ke.resize(ndof, ndof);
-        ke.zero();
+        FEElementMatrix& ke = ws->ElementMatrix(el, ndof, ndof);
         
         // calculate inertial stiffness
         ElementMassMatrix(el, ke);
         
         // get the element's LM vector
-		vector<int> lm;
+		vector<int>& lm = ws->lm;
 		UnpackLM(el, lm);
-		ke.SetIndices(lm);
+		ke.SwapIndices(lm);
         
         // assemble element matrix in global stiffness matrix
 		LS.Assemble(ke);
@@ -522,20 +523,19 @@ void FEFluidDomain3D::BodyForceStiffness(FELinearSystem& LS, FEBodyForce& bf)
 		FESolidElement& el = m_Elem[iel];
 
         // element stiffness matrix
-        FEElementMatrix ke(el);
+        FEScopedWorkspace ws;
         
         // create the element's stiffness matrix
         int ndof = 4*el.Nodes();
-        ke.resize(ndof, ndof);
-        ke.zero();
+        FEElementMatrix& ke = ws->ElementMatrix(el, ndof, ndof);
         
         // calculate inertial stiffness
         ElementBodyForceStiffness(bf, el, ke);
         
         // get the element's LM vector
-		vector<int> lm;
+		vector<int>& lm = ws->lm;
 		UnpackLM(el, lm);
-		ke.SetIndices(lm);
+		ke.SwapIndices(lm);
         
         // assemble element matrix in global stiffness matrix
 		LS.Assemble(ke);
@@ -716,8 +716,9 @@ void FEFluidDomain3D::InertialForces(FEGlobalVector& R)
     for (int i=0; i<NE; ++i)
     {
         // element force vector
-        vector<double> fe;
-        vector<int> lm;
+        FEScopedWorkspace ws;
+        vector<double>& fe = ws->fe;
+        vector<int>& lm = ws->lm;
         
         // get the element
         FESolidElement& el = m_Elem[i];
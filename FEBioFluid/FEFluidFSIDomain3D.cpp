@@ -32,6 +32,7 @@ SOFTWARE.*/
 #include <FECore/FEModel.h>
 #include "FEBioFSI.h"
 #include <FECore/FELinearSystem.h>
+#include <FECore/FEElementWorkspace.h>
 
 //-----------------------------------------------------------------------------
 //! constructor
@@ -157,7 +158,7 @@ void FEFluidFSIDomain3D::UnpackLM(FEElement& el, vector<int>& lm)
     for (int i=0; i<N; ++i)
     {
         FENode& node = m_pMesh->Node(el.m_node[i]);
-        vector<int>& id = node.m_ID;
+        FENodeDofArray<int>& id = node.m_ID;
         
         // first the displacement dofs
         lm[7*i  ] = id[m_dofU[0]];
@@ -180,7 +181,7 @@ void FEFluidFSIDomain3D::UnpackLM(FEElement& el, vector<int>& lm)
     {
         if (sel.m_bitfc[i]) {
             FENode& node = m_pMesh->Node(el.m_node[i]);
-            vector<int>& id = node.m_ID;
+            FENodeDofArray<int>& id = node.m_ID;
             
             // first the displacement dofs
             lm[7*i  ] = id[m_dofSU[0]];
@@ -198,8 +199,9 @@ void FEFluidFSIDomain3D::InternalForces(FEGlobalVector& R)
     for (int i=0; i<NE; ++i)
     {
         // element force vector
-        vector<double> fe;
-        vector<int> lm;
+        FEScopedWorkspace ws;
+        vector<double>& fe = ws->fe;
+        vector<int>& lm = ws->lm;
         
         // get the element
         FESolidElement& el = m_Elem[i];
@@ -316,8 +318,9 @@ void FEFluidFSIDomain3D::BodyForce(FEGlobalVector& R, FEBodyForce& BF)
         FESolidElement& el = m_Elem[i];
         
         if (el.isActive()) {
-            vector<double> fe;
-            vector<int> lm;
+            FEScopedWorkspace ws;
+            vector<double>& fe = ws->fe;
+            vector<int>& lm = ws->lm;
             
             // get the element force vector and initialize it to zero
             int ndof = 7*el.Nodes();
@@ -574,20 +577,19 @@ void FEFluidFSIDomain3D::StiffnessMatrix(FELinearSystem& LS)
         
         if (el.isActive()) {
             // element stiffness matrix
-            FEElementMatrix ke(el);
+            FEScopedWorkspace ws;
             
             // create the element's stiffness matrix
             int ndof = 7*el.Nodes();
-            ke.resize(ndof, ndof);
-            ke.zero();
+            FEElementMatrix& ke = ws->ElementMatrix(el, ndof, ndof);
             
             // calculate material stiffness
             ElementStiffness(el, ke);
             
             // get the element's LM vector
-			vector<int> lm;
+			vector<int>& lm = ws->lm;
 			UnpackLM(el, lm);
-			ke.SetIndices(lm);
+			ke.SwapIndices(lm);
             
             // assemble element matrix in global stiffness matrix
 			LS.Assemble(ke);
@@ -608,20 +610,19 @@ void FEFluidFSIDomain3D::MassMatrix(FELinearSystem& LS)
         
         if (el.isActive()) {
 
-			FEElementMatrix ke(el);
+			FEScopedWorkspace ws;
 
             // create the element's stiffness matrix
             int ndof = 7*el.Nodes();
-            ke.resize(ndof, ndof);
-            ke.zero();
+            FEElementMatrix& ke = ws->ElementMatrix(el, ndof, ndof);
             
             // calculate inertial stiffness
             ElementMassMatrix(el, ke);
             
             // get the element's LM vector
-			vector<int> lm;
+			vector<int>& lm = ws->lm;
 			UnpackLM(el, lm);
-			ke.SetIndices(lm);
+			ke.SwapIndices(lm);
             
             // assemble element matrix in global stiffness matrix
 			LS.Assemble(ke);
@@ -644,20 +645,19 @@ void FEFluidFSIDomain3D::BodyForceStiffness(FELinearSystem& LS, FEBodyForce& bf)
         if (el.isActive()) {
 
 			// element stiffness matrix
-			FEElementMatrix ke(el);
+			FEScopedWorkspace ws;
 
             // create the element's stiffness matrix
             int ndof = 7*el.Nodes();
-            ke.resize(ndof, ndof);
-            ke.zero();
+            FEElementMatrix& ke = ws->ElementMatrix(el, ndof, ndof);
             
             // calculate inertial stiffness
             ElementBodyForceStiffness(bf, el, ke);
             
             // get the element's LM vector
-			vector<int> lm;
+			vector<int>& lm = ws->lm;
 			UnpackLM(el, lm);
-			ke.SetIndices(lm);
+			ke.SwapIndices(lm);
             
             // assemble element matrix in global stiffness matrix
 			LS.Assemble(ke);
@@ -888,8 +888,9 @@ void FEFluidFSIDomain3D::InertialForces(FEGlobalVector& R)
         
         if (el.isActive()) {
             // element force vector
-            vector<double> fe;
-            vector<int> lm;
+            FEScopedWorkspace ws;
+            vector<double>& fe = ws->fe;
+            vector<int>& lm = ws->lm;
             
             // get the element force vector and initialize it to zero
             int ndof = 7*el.Nodes();
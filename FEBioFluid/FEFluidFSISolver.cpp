@@ -55,6 +55,7 @@ SOFTWARE.*/
 #include <FECore/FELinearConstraintManager.h>
 #include <FECore/DumpStream.h>
 #include "FEFluidFSIAnalysis.h"
+#include "FEFSIPartitionedSolver.h"
 
 //-----------------------------------------------------------------------------
 // define the parameter list
@@ -68,6 +69,7 @@ BEGIN_FECORE_CLASS(FEFluidFSISolver, FENewtonSolver)
 	ADD_PARAMETER(m_pred , "predictor"   );
     ADD_PARAMETER(m_minJf, "min_volume_ratio");
     ADD_PARAMETER(m_order, "order"      );
+    ADD_PARAMETER(m_coupling, "coupling", 0, "monolithic\0partitioned\0");
 END_FECORE_CLASS();
 
 //-----------------------------------------------------------------------------
@@ -103,6 +105,7 @@ m_dofU(pfem), m_dofV(pfem), m_dofSU(pfem), m_dofSV(pfem), m_dofSA(pfem),m_dofR(p
     m_gamma = 1;
     m_pred = 0;
     m_order = 2;
+    m_coupling = MONOLITHIC;
     
 	// Preferred strategy is Broyden's method
 	SetDefaultStrategy(QN_BROYDEN);
@@ -175,6 +178,16 @@ void FEFluidFSISolver:: SolverWarnings()
 //
 bool FEFluidFSISolver::Init()
 {
+    // The partitioned coupling solves the structure and fluid fields separately.
+    // A user-defined linear solver is then used for the structure.
+    if ((m_coupling == PARTITIONED) && (dynamic_cast<FEFSIPartitionedSolver*>(m_plinsolve) == nullptr))
+    {
+        FEFSIPartitionedSolver* ps = fecore_new<FEFSIPartitionedSolver>("fsi partitioned", GetFEModel());
+        if (ps == nullptr) return false;
+        ps->SetStructureSolver(m_plinsolve);
+        m_plinsolve = ps;
+    }
+
     // initialize base class
     if (FENewtonSolver::Init() == false) return false;
     
@@ -922,7 +935,7 @@ bool FEFluidFSISolver::Quasin()
         
         // calculate norms
         // update all degrees of freedom
-        for (int i=0; i<m_neq; ++i) m_Ui[i] += s*m_ui[i];
+        vadds(m_Ui, m_ui, s);
             
         // update displacements
 		for (int i = 0; i<m_ndeq; ++i) m_Di[i] += s*m_di[i];
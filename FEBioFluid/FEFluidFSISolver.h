@@ -145,6 +145,10 @@ public:
     double  m_gamma;        //!< gamma
     int     m_pred;         //!< predictor method
     int     m_order;        //!< generalized-alpha integration order
+
+    // coupling of the fluid and structure fields
+    enum { MONOLITHIC, PARTITIONED };
+    int     m_coupling;     //!< monolithic or partitioned linear solves
     
 protected:
 	FEDofList	m_dofU;		// solid displacement
@@ -36,6 +36,7 @@ SOFTWARE.*/
 #include <FECore/sys.h>
 #include "FEBioFluidSolutes.h"
 #include <FECore/FELinearSystem.h>
+#include <FECore/FEElementWorkspace.h>
 
 #ifndef SQR
 #define SQR(x) ((x)*(x))
@@ -297,8 +298,9 @@ void FEFluidSolutesDomain3D::InternalForces(FEGlobalVector& R)
     for (int i=0; i<NE; ++i)
     {
         // element force vector
-        vector<double> fe;
-        vector<int> lm;
+        FEScopedWorkspace ws;
+        vector<double>& fe = ws->fe;
+        vector<int>& lm = ws->lm;
         
         // get the element
         FESolidElement& el = m_Elem[i];
@@ -452,8 +454,9 @@ void FEFluidSolutesDomain3D::BodyForce(FEGlobalVector& R, FEBodyForce& BF)
     int ndpn = 4+nsol;
     for (int i=0; i<NE; ++i)
     {
-        vector<double> fe;
-        vector<int> lm;
+        FEScopedWorkspace ws;
+        vector<double>& fe = ws->fe;
+        vector<int>& lm = ws->lm;
         
         // get the element
         FESolidElement& el = m_Elem[i];
@@ -888,22 +891,21 @@ void FEFluidSolutesDomain3D::StiffnessMatrix(FELinearSystem& LS)
         FESolidElement& el = m_Elem[iel];
         
         // element stiffness matrix
-        FEElementMatrix ke(el);
+        FEScopedWorkspace ws;
         
         // create the element's stiffness matrix
         int nsol = m_pMat->Solutes();
         int ndpn = 4 + nsol;
         int ndof = ndpn*el.Nodes();
-        ke.resize(ndof, ndof);
-        ke.zero();
+        FEElementMatrix& ke = ws->ElementMatrix(el, ndof, ndof);
         
         // calculate material stiffness
         ElementStiffness(el, ke);
         
         // get the element's LM vector
-        vector<int> lm;
+        vector<int>& lm = ws->lm;
         UnpackLM(el, lm);
-        ke.SetIndices(lm);
+        ke.SwapIndices(lm);
         
         // assemble element matrix in global stiffness matrix
         LS.Assemble(ke);
@@ -922,22 +924,21 @@ void FEFluidSolutesDomain3D::MassMatrix(FELinearSystem& LS)
         FESolidElement& el = m_Elem[iel];
         
         // element stiffness matrix
-        FEElementMatrix ke(el);
+        FEScopedWorkspace ws;
         
         // create the element's stiffness matrix
         const int nsol = m_pMat->Solutes();
         const int ndpn = 4 + nsol;
         int ndof = ndpn*el.Nodes();
-        ke.resize(ndof, ndof);
-        ke.zero();
+        FEElementMatrix& ke = ws->ElementMatrix(el, ndof, ndof);
         
         // calculate inertial stiffness
         ElementMassMatrix(el, ke);
         
         // get the element's LM vector
-        vector<int> lm;
+        vector<int>& lm = ws->lm;
         UnpackLM(el, lm);
-        ke.SetIndices(lm);
+        ke.SwapIndices(lm);
         
         // assemble element matrix in global stiffness matrix
         LS.Assemble(ke);
@@ -955,22 +956,21 @@ void FEFluidSolutesDomain3D::BodyForceStiffness(FELinearSystem& LS, FEBodyForce&
         FESolidElement& el = m_Elem[iel];
         
         // element stiffness matrix
-        FEElementMatrix ke(el);
+        FEScopedWorkspace ws;
         
         // create the element's stiffness matrix
         const int nsol = m_pMat->Solutes();
         const int ndpn = 4 + nsol;
         int ndof = ndpn*el.Nodes();
-        ke.resize(ndof, ndof);
-        ke.zero();
+        FEElementMatrix& ke = ws->ElementMatrix(el, ndof, ndof);
         
         // calculate element body force stiffness
         ElementBodyForceStiffness(bf, el, ke);
         
         // get the element's LM vector
-        vector<int> lm;
+        vector<int>& lm = ws->lm;
         UnpackLM(el, lm);
-        ke.SetIndices(lm);
+        ke.SwapIndices(lm);
         
         // assemble element matrix in global stiffness matrix
         LS.Assemble(ke);
@@ -1193,8 +1193,9 @@ void FEFluidSolutesDomain3D::InertialForces(FEGlobalVector& R)
     for (int i=0; i<NE; ++i)
     {
         // element force vector
-        vector<double> fe;
-        vector<int> lm;
+        FEScopedWorkspace ws;
+        vector<double>& fe = ws->fe;
+        vector<int>& lm = ws->lm;
         
         // get the element
         FESolidElement& el = m_Elem[i];
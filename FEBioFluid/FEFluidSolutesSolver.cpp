@@ -809,7 +809,7 @@ bool FEFluidSolutesSolver::Quasin()
         
         // calculate norms
         // update all degrees of freedom
-        for (int i=0; i<m_neq; ++i) m_Ui[i] += s*m_ui[i];
+        vadds(m_Ui, m_ui, s);
         
         // update velocities
         for (int i = 0; i<m_nveq; ++i) m_Vi[i] += s*m_vi[i];
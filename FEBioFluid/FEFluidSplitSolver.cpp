@@ -0,0 +1,71 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+#include "stdafx.h"
+#include "FEFluidSplitSolver.h"
+#include <FECore/CompactUnSymmMatrix.h>
+#include <FECore/FEModel.h>
+
+//-----------------------------------------------------------------------------
+FEFluidSplitSolver::FEFluidSplitSolver(FEModel* fem) : LinearSolver(fem)
+{
+	m_K = nullptr;
+}
+
+//-----------------------------------------------------------------------------
+FEFluidSplitSolver::~FEFluidSplitSolver()
+{
+}
+
+//-----------------------------------------------------------------------------
+SparseMatrix* FEFluidSplitSolver::CreateSparseMatrix(Matrix_Type ntype)
+{
+	if (ntype != REAL_UNSYMMETRIC) return nullptr;
+	m_K = new CRSSparseMatrix(1);
+	return m_K;
+}
+
+//-----------------------------------------------------------------------------
+bool FEFluidSplitSolver::SetSparseMatrix(SparseMatrix* pA)
+{
+	m_K = dynamic_cast<CRSSparseMatrix*>(pA);
+	return (m_K != nullptr);
+}
+
+//-----------------------------------------------------------------------------
+void FEFluidSplitSolver::Destroy()
+{
+	m_split.Clear();
+}
+
+//-----------------------------------------------------------------------------
+bool FEFluidSplitSolver::SplitEquations(const std::vector<int>& dofs)
+{
+	if (m_K == nullptr) return false;
+	return m_split.SplitEquations(GetFEModel(), m_K->Rows(), dofs);
+}
@@ -0,0 +1,76 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+#pragma once
+#include <FECore/LinearSolver.h>
+#include <FECore/FEFieldSplit.h>
+#include "febiofluid_api.h"
+
+//-----------------------------------------------------------------------------
+//! Base class for linear solvers that split the global system into two fields
+//!
+//!   | A  B | |x0|   |y0|
+//!   | C  D | |x1| = |y1|
+//!
+//! where the second field is defined by a list of nodal degrees of freedom.
+//! The blocks are managed by an FEFieldSplit (see there for the storage formats).
+class FEBIOFLUID_API FEFluidSplitSolver : public LinearSolver
+{
+public:
+	FEFluidSplitSolver(FEModel* fem);
+	~FEFluidSplitSolver();
+
+public:
+	SparseMatrix* CreateSparseMatrix(Matrix_Type ntype) override;
+
+	bool SetSparseMatrix(SparseMatrix* pA) override;
+
+	void Destroy() override;
+
+protected:
+	//! assign the equations of the given dofs to the second field (all others go to the first)
+	bool SplitEquations(const std::vector<int>& dofs);
+
+	//! allocate the blocks (call after SplitEquations)
+	void BuildBlocks() { m_split.BuildBlocks(m_K); }
+
+	//! copy the values of the global matrix into the blocks
+	void UpdateBlocks() { m_split.UpdateBlocks(m_K); }
+
+	//! split a global vector into the field vectors
+	void Gather(const double* y, std::vector<double>& y0, std::vector<double>& y1) const { m_split.Gather(y, y0.data(), y1.data()); }
+
+	//! assemble the field vectors into a global vector
+	void Scatter(const std::vector<double>& x0, const std::vector<double>& x1, double* x) const { m_split.Scatter(x0.data(), x1.data(), x); }
+
+	int FieldEquations(int n) const { return m_split.Equations(n); }
+
+protected:
+	CRSSparseMatrix*	m_K;		//!< global matrix
+	FEFieldSplit		m_split;	//!< the blocks of the two fields
+};
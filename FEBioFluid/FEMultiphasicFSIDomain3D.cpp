@@ -35,6 +35,7 @@
 #include "FEFluidFSI.h"
 #include "FEBiphasicFSI.h"
 #include <FECore/FELinearSystem.h>
+#include <FECore/FEElementWorkspace.h>
 
 #ifndef SQR
 #define SQR(x) ((x)*(x))
@@ -336,7 +337,7 @@ void FEMultiphasicFSIDomain3D::UnpackLM(FEElement& el, vector<int>& lm)
     for (int i=0; i<N; ++i)
     {
         FENode& node = m_pMesh->Node(el.m_node[i]);
-        vector<int>& id = node.m_ID;
+        FENodeDofArray<int>& id = node.m_ID;
         
         // first the displacement dofs
         lm[ndpn*i  ] = id[m_dofU[0]];
@@ -364,7 +365,7 @@ void FEMultiphasicFSIDomain3D::UnpackLM(FEElement& el, vector<int>& lm)
     {
         if (sel.m_bitfc[i]) {
             FENode& node = m_pMesh->Node(el.m_node[i]);
-            vector<int>& id = node.m_ID;
+            FENodeDofArray<int>& id = node.m_ID;
             
             // first the displacement dofs
             lm[ndpn*i  ] = id[m_dofSU[0]];
@@ -386,8 +387,9 @@ void FEMultiphasicFSIDomain3D::InternalForces(FEGlobalVector& R)
     for (int i=0; i<NE; ++i)
     {
         // element force vector
-        vector<double> fe;
-        vector<int> lm;
+        FEScopedWorkspace ws;
+        vector<double>& fe = ws->fe;
+        vector<int>& lm = ws->lm;
         
         // get the element
         FESolidElement& el = m_Elem[i];
@@ -591,8 +593,9 @@ void FEMultiphasicFSIDomain3D::BodyForce(FEGlobalVector& R, FEBodyForce& BF)
         FESolidElement& el = m_Elem[i];
         
         if (el.isActive()) {
-            vector<double> fe;
-            vector<int> lm;
+            FEScopedWorkspace ws;
+            vector<double>& fe = ws->fe;
+            vector<int>& lm = ws->lm;
             
             // get the element force vector and initialize it to zero
             int ndof = ndpn*el.Nodes();
@@ -1253,20 +1256,19 @@ void FEMultiphasicFSIDomain3D::StiffnessMatrix(FELinearSystem& LS)
         
         if (el.isActive()) {
             // element stiffness matrix
-            FEElementMatrix ke(el);
+            FEScopedWorkspace ws;
             
             // create the element's stiffness matrix
             int ndof = ndpn*el.Nodes();
-            ke.resize(ndof, ndof);
-            ke.zero();
+            FEElementMatrix& ke = ws->ElementMatrix(el, ndof, ndof);
             
             // calculate material stiffness
             ElementStiffness(el, ke);
             
             // get the element's LM vector
-            vector<int> lm;
+            vector<int>& lm = ws->lm;
             UnpackLM(el, lm);
-            ke.SetIndices(lm);
+            ke.SwapIndices(lm);
             
             // assemble element matrix in global stiffness matrix
             LS.Assemble(ke);
@@ -1290,20 +1292,19 @@ void FEMultiphasicFSIDomain3D::MassMatrix(FELinearSystem& LS)
         
         if (el.isActive()) {
             
-            FEElementMatrix ke(el);
+            FEScopedWorkspace ws;
             
             // create the element's stiffness matrix
             int ndof = ndpn*el.Nodes();
-            ke.resize(ndof, ndof);
-            ke.zero();
+            FEElementMatrix& ke = ws->ElementMatrix(el, ndof, ndof);
             
             // calculate inertial stiffness
             ElementMassMatrix(el, ke);
             
             // get the element's LM vector
-            vector<int> lm;
+            vector<int>& lm = ws->lm;
             UnpackLM(el, lm);
-            ke.SetIndices(lm);
+            ke.SwapIndices(lm);
             
             // assemble element matrix in global stiffness matrix
             LS.Assemble(ke);
@@ -1330,20 +1331,19 @@ void FEMultiphasicFSIDomain3D::BodyForceStiffness(FELinearSystem& LS, FEBodyForc
         if (el.isActive()) {
             
             // element stiffness matrix
-            FEElementMatrix ke(el);
+            FEScopedWorkspace ws;
             
             // create the element's stiffness matrix
             int ndof = ndpn*el.Nodes();
-            ke.resize(ndof, ndof);
-            ke.zero();
+            FEElementMatrix& ke = ws->ElementMatrix(el, ndof, ndof);
             
             // calculate inertial stiffness
             ElementBodyForceStiffness(bf, el, ke);
             
             // get the element's LM vector
-            vector<int> lm;
+            vector<int>& lm = ws->lm;
             UnpackLM(el, lm);
-            ke.SetIndices(lm);
+            ke.SwapIndices(lm);
             
             // assemble element matrix in global stiffness matrix
             LS.Assemble(ke);
@@ -1681,8 +1681,9 @@ void FEMultiphasicFSIDomain3D::InertialForces(FEGlobalVector& R)
         
         if (el.isActive()) {
             // element force vector
-            vector<double> fe;
-            vector<int> lm;
+            FEScopedWorkspace ws;
+            vector<double>& fe = ws->fe;
+            vector<int>& lm = ws->lm;
             
             // get the element force vector and initialize it to zero
             int ndof = ndpn*el.Nodes();
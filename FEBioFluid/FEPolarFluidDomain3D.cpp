@@ -38,6 +38,7 @@
 #include "FEBioPolarFluid.h"
 #include <FECore/FELinearSystem.h>
 #include "FEBodyMoment.h"
+#include <FECore/FEElementWorkspace.h>
 
 //-----------------------------------------------------------------------------
 //! constructor
@@ -148,8 +149,9 @@ void FEPolarFluidDomain3D::InternalForces(FEGlobalVector& R)
     for (int i=0; i<NE; ++i)
     {
         // element force vector
-        vector<double> fe;
-        vector<int> lm;
+        FEScopedWorkspace ws;
+        vector<double>& fe = ws->fe;
+        vector<int>& lm = ws->lm;
         
         // get the element
         FESolidElement& el = m_Elem[i];
@@ -253,8 +255,9 @@ void FEPolarFluidDomain3D::BodyForce(FEGlobalVector& R, FEBodyForce& BF)
     int NE = (int)m_Elem.size();
     for (int i=0; i<NE; ++i)
     {
-        vector<double> fe;
-        vector<int> lm;
+        FEScopedWorkspace ws;
+        vector<double>& fe = ws->fe;
+        vector<int>& lm = ws->lm;
         
         // get the element
         FESolidElement& el = m_Elem[i];
@@ -372,8 +375,9 @@ void FEPolarFluidDomain3D::BodyMoment(FEGlobalVector& R, FEBodyMoment& bm)
     int NE = (int)m_Elem.size();
     for (int i=0; i<NE; ++i)
     {
-        vector<double> fe;
-        vector<int> lm;
+        FEScopedWorkspace ws;
+        vector<double>& fe = ws->fe;
+        vector<int>& lm = ws->lm;
         
         // get the element
         FESolidElement& el = m_Elem[i];
@@ -637,20 +641,19 @@ void FEPolarFluidDomain3D::StiffnessMatrix(FELinearSystem& LS)
         FESolidElement& el = m_Elem[iel];
         
         // element stiffness matrix
-        FEElementMatrix ke(el);
+        FEScopedWorkspace ws;
         
         // create the element's stiffness matrix
         int ndof = 7*el.Nodes();
-        ke.resize(ndof, ndof);
-        ke.zero();
+        FEElementMatrix& ke = ws->ElementMatrix(el, ndof, ndof);
         
         // calculate material stiffness
         ElementStiffness(el, ke);
         
         // get the element's LM vector
-        vector<int> lm;
+        vector<int>& lm = ws->lm;
         UnpackLM(el, lm);
-        ke.SetIndices(lm);
+        ke.SwapIndices(lm);
         
         // assemble element matrix in global stiffness matrix
         LS.Assemble(ke);
@@ -669,20 +672,19 @@ void FEPolarFluidDomain3D::MassMatrix(FELinearSystem& LS)
         FESolidElement& el = m_Elem[iel];
         
         // element stiffness matrix
-        FEElementMatrix ke(el);
+        FEScopedWorkspace ws;
         
         // create the element's stiffness matrix
         int ndof = 7*el.Nodes();
-        ke.resize(ndof, ndof);
-        ke.zero();
+        FEElementMatrix& ke = ws->ElementMatrix(el, ndof, ndof);
         
         // calculate inertial stiffness
         ElementMassMatrix(el, ke);
         
         // get the element's LM vector
-        vector<int> lm;
+        vector<int>& lm = ws->lm;
         UnpackLM(el, lm);
-        ke.SetIndices(lm);
+        ke.SwapIndices(lm);
         
         // assemble element matrix in global stiffness matrix
         LS.Assemble(ke);
@@ -701,20 +703,19 @@ void FEPolarFluidDomain3D::BodyForceStiffness(FELinearSystem& LS, FEBodyForce& b
         FESolidElement& el = m_Elem[iel];
         
         // element stiffness matrix
-        FEElementMatrix ke(el);
+        FEScopedWorkspace ws;
         
         // create the element's stiffness matrix
         int ndof = 7*el.Nodes();
-        ke.resize(ndof, ndof);
-        ke.zero();
+        FEElementMatrix& ke = ws->ElementMatrix(el, ndof, ndof);
         
         // calculate inertial stiffness
         ElementBodyForceStiffness(bf, el, ke);
         
         // get the element's LM vector
-        vector<int> lm;
+        vector<int>& lm = ws->lm;
         UnpackLM(el, lm);
-        ke.SetIndices(lm);
+        ke.SwapIndices(lm);
         
         // assemble element matrix in global stiffness matrix
         LS.Assemble(ke);
@@ -732,20 +733,19 @@ void FEPolarFluidDomain3D::BodyMomentStiffness(FELinearSystem& LS, FEBodyMoment&
         FESolidElement& el = m_Elem[iel];
         
         // element stiffness matrix
-        FEElementMatrix ke(el);
+        FEScopedWorkspace ws;
         
         // create the element's stiffness matrix
         int ndof = 7*el.Nodes();
-        ke.resize(ndof, ndof);
-        ke.zero();
+        FEElementMatrix& ke = ws->ElementMatrix(el, ndof, ndof);
         
         // calculate inertial stiffness
         ElementBodyMomentStiffness(bm, el, ke);
         
         // get the element's LM vector
-        vector<int> lm;
+        vector<int>& lm = ws->lm;
         UnpackLM(el, lm);
-        ke.SetIndices(lm);
+        ke.SwapIndices(lm);
         
         // assemble element matrix in global stiffness matrix
         LS.Assemble(ke);
@@ -969,8 +969,9 @@ void FEPolarFluidDomain3D::InertialForces(FEGlobalVector& R)
     for (int i=0; i<NE; ++i)
     {
         // element force vector
-        vector<double> fe;
-        vector<int> lm;
+        FEScopedWorkspace ws;
+        vector<double>& fe = ws->fe;
+        vector<int>& lm = ws->lm;
         
         // get the element
         FESolidElement& el = m_Elem[i];
@@ -835,7 +835,7 @@ bool FEPolarFluidSolver::Quasin()
         
         // calculate norms
         // update all degrees of freedom
-        for (int i=0; i<m_neq; ++i) m_Ui[i] += s*m_ui[i];
+        vadds(m_Ui, m_ui, s);
         
         // update velocities
         for (int i = 0; i<m_nveq; ++i) m_Vi[i] += s*m_vi[i];
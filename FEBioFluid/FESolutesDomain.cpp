@@ -32,6 +32,7 @@ SOFTWARE.*/
 #include <FECore/sys.h>
 #include "FEBioFluidSolutes.h"
 #include <FECore/FELinearSystem.h>
+#include <FECore/FEElementWorkspace.h>
 
 //-----------------------------------------------------------------------------
 //! constructor
@@ -242,8 +243,9 @@ void FESolutesDomain::InternalForces(FEGlobalVector& R)
 	for (int i = 0; i<NE; ++i)
 	{
 		// element force vector
-		vector<double> fe;
-		vector<int> lm;
+		FEScopedWorkspace ws;
+		vector<double>& fe = ws->fe;
+		vector<int>& lm = ws->lm;
 
 		// get the element
 		FESolidElement& el = m_Elem[i];
@@ -454,21 +456,20 @@ void FESolutesDomain::StiffnessMatrix(FELinearSystem& LS)
 		FESolidElement& el = m_Elem[iel];
 
 		// element stiffness matrix
-		FEElementMatrix ke(el);
+		FEScopedWorkspace ws;
 
 		// create the element's stiffness matrix
 		int nsol = m_pMat->Solutes();
 		int ndof = nsol*el.Nodes();
-		ke.resize(ndof, ndof);
-		ke.zero();
+		FEElementMatrix& ke = ws->ElementMatrix(el, ndof, ndof);
 
 		// calculate material stiffness
 		ElementStiffness(el, ke);
 
 		// get the element's LM vector
-		vector<int> lm;
+		vector<int>& lm = ws->lm;
 		UnpackLM(el, lm);
-		ke.SetIndices(lm);
+		ke.SwapIndices(lm);
 
 		// assemble element matrix in global stiffness matrix
 		LS.Assemble(ke);
@@ -570,7 +570,7 @@ bool FESolutesSolver::Quasin()
         
         // calculate norms
         // update all degrees of freedom
-        for (int i=0; i<m_neq; ++i) m_Ui[i] += s*m_ui[i];
+        vadds(m_Ui, m_ui, s);
         
         // calculate the norms
         normR1 = m_R1*m_R1;
@@ -102,7 +102,7 @@ void FETemperatureBackFlowStabilization::Update()
         {
             node.set_bc(m_dofT, DOF_PRESCRIBED);
             node.m_ID[m_dofT] = -node.m_ID[m_dofT] - 2;
-            int nid = node.GetID()-1; //0 based
+            int nid = ps->NodeIndex(i); // mesh node index
             int val = m_nnlist.Valence(nid);
             int* nlist = m_nnlist.NodeList(nid);
             
@@ -115,7 +115,7 @@ void FETemperatureBackFlowStabilization::Update()
                 bool isSurf = false;
                 for (int k=0; k<ps->Nodes(); ++k)
                 {
-                    if (cnid==ps->Node(k).GetID()-1)
+                    if (cnid==ps->NodeIndex(k))
                         isSurf = true;
                 }
                 if (!isSurf)
@@ -127,11 +127,11 @@ void FETemperatureBackFlowStabilization::Update()
             if (connectnidarray.size()>0)
             {
                 int cnodeIndex = 0;
-                FENode* cnodeArray = GetFEModel()->GetMesh().FindNodeFromID(connectnidarray[cnodeIndex]+1);
+                FENode* cnodeArray = &GetFEModel()->GetMesh().Node(connectnidarray[cnodeIndex]);
                 double smallDist = sqrt(pow((node.m_rt.x-cnodeArray->m_rt.x),2)+pow((node.m_rt.y-cnodeArray->m_rt.y),2)+pow((node.m_rt.z-cnodeArray->m_rt.z),2));
                 for (int j = 1; j<connectnidarray.size(); ++j)
                 {
-                    FENode* tempNode = GetFEModel()->GetMesh().FindNodeFromID(connectnidarray[j]+1);
+                    FENode* tempNode = &GetFEModel()->GetMesh().Node(connectnidarray[j]);
                     double temp = sqrt(pow((node.m_rt.x-tempNode->m_rt.x),2)+pow((node.m_rt.y-tempNode->m_rt.y),2)+pow((node.m_rt.z-tempNode->m_rt.z),2));
                     if(temp<smallDist)
                     {
@@ -141,7 +141,7 @@ void FETemperatureBackFlowStabilization::Update()
                     }
                 }
                 connectnid = connectnidarray[cnodeIndex];
-                FENode* cnode = GetFEModel()->GetMesh().FindNodeFromID(connectnid+1);
+                FENode* cnode = &GetFEModel()->GetMesh().Node(connectnid);
                 node.set(m_dofT, cnode->get(m_dofT));
             }
             else
@@ -37,6 +37,7 @@ SOFTWARE.*/
 #include <FECore/FEAnalysis.h>
 #include <FECore/sys.h>
 #include <FECore/FELinearSystem.h>
+#include <FECore/FEElementWorkspace.h>
 
 //-----------------------------------------------------------------------------
 //! constructor
@@ -167,8 +168,9 @@ void FEThermoFluidDomain3D::InternalForces(FEGlobalVector& R)
     for (int i=0; i<NE; ++i)
     {
         // element force vector
-        vector<double> fe;
-        vector<int> lm;
+        FEScopedWorkspace ws;
+        vector<double>& fe = ws->fe;
+        vector<int>& lm = ws->lm;
         
         // get the element
         FESolidElement& el = m_Elem[i];
@@ -283,8 +285,9 @@ void FEThermoFluidDomain3D::BodyForce(FEGlobalVector& R, FEBodyForce& BF)
     int ndpn = 5;
     for (int i=0; i<NE; ++i)
     {
-        vector<double> fe;
-        vector<int> lm;
+        FEScopedWorkspace ws;
+        vector<double>& fe = ws->fe;
+        vector<int>& lm = ws->lm;
         
         // get the element
         FESolidElement& el = m_Elem[i];
@@ -356,8 +359,9 @@ void FEThermoFluidDomain3D::HeatSupply(FEGlobalVector& R, FEFluidHeatSupply& BF)
     int NE = (int)m_Elem.size();
     for (int i=0; i<NE; ++i)
     {
-        vector<double> fe;
-        vector<int> lm;
+        FEScopedWorkspace ws;
+        vector<double>& fe = ws->fe;
+        vector<int>& lm = ws->lm;
         
         // get the element
         FESolidElement& el = m_Elem[i];
@@ -656,20 +660,19 @@ void FEThermoFluidDomain3D::StiffnessMatrix(FELinearSystem& LS)
         FESolidElement& el = m_Elem[iel];
 
         // element stiffness matrix
-        FEElementMatrix ke(el);
+        FEScopedWorkspace ws;
         
         // create the element's stiffness matrix
         int ndof = 5*el.Nodes();
-        ke.resize(ndof, ndof);
-        ke.zero();
+        FEElementMatrix& ke = ws->ElementMatrix(el, ndof, ndof);
         
         // calculate material stiffness
         ElementStiffness(el, ke);
         
         // get the element's LM vector
-        vector<int> lm;
+        vector<int>& lm = ws->lm;
         UnpackLM(el, lm);
-        ke.SetIndices(lm);
+        ke.SwapIndices(lm);
 
         // assemble element matrix in global stiffness matrix
         LS.Assemble(ke);
@@ -688,20 +691,19 @@ void FEThermoFluidDomain3D::MassMatrix(FELinearSystem& LS)
         FESolidElement& el = m_Elem[iel];
 
         // element stiffness matrix
-        FEElementMatrix ke(el);
+        FEScopedWorkspace ws;
         
         // create the element's stiffness matrix
         int ndof = 5*el.Nodes();
-        ke.resize(ndof, ndof);
-        ke.zero();
+        FEElementMatrix& ke = ws->ElementMatrix(el, ndof, ndof);
         
         // calculate inertial stiffness
         ElementMassMatrix(el, ke);
         
         // get the element's LM vector
-        vector<int> lm;
+        vector<int>& lm = ws->lm;
         UnpackLM(el, lm);
-        ke.SetIndices(lm);
+        ke.SwapIndices(lm);
         
         // assemble element matrix in global stiffness matrix
         LS.Assemble(ke);
@@ -720,20 +722,19 @@ void FEThermoFluidDomain3D::BodyForceStiffness(FELinearSystem& LS, FEBodyForce&
         FESolidElement& el = m_Elem[iel];
 
         // element stiffness matrix
-        FEElementMatrix ke(el);
+        FEScopedWorkspace ws;
         
         // create the element's stiffness matrix
         int ndof = 5*el.Nodes();
-        ke.resize(ndof, ndof);
-        ke.zero();
+        FEElementMatrix& ke = ws->ElementMatrix(el, ndof, ndof);
         
         // calculate inertial stiffness
         ElementBodyForceStiffness(bf, el, ke);
         
         // get the element's LM vector
-        vector<int> lm;
+        vector<int>& lm = ws->lm;
         UnpackLM(el, lm);
-        ke.SetIndices(lm);
+        ke.SwapIndices(lm);
         
         // assemble element matrix in global stiffness matrix
         LS.Assemble(ke);
@@ -751,20 +752,19 @@ void FEThermoFluidDomain3D::HeatSupplyStiffness(FELinearSystem& LS, FEFluidHeatS
         FESolidElement& el = m_Elem[iel];
 
         // element stiffness matrix
-        FEElementMatrix ke(el);
+        FEScopedWorkspace ws;
         
         // create the element's stiffness matrix
         int ndof = 5*el.Nodes();
-        ke.resize(ndof, ndof);
-        ke.zero();
+        FEElementMatrix& ke = ws->ElementMatrix(el, ndof, ndof);
         
         // calculate inertial stiffness
         ElementHeatSupplyStiffness(bf, el, ke);
         
         // get the element's LM vector
-        vector<int> lm;
+        vector<int>& lm = ws->lm;
         UnpackLM(el, lm);
-        ke.SetIndices(lm);
+        ke.SwapIndices(lm);
         
         // assemble element matrix in global stiffness matrix
         LS.Assemble(ke);
@@ -964,8 +964,9 @@ void FEThermoFluidDomain3D::InertialForces(FEGlobalVector& R)
     for (int i=0; i<NE; ++i)
     {
         // element force vector
-        vector<double> fe;
-        vector<int> lm;
+        FEScopedWorkspace ws;
+        vector<double>& fe = ws->fe;
+        vector<int>& lm = ws->lm;
         
         // get the element
         FESolidElement& el = m_Elem[i];
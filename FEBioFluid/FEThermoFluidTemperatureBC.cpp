@@ -77,7 +77,7 @@ void FEThermoFluidTemperatureBC::Update()
         
         if (m_backflow[i]) m_T[i] = node.get_prev(m_dofT);
         else {
-            int nid = node.GetID()-1; //0 based
+            int nid = m_surf->NodeIndex(i); // mesh node index
             int val = m_nnlist.Valence(nid);
             int* nlist = m_nnlist.NodeList(nid);
             
@@ -90,7 +90,7 @@ void FEThermoFluidTemperatureBC::Update()
                 bool isSurf = false;
                 for (int k=0; k<m_surf->Nodes(); ++k)
                 {
-                    if (cnid==m_surf->Node(k).GetID()-1)
+                    if (cnid==m_surf->NodeIndex(k))
                         isSurf = true;
                 }
                 if (!isSurf)
@@ -102,11 +102,11 @@ void FEThermoFluidTemperatureBC::Update()
             if (connectnidarray.size()>0)
             {
                 int cnodeIndex = 0;
-                FENode* cnodeArray = GetFEModel()->GetMesh().FindNodeFromID(connectnidarray[cnodeIndex]+1);
+                FENode* cnodeArray = &GetFEModel()->GetMesh().Node(connectnidarray[cnodeIndex]);
                 double smallDist = sqrt(pow((node.m_rt.x-cnodeArray->m_rt.x),2)+pow((node.m_rt.y-cnodeArray->m_rt.y),2)+pow((node.m_rt.z-cnodeArray->m_rt.z),2));
                 for (int j = 1; j<connectnidarray.size(); ++j)
                 {
-                    FENode* tempNode = GetFEModel()->GetMesh().FindNodeFromID(connectnidarray[j]+1);
+                    FENode* tempNode = &GetFEModel()->GetMesh().Node(connectnidarray[j]);
                     double temp = sqrt(pow((node.m_rt.x-tempNode->m_rt.x),2)+pow((node.m_rt.y-tempNode->m_rt.y),2)+pow((node.m_rt.z-tempNode->m_rt.z),2));
                     if(temp<smallDist)
                     {
@@ -116,7 +116,7 @@ void FEThermoFluidTemperatureBC::Update()
                     }
                 }
                 connectnid = connectnidarray[cnodeIndex];
-                FENode* cnode = GetFEModel()->GetMesh().FindNodeFromID(connectnid+1);
+                FENode* cnode = &GetFEModel()->GetMesh().Node(connectnid);
                 m_T[i] = cnode->get(m_dofT);
             }
             else
@@ -44,7 +44,7 @@ SOFTWARE.*/
 // It is incremented when the structure of this file is modified.
 //
 
-#define RSTRTVERSION		0x06
+#define RSTRTVERSION		0x07	// 0x07: nodal dof data is stored by the mesh (FENodeDofStore)
 
 namespace febio
 {
@@ -295,6 +295,16 @@ void FE3FieldElasticSolidDomain::ElementMaterialStiffness(int iel, matrix &ke)
 	tens4ds I4  = dyad4s(I);
 	tens4ds Cp = IxI - I4*2;
 
+	// evaluate the deviatoric tangent at all integration points at once, 
+	// if the material supports it
+	FEElasticBatch batch;
+	bool bbatch = (BatchMaterial(true) != nullptr);
+	if (bbatch)
+	{
+		for (int n = 0; n < nint; ++n) batch.Add(*el.GetMaterialPoint(n));
+		mat.DevTangentBatch(batch);
+	}
+
 	// calculate element stiffness matrix
 	for (int n=0; n<nint; ++n)
 	{
@@ -310,7 +320,7 @@ void FE3FieldElasticSolidDomain::ElementMaterialStiffness(int iel, matrix &ke)
 		// Note that we are only grabbing the deviatoric tangent. 
 		// The other tangent terms depend on the pressure p
 		// which we seperately
-		tens4ds C = Cp*ed.ep + mat.DevTangent(mp);
+		tens4ds C = Cp*ed.ep + (bbatch ? batch.Tangent(n) : mat.DevTangent(mp));
 
 		// get the 'D' matrix
 		C.extract(D);
@@ -525,8 +535,12 @@ void FE3FieldElasticSolidDomain::UpdateElementStress(int iel, const FETimeInfo&
 	ed.ep = ed.Lk*mat.hp(ed.eJ) + mat.UJ(ed.eJ);
 //	ed.ep = mat.UJ(ed.eJ);
 
-	// loop over the integration points and calculate
-	// the stress at the integration point
+	// the deviatoric stress is evaluated for all integration points at once,
+	// if the material supports it
+	FEElasticBatch batch;
+	bool bbatch = (BatchMaterial(false) != nullptr);
+
+	// loop over the integration points and update the kinematics
 	for (int n=0; n<nint; ++n)
 	{
 		FEMaterialPoint& mp = *el.GetMaterialPoint(n);
@@ -540,10 +554,9 @@ void FE3FieldElasticSolidDomain::UpdateElementStress(int iel, const FETimeInfo&
 		mp.m_rt = el.Evaluate(r, n);
 
 		// get the deformation gradient and determinant
-        double Jt, Jp;
         mat3d Ft, Fp;
-        Jt = defgrad(el, Ft, n);
-        Jp = defgradp(el, Fp, n);
+        defgrad(el, Ft, n);
+        defgradp(el, Fp, n);
         pt.m_F = (m_alphaf==1.0? Ft : Ft*m_alphaf + Fp*(1-m_alphaf));
         pt.m_J = pt.m_F.det();
         mat3d Fi = pt.m_F.inverse();
@@ -553,19 +566,33 @@ void FE3FieldElasticSolidDomain::UpdateElementStress(int iel, const FETimeInfo&
 
         // update specialized material points
         m_pMat->UpdateSpecializedMaterialPoints(mp, tp);
-        
+
+		if (bbatch) batch.Add(mp);
+	}
+
+	// evaluate the deviatoric stress at all integration points at once,
+	// if the material supports it
+	if (bbatch) mat.DevStressBatch(batch);
+
+	for (int n=0; n<nint; ++n)
+	{
+		FEMaterialPoint& mp = *el.GetMaterialPoint(n);
+		FEElasticMaterialPoint& pt = *(mp.ExtractData<FEElasticMaterialPoint>());
+
 		// calculate the stress at this material point
 		// Note that we don't call the material's Stress member function.
 		// The reason is that we need to use the averaged pressure for the element
 		// and the Stress function uses the pointwise pressure. 
 		// Therefore we call the DevStress function and add the pressure term
 		// seperately. 
-		pt.m_s = mat.DevStress(mp);
+		pt.m_s = (bbatch ? batch.Stress(n) : mat.DevStress(mp));
         
         // adjust stress for strain energy conservation
         if (m_alphaf == 0.5) 
 		{
 			// evaluate deviatoric strain energy at current and previous time
+			mat3d Ft;
+			double Jt = defgrad(el, Ft, n);
 			mat3d Ftmp = pt.m_F;
 			double Jtmp = pt.m_J;
 			pt.m_F = Ft;
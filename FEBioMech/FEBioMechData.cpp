@@ -133,7 +133,7 @@ double FENodeForceX::value(const FENode& node)
 	if (psolid_solver)
 	{
 		vector<double>& Fr = psolid_solver->m_Fr;
-		const vector<int>& id = node.m_ID;
+		const FENodeDofArray<int>& id = node.m_ID;
 		return (-id[0] - 2 >= 0 ? Fr[-id[0] - 2] : 0);
 	}
 	return 0;
@@ -146,7 +146,7 @@ double FENodeForceY::value(const FENode& node)
 	if (psolid_solver)
 	{
 		vector<double>& Fr = psolid_solver->m_Fr;
-		const vector<int>& id = node.m_ID;
+		const FENodeDofArray<int>& id = node.m_ID;
 		return (-id[1] - 2 >= 0 ? Fr[-id[1]-2] : 0);
 	}
 	return 0;
@@ -159,7 +159,7 @@ double FENodeForceZ::value(const FENode& node)
 	if (psolid_solver)
 	{
 		vector<double>& Fr = psolid_solver->m_Fr;
-		const vector<int>& id = node.m_ID;
+		const FENodeDofArray<int>& id = node.m_ID;
 		return (-id[2] - 2 >= 0 ? Fr[-id[2]-2] : 0);
 	}
 	return 0;
@@ -785,7 +785,7 @@ bool FECGSolidSolver::SolveStep()
 			if (s > 0) olds = s;  // and store the current step to be used for the iteration after next
 			// update total incremental displacements
 			int neq = (int)m_Ui.size();
-			for (i = 0; i < neq; ++i) m_Ui[i] += s * m_ui[i];
+			vadds(m_Ui, m_ui, s);
 		}
 		else { // the line search has failed and we need to restart
 			breform = true;
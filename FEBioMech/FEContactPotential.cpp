@@ -30,6 +30,7 @@ SOFTWARE.*/
 #include <FECore/FELinearSystem.h>
 #include <FECore/FEBox.h>
 #include <stdexcept>
+#include <algorithm>
 
 vec3d MaterialPointPosition(FESurfaceElement& el, int n)
 {
@@ -136,6 +137,8 @@ FEContactPotential::FEContactPotential(FEModel* fem) : FEContactInterface(fem),
 	m_Rout = 2.0;
 	m_Rmin = 0.0;
 	m_wtol = 0.0;
+
+	m_grid = nullptr;
 }
 
 //! return the primary surface
@@ -156,18 +159,6 @@ bool FEContactPotential::UseNodalIntegration()
 	return false;
 }
 
-static bool is_neighbor(FESurfaceElement& e1, FESurfaceElement& e2)
-{
-	int n1 = e1.Nodes();
-	int n2 = e2.Nodes();
-	for (int i = 0; i < n1; ++i)
-	for (int j = 0; j < n2; ++j)
-	{
-		if (e1.m_node[i] == e2.m_node[j]) return true;
-	}
-	return false;
-}
-
 struct BOX
 {
 public:
@@ -220,81 +211,42 @@ public:
 	double depth () const { return r1.z - r0.z; }
 };
 
-class Grid
+// The grid stores the elements of a surface in flat (CSR) cell lists. The cell layout
+// is kept between updates and is only rebuilt when the surface leaves the grid's box.
+class FEContactPotential::Grid
 {
 public:
-	class Cell
-	{
-	public:
-		Cell() {}
-		Cell(const Cell& c) : m_box(c.m_box), m_elemList(c.m_elemList), m_nbr(c.m_nbr) {}
-		void operator = (const Cell& c) { 
-			m_box = c.m_box; 
-			m_elemList = c.m_elemList; 
-			m_nbr = c.m_nbr;
-		}
-
-		void add(FESurfaceElement* el)
-		{
-			m_elemList.insert(el);
-		}
-
-		bool empty() const { return m_elemList.empty(); }
-
-	public:
-		BOX m_box;
-		set<FESurfaceElement*>	m_elemList;
-		vector<Cell*>	m_nbr;
-	};
+	Grid() { m_nx = m_ny = m_nz = 0; }
 
-	Cell* FindCell(const vec3d& r)
+	// see if the cell layout can still be used for the current configuration
+	bool IsValid(FESurface& s, double minBoxSize) const
 	{
-		if (box.isInside(r) == false) return nullptr;
+		if (m_nx == 0) return false;
 
-		int ix = (int)(m_nx * (r.x - box.r0.x) / box.width());
-		int iy = (int)(m_ny * (r.y - box.r0.y) / box.height());
-		int iz = (int)(m_nz * (r.z - box.r0.z) / box.depth());
-		if (ix == m_nx) ix--;
-		if (iy == m_ny) iy--;
-		if (iz == m_nz) iz--;
+		BOX b = NodeBox(s);
+		b.inflate(minBoxSize);
+		if ((box.isInside(b.r0) == false) || (box.isInside(b.r1) == false)) return false;
 
-		int icell = iz * (m_nx * m_ny) + iy * m_nx + ix;
-		Cell* c = m_cell + icell;
-		assert(c->m_box.isInside(r));
-		return m_cell + icell;
-	}
+		// the cells cannot be smaller than the search radius
+		if ((box.width () < m_nx * minBoxSize) && (m_nx > 1)) return false;
+		if ((box.height() < m_ny * minBoxSize) && (m_ny > 1)) return false;
+		if ((box.depth () < m_nz * minBoxSize) && (m_nz > 1)) return false;
 
-	int GetCellNeighborHood(const vec3d& r, Cell** cellList)
-	{
-		Cell* c = FindCell(r);
-		if (c == nullptr) return 0;
+		// rebuild when the surface shrunk considerably
+		if (b.MaxExtent() < 0.5 * box.MaxExtent()) return false;
 
-		int n = 0;
-		for (int i = 0; i < 27; ++i)
-		{
-			Cell* ci = c->m_nbr[i];
-			if ((ci != nullptr) && (ci->empty() == false)) cellList[n++] = ci;
-		}
-		return n;
+		return true;
 	}
 
-public:
-	Grid() { m_nx = m_ny = m_nz = 0; m_cell = nullptr; }
-
-	bool Build(FESurface& s, int boxDivs, double minBoxSize)
+	// build the cell layout
+	void Build(FESurface& s, int boxDivs, double minBoxSize)
 	{
 		// update the bounding box
-		for (int i = 0; i < s.Nodes(); ++i)
-		{
-			FENode& node = s.Node(i);
-			vec3d ri = node.m_rt;
-			if (i == 0) box.r0 = box.r1 = ri;
-			else box.add(ri);
-		}
+		box = NodeBox(s);
 
-		// inflate a little, just to be sure
+		// inflate a little, so the grid can be reused in the next updates
 		double R = box.MaxExtent();
-		box.inflate(minBoxSize);
+		box.inflate(minBoxSize + 0.05 * R);
 
 		// determine the sizes
 		double W = box.width();
@@ -307,89 +259,120 @@ public:
 		m_nx = (int)(W / boxSize); if (m_nx < 1) m_nx = 1;
 		m_ny = (int)(H / boxSize); if (m_ny < 1) m_ny = 1;
 		m_nz = (int)(D / boxSize); if (m_nz < 1) m_nz = 1;
+	}
 
-		// allocate the grid
+	// assign the elements to the grid cells
+	bool Fill(FESurface& s)
+	{
 		int ncells = m_nx * m_ny * m_nz;
-		m_cell = new Cell[ncells];
-
-		// helper lookup-table for cell neighbors
-		const int LUT[27][3] = {
-			{-1,-1,-1},{ 0,-1,-1},{1,-1,-1},
-			{-1, 0,-1},{ 0, 0,-1},{1, 0,-1},
-			{-1, 1,-1},{ 0, 1,-1},{1, 1,-1},
-			{-1,-1, 0},{ 0,-1, 0},{1,-1, 0},
-			{-1, 0, 0},{ 0, 0, 0},{1, 0, 0},
-			{-1, 1, 0},{ 0, 1, 0},{1, 1, 0},
-			{-1,-1, 1},{ 0,-1, 1},{1,-1, 1},
-			{-1, 0, 1},{ 0, 0, 1},{1, 0, 1},
-			{-1, 1, 1},{ 0, 1, 1},{1, 1, 1} };
-
-		// construct cells
-		Cell* c = m_cell;
-		double X0 = box.r0.x;
-		double Y0 = box.r0.y;
-		double Z0 = box.r0.z;
-		for (int k = 0; k < m_nz; ++k)
+
+		// count the elements in each cell
+		m_cellOffset.assign(ncells + 1, 0);
+		m_last.assign(ncells, -1);
+		for (int i = 0; i < s.Elements(); ++i)
 		{
-			double z0 = Z0 + k * D / m_nz;
-			double z1 = Z0 + (k+1) * D / m_nz;
-			for (int j = 0; j < m_ny; ++j)
+			FESurfaceElement& el = s.Element(i);
+			for (int n = 0; n < el.GaussPoints(); ++n)
 			{
-				double y0 = Y0 + j * H / m_ny;
-				double y1 = Y0 + (j + 1) * H / m_ny;
-				for (int i = 0; i < m_nx; ++i, ++c)
-				{
-					double x0 = X0 + i * W / m_nx;
-					double x1 = X0 + (i + 1) * W / m_nx;
-
-					c->m_box = BOX(vec3d(x0, y0, z0), vec3d(x1, y1, z1));
-					double R = c->m_box.MaxExtent();
-					c->m_box.inflate(R * 1e-4);
-
-					// assign neighbors
-					c->m_nbr.assign(27, nullptr);
-					for (int n = 0; n < 27; ++n)
-					{
-						const int* l = LUT[n];
-						c->m_nbr[n] = GetCell(i + l[0], j + l[1], k + l[2]);
-					}
-				}
+				int c = FindCell(el.GetMaterialPoint(n)->m_rt);
+				if (c < 0) return false;
+				if (m_last[c] != i) { m_last[c] = i; m_cellOffset[c + 1]++; }
 			}
 		}
+		for (int i = 0; i < ncells; ++i) m_cellOffset[i + 1] += m_cellOffset[i];
 
-		// assign elements to grid cells
+		// fill the cell lists
+		m_cellElem.resize(m_cellOffset[ncells]);
+		m_last.assign(ncells, -1);
+		vector<int> pos(m_cellOffset.begin(), m_cellOffset.end() - 1);
 		for (int i = 0; i < s.Elements(); ++i)
 		{
 			FESurfaceElement& el = s.Element(i);
-			int nint = el.GaussPoints();
-			for (int n = 0; n < nint; ++n)
+			for (int n = 0; n < el.GaussPoints(); ++n)
 			{
-				FECPContactPoint& mp = static_cast<FECPContactPoint&>(*el.GetMaterialPoint(n));
-				Cell* c = FindCell(mp.m_rt); assert(c);
-				if (c == nullptr) return false;
-				c->add(&el);
+				int c = FindCell(el.GetMaterialPoint(n)->m_rt);
+				if (m_last[c] != i) { m_last[c] = i; m_cellElem[pos[c]++] = i; }
 			}
 		}
 
 		return true;
 	}
 
-	Cell* GetCell(int i, int j, int k) const
+	// returns the index of the cell that contains r, or -1 if r is outside the grid
+	int FindCell(const vec3d& r) const
+	{
+		int ix, iy, iz;
+		if (CellIndex(r, ix, iy, iz) == false) return -1;
+		return iz * (m_nx * m_ny) + iy * m_nx + ix;
+	}
+
+	// find the non-empty cells in the neighborhood of r
+	int GetCellNeighborHood(const vec3d& r, int* cellList) const
+	{
+		int ix, iy, iz;
+		if (CellIndex(r, ix, iy, iz) == false) return 0;
+
+		int n = 0;
+		for (int k = iz - 1; k <= iz + 1; ++k)
+		{
+			if ((k < 0) || (k >= m_nz)) continue;
+			for (int j = iy - 1; j <= iy + 1; ++j)
+			{
+				if ((j < 0) || (j >= m_ny)) continue;
+				for (int i = ix - 1; i <= ix + 1; ++i)
+				{
+					if ((i < 0) || (i >= m_nx)) continue;
+					int c = k * (m_nx * m_ny) + j * m_nx + i;
+					if (m_cellOffset[c + 1] > m_cellOffset[c]) cellList[n++] = c;
+				}
+			}
+		}
+		return n;
+	}
+
+	// the element list of a cell
+	const int* CellElements(int c) const { return &m_cellElem[0] + m_cellOffset[c]; }
+	int CellSize(int c) const { return m_cellOffset[c + 1] - m_cellOffset[c]; }
+
+private:
+	bool CellIndex(const vec3d& r, int& ix, int& iy, int& iz) const
 	{
-		if ((i < 0) || (i >= m_nx)) return nullptr;
-		if ((j < 0) || (j >= m_ny)) return nullptr;
-		if ((k < 0) || (k >= m_nz)) return nullptr;
-		return m_cell + (k * (m_nx * m_ny) + j * m_nx + i);
+		if ((m_nx == 0) || (box.isInside(r) == false)) return false;
+
+		ix = (int)(m_nx * (r.x - box.r0.x) / box.width());
+		iy = (int)(m_ny * (r.y - box.r0.y) / box.height());
+		iz = (int)(m_nz * (r.z - box.r0.z) / box.depth());
+		if (ix == m_nx) ix--;
+		if (iy == m_ny) iy--;
+		if (iz == m_nz) iz--;
+		return true;
 	}
 
-	~Grid() { delete [] m_cell; }
+	static BOX NodeBox(FESurface& s)
+	{
+		BOX b;
+		for (int i = 0; i < s.Nodes(); ++i)
+		{
+			vec3d ri = s.Node(i).m_rt;
+			if (i == 0) b.r0 = b.r1 = ri;
+			else b.add(ri);
+		}
+		return b;
+	}
 
-protected:
+private:
 	BOX		box;
 	int		m_nx, m_ny, m_nz;
-	Cell*	m_cell;
+	vector<int>	m_cellOffset;	// offsets into m_cellElem (size = ncells + 1)
+	vector<int>	m_cellElem;		// element indices, sorted by cell
+	vector<int>	m_last;			// last element added to each cell
 };
 
+FEContactPotential::~FEContactPotential()
+{
+	delete m_grid;
+}
+
 // initialization
 bool FEContactPotential::Init()
 {
@@ -398,24 +381,55 @@ bool FEContactPotential::Init()
 	return true;
 }
 
+// Find the elements of surface 2 that share a node with the elements of surface 1. 
+// (This is only relevant for self-contact.)
 void FEContactPotential::BuildNeighborTable()
 {
-	m_elemNeighbors.resize(m_surf1.Elements());
-	for (int i = 0; i < m_surf1.Elements(); ++i)
-	{
-		FESurfaceElement& el1 = m_surf1.Element(i);
+	int N1 = m_surf1.Elements();
+	int N2 = m_surf2.Elements();
 
-		set<FESurfaceElement*>& nbrList = m_elemNeighbors[i];
-		nbrList.clear();
+	// build the node-element list of surface 2
+	int maxNode = -1;
+	for (int j = 0; j < N2; ++j)
+	{
+		FESurfaceElement& el2 = m_surf2.Element(j);
+		for (int b = 0; b < el2.Nodes(); ++b) maxNode = max(maxNode, el2.m_node[b]);
+	}
+	vector<int> nodeOffset(maxNode + 2, 0);
+	for (int j = 0; j < N2; ++j)
+	{
+		FESurfaceElement& el2 = m_surf2.Element(j);
+		for (int b = 0; b < el2.Nodes(); ++b) nodeOffset[el2.m_node[b] + 1]++;
+	}
+	for (int i = 0; i <= maxNode; ++i) nodeOffset[i + 1] += nodeOffset[i];
+	vector<int> nodeElem(nodeOffset[maxNode + 1]);
+	vector<int> pos(nodeOffset.begin(), nodeOffset.end() - 1);
+	for (int j = 0; j < N2; ++j)
+	{
+		FESurfaceElement& el2 = m_surf2.Element(j);
+		for (int b = 0; b < el2.Nodes(); ++b) nodeElem[pos[el2.m_node[b]]++] = j;
+	}
 
-		for (int j = 0; j < m_surf2.Elements(); ++j)
+	// collect the elements of surface 2 that are attached to the nodes of each element
+	vector<int> tag(N2, -1);
+	m_nbrOffset.assign(N1 + 1, 0);
+	m_nbrList.clear();
+	for (int i = 0; i < N1; ++i)
+	{
+		FESurfaceElement& el1 = m_surf1.Element(i);
+		int n0 = (int)m_nbrList.size();
+		for (int a = 0; a < el1.Nodes(); ++a)
 		{
-			FESurfaceElement& el2 = m_surf2.Element(j);
-			if (is_neighbor(el1, el2))
+			int na = el1.m_node[a];
+			if (na > maxNode) continue;
+			for (int k = nodeOffset[na]; k < nodeOffset[na + 1]; ++k)
 			{
-				nbrList.insert(&el2);
+				int j = nodeElem[k];
+				if (tag[j] != i) { tag[j] = i; m_nbrList.push_back(j); }
 			}
 		}
+		sort(m_nbrList.begin() + n0, m_nbrList.end());
+		m_nbrOffset[i + 1] = (int)m_nbrList.size();
 	}
 }
 
@@ -435,51 +449,68 @@ void FEContactPotential::Update()
 		UpdateSurface(m_surf2);
 	}
 
-	// build the grid
-	int ndivs = (int)pow(m_surf2.Elements(), 0.33333);
-	if (ndivs < 2) ndivs = 2;
-	Grid g;
-	if (g.Build(m_surf2, ndivs, m_Rout) == false)
+	// update the grid
+	if (m_grid == nullptr) m_grid = new Grid;
+	Grid& g = *m_grid;
+	if (g.IsValid(m_surf2, m_Rout) == false)
+	{
+		int ndivs = (int)pow(m_surf2.Elements(), 0.33333);
+		if (ndivs < 2) ndivs = 2;
+		g.Build(m_surf2, ndivs, m_Rout);
+	}
+	if (g.Fill(m_surf2) == false)
 	{
 		throw std::runtime_error("Failed to build grid in FEContactPotential::Update");
 	}
 
 	// build the list of active elements
-	m_activeElements.resize(m_surf1.Elements());
-#pragma omp parallel for shared(g) schedule(dynamic)
-	for (int i = 0; i < m_surf1.Elements(); ++i)
+	int N1 = m_surf1.Elements();
+	int N2 = m_surf2.Elements();
+	m_activeOffset.assign(N1 + 1, 0);
+#pragma omp parallel shared(g)
 	{
-		FESurfaceElement& el1 = m_surf1.Element(i);
+		// elements to exclude are tagged with the index of the current element. 
+		// These are neighbors and elements already processed
+		vector<int> tag(N2, -1);
 
-		set<FESurfaceElement*>& activeElems = m_activeElements[i];
-		activeElems.clear();
+		// the elements processed by this thread and their active lists
+		vector<int> elemList;
+		vector<int> activeList;
 
-		// list of elements to exclude. This will be neighbors and elements
-		// already processed
-		set<FESurfaceElement*> excludeList = m_elemNeighbors[i];
+		int c[27];
 
-		for (int n = 0; n < el1.GaussPoints(); ++n)
+#pragma omp for schedule(dynamic)
+		for (int i = 0; i < N1; ++i)
 		{
-			FECPContactPoint& mp1 = static_cast<FECPContactPoint&>(*el1.GetMaterialPoint(n));
-			mp1.m_gap = 0.0;
-			vec3d r1 = mp1.m_rt;
-			vec3d R1 = mp1.m_r0;
-			vec3d n1 = mp1.dxr ^ mp1.dxs; n1.unit();
-
-			// find the grid cell this point is in and loop over the cell's neighborhood
-			Grid::Cell* c[27] = { nullptr };
-			int nc = g.GetCellNeighborHood(r1, &c[0]);
-			for (int l = 0; l < nc; ++l)
+			FESurfaceElement& el1 = m_surf1.Element(i);
+			int n0 = (int)activeList.size();
+
+			for (int k = m_nbrOffset[i]; k < m_nbrOffset[i + 1]; ++k) tag[m_nbrList[k]] = i;
+
+			for (int n = 0; n < el1.GaussPoints(); ++n)
 			{
-				Grid::Cell* cl = c[l];
-				for (FESurfaceElement* el2 : cl->m_elemList)
+				FECPContactPoint& mp1 = static_cast<FECPContactPoint&>(*el1.GetMaterialPoint(n));
+				mp1.m_gap = 0.0;
+				vec3d r1 = mp1.m_rt;
+				vec3d R1 = mp1.m_r0;
+				vec3d n1 = mp1.dxr ^ mp1.dxs; n1.unit();
+
+				// find the grid cell this point is in and loop over the cell's neighborhood
+				int nc = g.GetCellNeighborHood(r1, c);
+				for (int l = 0; l < nc; ++l)
 				{
-					// make sure we did not process this element yet
-					// and the element is not a neighbor (which can be the case for self-contact)
-					if (excludeList.find(el2) == excludeList.end())
+					const int* elems = g.CellElements(c[l]);
+					int ne = g.CellSize(c[l]);
+					for (int k = 0; k < ne; ++k)
 					{
+						// make sure we did not process this element yet
+						// and the element is not a neighbor (which can be the case for self-contact)
+						int j = elems[k];
+						if (tag[j] == i) continue;
+
 						// Next, we see if any integration point of el2 is close to the current 
 						// integration point of el1. 
+						FESurfaceElement* el2 = &m_surf2.Element(j);
 						vec3d r12;
 						for (int m = 0; m < el2->GaussPoints(); ++m)
 						{
@@ -490,7 +521,6 @@ void FEContactPotential::Update()
 							r12.x = r1.x - r2.x;
 							r12.y = r1.y - r2.y;
 							r12.z = r1.z - r2.z;
-//							vec3d r12 = r1 - mp2.m_rt;
 							if ((r12.x < m_Rout) && (r12.x > -m_Rout) &&
 								(r12.y < m_Rout) && (r12.y > -m_Rout) &&
 								(r12.z < m_Rout) && (r12.z > -m_Rout) &&
@@ -501,14 +531,9 @@ void FEContactPotential::Update()
 								if ((fabs(r12 * n1) >= m_wtol) && (L12 >= m_Rmin))
 								{
 									// we found one, so insert it to the list of active elements
-									activeElems.insert(el2);
-
-									// also insert it to the exclude list
-									excludeList.insert(el2);
-
-//									fprintf(stderr, "r12: %lg, %lg, %lg\n", r12.x, r12.y, r12.z);
-//									fprintf(stderr, "n1 : %lg, %lg, %lg\n", n1.x, n1.y, n1.z);
-//									fprintf(stderr, "l12 = %lg\n", l12);
+									// and to the exclude list
+									activeList.push_back(j);
+									tag[j] = i;
 
 									if ((mp1.m_gap == 0.0) || (l12 < mp1.m_gap))
 									{
@@ -518,10 +543,29 @@ void FEContactPotential::Update()
 								}
 							}
 						}
-
 					}
 				}
 			}
+
+			sort(activeList.begin() + n0, activeList.end());
+			elemList.push_back(i);
+			m_activeOffset[i + 1] = (int)activeList.size() - n0;
+		}
+
+		// convert counts to offsets
+#pragma omp single
+		{
+			for (int i = 0; i < N1; ++i) m_activeOffset[i + 1] += m_activeOffset[i];
+			m_activeList.resize(m_activeOffset[N1]);
+		}
+
+		// copy this thread's lists
+		int m = 0;
+		for (int i : elemList)
+		{
+			int n = m_activeOffset[i + 1] - m_activeOffset[i];
+			for (int k = 0; k < n; ++k) m_activeList[m_activeOffset[i] + k] = activeList[m + k];
+			m += n;
 		}
 	}
 }
@@ -529,6 +573,9 @@ void FEContactPotential::Update()
 // Build the matrix profile
 void FEContactPotential::BuildMatrixProfile(FEGlobalMatrix& M)
 {
+	// the active element lists are built in Update
+	if ((int)m_activeOffset.size() != m_surf1.Elements() + 1) return;
+
 	// connect every element of surface 1 to surface 2
 	for (int i = 0; i < m_surf1.Elements(); ++i)
 	{
@@ -545,9 +592,9 @@ void FEContactPotential::BuildMatrixProfile(FEGlobalMatrix& M)
 		}
 
 		// add all active dofs of surface 2
-		set<FESurfaceElement*>& activeElems = m_activeElements[i];
-		for (FESurfaceElement* el2 : activeElems)
+		for (int k = m_activeOffset[i]; k < m_activeOffset[i + 1]; ++k)
 		{
+			FESurfaceElement* el2 = &m_surf2.Element(m_activeList[k]);
 			for (int j = 0; j < el2->Nodes(); ++j)
 			{
 				FENode& node = m_surf2.Node(el2->m_lnode[j]);
@@ -632,9 +679,9 @@ void FEContactPotential::LoadVector(FEGlobalVector& R, const FETimeInfo& tp)
 		vector<int> lm;
 
 		// loop over all elements of surf 2
-		set<FESurfaceElement*>& activeElems = m_activeElements[i];
-		for (FESurfaceElement* elj : activeElems)
+		for (int k = m_activeOffset[i]; k < m_activeOffset[i + 1]; ++k)
 		{
+			FESurfaceElement* elj = &m_surf2.Element(m_activeList[k]);
 			int nb = elj->Nodes();
 
 			// evaluate contribution to force vector
@@ -759,9 +806,9 @@ void FEContactPotential::StiffnessMatrix(FELinearSystem& LS, const FETimeInfo& t
 		FESurfaceElement& eli = m_surf1.Element(i);
 		int na = eli.Nodes();
 
-		set<FESurfaceElement*>& activeElems = m_activeElements[i];
-		for (FESurfaceElement* elj : activeElems)
+		for (int k = m_activeOffset[i]; k < m_activeOffset[i + 1]; ++k)
 		{
+			FESurfaceElement* elj = &m_surf2.Element(m_activeList[k]);
 			int nb = elj->Nodes();
 
 			FEElementMatrix ke((na + nb) * ndof, (na + nb) * ndof);
@@ -886,5 +933,9 @@ void FEContactPotential::Serialize(DumpStream& ar)
 	m_surf1.Serialize(ar);
 	m_surf2.Serialize(ar);
 
+	// the grid is rebuilt on the next update
+	delete m_grid;
+	m_grid = nullptr;
+
 	BuildNeighborTable();
 }
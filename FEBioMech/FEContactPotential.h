@@ -26,7 +26,7 @@ SOFTWARE.*/
 #pragma once
 #include "FEContactInterface.h"
 #include "FEContactSurface.h"
-#include <set>
+#include <vector>
 
 class FEContactPotentialSurface : public FEContactSurface
 {
@@ -59,6 +59,7 @@ class FEContactPotential : public FEContactInterface
 {
 public:
 	FEContactPotential(FEModel* fem);
+	~FEContactPotential();
 
 	// -- From FESurfacePairConstraint
 public:
@@ -114,8 +115,16 @@ protected:
 
 	double	m_c1, m_c2;
 
-	std::vector< std::set<FESurfaceElement*> >	m_activeElements;
-	std::vector< std::set<FESurfaceElement*> >	m_elemNeighbors;
+	// active elements of surface 2 for each element of surface 1 (CSR format)
+	std::vector<int>	m_activeOffset;
+	std::vector<int>	m_activeList;
+
+	// elements of surface 2 that share a node with an element of surface 1 (CSR format)
+	std::vector<int>	m_nbrOffset;
+	std::vector<int>	m_nbrList;
+
+	class Grid;
+	Grid*	m_grid;
 
 	DECLARE_FECORE_CLASS();
 };
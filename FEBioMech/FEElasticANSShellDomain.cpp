@@ -209,12 +209,12 @@ void FEElasticANSShellDomain::ElementInternalForce(FEShellElementNew& el, vector
     // ANS method: Evaluate collocation strains
     CollocationStrainsANS(el, EE, HU, HW, NS, NN);
     
-    vector<matrix> hu(neln, matrix(3,6));
-    vector<matrix> hw(neln, matrix(3,6));
+    vector< small_matrix<3,6> > hu(neln);
+    vector< small_matrix<3,6> > hw(neln);
     vector<vec3d> Nu(neln);
     vector<vec3d> Nw(neln);
     
-    matrix Fu(3,1), Fw(3,1);
+    small_matrix<3,1> Fu, Fw;
     
     // repeat for all integration points
     for (n=0; n<nint; ++n)
@@ -227,7 +227,7 @@ void FEElasticANSShellDomain::ElementInternalForce(FEShellElementNew& el, vector
         EvaluateANS(el, n, Gcnt, el.m_E[n], hu, hw, EE, HU, HW);
         
         // evaluate 2nd P-K stress
-        matrix SC(6,1);
+        small_matrix<6,1> SC;
         mat3ds S = m_pMat->PK2Stress(mp, el.m_E[n]);
         mat3dsCntMat61(S, Gcnt, SC);
         
@@ -578,14 +578,13 @@ void FEElasticANSShellDomain::ElementStiffness(int iel, matrix& ke)
     if (ANS) CollocationStrainsANS(el, EE, HU, HW, NS, NN);
     
     // calculate element stiffness matrix
-    vector<matrix> hu(neln, matrix(3,6));
-    vector<matrix> hw(neln, matrix(3,6));
+    vector< small_matrix<3,6> > hu(neln);
+    vector< small_matrix<3,6> > hw(neln);
     vector<vec3d> Nu(neln);
     vector<vec3d> Nw(neln);
     
     ke.zero();
     
-    matrix KUU(3,3), KUW(3,3), KWU(3,3), KWW(3,3);
     for (n=0; n<nint; ++n)
     {
         FEMaterialPoint& mp = *(el.GetMaterialPoint(n));
@@ -599,12 +598,12 @@ void FEElasticANSShellDomain::ElementStiffness(int iel, matrix& ke)
         detJt = detJ0(el, n)*gw[n];
         
         // evaluate 2nd P-K stress
-        matrix SC(6,1);
+        small_matrix<6,1> SC;
         mat3ds S = m_pMat->PK2Stress(mp, el.m_E[n]);
         mat3dsCntMat61(S, Gcnt, SC);
         
         // evaluate the material tangent
-        matrix CC(6,6);
+        small_matrix<6,6> CC;
         tens4dmm c = m_pMat->MaterialTangent(mp, el.m_E[n]);
         tens4dmmCntMat66(c, Gcnt, CC);
 //        tens4dsCntMat66(c, Gcnt, CC);
@@ -613,13 +612,15 @@ void FEElasticANSShellDomain::ElementStiffness(int iel, matrix& ke)
         
         for (i=0, i6=0; i<neln; ++i, i6 += 6)
         {
+            small_matrix<3,6> huC = hu[i]*CC;
+            small_matrix<3,6> hwC = hw[i]*CC;
             for (j=0, j6 = 0; j<neln; ++j, j6 += 6)
             {
-                matrix KUU(3,3), KUW(3,3), KWU(3,3), KWW(3,3);
-                KUU = hu[i]*CC*hu[j].transpose();
-                KUW = hu[i]*CC*hw[j].transpose();
-                KWU = hw[i]*CC*hu[j].transpose();
-                KWW = hw[i]*CC*hw[j].transpose();
+                small_matrix<3,3> KUU, KUW, KWU, KWW;
+                FESmallLA::mult_abt(huC, hu[j], KUU);
+                FESmallLA::mult_abt(huC, hw[j], KUW);
+                FESmallLA::mult_abt(hwC, hu[j], KWU);
+                FESmallLA::mult_abt(hwC, hw[j], KWW);
                 KUU *= detJt; KUW *= detJt; KWU *= detJt; KWW *= detJt;
                 
                 ke[i6  ][j6  ] += KUU(0,0); ke[i6  ][j6+1] += KUU(0,1); ke[i6  ][j6+2] += KUU(0,2);
@@ -1019,7 +1020,7 @@ void FEElasticANSShellDomain::UnpackLM(FEElement& el, vector<int>& lm)
     for (int i=0; i<N; ++i)
     {
         FENode& node = m_pMesh->Node(el.m_node[i]);
-        vector<int>& id = node.m_ID;
+        FENodeDofArray<int>& id = node.m_ID;
         
         // first the displacement dofs
         lm[6*i  ] = id[m_dofU[0]];
@@ -1040,9 +1041,8 @@ void FEElasticANSShellDomain::UnpackLM(FEElement& el, vector<int>& lm)
 
 //-----------------------------------------------------------------------------
 //! Evaluate contravariant components of mat3ds tensor
-void FEElasticANSShellDomain::mat3dsCntMat61(const mat3ds s, const vec3d* Gcnt, matrix& S)
+void FEElasticANSShellDomain::mat3dsCntMat61(const mat3ds s, const vec3d* Gcnt, small_matrix<6,1>& S)
 {
-    S.resize(6, 1);
     S(0,0) = Gcnt[0]*(s*Gcnt[0]);
     S(1,0) = Gcnt[1]*(s*Gcnt[1]);
     S(2,0) = Gcnt[2]*(s*Gcnt[2]);
@@ -1055,9 +1055,8 @@ void FEElasticANSShellDomain::mat3dsCntMat61(const mat3ds s, const vec3d* Gcnt,
 //-----------------------------------------------------------------------------
 //! Evaluate contravariant components of tens4ds tensor
 //! Cijkl = Gj.(Gi.c.Gl).Gk
-void FEElasticANSShellDomain::tens4dsCntMat66(const tens4ds c, const vec3d* Gcnt, matrix& C)
+void FEElasticANSShellDomain::tens4dsCntMat66(const tens4ds c, const vec3d* Gcnt, small_matrix<6,6>& C)
 {
-    C.resize(6, 6);
     C(0,0) =          Gcnt[0]*(vdotTdotv(Gcnt[0], c, Gcnt[0])*Gcnt[0]);  // i=0, j=0, k=0, l=0
     C(0,1) = C(1,0) = Gcnt[0]*(vdotTdotv(Gcnt[0], c, Gcnt[1])*Gcnt[1]);  // i=0, j=0, k=1, l=1
     C(0,2) = C(2,0) = Gcnt[0]*(vdotTdotv(Gcnt[0], c, Gcnt[2])*Gcnt[2]);  // i=0, j=0, k=2, l=2
@@ -1085,9 +1084,8 @@ void FEElasticANSShellDomain::tens4dsCntMat66(const tens4ds c, const vec3d* Gcnt
 //-----------------------------------------------------------------------------
 //! Evaluate contravariant components of tens4dm tensor
 //! Cijkl = Gj.(Gi.c.Gl).Gk
-void FEElasticANSShellDomain::tens4dmmCntMat66(const tens4dmm c, const vec3d* Gcnt, matrix& C)
+void FEElasticANSShellDomain::tens4dmmCntMat66(const tens4dmm c, const vec3d* Gcnt, small_matrix<6,6>& C)
 {
-    C.resize(6, 6);
     C(0,0) =          Gcnt[0]*(vdotTdotv(Gcnt[0], c, Gcnt[0])*Gcnt[0]);  // i=0, j=0, k=0, l=0
     C(0,1) = C(1,0) = Gcnt[0]*(vdotTdotv(Gcnt[0], c, Gcnt[1])*Gcnt[1]);  // i=0, j=0, k=1, l=1
     C(0,2) = C(2,0) = Gcnt[0]*(vdotTdotv(Gcnt[0], c, Gcnt[2])*Gcnt[2]);  // i=0, j=0, k=2, l=2
@@ -1280,7 +1278,7 @@ void FEElasticANSShellDomain::CollocationStrainsANS(FEShellElementNew& el, vecto
 //-----------------------------------------------------------------------------
 //! Evaluate assumed natural strain (ANS)
 void FEElasticANSShellDomain::EvaluateANS(FEShellElementNew& el, const int n, const vec3d* Gcnt,
-                                          mat3ds& Ec, vector<matrix>& hu, vector<matrix>& hw,
+                                          mat3ds& Ec, vector< small_matrix<3,6> >& hu, vector< small_matrix<3,6> >& hw,
                                           vector<double>& E, vector< vector<vec3d>>& HU, vector< vector<vec3d>>& HW)
 {
     // ANS method for 4-node quadrilaterials
@@ -1344,7 +1342,7 @@ void FEElasticANSShellDomain::EvaluateANS(FEShellElementNew& el, const int n, co
 //-----------------------------------------------------------------------------
 //! Evaluate strain E and matrix hu and hw
 void FEElasticANSShellDomain::EvaluateEh(FEShellElementNew& el, const int n, const vec3d* Gcnt, mat3ds& E,
-                                         vector<matrix>& hu, vector<matrix>& hw, vector<vec3d>& Nu, vector<vec3d>& Nw)
+                                         vector< small_matrix<3,6> >& hu, vector< small_matrix<3,6> >& hw, vector<vec3d>& Nu, vector<vec3d>& Nw)
 {
     FETimeInfo& tp = GetFEModel()->GetTime();
     
@@ -0,0 +1,73 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+#include "stdafx.h"
+#include "FEElasticBatch.h"
+#include "FEElasticMaterialPoint.h"
+
+//-----------------------------------------------------------------------------
+void FEElasticBatch::Add(FEMaterialPoint& mp)
+{
+	assert(m_n < MAX_POINTS);
+	FEElasticMaterialPoint& pt = *mp.ExtractData<FEElasticMaterialPoint>();
+	const int i = m_n++;
+	m_mp[i] = &mp;
+	const mat3d& F = pt.m_F;
+	m_F[0][i] = F[0][0]; m_F[1][i] = F[0][1]; m_F[2][i] = F[0][2];
+	m_F[3][i] = F[1][0]; m_F[4][i] = F[1][1]; m_F[5][i] = F[1][2];
+	m_F[6][i] = F[2][0]; m_F[7][i] = F[2][1]; m_F[8][i] = F[2][2];
+	m_J[i] = pt.m_J;
+}
+
+//-----------------------------------------------------------------------------
+mat3ds FEElasticBatch::Stress(int i) const
+{
+	// mat3ds constructor takes (xx, yy, zz, xy, yz, xz)
+	return mat3ds(m_s[0][i], m_s[2][i], m_s[5][i], m_s[1][i], m_s[4][i], m_s[3][i]);
+}
+
+//-----------------------------------------------------------------------------
+void FEElasticBatch::SetStress(int i, const mat3ds& s)
+{
+	m_s[0][i] = s.xx(); m_s[1][i] = s.xy(); m_s[2][i] = s.yy();
+	m_s[3][i] = s.xz(); m_s[4][i] = s.yz(); m_s[5][i] = s.zz();
+}
+
+//-----------------------------------------------------------------------------
+tens4ds FEElasticBatch::Tangent(int i) const
+{
+	tens4ds c;
+	for (int k = 0; k < tens4ds::NNZ; ++k) c.d[k] = m_c[k][i];
+	return c;
+}
+
+//-----------------------------------------------------------------------------
+void FEElasticBatch::SetTangent(int i, const tens4ds& c)
+{
+	for (int k = 0; k < tens4ds::NNZ; ++k) m_c[k][i] = c.d[k];
+}
@@ -0,0 +1,181 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+#pragma once
+#include <FECore/FEElement.h>
+#include <FECore/tens4d.h>
+#include "febiomech_api.h"
+
+class FEMaterialPoint;
+
+//-----------------------------------------------------------------------------
+//! Structure-of-arrays data for evaluating an elastic material at a batch of
+//! material points (typically all the integration points of one element).
+
+//! The kinematics (F, J) and the results (Cauchy stress, spatial tangent) are
+//! stored component-wise, i.e. each component array is indexed by the point number.
+//! Materials that support batch evaluation can then process all points of the batch
+//! in a single vectorized loop instead of one virtual call per point.
+//! Symmetric second-order tensors use the mat3ds storage order (xx, xy, yy, xz, yz, zz)
+//! and the tangent uses the tens4ds storage order.
+class FEBIOMECH_API FEElasticBatch
+{
+public:
+	enum { MAX_POINTS = FEElement::MAX_INTPOINTS };
+
+public:
+	FEElasticBatch() : m_n(0) {}
+
+	//! clear the batch
+	void Clear() { m_n = 0; }
+
+	//! add a material point to the batch (copies F and J)
+	void Add(FEMaterialPoint& mp);
+
+	//! number of points in the batch
+	int Points() const { return m_n; }
+
+	//! return a material point of the batch
+	FEMaterialPoint& MaterialPoint(int i) { return *m_mp[i]; }
+
+	//! get/set the stress of point i
+	mat3ds Stress(int i) const;
+	void SetStress(int i, const mat3ds& s);
+
+	//! get/set the tangent of point i
+	tens4ds Tangent(int i) const;
+	void SetTangent(int i, const tens4ds& c);
+
+public:
+	int					m_n;					//!< number of points in batch
+	FEMaterialPoint*	m_mp[MAX_POINTS];		//!< material points
+	double				m_F[9][MAX_POINTS];		//!< deformation gradient (row-major)
+	double				m_J[MAX_POINTS];		//!< determinant of F
+	double				m_s[6][MAX_POINTS];		//!< Cauchy stress
+	double				m_c[21][MAX_POINTS];	//!< spatial tangent
+};
+
+//-----------------------------------------------------------------------------
+// Small tensor kernels that operate on the components of a single batch point.
+// These are meant to be inlined inside the vectorized loops of the batch routines.
+namespace FEBatchTensor {
+
+	// mat3ds index of the tens4ds (Voigt) index, i.e. (xx, yy, zz, xy, yz, xz)
+	const int VOIGT[6] = { 0, 2, 5, 1, 4, 3 };
+
+	// mat3ds index of the tensor component (i,j)
+	const int SYM[3][3] = { { 0, 1, 3 }, { 1, 2, 4 }, { 3, 4, 5 } };
+
+	// Voigt index to tensor indices
+	const int VI[6] = { 0, 1, 2, 0, 1, 0 };
+	const int VJ[6] = { 0, 1, 2, 1, 2, 2 };
+
+	// load F of point i
+	inline void LoadF(const double F[9][FEElasticBatch::MAX_POINTS], int i, double f[9])
+	{
+		for (int k = 0; k < 9; ++k) f[k] = F[k][i];
+	}
+
+	// left Cauchy-Green tensor b = F*Ft
+	inline void LeftCauchyGreen(const double F[9], double b[6])
+	{
+		b[0] = F[0]*F[0] + F[1]*F[1] + F[2]*F[2];
+		b[1] = F[0]*F[3] + F[1]*F[4] + F[2]*F[5];
+		b[2] = F[3]*F[3] + F[4]*F[4] + F[5]*F[5];
+		b[3] = F[0]*F[6] + F[1]*F[7] + F[2]*F[8];
+		b[4] = F[3]*F[6] + F[4]*F[7] + F[5]*F[8];
+		b[5] = F[6]*F[6] + F[7]*F[7] + F[8]*F[8];
+	}
+
+	// trace
+	inline double Trace(const double a[6]) { return a[0] + a[2] + a[5]; }
+
+	// determinant
+	inline double Det(const double a[6])
+	{
+		return a[0]*(a[2]*a[5] - a[4]*a[4]) - a[1]*(a[1]*a[5] - a[4]*a[3]) + a[3]*(a[1]*a[4] - a[2]*a[3]);
+	}
+
+	// a2 = a*a
+	inline void Sqr(const double a[6], double a2[6])
+	{
+		a2[0] = a[0]*a[0] + a[1]*a[1] + a[3]*a[3];
+		a2[1] = a[0]*a[1] + a[1]*a[2] + a[3]*a[4];
+		a2[2] = a[1]*a[1] + a[2]*a[2] + a[4]*a[4];
+		a2[3] = a[0]*a[3] + a[1]*a[4] + a[3]*a[5];
+		a2[4] = a[1]*a[3] + a[2]*a[4] + a[4]*a[5];
+		a2[5] = a[3]*a[3] + a[4]*a[4] + a[5]*a[5];
+	}
+
+	// deviatoric part
+	inline void Dev(double a[6])
+	{
+		double p = Trace(a) / 3.0;
+		a[0] -= p; a[2] -= p; a[5] -= p;
+	}
+
+	// c += s*(a dyad1s a), i.e. c_ijkl += s*a_ij*a_kl
+	inline void Dyad1s(double c[21], const double a[6], double s)
+	{
+		for (int q = 0, k = 0; q < 6; ++q)
+			for (int p = 0; p <= q; ++p, ++k)
+				c[k] += s*a[VOIGT[p]]*a[VOIGT[q]];
+	}
+
+	// c += s*(a dyad1s b), i.e. c_ijkl += s*(a_ij*b_kl + b_ij*a_kl)
+	inline void Dyad1s(double c[21], const double a[6], const double b[6], double s)
+	{
+		for (int q = 0, k = 0; q < 6; ++q)
+			for (int p = 0; p <= q; ++p, ++k)
+				c[k] += s*(a[VOIGT[p]]*b[VOIGT[q]] + b[VOIGT[p]]*a[VOIGT[q]]);
+	}
+
+	// c += s*(a dyad4s a), i.e. c_ijkl += s*(a_ik*a_jl + a_il*a_jk)/2
+	inline void Dyad4s(double c[21], const double a[6], double s)
+	{
+		for (int q = 0, k = 0; q < 6; ++q)
+			for (int p = 0; p <= q; ++p, ++k)
+			{
+				const int i = VI[p], j = VJ[p], l = VJ[q], m = VI[q];
+				c[k] += 0.5*s*(a[SYM[i][m]]*a[SYM[j][l]] + a[SYM[i][l]]*a[SYM[j][m]]);
+			}
+	}
+
+	// c += s*(I dyad1s I)
+	inline void IdentityDyad1s(double c[21], double s)
+	{
+		c[0] += s; c[1] += s; c[2] += s; c[3] += s; c[4] += s; c[5] += s;
+	}
+
+	// c += s*(I dyad4s I)
+	inline void IdentityDyad4s(double c[21], double s)
+	{
+		c[0] += s; c[2] += s; c[5] += s;
+		c[9] += 0.5*s; c[14] += 0.5*s; c[20] += 0.5*s;
+	}
+}
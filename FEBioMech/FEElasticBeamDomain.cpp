@@ -338,7 +338,7 @@ void FEElasticBeamDomain::IncrementalUpdate(std::vector<double>& ui, bool finalF
 		for (int j = 0; j < ne; ++j)
 		{
 			FENode& node = Node(el.m_lnode[j]);
-			std::vector<int>& id = node.m_ID;
+			FENodeDofArray<int>& id = node.m_ID;
 			int eq[3] = { id[m_dofs[3]], id[m_dofs[4]], id[m_dofs[5]] };
 			vec3d d(0, 0, 0);
 			if (eq[0] >= 0) d.x = ui[eq[0]];
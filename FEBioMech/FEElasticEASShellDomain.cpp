@@ -79,6 +79,7 @@ void FEElasticEASShellDomain::Serialize(DumpStream& ar)
 {
     //erialize the base class, which instantiates the elements
     FESSIShellDomain::Serialize(ar);
+    m_cond.Serialize(ar);
     if (ar.IsShallow()) return;
     
     // serialize class variables
@@ -110,17 +111,16 @@ bool FEElasticEASShellDomain::Init()
 	for (int i=0; i<Elements(); ++i)
     {
         FEShellElementNew& el = ShellElement(i);
-        int neln = el.Nodes();
         int nint = el.GaussPoints();
-        el.m_Kaai.resize(m_nEAS, m_nEAS);
-        el.m_fa.resize(m_nEAS, 1);
         el.m_alpha.resize(m_nEAS, 1); el.m_alpha.zero();
         el.m_alphat.resize(m_nEAS, 1); el.m_alphat.zero();
         el.m_alphai.resize(m_nEAS, 1); el.m_alphai.zero();
-        el.m_Kua.resize(neln,matrix(3, m_nEAS));
-        el.m_Kwa.resize(neln,matrix(3, m_nEAS));
         el.m_E.resize(nint, mat3ds(0, 0, 0, 0, 0, 0));
     }
+
+    // the EAS parameters are condensed out of the element matrices
+    // (all elements of a domain have the same number of nodes)
+    if (Elements() > 0) m_cond.Create(Elements(), 6*ShellElement(0).Nodes(), m_nEAS);
     
     return true;
 }
@@ -178,29 +178,49 @@ void FEElasticEASShellDomain::PreSolveUpdate(const FETimeInfo& timeInfo)
 // Calculates the forces due to the stress
 void FEElasticEASShellDomain::InternalForces(FEGlobalVector& R)
 {
+    // The elements are processed in batches so that the EAS blocks
+    // of all elements in a batch can be condensed together.
+    const int W = FEStaticCondensation::LANES;
     int NS = (int)m_Elem.size();
-#pragma omp parallel for shared (NS)
-    for (int i=0; i<NS; ++i)
+    int NB = (NS + W - 1) / W;
+#pragma omp parallel shared (NS, NB)
     {
+        FEStaticCondensation::Batch batch(m_cond);
+        EASElementData data[W];
+        
         // element force vector
         vector<double> fe;
         vector<int> lm;
         
-        // get the element
-		FEShellElementNew& el = m_Elem[i];
-        
-        // create the element force vector and initialize to zero
-        int ndof = 6*el.Nodes();
-        fe.assign(ndof, 0);
-        
-        // calculate element's internal force
-        ElementInternalForce(el, fe);
-        
-        // get the element's LM vector
-        UnpackLM(el, lm);
-        
-        // assemble the residual
-        R.Assemble(el.m_node, lm, fe, true);
+#pragma omp for
+        for (int ib=0; ib<NB; ++ib)
+        {
+            int i0 = ib*W;
+            int i1 = (i0 + W < NS ? i0 + W : NS);
+            
+            // evaluate and condense the EAS blocks of this batch
+            for (int i=i0; i<i1; ++i) EvaluateElementEAS(m_Elem[i], data[i-i0], batch);
+            batch.Factor();
+            
+            for (int i=i0; i<i1; ++i)
+            {
+                // get the element
+                FEShellElementNew& el = m_Elem[i];
+                
+                // create the element force vector and initialize to zero
+                int ndof = 6*el.Nodes();
+                fe.assign(ndof, 0);
+                
+                // calculate element's internal force
+                ElementInternalForce(el, data[i-i0], fe);
+                
+                // get the element's LM vector
+                UnpackLM(el, lm);
+                
+                // assemble the residual
+                R.Assemble(el.m_node, lm, fe, true);
+            }
+        }
     }
 }
 
@@ -210,6 +230,36 @@ void FEElasticEASShellDomain::InternalForces(FEGlobalVector& R)
 //! integration. This will integrate linear functions exactly.
 
 void FEElasticEASShellDomain::ElementInternalForce(FEShellElementNew& el, vector<double>& fe)
+{
+    EASElementData d;
+    FEStaticCondensation::Batch batch(m_cond);
+    EvaluateElementEAS(el, d, batch);
+    batch.Factor();
+    ElementInternalForce(el, d, fe);
+}
+
+//-----------------------------------------------------------------------------
+void FEElasticEASShellDomain::EvaluateElementEAS(FEShellElementNew& el, EASElementData& d, FEStaticCondensation::Batch& batch)
+{
+    int nint = el.GaussPoints();
+    int neln = el.Nodes();
+    
+    // allocate arrays
+    d.S.resize(nint);
+    d.C.resize(nint);
+    d.NS.resize(neln,16);
+    d.NN.resize(neln,8);
+    
+    // ANS method: Evaluate collocation strains
+    CollocationStrainsANS(el, d.EE, d.HU, d.HW, d.NS, d.NN);
+    
+    // EAS method: Evaluate Kua, Kwa, and Kaa
+    // Also evaluate PK2 stress and material tangent using enhanced strain
+    EvaluateEAS(el, d.EE, d.HU, d.HW, d.S, d.C, batch);
+}
+
+//-----------------------------------------------------------------------------
+void FEElasticEASShellDomain::ElementInternalForce(FEShellElementNew& el, EASElementData& d, vector<double>& fe)
 {
     int i, n;
     
@@ -223,47 +273,20 @@ void FEElasticEASShellDomain::ElementInternalForce(FEShellElementNew& el, vector
     
     vec3d Gcnt[3];
     
-    // allocate arrays
-    vector<mat3ds> S(nint);
-    vector<tens4dmm> C(nint);
-    vector<double> EE;
-    vector< vector<vec3d>> HU;
-    vector< vector<vec3d>> HW;
-    matrix NS(neln,16);
-    matrix NN(neln,8);
+    vector<mat3ds>& S = d.S;
+    vector<double>& EE = d.EE;
+    vector< vector<vec3d>>& HU = d.HU;
+    vector< vector<vec3d>>& HW = d.HW;
     
-    // ANS method: Evaluate collocation strains
-    CollocationStrainsANS(el, EE, HU, HW, NS, NN);
-    
-    // EAS method: Evaluate Kua, Kwa, and Kaa
-    // Also evaluate PK2 stress and material tangent using enhanced strain
-    EvaluateEAS(el, EE, HU, HW, S, C);
-    matrix Kif(7,1);
-    Kif = el.m_Kaai*el.m_fa;
-    
-    vector<matrix> hu(neln, matrix(3,6));
-    vector<matrix> hw(neln, matrix(3,6));
+    vector< small_matrix<3,6> > hu(neln);
+    vector< small_matrix<3,6> > hw(neln);
     vector<vec3d> Nu(neln);
     vector<vec3d> Nw(neln);
     
     // EAS contribution
-    matrix Fu(3,1), Fw(3,1);
-    for (i=0; i<neln; ++i)
-    {
-        Fu = el.m_Kua[i]*Kif;
-        Fw = el.m_Kwa[i]*Kif;
-        
-        // calculate internal force
-        // the '-' sign is so that the internal forces get subtracted
-        // from the global residual vector
-        fe[6*i  ] += Fu(0,0);
-        fe[6*i+1] += Fu(1,0);
-        fe[6*i+2] += Fu(2,0);
-        
-        fe[6*i+3] += Fw(0,0);
-        fe[6*i+4] += Fw(1,0);
-        fe[6*i+5] += Fw(2,0);
-    }
+    m_cond.CondenseResidual(el.GetLocalID(), fe);
+    
+    small_matrix<3,1> Fu, Fw;
     
     // repeat for all integration points
     for (n=0; n<nint; ++n)
@@ -275,7 +298,7 @@ void FEElasticEASShellDomain::ElementInternalForce(FEShellElementNew& el, vector
         EvaluateANS(el, n, Gcnt, E, hu, hw, EE, HU, HW);
         
         // evaluate 2nd P-K stress
-        matrix SC(6,1);
+        small_matrix<6,1> SC;
         mat3dsCntMat61(S[n], Gcnt, SC);
         //        mat3ds S = m_pMat->PK2Stress(E);
         //        mat3dsCntMat61(S, Gcnt, SC);
@@ -510,28 +533,47 @@ void FEElasticEASShellDomain::ElementBodyForceStiffness(FEBodyForce& BF, FEShell
 
 void FEElasticEASShellDomain::StiffnessMatrix(FELinearSystem& LS)
 {
-    // repeat over all shell elements
+    // repeat over all shell elements, in batches so that the EAS blocks
+    // of all elements in a batch can be condensed together
+    const int W = FEStaticCondensation::LANES;
     int NS = (int)m_Elem.size();
-#pragma omp parallel for shared (NS)
-    for (int iel=0; iel<NS; ++iel)
+    int NB = (NS + W - 1) / W;
+#pragma omp parallel shared (NS, NB)
     {
-		FEShellElement& el = m_Elem[iel];
-
-        // create the element's stiffness matrix
-		FEElementMatrix ke(el);
-		int ndof = 6*el.Nodes();
-        ke.resize(ndof, ndof);
-        
-        // calculate the element stiffness matrix
-        ElementStiffness(iel, ke);
-        
-        // get the element's LM vector
-		vector<int> lm;
-		UnpackLM(el, lm);
-		ke.SetIndices(lm);
+        FEStaticCondensation::Batch batch(m_cond);
+        EASElementData data[W];
         
-        // assemble element matrix in global stiffness matrix
-		LS.Assemble(ke);
+#pragma omp for
+        for (int ib=0; ib<NB; ++ib)
+        {
+            int i0 = ib*W;
+            int i1 = (i0 + W < NS ? i0 + W : NS);
+            
+            // evaluate and condense the EAS blocks of this batch
+            for (int iel=i0; iel<i1; ++iel) EvaluateElementEAS(m_Elem[iel], data[iel-i0], batch);
+            batch.Factor();
+            
+            for (int iel=i0; iel<i1; ++iel)
+            {
+                FEShellElementNew& el = m_Elem[iel];
+                
+                // create the element's stiffness matrix
+                FEElementMatrix ke(el);
+                int ndof = 6*el.Nodes();
+                ke.resize(ndof, ndof);
+                
+                // calculate the element stiffness matrix
+                ElementStiffness(el, data[iel-i0], ke);
+                
+                // get the element's LM vector
+                vector<int> lm;
+                UnpackLM(el, lm);
+                ke.SetIndices(lm);
+                
+                // assemble element matrix in global stiffness matrix
+                LS.Assemble(ke);
+            }
+        }
     }
 }
 
@@ -599,7 +641,16 @@ void FEElasticEASShellDomain::BodyForceStiffness(FELinearSystem& LS, FEBodyForce
 void FEElasticEASShellDomain::ElementStiffness(int iel, matrix& ke)
 {
 	FEShellElementNew& el = ShellElement(iel);
-    
+    EASElementData d;
+    FEStaticCondensation::Batch batch(m_cond);
+    EvaluateElementEAS(el, d, batch);
+    batch.Factor();
+    ElementStiffness(el, d, ke);
+}
+
+//-----------------------------------------------------------------------------
+void FEElasticEASShellDomain::ElementStiffness(FEShellElementNew& el, EASElementData& d, matrix& ke)
+{
     int i, i6, j, j6, n;
     
     // Get the current element's data
@@ -614,59 +665,27 @@ void FEElasticEASShellDomain::ElementStiffness(int iel, matrix& ke)
     
     vec3d Gcnt[3];
     
-    // allocate arrays
-    vector<mat3ds> S(nint);
-    vector<tens4dmm> C(nint);
-    vector<double> EE;
-    vector< vector<vec3d>> HU;
-    vector< vector<vec3d>> HW;
-    matrix NS(neln,16);
-    matrix NN(neln,8);
+    vector<mat3ds>& S = d.S;
+    vector<tens4dmm>& C = d.C;
+    vector<double>& EE = d.EE;
+    vector< vector<vec3d>>& HU = d.HU;
+    vector< vector<vec3d>>& HW = d.HW;
+    matrix& NS = d.NS;
+    matrix& NN = d.NN;
     
     bool ANS = true;
     //    bool ANS = false;
     
-    if (ANS) CollocationStrainsANS(el, EE, HU, HW, NS, NN);
-    
-    // EAS method: Evaluate Kua, Kwa, and Kaa
-    // Also evaluate PK2 stress and material tangent using enhanced strain
-    EvaluateEAS(el, EE, HU, HW, S, C);
-    
     // calculate element stiffness matrix
-    vector<matrix> hu(neln, matrix(3,6));
-    vector<matrix> hw(neln, matrix(3,6));
+    vector< small_matrix<3,6> > hu(neln);
+    vector< small_matrix<3,6> > hw(neln);
     vector<vec3d> Nu(neln);
     vector<vec3d> Nw(neln);
     
     ke.zero();
     
-    matrix KUU(3,3), KUW(3,3), KWU(3,3), KWW(3,3);
-    for (i=0, i6=0; i<neln; ++i, i6 += 6)
-    {
-        for (j=0, j6 = 0; j<neln; ++j, j6 += 6)
-        {
-            KUU = (el.m_Kua[i]*el.m_Kaai*el.m_Kua[j].transpose());
-            KUW = (el.m_Kua[i]*el.m_Kaai*el.m_Kwa[j].transpose());
-            KWU = (el.m_Kwa[i]*el.m_Kaai*el.m_Kua[j].transpose());
-            KWW = (el.m_Kwa[i]*el.m_Kaai*el.m_Kwa[j].transpose());
-            
-            ke[i6  ][j6  ] -= KUU(0,0); ke[i6  ][j6+1] -= KUU(0,1); ke[i6  ][j6+2] -= KUU(0,2);
-            ke[i6+1][j6  ] -= KUU(1,0); ke[i6+1][j6+1] -= KUU(1,1); ke[i6+1][j6+2] -= KUU(1,2);
-            ke[i6+2][j6  ] -= KUU(2,0); ke[i6+2][j6+1] -= KUU(2,1); ke[i6+2][j6+2] -= KUU(2,2);
-            
-            ke[i6  ][j6+3] -= KUW(0,0); ke[i6  ][j6+4] -= KUW(0,1); ke[i6  ][j6+5] -= KUW(0,2);
-            ke[i6+1][j6+3] -= KUW(1,0); ke[i6+1][j6+4] -= KUW(1,1); ke[i6+1][j6+5] -= KUW(1,2);
-            ke[i6+2][j6+3] -= KUW(2,0); ke[i6+2][j6+4] -= KUW(2,1); ke[i6+2][j6+5] -= KUW(2,2);
-            
-            ke[i6+3][j6  ] -= KWU(0,0); ke[i6+3][j6+1] -= KWU(0,1); ke[i6+3][j6+2] -= KWU(0,2);
-            ke[i6+4][j6  ] -= KWU(1,0); ke[i6+4][j6+1] -= KWU(1,1); ke[i6+4][j6+2] -= KWU(1,2);
-            ke[i6+5][j6  ] -= KWU(2,0); ke[i6+5][j6+1] -= KWU(2,1); ke[i6+5][j6+2] -= KWU(2,2);
-            
-            ke[i6+3][j6+3] -= KWW(0,0); ke[i6+3][j6+4] -= KWW(0,1); ke[i6+3][j6+5] -= KWW(0,2);
-            ke[i6+4][j6+3] -= KWW(1,0); ke[i6+4][j6+4] -= KWW(1,1); ke[i6+4][j6+5] -= KWW(1,2);
-            ke[i6+5][j6+3] -= KWW(2,0); ke[i6+5][j6+4] -= KWW(2,1); ke[i6+5][j6+5] -= KWW(2,2);
-        }
-    }
+    // EAS contribution
+    m_cond.CondenseStiffness(el.GetLocalID(), ke);
     
     for (n=0; n<nint; ++n)
     {
@@ -680,13 +699,13 @@ void FEElasticEASShellDomain::ElementStiffness(int iel, matrix& ke)
         detJt = detJ0(el, n)*gw[n];
         
         // evaluate 2nd P-K stress
-        matrix SC(6,1);
+        small_matrix<6,1> SC;
         mat3dsCntMat61(S[n], Gcnt, SC);
         //        mat3ds S = m_pMat->PK2Stress(E);
         //        mat3dsCntMat61(S, Gcnt, SC);
         
         // evaluate the material tangent
-        matrix CC(6,6);
+        small_matrix<6,6> CC;
         tens4dmmCntMat66(C[n], Gcnt, CC);
 //        tens4dsCntMat66(C[n], Gcnt, CC);
         //        tens4ds c = m_pMat->MaterialTangent(E);
@@ -696,13 +715,15 @@ void FEElasticEASShellDomain::ElementStiffness(int iel, matrix& ke)
         
         for (i=0, i6=0; i<neln; ++i, i6 += 6)
         {
+            small_matrix<3,6> huC = hu[i]*CC;
+            small_matrix<3,6> hwC = hw[i]*CC;
             for (j=0, j6 = 0; j<neln; ++j, j6 += 6)
             {
-                matrix KUU(3,3), KUW(3,3), KWU(3,3), KWW(3,3);
-                KUU = hu[i]*CC*hu[j].transpose();
-                KUW = hu[i]*CC*hw[j].transpose();
-                KWU = hw[i]*CC*hu[j].transpose();
-                KWW = hw[i]*CC*hw[j].transpose();
+                small_matrix<3,3> KUU, KUW, KWU, KWW;
+                FESmallLA::mult_abt(huC, hu[j], KUU);
+                FESmallLA::mult_abt(huC, hw[j], KUW);
+                FESmallLA::mult_abt(hwC, hu[j], KWU);
+                FESmallLA::mult_abt(hwC, hw[j], KWW);
                 KUU *= detJt; KUW *= detJt; KWU *= detJt; KWW *= detJt;
                 
                 ke[i6  ][j6  ] += KUU(0,0); ke[i6  ][j6+1] += KUU(0,1); ke[i6  ][j6+2] += KUU(0,2);
@@ -973,22 +994,20 @@ void FEElasticEASShellDomain::UpdateEAS(vector<double>& ui)
         
         // allocate arrays
         matrix dalpha(m_nEAS,1);
-        matrix Du(3,1), Dw(3,1);
+        vector<double> du(6*neln);
         
         // nodal coordinates and EAS vector alpha update
-        dalpha = el.m_fa;
         for (int j=0; j<neln; ++j)
         {
             FENode& nj = mesh.Node(el.m_node[j]);
-            Du(0,0) = (nj.m_ID[m_dofU[0]] >=0) ? ui[nj.m_ID[m_dofU[0]]] : 0;
-            Du(1,0) = (nj.m_ID[m_dofU[1]] >=0) ? ui[nj.m_ID[m_dofU[1]]] : 0;
-            Du(2,0) = (nj.m_ID[m_dofU[2]] >=0) ? ui[nj.m_ID[m_dofU[2]]] : 0;
-            Dw(0,0) = (nj.m_ID[m_dofSU[0]] >=0) ? ui[nj.m_ID[m_dofSU[0]]] : 0;
-            Dw(1,0) = (nj.m_ID[m_dofSU[1]] >=0) ? ui[nj.m_ID[m_dofSU[1]]] : 0;
-            Dw(2,0) = (nj.m_ID[m_dofSU[2]] >=0) ? ui[nj.m_ID[m_dofSU[2]]] : 0;
-            dalpha += el.m_Kua[j].transpose()*Du + el.m_Kwa[j].transpose()*Dw;
+            du[6*j  ] = (nj.m_ID[m_dofU[0]] >=0) ? ui[nj.m_ID[m_dofU[0]]] : 0;
+            du[6*j+1] = (nj.m_ID[m_dofU[1]] >=0) ? ui[nj.m_ID[m_dofU[1]]] : 0;
+            du[6*j+2] = (nj.m_ID[m_dofU[2]] >=0) ? ui[nj.m_ID[m_dofU[2]]] : 0;
+            du[6*j+3] = (nj.m_ID[m_dofSU[0]] >=0) ? ui[nj.m_ID[m_dofSU[0]]] : 0;
+            du[6*j+4] = (nj.m_ID[m_dofSU[1]] >=0) ? ui[nj.m_ID[m_dofSU[1]]] : 0;
+            du[6*j+5] = (nj.m_ID[m_dofSU[2]] >=0) ? ui[nj.m_ID[m_dofSU[2]]] : 0;
         }
-        dalpha = el.m_Kaai*dalpha;
+        m_cond.Recover(i, &du[0], dalpha[0]);
         el.m_alpha = el.m_alphat + el.m_alphai - dalpha;
     }
 }
@@ -1010,22 +1029,20 @@ void FEElasticEASShellDomain::UpdateIncrementsEAS(vector<double>& ui, const bool
             
             // allocate arrays
             matrix dalpha(m_nEAS,1);
-            matrix Du(3,1), Dw(3,1);
+            vector<double> du(6*neln);
             
             // nodal coordinates and EAS vector alpha update
-            dalpha = el.m_fa;
             for (int j=0; j<neln; ++j)
             {
                 FENode& nj = mesh.Node(el.m_node[j]);
-                Du(0,0) = (nj.m_ID[m_dofU[0]] >=0) ? ui[nj.m_ID[m_dofU[0]]] : 0;
-                Du(1,0) = (nj.m_ID[m_dofU[1]] >=0) ? ui[nj.m_ID[m_dofU[1]]] : 0;
-                Du(2,0) = (nj.m_ID[m_dofU[2]] >=0) ? ui[nj.m_ID[m_dofU[2]]] : 0;
-                Dw(0,0) = (nj.m_ID[m_dofSU[0]] >=0) ? ui[nj.m_ID[m_dofSU[0]]] : 0;
-                Dw(1,0) = (nj.m_ID[m_dofSU[1]] >=0) ? ui[nj.m_ID[m_dofSU[1]]] : 0;
-                Dw(2,0) = (nj.m_ID[m_dofSU[2]] >=0) ? ui[nj.m_ID[m_dofSU[2]]] : 0;
-                dalpha += el.m_Kua[j].transpose()*Du + el.m_Kwa[j].transpose()*Dw;
+                du[6*j  ] = (nj.m_ID[m_dofU[0]] >=0) ? ui[nj.m_ID[m_dofU[0]]] : 0;
+                du[6*j+1] = (nj.m_ID[m_dofU[1]] >=0) ? ui[nj.m_ID[m_dofU[1]]] : 0;
+                du[6*j+2] = (nj.m_ID[m_dofU[2]] >=0) ? ui[nj.m_ID[m_dofU[2]]] : 0;
+                du[6*j+3] = (nj.m_ID[m_dofSU[0]] >=0) ? ui[nj.m_ID[m_dofSU[0]]] : 0;
+                du[6*j+4] = (nj.m_ID[m_dofSU[1]] >=0) ? ui[nj.m_ID[m_dofSU[1]]] : 0;
+                du[6*j+5] = (nj.m_ID[m_dofSU[2]] >=0) ? ui[nj.m_ID[m_dofSU[2]]] : 0;
             }
-            dalpha = el.m_Kaai*dalpha;
+            m_cond.Recover(i, &du[0], dalpha[0]);
             el.m_alphai -= dalpha;
         }
         else el.m_alphat += el.m_alphai;
@@ -1177,7 +1194,7 @@ void FEElasticEASShellDomain::UnpackLM(FEElement& el, vector<int>& lm)
     for (int i=0; i<N; ++i)
     {
         FENode& node = m_pMesh->Node(el.m_node[i]);
-        vector<int>& id = node.m_ID;
+        FENodeDofArray<int>& id = node.m_ID;
         
         // first the displacement dofs
         lm[6*i  ] = id[m_dofU[0]];
@@ -1281,9 +1298,8 @@ void FEElasticEASShellDomain::GenerateGMatrix(FEShellElementNew& el, const int n
 
 //-----------------------------------------------------------------------------
 //! Evaluate contravariant components of mat3ds tensor
-void FEElasticEASShellDomain::mat3dsCntMat61(const mat3ds s, const vec3d* Gcnt, matrix& S)
+void FEElasticEASShellDomain::mat3dsCntMat61(const mat3ds s, const vec3d* Gcnt, small_matrix<6,1>& S)
 {
-    S.resize(6, 1);
     S(0,0) = Gcnt[0]*(s*Gcnt[0]);
     S(1,0) = Gcnt[1]*(s*Gcnt[1]);
     S(2,0) = Gcnt[2]*(s*Gcnt[2]);
@@ -1296,9 +1312,8 @@ void FEElasticEASShellDomain::mat3dsCntMat61(const mat3ds s, const vec3d* Gcnt,
 //-----------------------------------------------------------------------------
 //! Evaluate contravariant components of tens4ds tensor
 //! Cijkl = Gj.(Gi.c.Gl).Gk
-void FEElasticEASShellDomain::tens4dsCntMat66(const tens4ds c, const vec3d* Gcnt, matrix& C)
+void FEElasticEASShellDomain::tens4dsCntMat66(const tens4ds c, const vec3d* Gcnt, small_matrix<6,6>& C)
 {
-    C.resize(6, 6);
     C(0,0) =          Gcnt[0]*(vdotTdotv(Gcnt[0], c, Gcnt[0])*Gcnt[0]);  // i=0, j=0, k=0, l=0
     C(0,1) = C(1,0) = Gcnt[0]*(vdotTdotv(Gcnt[0], c, Gcnt[1])*Gcnt[1]);  // i=0, j=0, k=1, l=1
     C(0,2) = C(2,0) = Gcnt[0]*(vdotTdotv(Gcnt[0], c, Gcnt[2])*Gcnt[2]);  // i=0, j=0, k=2, l=2
@@ -1326,9 +1341,8 @@ void FEElasticEASShellDomain::tens4dsCntMat66(const tens4ds c, const vec3d* Gcnt
 //-----------------------------------------------------------------------------
 //! Evaluate contravariant components of tens4dmm tensor
 //! Cijkl = Gj.(Gi.c.Gl).Gk
-void FEElasticEASShellDomain::tens4dmmCntMat66(const tens4dmm c, const vec3d* Gcnt, matrix& C)
+void FEElasticEASShellDomain::tens4dmmCntMat66(const tens4dmm c, const vec3d* Gcnt, small_matrix<6,6>& C)
 {
-    C.resize(6, 6);
     C(0,0) =          Gcnt[0]*(vdotTdotv(Gcnt[0], c, Gcnt[0])*Gcnt[0]);  // i=0, j=0, k=0, l=0
     C(0,1) = C(1,0) = Gcnt[0]*(vdotTdotv(Gcnt[0], c, Gcnt[1])*Gcnt[1]);  // i=0, j=0, k=1, l=1
     C(0,2) = C(2,0) = Gcnt[0]*(vdotTdotv(Gcnt[0], c, Gcnt[2])*Gcnt[2]);  // i=0, j=0, k=2, l=2
@@ -1357,36 +1371,29 @@ void FEElasticEASShellDomain::tens4dmmCntMat66(const tens4dmm c, const vec3d* Gc
 //! Evaluate the matrices and vectors relevant to the EAS method
 void FEElasticEASShellDomain::EvaluateEAS(FEShellElementNew& el, vector<double>& EE,
                                        vector< vector<vec3d>>& HU, vector< vector<vec3d>>& HW,
-                                       vector<mat3ds>& S, vector<tens4dmm>& c)
+                                       vector<mat3ds>& S, vector<tens4dmm>& c, FEStaticCondensation::Batch& batch)
 {
     int i, n;
     
     // jacobian matrix determinant
     double detJt;
     
-    const double* Mr, *Ms, *M;
-    
     int nint = el.GaussPoints();
     int neln = el.Nodes();
     
-    vector<matrix> hu(neln, matrix(3,6));
-    vector<matrix> hw(neln, matrix(3,6));
+    vector< small_matrix<3,6> > hu(neln);
+    vector< small_matrix<3,6> > hw(neln);
     vector<vec3d> Nu(neln);
     vector<vec3d> Nw(neln);
-    matrix NS(neln,16);
-    matrix NN(neln,8);
     
     double*    gw = el.GaussWeights();
-    double eta;
     vec3d Gcnt[3];
     
     // Evaluate fa, Kua, Kwa, and Kaa by integrating over the element
-    el.m_fa.zero();
-    el.m_Kaai.zero();
-    for (i=0; i< neln; ++i) {
-        el.m_Kua[i].zero();
-        el.m_Kwa[i].zero();
-    }
+    matrix fa(m_nEAS,1), Kaa(m_nEAS,m_nEAS), Kua(6*neln,m_nEAS);
+    fa.zero();
+    Kaa.zero();
+    Kua.zero();
     
     // repeat for all integration points
     for (n=0; n<nint; ++n)
@@ -1422,47 +1429,45 @@ void FEElasticEASShellDomain::EvaluateEAS(FEShellElementNew& el, vector<double>&
         
         // get the stress tensor for this integration point and evaluate its contravariant components
         S[n] = m_pMat->PK2Stress(mp, el.m_E[n]);
-        matrix SM;
+        small_matrix<6,1> SM;
         mat3dsCntMat61(S[n], Gcnt, SM);
         
         // get the material tangent
         c[n] = m_pMat->MaterialTangent(mp, el.m_E[n]);
         // get contravariant components of material tangent
-        matrix CC;
+        small_matrix<6,6> CC;
         tens4dmmCntMat66(c[n], Gcnt, CC);
 //        tens4dsCntMat66(c[n], Gcnt, CC);
         
         // Evaluate fa
-        matrix tmp(m_nEAS,1);
-        tmp = G.transpose()*SM;
-        tmp *= detJt;
-        el.m_fa += tmp;
+        for (int a=0; a<m_nEAS; ++a)
+        {
+            double fan = 0;
+            for (int k=0; k<6; ++k) fan += G(k,a)*SM(k,0);
+            fa(a,0) += fan*detJt;
+        }
+        
+        // CG = CC*G is shared by Kaa, Kua, and Kwa
+        matrix CG(6,m_nEAS);
+        CG.zero();
+        FESmallLA::mult_add(CC, G[0], m_nEAS, CG[0], m_nEAS, 1.0);
         
         // Evaluate Kaa
         matrix Tmpa(m_nEAS,m_nEAS);
-        Tmpa = G.transpose()*CC*G;
+        Tmpa = G.transpose()*CG;
         Tmpa *= detJt;
-        el.m_Kaai += Tmpa;
-        
-        eta = el.gt(n);
-        Mr = el.Hr(n);
-        Ms = el.Hs(n);
-        M  = el.H(n);
+        Kaa += Tmpa;
         
         // Evaluate Kua and Kwa
-        matrix Tmp(3,m_nEAS);
         for (i=0; i<neln; ++i)
         {
-            Tmp = hu[i]*CC*G;
-            Tmp *= detJt;
-            el.m_Kua[i] += Tmp;
-            Tmp = hw[i]*CC*G;
-            Tmp *= detJt;
-            el.m_Kwa[i] += Tmp;
+            FESmallLA::mult_add(hu[i], CG[0], m_nEAS, Kua[6*i  ], m_nEAS, detJt);
+            FESmallLA::mult_add(hw[i], CG[0], m_nEAS, Kua[6*i+3], m_nEAS, detJt);
         }
     }
-    // invert Kaa
-    el.m_Kaai = el.m_Kaai.inverse();
+    
+    // add the EAS blocks to the batch (Kau = Kua^T)
+    batch.Add(el.GetLocalID(), Kaa[0], Kua[0], nullptr, fa[0]);
 }
 
 //-----------------------------------------------------------------------------
@@ -1633,7 +1638,7 @@ void FEElasticEASShellDomain::CollocationStrainsANS(FEShellElementNew& el, vecto
 //-----------------------------------------------------------------------------
 //! Evaluate assumed natural strain (ANS)
 void FEElasticEASShellDomain::EvaluateANS(FEShellElementNew& el, const int n, const vec3d* Gcnt,
-                                       mat3ds& Ec, vector<matrix>& hu, vector<matrix>& hw,
+                                       mat3ds& Ec, vector< small_matrix<3,6> >& hu, vector< small_matrix<3,6> >& hw,
                                        vector<double>& E, vector< vector<vec3d>>& HU, vector< vector<vec3d>>& HW)
 {
     // ANS method for 4-node quadrilaterials
@@ -1697,7 +1702,7 @@ void FEElasticEASShellDomain::EvaluateANS(FEShellElementNew& el, const int n, co
 //-----------------------------------------------------------------------------
 //! Evaluate strain E and matrix hu and hw
 void FEElasticEASShellDomain::EvaluateEh(FEShellElementNew& el, const int n, const vec3d* Gcnt, mat3ds& E,
-                                      vector<matrix>& hu, vector<matrix>& hw, vector<vec3d>& Nu, vector<vec3d>& Nw)
+                                      vector< small_matrix<3,6> >& hu, vector< small_matrix<3,6> >& hw, vector<vec3d>& Nu, vector<vec3d>& Nw)
 {
     FETimeInfo& tp = GetFEModel()->GetTime();
     
@@ -30,6 +30,8 @@ SOFTWARE.*/
 #include "FESSIShellDomain.h"
 #include "FEElasticDomain.h"
 #include "FESolidMaterial.h"
+#include <FECore/FESmallMatrix.h>
+#include <FECore/FEStaticCondensation.h>
 
 //-----------------------------------------------------------------------------
 //! Domain described by 3D shell elements
@@ -98,7 +100,7 @@ public: // overrides from FEElasticDomain
     void BodyForceStiffness(FELinearSystem& LS, FEBodyForce& bf) override;
     
     // evaluate strain E and matrix hu and hw
-	void EvaluateEh(FEShellElementNew& el, const int n, const vec3d* Gcnt, mat3ds& E, vector<matrix>& hu, vector<matrix>& hw, vector<vec3d>& Nu, vector<vec3d>& Nw);
+	void EvaluateEh(FEShellElementNew& el, const int n, const vec3d* Gcnt, mat3ds& E, vector< small_matrix<3,6> >& hu, vector< small_matrix<3,6> >& hw, vector<vec3d>& Nu, vector<vec3d>& Nw);
     
 public:
     
@@ -135,27 +137,48 @@ public:
 	void GenerateGMatrix(FEShellElementNew& el, const int n, const double Jeta, matrix& G);
     
     // Evaluate contravariant components of mat3ds tensor
-    void mat3dsCntMat61(const mat3ds s, const vec3d* Gcnt, matrix& S);
+    void mat3dsCntMat61(const mat3ds s, const vec3d* Gcnt, small_matrix<6,1>& S);
     
     // Evaluate contravariant components of tens4ds tensor
-    void tens4dsCntMat66(const tens4ds c, const vec3d* Gcnt, matrix& C);
-    void tens4dmmCntMat66(const tens4dmm c, const vec3d* Gcnt, matrix& C);
+    void tens4dsCntMat66(const tens4ds c, const vec3d* Gcnt, small_matrix<6,6>& C);
+    void tens4dmmCntMat66(const tens4dmm c, const vec3d* Gcnt, small_matrix<6,6>& C);
 
-    // Evaluate the matrices and vectors relevant to the EAS method
-	void EvaluateEAS(FEShellElementNew& el, vector<double>& E, vector< vector<vec3d>>& HU, vector< vector<vec3d>>& HW, vector<mat3ds>& S, vector<tens4dmm>& c);
+    // Evaluate the matrices and vectors relevant to the EAS method and add them to the condensation batch
+	void EvaluateEAS(FEShellElementNew& el, vector<double>& E, vector< vector<vec3d>>& HU, vector< vector<vec3d>>& HW, vector<mat3ds>& S, vector<tens4dmm>& c, FEStaticCondensation::Batch& batch);
     
     // Evaluate the strain using the ANS method
 	void CollocationStrainsANS(FEShellElementNew& el, vector<double>& E, vector< vector<vec3d>>& HU, vector< vector<vec3d>>& HW, matrix& NS, matrix& NN);
     
-	void EvaluateANS(FEShellElementNew& el, const int n, const vec3d* Gcnt, mat3ds& Ec, vector<matrix>& hu, vector<matrix>& hw, vector<double>& E, vector< vector<vec3d>>& HU, vector< vector<vec3d>>& HW);
+	void EvaluateANS(FEShellElementNew& el, const int n, const vec3d* Gcnt, mat3ds& Ec, vector< small_matrix<3,6> >& hu, vector< small_matrix<3,6> >& hw, vector<double>& E, vector< vector<vec3d>>& HU, vector< vector<vec3d>>& HW);
     
     // Update alpha in EAS method
     void UpdateEAS(vector<double>& ui) override;
     void UpdateIncrementsEAS(vector<double>& ui, const bool binc) override;
     
+protected:
+    //! element data that is evaluated before the EAS parameters are condensed
+    struct EASElementData
+    {
+        vector<mat3ds>      S;
+        vector<tens4dmm>    C;
+        vector<double>      EE;
+        vector< vector<vec3d> > HU;
+        vector< vector<vec3d> > HW;
+        matrix              NS;
+        matrix              NN;
+    };
+
+    //! evaluate the ANS and EAS data of an element and add its EAS blocks to the batch
+    void EvaluateElementEAS(FEShellElementNew& el, EASElementData& d, FEStaticCondensation::Batch& batch);
+
+    //! element stiffness and internal force, once the batch of the element was factored
+    void ElementStiffness(FEShellElementNew& el, EASElementData& d, matrix& ke);
+    void ElementInternalForce(FEShellElementNew& el, EASElementData& d, vector<double>& fe);
+
 protected:
     FESolidMaterial*    m_pMat;
     int                 m_nEAS;
+    FEStaticCondensation    m_cond;     //!< condensation of the EAS parameters
     bool                m_update_dynamic;    //!< flag for updating quantities only used in dynamic analysis
     
     bool    m_secant_stress;    //!< use secant approximation to stress
@@ -51,6 +51,22 @@ FEMaterialPointData* FEElasticMaterial::CreateMaterialPointData()
 	return new FEElasticMaterialPoint;
 }
 
+//-----------------------------------------------------------------------------
+//! The default batch implementation simply evaluates the stress point by point.
+void FEElasticMaterial::StressBatch(FEElasticBatch& batch)
+{
+	for (int i = 0; i < batch.Points(); ++i)
+		batch.SetStress(i, Stress(batch.MaterialPoint(i)));
+}
+
+//-----------------------------------------------------------------------------
+//! The default batch implementation simply evaluates the tangent point by point.
+void FEElasticMaterial::TangentBatch(FEElasticBatch& batch)
+{
+	for (int i = 0; i < batch.Points(); ++i)
+		batch.SetTangent(i, Tangent(batch.MaterialPoint(i)));
+}
+
 //-----------------------------------------------------------------------------
 //! calculate spatial tangent stiffness at material point, using secant method
 mat3ds FEElasticMaterial::SecantStress(FEMaterialPoint& mp, bool PK2)
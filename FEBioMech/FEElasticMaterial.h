@@ -29,6 +29,7 @@ SOFTWARE.*/
 #pragma once
 #include "FESolidMaterial.h"
 #include "FEElasticMaterialPoint.h"
+#include "FEElasticBatch.h"
 
 //-----------------------------------------------------------------------------
 //! Base class for (hyper-)elastic materials
@@ -55,6 +56,16 @@ public:
 	//! evaluates approximation to Cauchy stress using forward difference
 	mat3ds SecantStress(FEMaterialPoint& pt, bool PK2 = false) override;
 
+public:
+	//! Returns true if the material provides a vectorized implementation of the batch functions
+	virtual bool HasBatchEvaluation() const { return false; }
+
+	//! evaluate the Cauchy stress at all points of the batch
+	virtual void StressBatch(FEElasticBatch& batch);
+
+	//! evaluate the spatial tangent at all points of the batch
+	virtual void TangentBatch(FEElasticBatch& batch);
+
 public:
     virtual double StrongBondSED(FEMaterialPoint& pt) { return StrainEnergyDensity(pt); }
     virtual double WeakBondSED(FEMaterialPoint& pt) { return 0; }
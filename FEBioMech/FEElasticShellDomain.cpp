@@ -445,6 +445,9 @@ void FEElasticShellDomain::StiffnessMatrix(FELinearSystem& LS)
 {
     // repeat over all shell elements
     int NS = (int)m_Elem.size();
+
+	// for symmetric systems, we only need the upper triangular part of the element matrices
+	const bool upper = LS.IsSymmetric();
 #pragma omp parallel for shared (NS)
     for (int iel=0; iel<NS; ++iel)
     {
@@ -456,7 +459,8 @@ void FEElasticShellDomain::StiffnessMatrix(FELinearSystem& LS)
         ke.resize(ndof, ndof);
         
         // calculate the element stiffness matrix
-        ElementStiffness(iel, ke);
+        ElementStiffness(iel, ke, upper);
+		ke.SetUpperTriangular(upper);
         
         // get the element's LM vector
 		vector<int> lm;
@@ -529,7 +533,8 @@ void FEElasticShellDomain::BodyForceStiffness(FELinearSystem& LS, FEBodyForce& b
 //-----------------------------------------------------------------------------
 //! Calculates the shell element stiffness matrix
 
-void FEElasticShellDomain::ElementStiffness(int iel, matrix& ke)
+//! If upper is true, only the upper triangular part of ke is evaluated.
+void FEElasticShellDomain::ElementStiffness(int iel, matrix& ke, bool upper)
 {
     FEShellElement& el = Element(iel);
     
@@ -587,7 +592,7 @@ void FEElasticShellDomain::ElementStiffness(int iel, matrix& ke)
         
         for (i=0, i6=0; i<neln; ++i, i6 += 6)
         {
-            for (j=0, j6 = 0; j<neln; ++j, j6 += 6)
+            for (j=(upper ? i : 0), j6 = 6*j; j<neln; ++j, j6 += 6)
             {
                 mat3d Kuu = vdotTdotv(gradMu[i], C, gradMu[j])*detJt;
                 mat3d Kud = vdotTdotv(gradMu[i], C, gradMd[j])*detJt;
@@ -615,7 +620,7 @@ void FEElasticShellDomain::ElementStiffness(int iel, matrix& ke)
         // ------------ initial stress component --------------
         
         for (i=0; i<neln; ++i)
-            for (j=0; j<neln; ++j)
+            for (j=(upper ? i : 0); j<neln; ++j)
             {
                 double Kuu = gradMu[i]*(s*gradMu[j])*detJt;
                 double Kud = gradMu[i]*(s*gradMd[j])*detJt;
@@ -906,7 +911,7 @@ void FEElasticShellDomain::UnpackLM(FEElement& el, vector<int>& lm)
 	for (int i=0; i<N; ++i)
 	{
 		FENode& node = m_pMesh->Node(el.m_node[i]);
-		vector<int>& id = node.m_ID;
+		FENodeDofArray<int>& id = node.m_ID;
 
 		// first the displacement dofs
 		lm[6*i  ] = id[m_dofU[0]];
@@ -99,7 +99,7 @@ public:
 	// --- S T I F F N E S S --- 
 
 	//! calculates the shell element stiffness matrix
-	void ElementStiffness(int iel, matrix& ke);
+	void ElementStiffness(int iel, matrix& ke, bool upper = false);
 
     //! calculates the solid element mass matrix
     void ElementMassMatrix(FEShellElement& el, matrix& ke, double a);
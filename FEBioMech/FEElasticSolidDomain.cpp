@@ -37,6 +37,8 @@ SOFTWARE.*/
 #include "FEBioMech.h"
 #include <FECore/FELinearSystem.h>
 #include "FEResidualVector.h"
+#include <FECore/FESolidElementKernels.h>
+#include <FECore/FEElementWorkspace.h>
 
 //-----------------------------------------------------------------------------
 //! constructor
@@ -141,6 +143,8 @@ void FEElasticSolidDomain::PreSolveUpdate(const FETimeInfo& timeInfo)
     m_alpham = timeInfo.alpham;
     m_beta = timeInfo.beta;
 
+	InvalidateKinematicsCache();
+
 #pragma omp parallel for
 	for (int i=0; i<Elements(); ++i)
 	{
@@ -172,8 +176,9 @@ void FEElasticSolidDomain::InternalForces(FEGlobalVector& R)
 
 		if (el.isActive()) {
 			// element force vector
-			vector<double> fe;
-			vector<int> lm;
+			FEScopedWorkspace ws;
+			vector<double>& fe = ws->fe;
+			vector<int>& lm = ws->lm;
 
 			// get the element force vector and initialize it to zero
 			int ndof = 3 * el.Nodes();
@@ -191,11 +196,32 @@ void FEElasticSolidDomain::InternalForces(FEGlobalVector& R)
 	}
 }
 
+//-----------------------------------------------------------------------------
+// helper classes for dispatching to the specialized element kernels
+struct FEElasticInternalForceKernel {
+	FEElasticSolidDomain* dom; FESolidElement& el; vector<double>& fe;
+	template <FE_Element_Type ET> void run() { dom->ElementInternalForce<ET>(el, fe); }
+};
+
+struct FEElasticGeometricalStiffnessKernel {
+	FEElasticSolidDomain* dom; FESolidElement& el; matrix& ke; bool upper;
+	template <FE_Element_Type ET> void run() { dom->ElementGeometricalStiffness<ET>(el, ke, upper); }
+};
+
+struct FEElasticMaterialStiffnessKernel {
+	FEElasticSolidDomain* dom; FESolidElement& el; matrix& ke; bool upper;
+	template <FE_Element_Type ET> void run() { dom->ElementMaterialStiffness<ET>(el, ke, upper); }
+};
+
 //-----------------------------------------------------------------------------
 //! calculates the internal equivalent nodal forces for solid elements
 
 void FEElasticSolidDomain::ElementInternalForce(FESolidElement& el, vector<double>& fe)
 {
+	// see if we have a specialized kernel for this element
+	FEElasticInternalForceKernel kernel = { this, el, fe };
+	if (FEDispatchSolidElementKernel(el.Type(), kernel)) return;
+
 	// jacobian matrix, inverse jacobian matrix and determinants
 	double Ji[3][3];
 
@@ -211,7 +237,7 @@ void FEElasticSolidDomain::ElementInternalForce(FESolidElement& el, vector<doubl
 		FEElasticMaterialPoint& pt = *(mp.ExtractData<FEElasticMaterialPoint>());
 
 		// calculate the jacobian
-		double detJt = (m_update_dynamic ? invjact(el, Ji, n, m_alphaf) : invjact(el, Ji, n));
+		double detJt = CachedInvJact(el, Ji, n, (m_update_dynamic ? m_alphaf : 1.0));
 
 		detJt *= gw[n];
 
@@ -283,6 +309,25 @@ void FEElasticSolidDomain::BodyForce(FEGlobalVector& R, FEBodyForce& BF)
 //! calculates element's geometrical stiffness component for integration point n
 void FEElasticSolidDomain::ElementGeometricalStiffness(FESolidElement &el, matrix &ke)
 {
+	EvalGeometricalStiffness(el, ke, false);
+}
+
+//-----------------------------------------------------------------------------
+//! calculates the upper triangular part of the element's geometrical stiffness
+void FEElasticSolidDomain::ElementGeometricalStiffnessUpper(FESolidElement &el, matrix &ke)
+{
+	EvalGeometricalStiffness(el, ke, true);
+}
+
+//-----------------------------------------------------------------------------
+//! calculates element's geometrical stiffness. If upper is true, only the
+//! upper triangular part of ke is evaluated.
+void FEElasticSolidDomain::EvalGeometricalStiffness(FESolidElement &el, matrix &ke, bool upper)
+{
+	// see if we have a specialized kernel for this element
+	FEElasticGeometricalStiffnessKernel kernel = { this, el, ke, upper };
+	if (FEDispatchSolidElementKernel(el.Type(), kernel)) return;
+
 	// spatial derivatives of shape functions
 	vec3d G[FEElement::MAX_NODES];
 
@@ -295,7 +340,7 @@ void FEElasticSolidDomain::ElementGeometricalStiffness(FESolidElement &el, matri
 	for (int n = 0; n<nint; ++n)
 	{
 		// calculate shape function gradients and jacobian
-		double w = ShapeGradient(el, n, G, m_alphaf)*gw[n]*m_alphaf;
+		double w = CachedShapeGradient(el, n, G, m_alphaf)*gw[n]*m_alphaf;
 
 		// get the material point data
 		FEMaterialPoint& mp = *el.GetMaterialPoint(n);
@@ -305,7 +350,7 @@ void FEElasticSolidDomain::ElementGeometricalStiffness(FESolidElement &el, matri
 		mat3ds& s = pt.m_s;
 
 		for (int i = 0; i<neln; ++i)
-			for (int j = 0; j<neln; ++j)
+			for (int j = (upper ? i : 0); j<neln; ++j)
 			{
 				double kab = (G[i]*(s * G[j]))*w;
 
@@ -321,6 +366,25 @@ void FEElasticSolidDomain::ElementGeometricalStiffness(FESolidElement &el, matri
 
 void FEElasticSolidDomain::ElementMaterialStiffness(FESolidElement &el, matrix &ke)
 {
+	EvalMaterialStiffness(el, ke, false);
+}
+
+//-----------------------------------------------------------------------------
+//! Calculates the upper triangular part of the element material stiffness
+void FEElasticSolidDomain::ElementMaterialStiffnessUpper(FESolidElement &el, matrix &ke)
+{
+	EvalMaterialStiffness(el, ke, true);
+}
+
+//-----------------------------------------------------------------------------
+//! Calculates element material stiffness element matrix. If upper is true, only
+//! the upper triangular part of ke is evaluated.
+void FEElasticSolidDomain::EvalMaterialStiffness(FESolidElement &el, matrix &ke, bool upper)
+{
+	// see if we have a specialized kernel for this element
+	FEElasticMaterialStiffnessKernel kernel = { this, el, ke, upper };
+	if (FEDispatchSolidElementKernel(el.Type(), kernel)) return;
+
 	// Get the current element's data
 	const int nint = el.GaussPoints();
 	const int neln = el.Nodes();
@@ -343,11 +407,15 @@ void FEElasticSolidDomain::ElementMaterialStiffness(FESolidElement &el, matrix &
 	// weights at gauss points
 	const double *gw = el.GaussWeights();
 
+	// evaluate the tangents of all integration points at once, if possible
+	FEElasticBatch batch;
+	bool bbatch = ElementTangentBatch(el, batch);
+
 	// calculate element stiffness matrix
 	for (int n=0; n<nint; ++n)
 	{
 		// calculate jacobian and shape function gradients
-		detJt = ShapeGradient(el, n, G, m_alphaf)*gw[n]*m_alphaf;
+		detJt = CachedShapeGradient(el, n, G, m_alphaf)*gw[n]*m_alphaf;
 
 		// setup the material point
 		// NOTE: deformation gradient and determinant have already been evaluated in the stress routine
@@ -355,19 +423,22 @@ void FEElasticSolidDomain::ElementMaterialStiffness(FESolidElement &el, matrix &
 
 		// get the 'D' matrix
 //		tens4ds C = m_pMat->Tangent(mp);
-        tens4dmm C = (m_secant_tangent ? m_pMat->SecantTangent(mp) : m_pMat->SolidTangent(mp));
-		C.extract(D);
+		if (bbatch) batch.Tangent(n).extract(D);
+		else
+		{
+			tens4dmm C = (m_secant_tangent ? m_pMat->SecantTangent(mp) : m_pMat->SolidTangent(mp));
+			C.extract(D);
+		}
 
-		// we only calculate the upper triangular part
-		// since ke is symmetric. The other part is
-		// determined below using this symmetry.
+		// when upper is set, we only calculate the upper triangular 
+		// part since ke is symmetric
 		for (int i=0, i3=0; i<neln; ++i, i3 += 3)
 		{
 			Gxi = G[i].x;
 			Gyi = G[i].y;
 			Gzi = G[i].z;
 
-			for (int j=0, j3 = 0; j<neln; ++j, j3 += 3)
+			for (int j=(upper ? i : 0), j3 = 3*j; j<neln; ++j, j3 += 3)
 			{
 				Gxj = G[j].x;
 				Gyj = G[j].y;
@@ -414,11 +485,87 @@ void FEElasticSolidDomain::ElementMaterialStiffness(FESolidElement &el, matrix &
 	}
 }
 
+//-----------------------------------------------------------------------------
+//! Internal force for element types with a compile-time number of nodes and integration points
+template <FE_Element_Type ET> void FEElasticSolidDomain::ElementInternalForce(FESolidElement& el, vector<double>& fe)
+{
+	const int NELN = FESolidElementKernel<ET>::NELN;
+	const int NINT = FESolidElementKernel<ET>::NINT;
+	assert((el.Nodes() == NELN) && (el.GaussPoints() == NINT));
+
+	vec3d G[NELN];
+	const double* gw = el.GaussWeights();
+	const double alpha = (m_update_dynamic ? m_alphaf : 1.0);
+	for (int n = 0; n < NINT; ++n)
+	{
+		FEMaterialPoint& mp = *el.GetMaterialPoint(n);
+		FEElasticMaterialPoint& pt = *(mp.ExtractData<FEElasticMaterialPoint>());
+
+		double w = CachedShapeGradient(el, n, G, alpha)*gw[n];
+
+		FESolidKernel::InternalForce<NELN>(G, pt.m_s, w, &fe[0]);
+	}
+}
+
+//-----------------------------------------------------------------------------
+//! Geometrical stiffness for element types with a compile-time number of nodes and integration points
+template <FE_Element_Type ET> void FEElasticSolidDomain::ElementGeometricalStiffness(FESolidElement& el, matrix& ke, bool upper)
+{
+	const int NELN = FESolidElementKernel<ET>::NELN;
+	const int NINT = FESolidElementKernel<ET>::NINT;
+	assert((el.Nodes() == NELN) && (el.GaussPoints() == NINT));
+
+	vec3d G[NELN];
+	const double* gw = el.GaussWeights();
+	for (int n = 0; n < NINT; ++n)
+	{
+		double w = CachedShapeGradient(el, n, G, m_alphaf)*gw[n] * m_alphaf;
+
+		FEMaterialPoint& mp = *el.GetMaterialPoint(n);
+		FEElasticMaterialPoint& pt = *(mp.ExtractData<FEElasticMaterialPoint>());
+
+		FESolidKernel::GeometricalStiffness<NELN>(G, pt.m_s, w, ke, upper);
+	}
+}
+
+//-----------------------------------------------------------------------------
+//! Material stiffness for element types with a compile-time number of nodes and integration points
+template <FE_Element_Type ET> void FEElasticSolidDomain::ElementMaterialStiffness(FESolidElement& el, matrix& ke, bool upper)
+{
+	const int NELN = FESolidElementKernel<ET>::NELN;
+	const int NINT = FESolidElementKernel<ET>::NINT;
+	assert((el.Nodes() == NELN) && (el.GaussPoints() == NINT));
+
+	FEElasticBatch batch;
+	bool bbatch = ElementTangentBatch(el, batch);
+
+	vec3d G[NELN];
+	double D[6][6];
+	const double* gw = el.GaussWeights();
+	for (int n = 0; n < NINT; ++n)
+	{
+		double w = CachedShapeGradient(el, n, G, m_alphaf)*gw[n] * m_alphaf;
+
+		if (bbatch) batch.Tangent(n).extract(D);
+		else
+		{
+			FEMaterialPoint& mp = *el.GetMaterialPoint(n);
+			tens4dmm C = (m_secant_tangent ? m_pMat->SecantTangent(mp) : m_pMat->SolidTangent(mp));
+			C.extract(D);
+		}
+
+		FESolidKernel::MaterialStiffness<NELN>(G, D, w, ke, upper);
+	}
+}
+
 //-----------------------------------------------------------------------------
 void FEElasticSolidDomain::StiffnessMatrix(FELinearSystem& LS)
 {
 	// repeat over all solid elements
 	int NE = Elements();
+
+	// for symmetric systems, we only need the upper triangular part of the element matrices
+	const bool upper = LS.IsSymmetric();
 	
 	#pragma omp parallel for shared (NE)
 	for (int iel=0; iel<NE; ++iel)
@@ -428,30 +575,30 @@ void FEElasticSolidDomain::StiffnessMatrix(FELinearSystem& LS)
 		if (el.isActive()) {
 
 			// get the element's LM vector
-			vector<int> lm;
+			FEScopedWorkspace ws;
+			vector<int>& lm = ws->lm;
 			UnpackLM(el, lm);
 
 			// element stiffness matrix
-			FEElementMatrix ke(el, lm);
-
-			// create the element's stiffness matrix
 			int ndof = 3 * el.Nodes();
-			ke.resize(ndof, ndof);
-			ke.zero();
-
-			// calculate geometrical stiffness
-			ElementGeometricalStiffness(el, ke);
-
-			// calculate material stiffness
-			ElementMaterialStiffness(el, ke);
-
-/*			// assign symmetic parts
-			// TODO: Can this be omitted by changing the Assemble routine so that it only
-			// grabs elements from the upper diagonal matrix?
-			for (int i = 0; i < ndof; ++i)
-				for (int j = i + 1; j < ndof; ++j)
-					ke[j][i] = ke[i][j];
-*/
+			FEElementMatrix& ke = ws->ElementMatrix(el, lm, ndof, ndof);
+
+			if (upper)
+			{
+				// calculate geometrical and material stiffness (upper triangular part only)
+				ElementGeometricalStiffnessUpper(el, ke);
+				ElementMaterialStiffnessUpper(el, ke);
+			}
+			else
+			{
+				// calculate geometrical stiffness
+				ElementGeometricalStiffness(el, ke);
+
+				// calculate material stiffness
+				ElementMaterialStiffness(el, ke);
+			}
+			ke.SetUpperTriangular(upper);
+
 			// assemble element matrix in global stiffness matrix
 			LS.Assemble(ke);
 		}
@@ -545,6 +692,9 @@ void FEElasticSolidDomain::ElementStiffness(const FETimeInfo& tp, int iel, matri
 //-----------------------------------------------------------------------------
 void FEElasticSolidDomain::Update(const FETimeInfo& tp)
 {
+	// update the shape gradients used by the element loops
+	UpdateKinematicsCache(m_alphaf);
+
 	bool berr = false;
 	int NE = Elements();
 	#pragma omp parallel for shared(NE, berr)
@@ -604,6 +754,12 @@ void FEElasticSolidDomain::UpdateElementStress(int iel, const FETimeInfo& tp)
 		}
 	}
 
+	// see if we can evaluate the stresses of all integration points at once
+	FEElasticMaterial* pbatch = (m_secant_stress ? nullptr : BatchMaterial(false));
+	FEElasticBatch batch;
+	mat3d Ftn[FEElement::MAX_INTPOINTS];
+	double Jtn[FEElement::MAX_INTPOINTS];
+
 	// loop over the integration points and calculate
 	// the stress at the integration point
 	for (int n=0; n<nint; ++n)
@@ -641,31 +797,86 @@ void FEElasticSolidDomain::UpdateElementStress(int iel, const FETimeInfo& tp)
 
         // update specialized material points
         m_pMat->UpdateSpecializedMaterialPoints(mp, tp);
+
+		// the batch stress is evaluated after all points are updated
+		if (pbatch)
+		{
+			batch.Add(mp);
+			Ftn[n] = Ft;
+			Jtn[n] = Jt;
+			continue;
+		}
         
 		// calculate the stress at this material point
 //		pt.m_s = m_pMat->Stress(mp);
 		pt.m_s = (m_secant_stress ? m_pMat->SecantStress(mp) : m_pMat->Stress(mp));
         
         // adjust stress for strain energy conservation
-        if (m_alphaf == 0.5) 
+        if (m_alphaf == 0.5) ConserveStrainEnergy(mp, Ft, Jt, dt);
+    }
+
+	if (pbatch)
+	{
+		pbatch->StressBatch(batch);
+		for (int n = 0; n < nint; ++n)
 		{
-			FEElasticMaterial* pme = dynamic_cast<FEElasticMaterial*>(m_pMat);
+			FEMaterialPoint& mp = *el.GetMaterialPoint(n);
+			FEElasticMaterialPoint& pt = *(mp.ExtractData<FEElasticMaterialPoint>());
+			pt.m_s = batch.Stress(n);
 
-			// evaluate strain energy at current time
-			mat3d Ftmp = pt.m_F;
-			double Jtmp = pt.m_J;
-			pt.m_F = Ft;
-			pt.m_J = Jt;
-			pt.m_Wt = pme->StrainEnergyDensity(mp);
-			pt.m_F = Ftmp;
-			pt.m_J = Jtmp;
-
-            mat3ds D = pt.RateOfDeformation();
-            double D2 = D.dotdot(D);
-            if (D2 > 0)
-                pt.m_s += D*(((pt.m_Wt-pt.m_Wp)/(dt*pt.m_J) - pt.m_s.dotdot(D))/D2);
-        }
-    }
+			if (m_alphaf == 0.5) ConserveStrainEnergy(mp, Ftn[n], Jtn[n], dt);
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+//! adjust stress for strain energy conservation
+void FEElasticSolidDomain::ConserveStrainEnergy(FEMaterialPoint& mp, const mat3d& Ft, double Jt, double dt)
+{
+	FEElasticMaterialPoint& pt = *(mp.ExtractData<FEElasticMaterialPoint>());
+	FEElasticMaterial* pme = dynamic_cast<FEElasticMaterial*>(m_pMat);
+
+	// evaluate strain energy at current time
+	mat3d Ftmp = pt.m_F;
+	double Jtmp = pt.m_J;
+	pt.m_F = Ft;
+	pt.m_J = Jt;
+	pt.m_Wt = pme->StrainEnergyDensity(mp);
+	pt.m_F = Ftmp;
+	pt.m_J = Jtmp;
+
+	mat3ds D = pt.RateOfDeformation();
+	double D2 = D.dotdot(D);
+	if (D2 > 0)
+		pt.m_s += D*(((pt.m_Wt-pt.m_Wp)/(dt*pt.m_J) - pt.m_s.dotdot(D))/D2);
+}
+
+//-----------------------------------------------------------------------------
+//! Materials can provide a vectorized implementation that evaluates the stress
+//! or tangent for all the integration points of an element at once. This is only
+//! used when the domain (or material) does not request a secant approximation.
+FEElasticMaterial* FEElasticSolidDomain::BatchMaterial(bool tangent)
+{
+	FEElasticMaterial* pme = dynamic_cast<FEElasticMaterial*>(m_pMat);
+	if ((pme == nullptr) || (pme->HasBatchEvaluation() == false)) return nullptr;
+	if (tangent && (m_secant_tangent || pme->UseSecantTangent())) return nullptr;
+	return pme;
+}
+
+//-----------------------------------------------------------------------------
+//! Evaluates the tangent at all integration points of the element. Returns false
+//! if the material does not support batch evaluation, in which case the caller 
+//! should evaluate the tangent point by point.
+bool FEElasticSolidDomain::ElementTangentBatch(FESolidElement& el, FEElasticBatch& batch)
+{
+	FEElasticMaterial* pme = BatchMaterial(true);
+	if (pme == nullptr) return false;
+
+	batch.Clear();
+	int nint = el.GaussPoints();
+	for (int n = 0; n < nint; ++n) batch.Add(*el.GetMaterialPoint(n));
+	pme->TangentBatch(batch);
+	return true;
 }
 
 //-----------------------------------------------------------------------------
@@ -677,7 +888,7 @@ void FEElasticSolidDomain::UnpackLM(FEElement& el, vector<int>& lm)
 	for (int i=0; i<N; ++i)
 	{
 		FENode& node = m_pMesh->Node(el.m_node[i]);
-		vector<int>& id = node.m_ID;
+		FENodeDofArray<int>& id = node.m_ID;
 
 		// first the displacement dofs
 		lm[3*i  ] = id[m_dofU[0]];
@@ -696,7 +907,7 @@ void FEElasticSolidDomain::UnpackLM(FEElement& el, vector<int>& lm)
     {
         if (sel.m_bitfc[i]) {
             FENode& node = m_pMesh->Node(el.m_node[i]);
-            vector<int>& id = node.m_ID;
+            FENodeDofArray<int>& id = node.m_ID;
             
             // first the displacement dofs
             lm[3*i  ] = id[m_dofSU[0]];
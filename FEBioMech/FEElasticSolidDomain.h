@@ -30,8 +30,11 @@ SOFTWARE.*/
 #include <FECore/FESolidDomain.h>
 #include "FEElasticDomain.h"
 #include "FESolidMaterial.h"
+#include "FEElasticBatch.h"
 #include <FECore/FEDofList.h>
 
+class FEElasticMaterial;
+
 //-----------------------------------------------------------------------------
 //! domain described by Lagrange-type 3D volumetric elements
 //!
@@ -108,6 +111,13 @@ public:
 	//! material stiffness component
 	virtual void ElementMaterialStiffness(FESolidElement& el, matrix& ke);
 
+	//! geometrical and material stiffness, where only the upper triangular part of ke
+	//! needs to be evaluated. StiffnessMatrix calls these for symmetric systems. Derived 
+	//! classes that override the functions above must override these as well (evaluating
+	//! the full matrix is fine, since only the upper triangular part is assembled).
+	virtual void ElementGeometricalStiffnessUpper(FESolidElement& el, matrix& ke);
+	virtual void ElementMaterialStiffnessUpper(FESolidElement& el, matrix& ke);
+
 	// --- R E S I D U A L ---
 
 	//! Calculates the internal stress vector for solid elements
@@ -115,6 +125,28 @@ public:
 
     //! Calculates the inertial force vector for solid elements
     void ElementInertialForce(FESolidElement& el, vector<double>& fe);
+
+public:
+	// --- specialized element kernels (see FESolidElementKernels.h) ---
+	template <FE_Element_Type ET> void ElementMaterialStiffness(FESolidElement& el, matrix& ke, bool upper);
+	template <FE_Element_Type ET> void ElementGeometricalStiffness(FESolidElement& el, matrix& ke, bool upper);
+	template <FE_Element_Type ET> void ElementInternalForce(FESolidElement& el, vector<double>& fe);
+
+private:
+	// implementation of the element stiffness functions above
+	void EvalGeometricalStiffness(FESolidElement& el, matrix& ke, bool upper);
+	void EvalMaterialStiffness(FESolidElement& el, matrix& ke, bool upper);
+
+protected:
+	//! returns the material if its batch evaluation can be used, or null otherwise
+	FEElasticMaterial* BatchMaterial(bool tangent);
+
+private:
+	//! evaluate the spatial tangent at all integration points of an element
+	bool ElementTangentBatch(FESolidElement& el, FEElasticBatch& batch);
+
+	//! adjust stress for strain energy conservation (used when alpha = 0.5)
+	void ConserveStrainEnergy(FEMaterialPoint& mp, const mat3d& Ft, double Jt, double dt);
     
 protected:
     double              m_alphaf;
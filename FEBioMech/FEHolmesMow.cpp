@@ -130,3 +130,77 @@ double FEHolmesMow::StrainEnergyDensity(FEMaterialPoint& mp)
 	
 	return sed;
 }
+
+//-----------------------------------------------------------------------------
+void FEHolmesMow::StressBatch(FEElasticBatch& batch)
+{
+	const int N = batch.Points();
+
+	#pragma omp simd
+	for (int i = 0; i < N; ++i)
+	{
+		double F[9], b[6], b2[6];
+		FEBatchTensor::LoadF(batch.m_F, i, F);
+		FEBatchTensor::LeftCauchyGreen(F, b);
+		FEBatchTensor::Sqr(b, b2);
+
+		double detFi = 1.0 / batch.m_J[i];
+
+		// calculate invariants of B
+		double I1 = FEBatchTensor::Trace(b);
+		double I2 = (I1*I1 - FEBatchTensor::Trace(b2))/2.;
+		double I3 = FEBatchTensor::Det(b);
+
+		// Exponential term
+		double eQ = exp(m_b*((2*mu-lam)*(I1-3) + lam*(I2-3))/Ha)/pow(I3,m_b);
+
+		// calculate stress
+		double a = 0.5*detFi*eQ;
+		double c1 = a*(2*mu + lam*(I1-1));
+		for (int k = 0; k < 6; ++k) batch.m_s[k][i] = c1*b[k] - a*lam*b2[k];
+		batch.m_s[0][i] -= a*Ha;
+		batch.m_s[2][i] -= a*Ha;
+		batch.m_s[5][i] -= a*Ha;
+	}
+}
+
+//-----------------------------------------------------------------------------
+void FEHolmesMow::TangentBatch(FEElasticBatch& batch)
+{
+	const int N = batch.Points();
+
+	#pragma omp simd
+	for (int i = 0; i < N; ++i)
+	{
+		double F[9], b[6], b2[6];
+		FEBatchTensor::LoadF(batch.m_F, i, F);
+		FEBatchTensor::LeftCauchyGreen(F, b);
+		FEBatchTensor::Sqr(b, b2);
+
+		double detF = batch.m_J[i];
+		double detFi = 1.0 / detF;
+
+		// calculate invariants of B
+		double I1 = FEBatchTensor::Trace(b);
+		double I2 = (I1*I1 - FEBatchTensor::Trace(b2))*0.5;
+		double I3 = FEBatchTensor::Det(b);
+
+		// Exponential term
+		double eQ = exp(m_b*((2*mu-lam)*(I1-3) + lam*(I2-3))/Ha)/pow(I3,m_b);
+
+		// calculate stress
+		double s[6];
+		double a = 0.5*detFi*eQ;
+		double c1 = a*(2*mu + lam*(I1-1));
+		for (int k = 0; k < 6; ++k) s[k] = c1*b[k] - a*lam*b2[k];
+		s[0] -= a*Ha; s[2] -= a*Ha; s[5] -= a*Ha;
+
+		// calculate elasticity tensor
+		double c[21] = { 0 };
+		FEBatchTensor::Dyad1s(c, s, 4.*m_b/Ha*detF/eQ);
+		FEBatchTensor::Dyad1s(c, b, detFi*eQ*lam);
+		FEBatchTensor::Dyad4s(c, b, -detFi*eQ*lam);
+		FEBatchTensor::IdentityDyad4s(c, detFi*eQ*Ha);
+		for (int k = 0; k < 21; ++k) batch.m_c[k][i] = c[k];
+	}
+}
@@ -50,6 +50,15 @@ public:
 	//! calculate tangent stiffness at material point
 	virtual tens4ds Tangent(FEMaterialPoint& pt) override;
 		
+	//! this material has a vectorized batch implementation
+	bool HasBatchEvaluation() const override { return true; }
+
+	//! calculate stress at all points of a batch
+	void StressBatch(FEElasticBatch& batch) override;
+
+	//! calculate tangent at all points of a batch
+	void TangentBatch(FEElasticBatch& batch) override;
+
 	//! calculate strain energy density at material point
 	virtual double StrainEnergyDensity(FEMaterialPoint& pt) override;
     
@@ -146,3 +146,70 @@ tens4dmm FEIsotropicElastic::MaterialTangent(FEMaterialPoint& pt, const mat3ds E
     
     return c;
 }
+
+//-----------------------------------------------------------------------------
+void FEIsotropicElastic::StressBatch(FEElasticBatch& batch)
+{
+	const int N = batch.Points();
+
+	// lame parameters
+	double lam[FEElasticBatch::MAX_POINTS], mu[FEElasticBatch::MAX_POINTS];
+	for (int i = 0; i < N; ++i)
+	{
+		FEMaterialPoint& mp = batch.MaterialPoint(i);
+		double E = m_E(mp);
+		double v = m_v(mp);
+		lam[i] = v*E/((1+v)*(1-2*v));
+		mu [i] = 0.5*E/(1+v);
+	}
+
+	#pragma omp simd
+	for (int i = 0; i < N; ++i)
+	{
+		double F[9], b[6], b2[6];
+		FEBatchTensor::LoadF(batch.m_F, i, F);
+		FEBatchTensor::LeftCauchyGreen(F, b);
+		FEBatchTensor::Sqr(b, b2);
+
+		double Ji = 1.0 / batch.m_J[i];
+		double trE = 0.5*(FEBatchTensor::Trace(b) - 3);
+
+		// s = b*(lam*trE - mu) + b2*mu
+		double a1 = Ji*(lam[i]*trE - mu[i]);
+		double a2 = Ji*mu[i];
+		for (int k = 0; k < 6; ++k) batch.m_s[k][i] = a1*b[k] + a2*b2[k];
+	}
+}
+
+//-----------------------------------------------------------------------------
+void FEIsotropicElastic::TangentBatch(FEElasticBatch& batch)
+{
+	const int N = batch.Points();
+
+	// lame parameters
+	double lam[FEElasticBatch::MAX_POINTS], mu[FEElasticBatch::MAX_POINTS];
+	for (int i = 0; i < N; ++i)
+	{
+		FEMaterialPoint& mp = batch.MaterialPoint(i);
+		double E = m_E(mp);
+		double v = m_v(mp);
+		lam[i] = v*E/((1+v)*(1-2*v));
+		mu [i] = 0.5*E/(1+v);
+	}
+
+	#pragma omp simd
+	for (int i = 0; i < N; ++i)
+	{
+		double F[9], b[6];
+		FEBatchTensor::LoadF(batch.m_F, i, F);
+		FEBatchTensor::LeftCauchyGreen(F, b);
+
+		double Ji = 1.0 / batch.m_J[i];
+
+		// c = dyad1s(b)*lam + dyad4s(b)*(2*mu)
+		double c[21] = { 0 };
+		FEBatchTensor::Dyad1s(c, b, Ji*lam[i]);
+		FEBatchTensor::Dyad4s(c, b, 2.0*Ji*mu[i]);
+		for (int k = 0; k < 21; ++k) batch.m_c[k][i] = c[k];
+	}
+}
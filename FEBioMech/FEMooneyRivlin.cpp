@@ -163,3 +163,112 @@ double FEMooneyRivlin::DevStrainEnergyDensity(FEMaterialPoint& mp)
     
     return sed;
 }
+
+//-----------------------------------------------------------------------------
+//! Calculate the deviatoric stress at all points of a batch
+void FEMooneyRivlin::DevStressBatch(FEElasticBatch& batch)
+{
+	const int N = batch.Points();
+
+	// get material parameters
+	double c1[FEElasticBatch::MAX_POINTS], c2[FEElasticBatch::MAX_POINTS];
+	for (int i = 0; i < N; ++i)
+	{
+		FEMaterialPoint& mp = batch.MaterialPoint(i);
+		c1[i] = m_c1(mp);
+		c2[i] = m_c2(mp);
+	}
+
+	#pragma omp simd
+	for (int i = 0; i < N; ++i)
+	{
+		double J = batch.m_J[i];
+		double Jm23 = pow(J, -2.0/3.0);
+
+		// calculate deviatoric left Cauchy-Green tensor and its square
+		double F[9], B[6], B2[6];
+		FEBatchTensor::LoadF(batch.m_F, i, F);
+		FEBatchTensor::LeftCauchyGreen(F, B);
+		for (int k = 0; k < 6; ++k) B[k] *= Jm23;
+		FEBatchTensor::Sqr(B, B2);
+
+		double I1 = FEBatchTensor::Trace(B);
+		double W1 = c1[i];
+		double W2 = c2[i];
+
+		// T = B*(W1 + W2*I1) - B2*W2
+		double T[6];
+		for (int k = 0; k < 6; ++k) T[k] = B[k]*(W1 + W2*I1) - B2[k]*W2;
+		FEBatchTensor::Dev(T);
+
+		for (int k = 0; k < 6; ++k) batch.m_s[k][i] = T[k]*(2.0/J);
+	}
+}
+
+//-----------------------------------------------------------------------------
+//! Calculate the deviatoric tangent at all points of a batch
+void FEMooneyRivlin::DevTangentBatch(FEElasticBatch& batch)
+{
+	const int N = batch.Points();
+
+	// get material parameters
+	double c1[FEElasticBatch::MAX_POINTS], c2[FEElasticBatch::MAX_POINTS];
+	for (int i = 0; i < N; ++i)
+	{
+		FEMaterialPoint& mp = batch.MaterialPoint(i);
+		c1[i] = m_c1(mp);
+		c2[i] = m_c2(mp);
+	}
+
+	// identity tensor
+	const double I[6] = { 1, 0, 1, 0, 0, 1 };
+
+	#pragma omp simd
+	for (int i = 0; i < N; ++i)
+	{
+		double J = batch.m_J[i];
+		double Ji = 1.0/J;
+		double Jm23 = pow(J, -2.0/3.0);
+
+		// calculate deviatoric left Cauchy-Green tensor and its square
+		double F[9], B[6], B2[6];
+		FEBatchTensor::LoadF(batch.m_F, i, F);
+		FEBatchTensor::LeftCauchyGreen(F, B);
+		for (int k = 0; k < 6; ++k) B[k] *= Jm23;
+		FEBatchTensor::Sqr(B, B2);
+
+		// Invariants of B (= invariants of C)
+		double I1 = FEBatchTensor::Trace(B);
+		double I2 = 0.5*(I1*I1 - FEBatchTensor::Trace(B2));
+
+		double W1 = c1[i];
+		double W2 = c2[i];
+
+		// calculate dWdC:C
+		double WC = W1*I1 + 2*W2*I2;
+
+		// calculate C:d2WdCdC:C
+		double CWWC = 2*I2*W2;
+
+		// deviatoric cauchy-stress and d2W/dCdC:C
+		double devs[6], WCCxC[6];
+		for (int k = 0; k < 6; ++k)
+		{
+			devs[k] = B[k]*(W1 + W2*I1) - B2[k]*W2;
+			WCCxC[k] = B[k]*(W2*I1) - B2[k]*W2;
+		}
+		FEBatchTensor::Dev(devs);
+		for (int k = 0; k < 6; ++k) devs[k] *= 2.0/J;
+
+		// c = (BxB - B4)*(W2*4/J) - dyad1s(WCCxC, I)*(4/(3J)) + IxI*(4/(9J)*CWWC)
+		//   + dyad1s(devs, I)*(-2/3) + (I4 - IxI/3)*(4/(3J)*WC)
+		double c[21] = { 0 };
+		FEBatchTensor::Dyad1s(c, B, W2*4.0*Ji);
+		FEBatchTensor::Dyad4s(c, B, -W2*4.0*Ji);
+		FEBatchTensor::Dyad1s(c, WCCxC, I, -4.0/3.0*Ji);
+		FEBatchTensor::Dyad1s(c, devs, I, -2.0/3.0);
+		FEBatchTensor::IdentityDyad1s(c, 4.0/9.0*Ji*CWWC - 4.0/9.0*Ji*WC);
+		FEBatchTensor::IdentityDyad4s(c, 4.0/3.0*Ji*WC);
+		for (int k = 0; k < 21; ++k) batch.m_c[k][i] = c[k];
+	}
+}
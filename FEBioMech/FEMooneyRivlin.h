@@ -51,6 +51,15 @@ public:
 
 	//! calculate deviatoric strain energy density
 	double DevStrainEnergyDensity(FEMaterialPoint& mp) override;
+
+	//! this material has a vectorized batch implementation
+	bool HasBatchEvaluation() const override { return true; }
+
+	//! deviatoric stress at all points of a batch
+	void DevStressBatch(FEElasticBatch& batch) override;
+
+	//! deviatoric tangent at all points of a batch
+	void DevTangentBatch(FEElasticBatch& batch) override;
     
 	// declare the parameter list
 	DECLARE_FECORE_CLASS();
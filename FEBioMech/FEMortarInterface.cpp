@@ -31,12 +31,46 @@ SOFTWARE.*/
 #include "FECore/mortar.h"
 #include "FECore/log.h"
 #include <FECore/FEMesh.h>
+#include <FECore/FEGlobalMatrix.h>
+#include <algorithm>
+
+//-----------------------------------------------------------------------------
+void FEMortarWeights::Add(int A, int B, double w)
+{
+	std::vector<ENTRY>& row = m_row[A];
+	for (ENTRY& e : row)
+	{
+		if (e.node == B) { e.val += w; return; }
+	}
+	ENTRY e = { B, w };
+	row.push_back(e);
+}
+
+//-----------------------------------------------------------------------------
+void FEMortarWeights::Sort()
+{
+	for (std::vector<ENTRY>& row : m_row)
+	{
+		std::sort(row.begin(), row.end(), [](const ENTRY& a, const ENTRY& b) { return a.node < b.node; });
+	}
+}
+
+//-----------------------------------------------------------------------------
+double FEMortarWeights::Sum() const
+{
+	double sum = 0.0;
+	for (const std::vector<ENTRY>& row : m_row)
+		for (const ENTRY& e : row) sum += e.val;
+	return sum;
+}
 
 //-----------------------------------------------------------------------------
 FEMortarInterface::FEMortarInterface(FEModel* pfem) : FEContactInterface(pfem)
 {
 	// set the integration rule
 	m_pT = dynamic_cast<FESurfaceElementTraits*>(FEElementLibrary::GetElementTraits(FE_TRI3G7));
+
+	m_srad = -1.0;	// test all facet pairs
 }
 
 //-----------------------------------------------------------------------------
@@ -45,12 +79,8 @@ void FEMortarInterface::UpdateMortarWeights(FESurface& ss, FESurface& ms)
 	// allocate sturcture for the integration weights
 	int NS = ss.Nodes();
 	int NM = ms.Nodes();
-	m_n1.resize(NS,NS);
-	m_n2.resize(NS,NM);
-
-	// clear weights
-	m_n1.zero();
-	m_n2.zero();
+	m_n1.Clear(NS);
+	m_n2.Clear(NS);
 
 	// number of integration points
 	const int MAX_INT = 11;
@@ -60,17 +90,25 @@ void FEMortarInterface::UpdateMortarWeights(FESurface& ss, FESurface& ms)
 	vector<double>& gs = m_pT->gs;
 
 	// calculate the mortar surface
+	// (if a search radius is set, only facet pairs within the search radius are intersected)
+	double R = (m_srad == 0.0 ? MortarSearchRadius(ss, ms) : m_srad);
 	MortarSurface mortar;
-	CalculateMortarSurface(ss, ms, mortar);
+	CalculateMortarSurface(ss, ms, mortar, R);
 
-	// These arrays will store the shape function values of the projection points 
-	// on the primary and secondary side when evaluating the integral over a pallet
-	double Ns[MAX_INT][4], Nm[MAX_INT][4];
+	// The contributions of each patch are evaluated in parallel and 
+	// then added to the weights in patch order.
+	struct WEIGHT { int a, b; double w; };
+	int NP = mortar.Patches();
+	vector< vector<WEIGHT> > w1(NP), w2(NP);
 
 	// loop over the mortar patches
-	int NP = mortar.Patches();
+#pragma omp parallel for schedule(dynamic, 16)
 	for (int i=0; i<NP; ++i)
 	{
+		// These arrays will store the shape function values of the projection points 
+		// on the primary and secondary side when evaluating the integral over a pallet
+		double Ns[MAX_INT][4], Nm[MAX_INT][4];
+
 		// get the next patch
 		Patch& pi = mortar.GetPatch(i);
 
@@ -134,7 +172,8 @@ void FEMortarInterface::UpdateMortarWeights(FESurface& ss, FESurface& ms)
 						n1 *= Area;
 
 						int b = se.m_lnode[B];
-						m_n1[a][b] += n1;
+						WEIGHT wab = { a, b, n1 };
+						w1[i].push_back(wab);
 					}
 
 					// loop over all the nodes on the secondary facet
@@ -148,23 +187,28 @@ void FEMortarInterface::UpdateMortarWeights(FESurface& ss, FESurface& ms)
 						n2 *= Area;
 
 						int c = me.m_lnode[C];
-						m_n2[a][c] += n2;
+						WEIGHT wac = { a, c, n2 };
+						w2[i].push_back(wac);
 					}
 				}
 			}		
 		}
 	}
 
+	// add it all up
+	for (int i=0; i<NP; ++i)
+	{
+		for (WEIGHT& w : w1[i]) m_n1.Add(w.a, w.b, w.w);
+		for (WEIGHT& w : w2[i]) m_n2.Add(w.a, w.b, w.w);
+	}
+	m_n1.Sort();
+	m_n2.Sort();
+
 #ifndef NDEBUG
 	// Sanity check: sum should add up to contact area
 	// This is for a hardcoded problem. Remove or generalize this!
-	double sum1 = 0.0;
-	for (int A=0; A<NS; ++A)
-		for (int B=0; B<NS; ++B) sum1 += m_n1[A][B];
-
-	double sum2 = 0.0;
-	for (int A=0; A<NS; ++A)
-		for (int C=0; C<NM; ++C) sum2 += m_n2[A][C];
+	double sum1 = m_n1.Sum();
+	double sum2 = m_n2.Sum();
 
 	if (fabs(sum1 - 1.0) > 1e-5) feLog("WARNING: Mortar weights are not correct (%lg).\n", sum1);
 	if (fabs(sum2 - 1.0) > 1e-5) feLog("WARNING: Mortar weights are not correct (%lg).\n", sum2);
@@ -186,21 +230,94 @@ void FEMortarInterface::UpdateNodalGaps(FEMortarContactSurface& ss, FEMortarCont
 	for (int A=0; A<NS; ++A)
 	{
 		// loop over all primary nodes
-		for (int B=0; B<NS; ++B)
+		for (const FEMortarWeights::ENTRY& e : m_n1.Row(A))
 		{
-			FENode& nodeB = ss.Node(B);
+			FENode& nodeB = ss.Node(e.node);
 			vec3d& xB = nodeB.m_rt;
-			double nAB = m_n1[A][B];
+			double nAB = e.val;
 			gap[A] += xB*nAB;
 		}
 
 		// loop over secondary side
-		for (int C=0; C<NM; ++C)
+		for (const FEMortarWeights::ENTRY& e : m_n2.Row(A))
 		{
-			FENode& nodeC = ms.Node(C);
+			FENode& nodeC = ms.Node(e.node);
 			vec3d& xC = nodeC.m_rt;
-			double nAC = m_n2[A][C];
+			double nAC = e.val;
 			gap[A] -= xC*nAC;
 		}
 	}
 }
+
+//-----------------------------------------------------------------------------
+//! Add the nodes that are coupled through the mortar weights to the matrix profile.
+//! Each primary node A couples all the nodes in its rows of the mortar weights, and
+//! the nodes of its adjacent primary facets (through the normals).
+void FEMortarInterface::BuildMortarProfile(FEGlobalMatrix& K, FESurface& ss, FESurface& ms)
+{
+	int NS = ss.Nodes();
+	int NM = ms.Nodes();
+
+	// If the weights were not calculated yet, we assume that 
+	// each node on the primary side is connected to the secondary side
+	if (m_n1.Rows() != NS)
+	{
+		vector<int> LM(3*(NS+NM));
+		for (int i=0; i<NS; ++i)
+		{
+			FENode& ni = ss.Node(i);
+			LM[3*i  ] = ni.m_ID[0];
+			LM[3*i+1] = ni.m_ID[1];
+			LM[3*i+2] = ni.m_ID[2];
+		}
+		for (int i=0; i<NM; ++i)
+		{
+			FENode& ni = ms.Node(i);
+			LM[3*NS + 3*i  ] = ni.m_ID[0];
+			LM[3*NS + 3*i+1] = ni.m_ID[1];
+			LM[3*NS + 3*i+2] = ni.m_ID[2];
+		}
+		K.build_add(LM);
+		return;
+	}
+
+	// find the neighbors of the primary nodes on the primary facets
+	vector< vector<int> > nbr(NS);
+	for (int i=0; i<ss.Elements(); ++i)
+	{
+		FESurfaceElement& f = ss.Element(i);
+		int nn = f.Nodes();
+		for (int j=0; j<nn; ++j)
+		{
+			vector<int>& nj = nbr[f.m_lnode[j]];
+			nj.push_back(f.m_lnode[(j+1)%nn]);
+			nj.push_back(f.m_lnode[(j+nn-1)%nn]);
+		}
+	}
+
+	vector<int> LM;
+	for (int A=0; A<NS; ++A)
+	{
+		const vector<FEMortarWeights::ENTRY>& r1 = m_n1.Row(A);
+		const vector<FEMortarWeights::ENTRY>& r2 = m_n2.Row(A);
+		if (r1.empty() && r2.empty()) continue;
+
+		LM.clear();
+		for (const FEMortarWeights::ENTRY& e : r1)
+		{
+			FENode& n = ss.Node(e.node);
+			LM.push_back(n.m_ID[0]); LM.push_back(n.m_ID[1]); LM.push_back(n.m_ID[2]);
+		}
+		for (const FEMortarWeights::ENTRY& e : r2)
+		{
+			FENode& n = ms.Node(e.node);
+			LM.push_back(n.m_ID[0]); LM.push_back(n.m_ID[1]); LM.push_back(n.m_ID[2]);
+		}
+		for (int B : nbr[A])
+		{
+			FENode& n = ss.Node(B);
+			LM.push_back(n.m_ID[0]); LM.push_back(n.m_ID[1]); LM.push_back(n.m_ID[2]);
+		}
+		K.build_add(LM);
+	}
+}
@@ -30,6 +30,42 @@ SOFTWARE.*/
 #include "FEContactInterface.h"
 #include "FEMortarContactSurface.h"
 
+//-----------------------------------------------------------------------------
+// Sparse storage of mortar integration weights. There is a row for each node
+// of the primary surface, which stores the nonzero weights of that row,
+// sorted by node index.
+class FEMortarWeights
+{
+public:
+	struct ENTRY
+	{
+		int		node;	//!< local node index
+		double	val;	//!< integration weight
+	};
+
+public:
+	//! clear all weights and set the number of rows
+	void Clear(int rows) { m_row.assign(rows, std::vector<ENTRY>()); }
+
+	//! number of rows
+	int Rows() const { return (int) m_row.size(); }
+
+	//! add to the weight of entry (A, B)
+	void Add(int A, int B, double w);
+
+	//! sort the rows by node index
+	void Sort();
+
+	//! return a row
+	const std::vector<ENTRY>& Row(int A) const { return m_row[A]; }
+
+	//! sum of all weights
+	double Sum() const;
+
+private:
+	std::vector< std::vector<ENTRY> >	m_row;
+};
+
 //-----------------------------------------------------------------------------
 // Base class for mortar-type contact formulations
 class FEMortarInterface : public FEContactInterface
@@ -45,8 +81,14 @@ public:
 	void UpdateNodalGaps(FEMortarContactSurface& ss, FEMortarContactSurface& ms);
 
 protected:
-	matrix	m_n1;	//!< integration weights n1_AB
-	matrix	m_n2;	//!< integration weights n2_AB
+	//! add the nodes that are coupled through the mortar weights to the matrix profile
+	void BuildMortarProfile(FEGlobalMatrix& K, FESurface& ss, FESurface& ms);
+
+protected:
+	FEMortarWeights	m_n1;	//!< integration weights n1_AB
+	FEMortarWeights	m_n2;	//!< integration weights n2_AB
+
+	double	m_srad;	//!< search radius for facet pairs (< 0 = test all pairs (default), 0 = use largest facet size)
 
 private:
 	// integration rule
@@ -115,6 +115,7 @@ BEGIN_FECORE_CLASS(FEMortarSlidingContact, FEMortarInterface)
 	ADD_PARAMETER(m_eps    , "penalty"      );
 	ADD_PARAMETER(m_naugmin, "minaug"       );
 	ADD_PARAMETER(m_naugmax, "maxaug"       );
+	ADD_PARAMETER(m_srad   , "search_radius");
 END_FECORE_CLASS();
 
 //-----------------------------------------------------------------------------
@@ -164,26 +165,8 @@ void FEMortarSlidingContact::Activate()
 //! build the matrix profile for use in the stiffness matrix
 void FEMortarSlidingContact::BuildMatrixProfile(FEGlobalMatrix& K)
 {
-	// For now we'll assume that each node on the primary side is connected to the secondary side
-	// This is obviously too much, but we'll worry about improving this later
-	int NS = m_ss.Nodes();
-	int NM = m_ms.Nodes();
-	vector<int> LM(3*(NS+NM));
-	for (int i=0; i<NS; ++i)
-	{
-		FENode& ni = m_ss.Node(i);
-		LM[3*i  ] = ni.m_ID[0];
-		LM[3*i+1] = ni.m_ID[1];
-		LM[3*i+2] = ni.m_ID[2];
-	}
-	for (int i=0; i<NM; ++i)
-	{
-		FENode& ni = m_ms.Node(i);
-		LM[3*NS + 3*i  ] = ni.m_ID[0];
-		LM[3*NS + 3*i+1] = ni.m_ID[1];
-		LM[3*NS + 3*i+2] = ni.m_ID[2];
-	}
-	K.build_add(LM);
+	// only connect the nodes that share a mortar weight
+	BuildMortarProfile(K, m_ss, m_ms);
 }
 
 //-----------------------------------------------------------------------------
@@ -209,15 +192,16 @@ void FEMortarSlidingContact::LoadVector(FEGlobalVector& R, const FETimeInfo& tp)
 		vector<int> en(1);
 		vector<int> lm(3);
 		vector<double> fe(3);
-		for (int B=0; B<NS; ++B)
+		for (const FEMortarWeights::ENTRY& eB : m_n1.Row(A))
 		{
+			int B = eB.node;
 			FENode& nodeB = m_ss.Node(B);
 			en[0] = m_ss.NodeIndex(B);
 			lm[0] = nodeB.m_ID[m_dofX];
 			lm[1] = nodeB.m_ID[m_dofY];
 			lm[2] = nodeB.m_ID[m_dofZ];
 
-			double nAB = -m_n1[A][B];
+			double nAB = -eB.val;
 			if (nAB != 0.0)
 			{
 				fe[0] = tA.x*nAB;
@@ -229,15 +213,16 @@ void FEMortarSlidingContact::LoadVector(FEGlobalVector& R, const FETimeInfo& tp)
 		}
 
 		// loop over secondary side
-		for (int C=0; C<NM; ++C)
+		for (const FEMortarWeights::ENTRY& eC : m_n2.Row(A))
 		{
+			int C = eC.node;
 			FENode& nodeC = m_ms.Node(C);
 			en[0] = m_ms.NodeIndex(C);
 			lm[0] = nodeC.m_ID[m_dofX];
 			lm[1] = nodeC.m_ID[m_dofY];
 			lm[2] = nodeC.m_ID[m_dofZ];
 
-			double nAC = m_n2[A][C];
+			double nAC = eC.val;
 			if (nAC != 0.0)
 			{
 				fe[0] = tA.x*nAC;
@@ -276,14 +261,15 @@ void FEMortarSlidingContact::ContactGapStiffness(FELinearSystem& LS)
 		double eps = m_eps*m_ss.m_A[A];
 
 		// loop over all primary nodes
-		for (int B=0; B<NS; ++B)
+		for (const FEMortarWeights::ENTRY& eB : m_n1.Row(A))
 		{
+			int B = eB.node;
 			FENode& nodeB = m_ss.Node(B);
 			lmi[0] = nodeB.m_ID[0];
 			lmi[1] = nodeB.m_ID[1];
 			lmi[2] = nodeB.m_ID[2];
 
-			double nAB = m_n1[A][B];
+			double nAB = eB.val;
 			if (nAB != 0.0)
 			{
 				kA[0][0] = eps*nAB*(nuA.x*nuA.x); kA[0][1] = eps*nAB*(nuA.x*nuA.y); kA[0][2] = eps*nAB*(nuA.x*nuA.z);
@@ -291,14 +277,15 @@ void FEMortarSlidingContact::ContactGapStiffness(FELinearSystem& LS)
 				kA[2][0] = eps*nAB*(nuA.z*nuA.x); kA[2][1] = eps*nAB*(nuA.z*nuA.y); kA[2][2] = eps*nAB*(nuA.z*nuA.z);
 
 				// loop over primary nodes
-				for (int C=0; C<NS; ++C)
+				for (const FEMortarWeights::ENTRY& eC : m_n1.Row(A))
 				{
+					int C = eC.node;
 					FENode& nodeC = m_ss.Node(C);
 					lmj[0] = nodeC.m_ID[0];
 					lmj[1] = nodeC.m_ID[1];
 					lmj[2] = nodeC.m_ID[2];
 
-					double nAC = m_n1[A][C];
+					double nAC = eC.val;
 					if (nAC != 0.0)
 					{
 						kG[0][0] = nAC; kG[0][1] = 0.0; kG[0][2] = 0.0;
@@ -313,14 +300,15 @@ void FEMortarSlidingContact::ContactGapStiffness(FELinearSystem& LS)
 				}
 
 				// loop over secondary nodes
-				for (int C=0; C<NM; ++C)
+				for (const FEMortarWeights::ENTRY& eC : m_n2.Row(A))
 				{
+					int C = eC.node;
 					FENode& nodeC = m_ms.Node(C);
 					lmj[0] = nodeC.m_ID[0];
 					lmj[1] = nodeC.m_ID[1];
 					lmj[2] = nodeC.m_ID[2];
 
-					double nAC = -m_n2[A][C];
+					double nAC = -eC.val;
 					if (nAC != 0.0)
 					{
 						kG[0][0] = nAC; kG[0][1] = 0.0; kG[0][2] = 0.0;
@@ -337,14 +325,15 @@ void FEMortarSlidingContact::ContactGapStiffness(FELinearSystem& LS)
 		}
 
 		// loop over all secondary nodes
-		for (int B=0; B<NM; ++B)
+		for (const FEMortarWeights::ENTRY& eB : m_n2.Row(A))
 		{
+			int B = eB.node;
 			FENode& nodeB = m_ms.Node(B);
 			lmi[0] = nodeB.m_ID[0];
 			lmi[1] = nodeB.m_ID[1];
 			lmi[2] = nodeB.m_ID[2];
 
-			double nAB = -m_n2[A][B];
+			double nAB = -eB.val;
 			if (nAB != 0.0)
 			{
 				kA[0][0] = eps*nAB*(nuA.x*nuA.x); kA[0][1] = eps*nAB*(nuA.x*nuA.y); kA[0][2] = eps*nAB*(nuA.x*nuA.z);
@@ -352,14 +341,15 @@ void FEMortarSlidingContact::ContactGapStiffness(FELinearSystem& LS)
 				kA[2][0] = eps*nAB*(nuA.z*nuA.x); kA[2][1] = eps*nAB*(nuA.z*nuA.y); kA[2][2] = eps*nAB*(nuA.z*nuA.z);
 
 				// loop over primary nodes
-				for (int C=0; C<NS; ++C)
+				for (const FEMortarWeights::ENTRY& eC : m_n1.Row(A))
 				{
+					int C = eC.node;
 					FENode& nodeC = m_ss.Node(C);
 					lmj[0] = nodeC.m_ID[0];
 					lmj[1] = nodeC.m_ID[1];
 					lmj[2] = nodeC.m_ID[2];
 
-					double nAC = m_n1[A][C];
+					double nAC = eC.val;
 					if (nAC != 0.0)
 					{
 						kG[0][0] = nAC; kG[0][1] = 0.0; kG[0][2] = 0.0;
@@ -374,14 +364,15 @@ void FEMortarSlidingContact::ContactGapStiffness(FELinearSystem& LS)
 				}
 
 				// loop over secondary nodes
-				for (int C=0; C<NM; ++C)
+				for (const FEMortarWeights::ENTRY& eC : m_n2.Row(A))
 				{
+					int C = eC.node;
 					FENode& nodeC = m_ms.Node(C);
 					lmj[0] = nodeC.m_ID[0];
 					lmj[1] = nodeC.m_ID[1];
 					lmj[2] = nodeC.m_ID[2];
 
-					double nAC = -m_n2[A][C];
+					double nAC = -eC.val;
 					if (nAC != 0.0)
 					{
 						kG[0][0] = nAC; kG[0][1] = 0.0; kG[0][2] = 0.0;
@@ -444,11 +435,12 @@ void FEMortarSlidingContact::ContactNormalStiffness(FELinearSystem& LS)
 			lm2[2] = nodej2.m_ID[2];
 
 			// loop over primary nodes
-			for (int B=0; B<NS; ++B)
+			for (const FEMortarWeights::ENTRY& eB : m_n1.Row(A))
 			{
+				int B = eB.node;
 				FENode& nodeB = m_ss.Node(B);
 				
-				double nAB = m_n1[A][B];
+				double nAB = eB.val;
 				if (nAB != 0.0)
 				{
 					vector<int> lmi(3);
@@ -475,11 +467,12 @@ void FEMortarSlidingContact::ContactNormalStiffness(FELinearSystem& LS)
 			}
 
 			// loop over secondary nodes
-			for (int B=0; B<NM; ++B)
+			for (const FEMortarWeights::ENTRY& eB : m_n2.Row(A))
 			{
+				int B = eB.node;
 				FENode& nodeB = m_ms.Node(B);
 				
-				double nAB = m_n2[A][B];
+				double nAB = eB.val;
 				if (nAB != 0.0)
 				{
 					vector<int> lmi(3);
@@ -164,3 +164,70 @@ tens4dmm FENeoHookean::MaterialTangent(FEMaterialPoint& pt, const mat3ds ES)
     
     return c;
 }
+
+//-----------------------------------------------------------------------------
+void FENeoHookean::StressBatch(FEElasticBatch& batch)
+{
+	const int N = batch.Points();
+
+	// lame parameters
+	double lam[FEElasticBatch::MAX_POINTS], mu[FEElasticBatch::MAX_POINTS];
+	for (int i = 0; i < N; ++i)
+	{
+		FEMaterialPoint& mp = batch.MaterialPoint(i);
+		double E = m_E(mp);
+		double v = m_v(mp);
+		lam[i] = v*E/((1+v)*(1-2*v));
+		mu [i] = 0.5*E/(1+v);
+	}
+
+	#pragma omp simd
+	for (int i = 0; i < N; ++i)
+	{
+		double F[9], b[6];
+		FEBatchTensor::LoadF(batch.m_F, i, F);
+		FEBatchTensor::LeftCauchyGreen(F, b);
+
+		double detFi = 1.0 / batch.m_J[i];
+		double lndetF = log(batch.m_J[i]);
+
+		double a = mu[i]*detFi;
+		double p = (lam[i]*lndetF - mu[i])*detFi;
+		batch.m_s[0][i] = a*b[0] + p;
+		batch.m_s[1][i] = a*b[1];
+		batch.m_s[2][i] = a*b[2] + p;
+		batch.m_s[3][i] = a*b[3];
+		batch.m_s[4][i] = a*b[4];
+		batch.m_s[5][i] = a*b[5] + p;
+	}
+}
+
+//-----------------------------------------------------------------------------
+void FENeoHookean::TangentBatch(FEElasticBatch& batch)
+{
+	const int N = batch.Points();
+
+	// lame parameters
+	double lam[FEElasticBatch::MAX_POINTS], mu[FEElasticBatch::MAX_POINTS];
+	for (int i = 0; i < N; ++i)
+	{
+		FEMaterialPoint& mp = batch.MaterialPoint(i);
+		double E = m_E(mp);
+		double v = m_v(mp);
+		lam[i] = v*E/((1+v)*(1-2*v));
+		mu [i] = 0.5*E/(1+v);
+	}
+
+	#pragma omp simd
+	for (int i = 0; i < N; ++i)
+	{
+		double detF = batch.m_J[i];
+		double lam1 = lam[i] / detF;
+		double mu1  = (mu[i] - lam[i]*log(detF)) / detF;
+
+		double c[21] = { 0 };
+		FEBatchTensor::IdentityDyad1s(c, lam1);
+		FEBatchTensor::IdentityDyad4s(c, 2*mu1);
+		for (int k = 0; k < 21; ++k) batch.m_c[k][i] = c[k];
+	}
+}
@@ -40,6 +40,10 @@ SOFTWARE.*/
 #include "FEMechModel.h"
 #include <FECore/FELinearSystem.h>
 #include "FESolidAnalysis.h"
+#include "FERigidConnector.h"
+
+// minimum number of rigid bodies (or connectors) for which the loops over them run in parallel
+#define MIN_PARALLEL_RIGID	64
 
 FERigidSolver::FERigidSolver(FEModel* fem)
 {
@@ -48,6 +52,7 @@ FERigidSolver::FERigidSolver(FEModel* fem)
 	m_dofX = m_dofY = m_dofZ = -1;
 
 	m_bAllowMixedBCs = false;
+	m_bcolors = false;
 }
 
 int FERigidSolver::InitEquations(int neq)
@@ -116,6 +121,9 @@ int FERigidSolver::InitEquations(int neq)
 		}
 	}
 
+	// (re)build the connector colors
+	BuildConnectorColors();
+
 	return neq;
 }
 
@@ -130,6 +138,9 @@ void FERigidSolver::Serialize(DumpStream& ar)
     ar & m_dofSX & m_dofSY & m_dofSZ;
     ar & m_dofSVX & m_dofSVY & m_dofSVZ;
 	ar & m_bAllowMixedBCs;
+
+	// the colors are rebuilt when they are needed
+	if (ar.IsLoading()) m_bcolors = false;
 }
 
 //-----------------------------------------------------------------------------
@@ -866,6 +877,17 @@ void FERigidSolver::RigidStiffnessShell(SparseMatrix& K, vector<double>& ui, vec
     }
 }
 
+//-----------------------------------------------------------------------------
+// R[n] += f for n >= 0. This can be called from parallel loops.
+static inline void AddToResidual(vector<double>& R, int n, double f)
+{
+	if (n >= 0)
+	{
+#pragma omp atomic
+		R[n] += f;
+	}
+}
+
 //-----------------------------------------------------------------------------
 void FERigidSolver::AssembleResidual(int node_id, int dof, double f, vector<double>& R)
 {
@@ -879,7 +901,7 @@ void FERigidSolver::AssembleResidual(int node_id, int dof, double f, vector<doub
     int n = node.m_ID[dof];
     
     // assemble into global vector
-    if (n >= 0) R[n] += f;
+    if (n >= 0) AddToResidual(R, n, f);
     else if (node.m_rid >= 0)
     {
         // this is a rigid body node
@@ -891,21 +913,21 @@ void FERigidSolver::AssembleResidual(int node_id, int dof, double f, vector<doub
         int* lm = RB.m_LM;
         if (dof == m_dofX)
         {
-            if (lm[0] >= 0) R[lm[0]] += f;
-            if (lm[4] >= 0) R[lm[4]] += a.z*f;
-            if (lm[5] >= 0) R[lm[5]] += -a.y*f;
+            AddToResidual(R, lm[0], f);
+            AddToResidual(R, lm[4], a.z*f);
+            AddToResidual(R, lm[5], -a.y*f);
         }
         else if (dof == m_dofY)
         {
-            if (lm[1] >= 0) R[lm[1]] += f;
-            if (lm[3] >= 0) R[lm[3]] += -a.z*f;
-            if (lm[5] >= 0) R[lm[5]] += a.x*f;
+            AddToResidual(R, lm[1], f);
+            AddToResidual(R, lm[3], -a.z*f);
+            AddToResidual(R, lm[5], a.x*f);
         }
         else if (dof == m_dofZ)
         {
-            if (lm[2] >= 0) R[lm[2]] += f;
-            if (lm[3] >= 0) R[lm[3]] += a.y*f;
-            if (lm[4] >= 0) R[lm[4]] += -a.x*f;
+            AddToResidual(R, lm[2], f);
+            AddToResidual(R, lm[3], a.y*f);
+            AddToResidual(R, lm[4], -a.x*f);
         }
 		if (node.HasFlags(FENode::SHELL) && node.HasFlags(FENode::RIGID_CLAMP)) {
             // get the shell director
@@ -913,21 +935,21 @@ void FERigidSolver::AssembleResidual(int node_id, int dof, double f, vector<doub
             vec3d b = a - d;
             if (dof == m_dofSX)
             {
-                if (lm[0] >= 0) R[lm[0]] +=  f;
-                if (lm[4] >= 0) R[lm[4]] += b.z*f;
-                if (lm[5] >= 0) R[lm[5]] += -b.y*f;
+                AddToResidual(R, lm[0],  f);
+                AddToResidual(R, lm[4], b.z*f);
+                AddToResidual(R, lm[5], -b.y*f);
             }
             else if (dof == m_dofSY)
             {
-                if (lm[1] >= 0) R[lm[1]] +=  f;
-                if (lm[3] >= 0) R[lm[3]] += -b.z*f;
-                if (lm[5] >= 0) R[lm[5]] += b.x*f;
+                AddToResidual(R, lm[1],  f);
+                AddToResidual(R, lm[3], -b.z*f);
+                AddToResidual(R, lm[5], b.x*f);
             }
             else if (dof == m_dofSZ)
             {
-                if (lm[2] >= 0) R[lm[2]] +=  f;
-                if (lm[3] >= 0) R[lm[3]] += b.y*f;
-                if (lm[4] >= 0) R[lm[4]] += -b.x*f;
+                AddToResidual(R, lm[2],  f);
+                AddToResidual(R, lm[3], b.y*f);
+                AddToResidual(R, lm[4], -b.x*f);
             }
         }
     }
@@ -975,13 +997,6 @@ void FERigidSolver::RigidMassMatrix(FELinearSystem& LS, const FETimeInfo& timeIn
 	if (m_fem == nullptr) return;
 	FEMechModel& fem = *m_fem;
 
-	// element stiffness matrix
-	vector<int> lm;
-	FEElementMatrix ke;
-
-	// 6 dofs per rigid body
-	ke.resize(6, 6);
-
 	// Newmark integration rule
 	double dt = timeInfo.timeIncrement;
     double alpham = timeInfo.alpham;
@@ -989,10 +1004,17 @@ void FERigidSolver::RigidMassMatrix(FELinearSystem& LS, const FETimeInfo& timeIn
 	double gamma = timeInfo.gamma;
 	double a = 1. / (beta*dt*dt);
 
-	for (int i=0; i<fem.RigidBodies(); ++i)
+	int NRB = fem.RigidBodies();
+#pragma omp parallel for if (NRB > MIN_PARALLEL_RIGID)
+	for (int i=0; i<NRB; ++i)
 	{
 		FERigidBody& RB = *fem.GetRigidBody(i);
 
+		// element stiffness matrix (6 dofs per rigid body)
+		vector<int> lm;
+		FEElementMatrix ke;
+		ke.resize(6, 6);
+
 		// mass matrix
 		double M = RB.m_mass*a*alpham;
 
@@ -1036,6 +1058,85 @@ void FERigidSolver::RigidMassMatrix(FELinearSystem& LS, const FETimeInfo& timeIn
 	}
 }
 
+//-----------------------------------------------------------------------------
+void FERigidSolver::BuildConnectorColors()
+{
+	m_connectorColors.clear();
+	m_bcolors = true;
+	if (m_fem == nullptr) return;
+	FEMechModel& fem = *m_fem;
+
+	// colors used so far by the connectors of each rigid body
+	int NRB = fem.RigidBodies();
+	vector< vector<int> > bodyColors(NRB);
+
+	// greedy coloring: each connector gets the lowest color that is not used
+	// yet by any other connector of its rigid bodies.
+	vector<int> mark;
+	int NC = fem.NonlinearConstraints();
+	for (int i = 0; i < NC; ++i)
+	{
+		FERigidConnector* rc = dynamic_cast<FERigidConnector*>(fem.NonlinearConstraint(i));
+		if (rc == nullptr) continue;
+
+		int a = rc->m_nRBa;
+		int b = rc->m_nRBb;
+		assert((a >= 0) && (a < NRB) && (b >= 0) && (b < NRB));
+
+		for (int c : bodyColors[a]) mark[c] = i;
+		for (int c : bodyColors[b]) mark[c] = i;
+
+		int color = 0;
+		while ((color < (int)mark.size()) && (mark[color] == i)) color++;
+		if (color == (int)mark.size())
+		{
+			mark.push_back(-1);
+			m_connectorColors.push_back(vector<FERigidConnector*>());
+		}
+
+		m_connectorColors[color].push_back(rc);
+		bodyColors[a].push_back(color);
+		if (b != a) bodyColors[b].push_back(color);
+	}
+}
+
+//-----------------------------------------------------------------------------
+//! Calculates the residual contribution of the rigid connectors. The connectors 
+//! of one color do not share rigid bodies and are assembled in parallel.
+void FERigidSolver::ConnectorForces(FEGlobalVector& R, const FETimeInfo& tp)
+{
+	if (m_bcolors == false) BuildConnectorColors();
+
+	for (vector<FERigidConnector*>& color : m_connectorColors)
+	{
+		int NC = (int)color.size();
+#pragma omp parallel for if (NC > MIN_PARALLEL_RIGID)
+		for (int i = 0; i < NC; ++i)
+		{
+			FERigidConnector* rc = color[i];
+			if (rc->IsActive()) rc->LoadVector(R, tp);
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+//! Calculates the stiffness contribution of the rigid connectors (see ConnectorForces)
+void FERigidSolver::ConnectorStiffness(FELinearSystem& LS, const FETimeInfo& tp)
+{
+	if (m_bcolors == false) BuildConnectorColors();
+
+	for (vector<FERigidConnector*>& color : m_connectorColors)
+	{
+		int NC = (int)color.size();
+#pragma omp parallel for if (NC > MIN_PARALLEL_RIGID)
+		for (int i = 0; i < NC; ++i)
+		{
+			FERigidConnector* rc = color[i];
+			if (rc->IsActive()) rc->StiffnessMatrix(LS, tp);
+		}
+	}
+}
+
 //=================================================================================================
 // FERigidSolverOld
 //=================================================================================================
@@ -1053,6 +1154,7 @@ void FERigidSolverOld::UpdateRigidKinematics()
 
 	// loop over all rigid bodies
 	int NRB = fem.RigidBodies();
+#pragma omp parallel for if (NRB > MIN_PARALLEL_RIGID)
 	for (int j = 0; j<NRB; ++j)
 	{
 		// get the rigid body
@@ -1131,6 +1233,7 @@ void FERigidSolverOld::UpdateRigidBodies(vector<double>& Ui, vector<double>& ui,
 	const int NRB = fem.RigidBodies();
 
 	// first calculate the rigid body displacement increments
+#pragma omp parallel for if (NRB > MIN_PARALLEL_RIGID)
 	for (int i = 0; i<NRB; ++i)
 	{
 		// get the rigid body
@@ -1165,6 +1268,7 @@ void FERigidSolverOld::UpdateRigidBodies(vector<double>& Ui, vector<double>& ui,
 	}
 
 	// update the rigid bodies
+#pragma omp parallel for if (NRB > MIN_PARALLEL_RIGID)
 	for (int i = 0; i<NRB; ++i)
 	{
 		// get the rigid body
@@ -1222,6 +1326,7 @@ void FERigidSolverOld::UpdateRigidBodies(vector<double>& Ui, vector<double>& ui,
 	// Since the rigid nodes are repositioned we need to update the displacement DOFS
 	FEMesh& mesh = m_fem->GetMesh();
 	int N = mesh.Nodes();
+#pragma omp parallel for
 	for (int i = 0; i<N; ++i)
 	{
 		FENode& node = mesh.Node(i);
@@ -1289,6 +1394,7 @@ void FERigidSolverNew::UpdateRigidBodies(vector<double>& Ui, vector<double>& ui)
 	FEMechModel& fem = *m_fem;
 
 	int nrb = fem.RigidBodies();
+#pragma omp parallel for if (nrb > MIN_PARALLEL_RIGID)
 	for (int i = 0; i<nrb; ++i)
 	{
 		// get the rigid body
@@ -1377,6 +1483,7 @@ void FERigidSolverNew::UpdateRigidBodies(vector<double>& Ui, vector<double>& ui)
 	// Since the rigid nodes are repositioned we need to update the displacement DOFS
 	FEMesh& mesh = m_fem->GetMesh();
 	int N = mesh.Nodes();
+#pragma omp parallel for
 	for (int i = 0; i<N; ++i)
 	{
 		FENode& node = mesh.Node(i);
@@ -1414,6 +1521,7 @@ void FERigidSolverNew::InertialForces(FEGlobalVector& R, const FETimeInfo& timeI
 	FEMechModel& fem = *m_fem;
 
 	int nrb = fem.RigidBodies();
+#pragma omp parallel for if (nrb > MIN_PARALLEL_RIGID)
 	for (int i = 0; i<nrb; ++i)
 	{
 		// get the rigid body
@@ -1433,6 +1541,7 @@ void FERigidSolverNew::InertialForces(FEGlobalVector& R, const FETimeInfo& timeI
 	}
 
 	// calculate rigid body inertial forces
+#pragma omp parallel for if (nrb > MIN_PARALLEL_RIGID)
 	for (int i = 0; i<nrb; ++i)
 	{
 		FERigidBody& RB = *fem.GetRigidBody(i);
@@ -42,6 +42,7 @@ class FESolidSolver2;
 class DumpStream;
 class FEElementMatrix;
 class FEMechModel;
+class FERigidConnector;
 
 //-----------------------------------------------------------------------------
 //! This is a helper class that helps the solid deformables solvers update the 
@@ -84,6 +85,12 @@ public:
 	// calculate contribution to mass matrix from a rigid body
 	void RigidMassMatrix(FELinearSystem& LS, const FETimeInfo& timeInfo);
 
+	// contribution from the rigid connectors to the residual
+	void ConnectorForces(FEGlobalVector& R, const FETimeInfo& tp);
+
+	// contribution from the rigid connectors to the stiffness matrix
+	void ConnectorStiffness(FELinearSystem& LS, const FETimeInfo& tp);
+
 	//! Serialization
 	void Serialize(DumpStream& ar);
 
@@ -93,6 +100,13 @@ public:
 public:
 	void AllowMixedBCs(bool b) { m_bAllowMixedBCs = b; }
 
+protected:
+	// Group the rigid connectors into colors such that no two connectors of 
+	// the same color share a rigid body. The connectors of one color only write
+	// to the equations and reaction forces of their own rigid bodies, so they
+	// can be assembled in parallel.
+	void BuildConnectorColors();
+
 protected:
 	FEMechModel*	m_fem;
 	int			m_dofX, m_dofY, m_dofZ;
@@ -101,6 +115,9 @@ protected:
     int         m_dofSX, m_dofSY, m_dofSZ;
     int         m_dofSVX, m_dofSVY, m_dofSVZ;
 	bool		m_bAllowMixedBCs;
+
+	std::vector< std::vector<FERigidConnector*> >	m_connectorColors;	//!< rigid connectors, grouped by color
+	bool		m_bcolors;		//!< the connector colors are up to date
 };
 
 //-----------------------------------------------------------------------------
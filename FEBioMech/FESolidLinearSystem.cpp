@@ -30,6 +30,7 @@ SOFTWARE.*/
 #include "FESolidSolver.h"
 #include <FECore/FELinearConstraintManager.h>
 #include <FECore/FEModel.h>
+#include "FEMechModel.h"
 
 FESolidLinearSystem::FESolidLinearSystem(FESolver* solver, FERigidSolver* rigidSolver, FEGlobalMatrix& K, std::vector<double>& F, std::vector<double>& u, bool bsymm, double alpha, int nreq) : FELinearSystem(solver, K, F, u, bsymm)
 {
@@ -47,6 +48,21 @@ void FESolidLinearSystem::StiffnessAssemblyScaleFactor(double a)
 
 void FESolidLinearSystem::Assemble(const FEElementMatrix& ke)
 {
+	// the linear constraints and rigid bodies need the full element matrix
+	if (ke.IsUpperTriangular())
+	{
+		FEModel* fem = m_solver->GetFEModel();
+		FEMechModel* mech = dynamic_cast<FEMechModel*>(fem);
+		FELinearConstraintManager& LCM = fem->GetLinearConstraintManager();
+		if ((LCM.LinearConstraints() > 0) || (mech && (mech->RigidBodies() > 0)))
+		{
+			FEElementMatrix kf(ke);
+			kf.Symmetrize();
+			Assemble(kf);
+			return;
+		}
+	}
+
 	// Rigid joints require a different assembly approach in that we can do 
 	// a direct assembly as defined by the base class. 
 	// Currently, we assume that if the node list of the element matrix is not
@@ -110,7 +126,7 @@ void FESolidLinearSystem::Assemble(const FEElementMatrix& ke)
 						{
 							// dof i is not a prescribed degree of freedom
 							#pragma omp atomic
-							m_F[I] -= ke[i][j] * ui[J];
+							m_F[I] -= ke.value(i, j) * ui[J];
 						}
 					}
 
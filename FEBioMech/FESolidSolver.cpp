@@ -429,7 +429,7 @@ bool FESolidSolver::Quasin()
 
 		// update total displacements
 		int neq = (int)m_Ui.size();
-		for (int i = 0; i<neq; ++i) m_Ui[i] += s*m_ui[i];
+		vadds(m_Ui, m_ui, s);
 		normU  = m_Ui*m_Ui;
 
 		// check residual norm
@@ -1267,8 +1267,15 @@ void FESolidSolver2::NonLinearConstraintStiffness(FELinearSystem& LS, const FETi
 	for (int i=0; i<N; ++i) 
 	{
 		FENLConstraint* plc = fem.NonlinearConstraint(i);
+
+		// the rigid connectors are done by the rigid solver below
+		if (dynamic_cast<FERigidConnector*>(plc)) continue;
+
 		if (plc->IsActive()) plc->StiffnessMatrix(LS, tp);
 	}
+
+	// rigid connectors
+	m_rigidSolver.ConnectorStiffness(LS, tp);
 }
 
 //-----------------------------------------------------------------------------
@@ -1324,6 +1331,7 @@ bool FESolidSolver2::Residual(vector<double>& R)
 	InternalForces(RHS);
 
 	// calculate nodal reaction forces
+#pragma omp parallel for
 	for (int i = 0; i < m_neq; ++i) m_Fr[i] -= R[i];
 
 	// extract the internal forces
@@ -1450,7 +1458,9 @@ void FESolidSolver2::ExternalForces(FEGlobalVector& RHS)
 
 	// set the nodal reaction forces
 	// TODO: Is this a good place to do this?
-	for (int i = 0; i<mesh.Nodes(); ++i)
+	int NN = mesh.Nodes();
+#pragma omp parallel for
+	for (int i = 0; i<NN; ++i)
 	{
 		FENode& node = mesh.Node(i);
 		node.set_load(m_dofU[0], 0);
@@ -1484,6 +1494,13 @@ void FESolidSolver2::NonLinearConstraintForces(FEGlobalVector& R, const FETimeIn
 	for (int i=0; i<N; ++i) 
 	{
 		FENLConstraint* plc = fem.NonlinearConstraint(i);
+
+		// the rigid connectors are done by the rigid solver below
+		if (dynamic_cast<FERigidConnector*>(plc)) continue;
+
 		if (plc->IsActive()) plc->LoadVector(R, tp);
 	}
+
+	// rigid connectors
+	m_rigidSolver.ConnectorForces(R, tp);
 }
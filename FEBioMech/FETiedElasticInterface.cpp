@@ -335,7 +335,7 @@ void FETiedElasticInterface::BuildMatrixProfile(FEGlobalMatrix& K)
                     
                     for (l=0; l<nseln; ++l)
                     {
-                        vector<int>& id = mesh.Node(sn[l]).m_ID;
+                        FENodeDofArray<int>& id = mesh.Node(sn[l]).m_ID;
                         lm[ndpn*l  ] = id[dof_X];
                         lm[ndpn*l+1] = id[dof_Y];
                         lm[ndpn*l+2] = id[dof_Z];
@@ -346,7 +346,7 @@ void FETiedElasticInterface::BuildMatrixProfile(FEGlobalMatrix& K)
                     
                     for (l=0; l<nmeln; ++l)
                     {
-                        vector<int>& id = mesh.Node(mn[l]).m_ID;
+                        FENodeDofArray<int>& id = mesh.Node(mn[l]).m_ID;
                         lm[ndpn*(l+nseln)  ] = id[dof_X];
                         lm[ndpn*(l+nseln)+1] = id[dof_Y];
                         lm[ndpn*(l+nseln)+2] = id[dof_Z];
@@ -698,6 +698,10 @@ void FETiedElasticInterface::StiffnessMatrix(FELinearSystem& LS, const FETimeInf
         else knmult = 0;
     }
     
+    // with the symmetric formulation and a symmetric global matrix, only the
+    // upper triangular part of the element matrices has to be evaluated
+    bool upper = (m_bsymm && LS.IsSymmetric());
+
     // do single- or two-pass
     int npass = (m_btwo_pass?2:1);
     for (int np=0; np < npass; ++np)
@@ -828,7 +832,7 @@ void FETiedElasticInterface::StiffnessMatrix(FELinearSystem& LS, const FETimeInf
                     }
                     
                     for (k=0; k<nmeln; ++k) {
-                        for (l=0; l<nseln; ++l)
+                        for (l=0; l<(upper ? 0 : nseln); ++l)
                         {
                             ke[ndpn*(nseln+k)    ][ndpn*l    ] += -eps*Hm[k]*Hs[l]*detJ[j]*w[j];
                             ke[ndpn*(nseln+k) + 1][ndpn*l + 1] += -eps*Hm[k]*Hs[l]*detJ[j]*w[j];
@@ -915,7 +919,7 @@ void FETiedElasticInterface::StiffnessMatrix(FELinearSystem& LS, const FETimeInf
                             }
                         }
                         
-                        for (k=0; k<nmeln; ++k) {
+                        for (k=0; k<(upper ? 0 : nmeln); ++k) {
                             for (l=0; l<nseln; ++l)
                             {
                                 ke[ndpn*(nseln+k)    ][ndpn*l    ] += -0.5*Hm[k]*As[l](0,0)*w[j];
@@ -952,6 +956,7 @@ void FETiedElasticInterface::StiffnessMatrix(FELinearSystem& LS, const FETimeInf
                     // assemble the global stiffness
 					ke.SetNodes(en);
 					ke.SetIndices(LM);
+					ke.SetUpperTriangular(upper);
 					LS.Assemble(ke);
                 }
             }
@@ -118,6 +118,10 @@ protected:
 	//! material stiffness component
 	void ElementMaterialStiffness(FESolidElement& el, matrix& ke) override;
 
+	//! the UT4 stiffness functions always evaluate the full element matrix
+	void ElementGeometricalStiffnessUpper(FESolidElement& el, matrix& ke) override { ElementGeometricalStiffness(el, ke); }
+	void ElementMaterialStiffnessUpper(FESolidElement& el, matrix& ke) override { ElementMaterialStiffness(el, ke); }
+
 	//! nodal geometry stiffness contribution
 	void NodalGeometryStiffness(UT4NODE& node, matrix& ke);
 
@@ -120,6 +120,58 @@ tens4ds FEUncoupledMaterial::Tangent(FEMaterialPoint &mp)
 	return DevTangent(mp) + (IxI - I4*2)*pt.m_p + IxI*(UJJ(pt.m_J)*pt.m_J);
 }
 
+//-----------------------------------------------------------------------------
+//! Batch version of Stress. The pressure is evaluated point by point (since U(J)
+//! depends on the pressure model) and added to the deviatoric batch stress.
+void FEUncoupledMaterial::StressBatch(FEElasticBatch& batch)
+{
+	DevStressBatch(batch);
+
+	for (int i = 0; i < batch.Points(); ++i)
+	{
+		FEElasticMaterialPoint& pt = *batch.MaterialPoint(i).ExtractData<FEElasticMaterialPoint>();
+		pt.m_p = UJ(batch.m_J[i]);
+
+		batch.m_s[0][i] += pt.m_p;
+		batch.m_s[2][i] += pt.m_p;
+		batch.m_s[5][i] += pt.m_p;
+	}
+}
+
+//-----------------------------------------------------------------------------
+//! Batch version of Tangent. See Tangent for the different terms.
+void FEUncoupledMaterial::TangentBatch(FEElasticBatch& batch)
+{
+	DevTangentBatch(batch);
+
+	for (int i = 0; i < batch.Points(); ++i)
+	{
+		FEElasticMaterialPoint& pt = *batch.MaterialPoint(i).ExtractData<FEElasticMaterialPoint>();
+		double J = batch.m_J[i];
+		pt.m_p = UJ(J);
+
+		// (IxI - I4*2)*p + IxI*(UJJ*J)
+		double c[21] = { 0 };
+		FEBatchTensor::IdentityDyad1s(c, pt.m_p + UJJ(J)*J);
+		FEBatchTensor::IdentityDyad4s(c, -2.0*pt.m_p);
+		for (int k = 0; k < 21; ++k) batch.m_c[k][i] += c[k];
+	}
+}
+
+//-----------------------------------------------------------------------------
+void FEUncoupledMaterial::DevStressBatch(FEElasticBatch& batch)
+{
+	for (int i = 0; i < batch.Points(); ++i)
+		batch.SetStress(i, DevStress(batch.MaterialPoint(i)));
+}
+
+//-----------------------------------------------------------------------------
+void FEUncoupledMaterial::DevTangentBatch(FEElasticBatch& batch)
+{
+	for (int i = 0; i < batch.Points(); ++i)
+		batch.SetTangent(i, DevTangent(batch.MaterialPoint(i)));
+}
+
 //-----------------------------------------------------------------------------
 //! The strain energy density function calculates the total sed as a sum of
 //! two terms, namely the deviatoric sed and U(J).
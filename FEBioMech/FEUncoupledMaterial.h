@@ -72,6 +72,12 @@ public:
 
 	//! Deviatoric strain energy density
 	virtual double DevStrainEnergyDensity(FEMaterialPoint& mp) { return 0; }
+
+	//! Deviatoric Cauchy stress at all points of a batch
+	virtual void DevStressBatch(FEElasticBatch& batch);
+
+	//! Deviatoric spatial tangent at all points of a batch
+	virtual void DevTangentBatch(FEElasticBatch& batch);
     
 public:
     virtual double StrongBondDevSED(FEMaterialPoint& pt) { return DevStrainEnergyDensity(pt); }
@@ -126,6 +132,12 @@ public:
 	//! total spatial tangent (do not overload!)
 	tens4ds Tangent(FEMaterialPoint& mp) final;
 
+	//! total Cauchy stress at all points of a batch (do not overload!)
+	void StressBatch(FEElasticBatch& batch) final;
+
+	//! total spatial tangent at all points of a batch (do not overload!)
+	void TangentBatch(FEElasticBatch& batch) final;
+
 	//! calculate strain energy (do not overload!)
 	double StrainEnergyDensity(FEMaterialPoint& pt) final;
     double StrongBondSED(FEMaterialPoint& pt) final;
@@ -33,6 +33,7 @@ SOFTWARE.*/
 #include <FECore/FEModel.h>
 #include <FECore/FESolidDomain.h>
 #include <FECore/FELinearSystem.h>
+#include <FECore/FEElementWorkspace.h>
 
 //-----------------------------------------------------------------------------
 FEBiphasicShellDomain::FEBiphasicShellDomain(FEModel* pfem) : FESSIShellDomain(pfem), FEBiphasicDomain(pfem), m_dof(pfem)
@@ -154,7 +155,7 @@ void FEBiphasicShellDomain::UnpackLM(FEElement& el, vector<int>& lm)
     {
         int n = el.m_node[i];
         FENode& node = m_pMesh->Node(n);
-        vector<int>& id = node.m_ID;
+        FENodeDofArray<int>& id = node.m_ID;
         
         // first the displacement dofs
         lm[8*i  ] = id[m_dofU[0]];
@@ -204,8 +205,9 @@ void FEBiphasicShellDomain::InternalForces(FEGlobalVector& R)
     for (int i=0; i<NE; ++i)
     {
         // element force vector
-        vector<double> fe;
-        vector<int> lm;
+        FEScopedWorkspace ws;
+        vector<double>& fe = ws->fe;
+        vector<int>& lm = ws->lm;
         
         // get the element
         FEShellElement& el = m_Elem[i];
@@ -322,8 +324,9 @@ void FEBiphasicShellDomain::InternalForcesSS(FEGlobalVector& R)
     for (int i=0; i<NE; ++i)
     {
         // element force vector
-        vector<double> fe;
-        vector<int> lm;
+        FEScopedWorkspace ws;
+        vector<double>& fe = ws->fe;
+        vector<int>& lm = ws->lm;
         
         // get the element
         FEShellElement& el = m_Elem[i];
@@ -438,17 +441,17 @@ void FEBiphasicShellDomain::StiffnessMatrix(FELinearSystem& LS, bool bsymm)
 		FEShellElement& el = m_Elem[iel];
 
         // element stiffness matrix
-        FEElementMatrix ke(el);
+        FEScopedWorkspace ws;
         int neln = el.Nodes();
         int ndof = neln*8;
-        ke.resize(ndof, ndof);
+        FEElementMatrix& ke = ws->ElementMatrix(el, ndof, ndof);
         
         // calculate the element stiffness matrix
         ElementBiphasicStiffness(el, ke, bsymm);
         
-		vector<int> lm;
+		vector<int>& lm = ws->lm;
 		UnpackLM(el, lm);
-		ke.SetIndices(lm);
+		ke.SwapIndices(lm);
         
         // assemble element matrix in global stiffness matrix
 		LS.Assemble(ke);
@@ -467,17 +470,17 @@ void FEBiphasicShellDomain::StiffnessMatrixSS(FELinearSystem& LS, bool bsymm)
 		FEShellElement& el = m_Elem[iel];
 
         // element stiffness matrix
-        FEElementMatrix ke(el);
+        FEScopedWorkspace ws;
         int neln = el.Nodes();
         int ndof = neln*8;
-        ke.resize(ndof, ndof);
+        FEElementMatrix& ke = ws->ElementMatrix(el, ndof, ndof);
         
         // calculate the element stiffness matrix
         ElementBiphasicStiffnessSS(el, ke, bsymm);
         
-		vector<int> lm;
+		vector<int>& lm = ws->lm;
 		UnpackLM(el, lm);
-		ke.SetIndices(lm);
+		ke.SwapIndices(lm);
         
         // assemble element matrix in global stiffness matrix
 		LS.Assemble(ke);
@@ -956,8 +959,9 @@ void FEBiphasicShellDomain::BodyForce(FEGlobalVector& R, FEBodyForce& BF)
 #pragma omp parallel for
     for (int i=0; i<NE; ++i)
     {
-        vector<double> fe;
-        vector<int> lm;
+        FEScopedWorkspace ws;
+        vector<double>& fe = ws->fe;
+        vector<int>& lm = ws->lm;
         
         // get the element
         FEShellElement& el = m_Elem[i];
@@ -1055,18 +1059,17 @@ void FEBiphasicShellDomain::BodyForceStiffness(FELinearSystem& LS, FEBodyForce&
         FEShellElement& el = m_Elem[iel];
         
         // create the element's stiffness matrix
-		FEElementMatrix ke(el);
+		FEScopedWorkspace ws;
 		int neln = el.Nodes();
         int ndof = 8*neln;
-        ke.resize(ndof, ndof);
-        ke.zero();
+        FEElementMatrix& ke = ws->ElementMatrix(el, ndof, ndof);
         
         // calculate inertial stiffness
         ElementBodyForceStiffness(bf, el, ke);
         
         // get the element's LM vector
         UnpackLM(el, lm);
-		ke.SetIndices(lm);
+		ke.SwapIndices(lm);
         
         // assemble element matrix in global stiffness matrix
 		LS.Assemble(ke);
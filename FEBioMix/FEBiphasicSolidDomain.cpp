@@ -34,6 +34,7 @@ SOFTWARE.*/
 #include <FECore/FEModel.h>
 #include <FEBioMech/FEBioMech.h>
 #include <FECore/FELinearSystem.h>
+#include <FECore/FEElementWorkspace.h>
 #include "FEBioMix.h"
 
 //-----------------------------------------------------------------------------
@@ -82,6 +83,8 @@ void FEBiphasicSolidDomain::SetMaterial(FEMaterial* pmat)
 //! Initialize element data
 void FEBiphasicSolidDomain::PreSolveUpdate(const FETimeInfo& timeInfo)
 {
+	InvalidateKinematicsCache();
+
 	const int NE = FEElement::MAX_NODES;
 	vec3d x0[NE], xt[NE], r0, rt;
     double pn[NE], p;
@@ -205,7 +208,7 @@ void FEBiphasicSolidDomain::UnpackLM(FEElement& el, vector<int>& lm)
 	{
 		int n = el.m_node[i];
 		FENode& node = m_pMesh->Node(n);
-		vector<int>& id = node.m_ID;
+		FENodeDofArray<int>& id = node.m_ID;
 
         // first the displacement dofs
         lm[4*i  ] = id[m_dofU[0]];
@@ -227,7 +230,7 @@ void FEBiphasicSolidDomain::UnpackLM(FEElement& el, vector<int>& lm)
     {
         if (sel.m_bitfc[i]) {
             FENode& node = m_pMesh->Node(el.m_node[i]);
-            vector<int>& id = node.m_ID;
+            FENodeDofArray<int>& id = node.m_ID;
             
             // first the back-face displacement dofs
             lm[4*i  ] = id[m_dofSU[0]];
@@ -267,8 +270,9 @@ void FEBiphasicSolidDomain::InternalForces(FEGlobalVector& R)
 	for (int i=0; i<NE; ++i)
 	{
 		// element force vector
-		vector<double> fe;
-		vector<int> lm;
+		FEScopedWorkspace ws;
+		vector<double>& fe = ws->fe;
+		vector<int>& lm = ws->lm;
 		
 		// get the element
 		FESolidElement& el = m_Elem[i];
@@ -319,7 +323,7 @@ void FEBiphasicSolidDomain::ElementInternalForce(FESolidElement& el, vector<doub
         FEBiphasicMaterialPoint& bpt = *(mp.ExtractData<FEBiphasicMaterialPoint>());
         
 		// calculate the jacobian
-		double Jw = invjact(el, Ji, n)*gw[n];
+		double Jw = CachedInvJact(el, Ji, n)*gw[n];
 
         // get the stress vector for this integration point
         mat3ds s = pt.m_s;
@@ -393,8 +397,9 @@ void FEBiphasicSolidDomain::InternalForcesSS(FEGlobalVector& R)
     for (int i=0; i<NE; ++i)
     {
         // element force vector
-        vector<double> fe;
-        vector<int> lm;
+        FEScopedWorkspace ws;
+        vector<double>& fe = ws->fe;
+        vector<int>& lm = ws->lm;
         
         // get the element
         FESolidElement& el = m_Elem[i];
@@ -444,7 +449,7 @@ void FEBiphasicSolidDomain::ElementInternalForceSS(FESolidElement& el, vector<do
         FEBiphasicMaterialPoint& bpt = *(mp.ExtractData<FEBiphasicMaterialPoint>());
         
         // calculate the jacobian
-        detJt = invjact(el, Ji, n);
+        detJt = CachedInvJact(el, Ji, n);
         
         detJt *= gw[n];
         
@@ -514,9 +519,9 @@ void FEBiphasicSolidDomain::StiffnessMatrix(FELinearSystem& LS, bool bsymm)
 		FESolidElement& el = m_Elem[iel];
 
 		// element stiffness matrix
-		FEElementMatrix ke(el);
+		FEScopedWorkspace ws;
 		int ndof = el.Nodes()*4;
-		ke.resize(ndof, ndof);
+		FEElementMatrix& ke = ws->ElementMatrix(el, ndof, ndof);
 		
 		// calculate the element stiffness matrix
 		ElementBiphasicStiffness(el, ke, bsymm);
@@ -526,9 +531,9 @@ void FEBiphasicSolidDomain::StiffnessMatrix(FELinearSystem& LS, bool bsymm)
 		// have to create a new lm array and place the equation numbers in the right order.
 		// What we really ought to do is fix the UnpackLM function so that it returns
 		// the LM vector in the right order for poroelastic elements.
-		vector<int> lm;
+		vector<int>& lm = ws->lm;
 		UnpackLM(el, lm);
-		ke.SetIndices(lm);
+		ke.SwapIndices(lm);
 
         // assemble element matrix in global stiffness matrix
 		LS.Assemble(ke);
@@ -547,9 +552,9 @@ void FEBiphasicSolidDomain::StiffnessMatrixSS(FELinearSystem& LS, bool bsymm)
 		FESolidElement& el = m_Elem[iel];
 
 		// element stiffness matrix
-		FEElementMatrix ke(el);
+		FEScopedWorkspace ws;
 		int ndof = el.Nodes()*4;
-		ke.resize(ndof, ndof);
+		FEElementMatrix& ke = ws->ElementMatrix(el, ndof, ndof);
 		
 		// calculate the element stiffness matrix
 		ElementBiphasicStiffnessSS(el, ke, bsymm);
@@ -559,9 +564,9 @@ void FEBiphasicSolidDomain::StiffnessMatrixSS(FELinearSystem& LS, bool bsymm)
 		// have to create a new lm array and place the equation numbers in the right order.
 		// What we really ought to do is fix the UnpackLM function so that it returns
 		// the LM vector in the right order for poroelastic elements.
-		vector<int> lm;
+		vector<int>& lm = ws->lm;
 		UnpackLM(el, lm);
-		ke.SetIndices(lm);
+		ke.SwapIndices(lm);
 
 		// assemble element matrix in global stiffness matrix
 		LS.Assemble(ke);
@@ -604,7 +609,7 @@ bool FEBiphasicSolidDomain::ElementBiphasicStiffness(FESolidElement& el, matrix&
         FEBiphasicMaterialPoint& pt = *(mp.ExtractData<FEBiphasicMaterialPoint>());
         
         // calculate jacobian
-        double detJ = invjact(el, Ji, n);
+        double detJ = CachedInvJact(el, Ji, n);
         
         // contravariant basis vectors in spatial frame
         vec3d g1(Ji[0][0],Ji[0][1],Ji[0][2]);
@@ -760,7 +765,7 @@ bool FEBiphasicSolidDomain::ElementBiphasicStiffnessSS(FESolidElement& el, matri
         FEBiphasicMaterialPoint& pt = *(mp.ExtractData<FEBiphasicMaterialPoint>());
         
         // calculate jacobian
-        double detJ = invjact(el, Ji, n);
+        double detJ = CachedInvJact(el, Ji, n);
         
         // contravariant basis vectors in spatial frame
         vec3d g1(Ji[0][0],Ji[0][1],Ji[0][2]);
@@ -884,6 +889,9 @@ bool FEBiphasicSolidDomain::ElementBiphasicStiffnessSS(FESolidElement& el, matri
 //-----------------------------------------------------------------------------
 void FEBiphasicSolidDomain::Update(const FETimeInfo& tp)
 {
+	// update the shape gradients used by the element loops
+	UpdateKinematicsCache();
+
 	bool berr = false;
 	int NE = (int) m_Elem.size();
 	#pragma omp parallel for shared(NE, berr)
@@ -1030,11 +1038,10 @@ void FEBiphasicSolidDomain::BodyForceStiffness(FELinearSystem& LS, FEBodyForce&
         FESolidElement& el = m_Elem[iel];
 
 		// element stiffness matrix
-		FEElementMatrix ke(el);
+		FEScopedWorkspace ws;
         int neln = el.Nodes();
         int ndof = 4*neln;
-        ke.resize(ndof, ndof);
-        ke.zero();
+        FEElementMatrix& ke = ws->ElementMatrix(el, ndof, ndof);
         
         // calculate inertial stiffness
         ElementBodyForceStiffness(bf, el, ke);
@@ -1044,9 +1051,9 @@ void FEBiphasicSolidDomain::BodyForceStiffness(FELinearSystem& LS, FEBodyForce&
         // have to create a new lm array and place the equation numbers in the right order.
         // What we really ought to do is fix the UnpackLM function so that it returns
         // the LM vector in the right order for poroelastic elements.
-		vector<int> lm;
+		vector<int>& lm = ws->lm;
 		UnpackLM(el, lm);
-		ke.SetIndices(lm);
+		ke.SwapIndices(lm);
         
         // assemble element matrix in global stiffness matrix
 		LS.Assemble(ke);
@@ -1101,7 +1108,7 @@ void FEBiphasicSolidDomain::ElementBodyForceStiffness(FEBodyForce& BF, FESolidEl
         N = el.H(n);
         
         // calculate jacobian
-        detJt = invjact(el, Ji, n)*gw[n];
+        detJt = CachedInvJact(el, Ji, n)*gw[n];
         
         Grn = el.Gr(n);
         Gsn = el.Gs(n);
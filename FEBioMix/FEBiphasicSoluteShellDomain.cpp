@@ -35,6 +35,7 @@ SOFTWARE.*/
 #include "FECore/DOFS.h"
 #include <FECore/FELinearSystem.h>
 #include "FEBiphasicAnalysis.h"
+#include <FECore/FEElementWorkspace.h>
 
 //-----------------------------------------------------------------------------
 FEBiphasicSoluteShellDomain::FEBiphasicSoluteShellDomain(FEModel* pfem) : FESSIShellDomain(pfem), FEBiphasicSoluteDomain(pfem), m_dof(pfem)
@@ -175,7 +176,7 @@ void FEBiphasicSoluteShellDomain::UnpackLM(FEElement& el, vector<int>& lm)
         int n = el.m_node[i];
         FENode& node = m_pMesh->Node(n);
         
-        vector<int>& id = node.m_ID;
+        FENodeDofArray<int>& id = node.m_ID;
         
         // first the displacement dofs
         lm[ndpn*i  ] = id[m_dofU[0]];
@@ -311,8 +312,9 @@ void FEBiphasicSoluteShellDomain::InternalForces(FEGlobalVector& R)
     for (int i=0; i<NE; ++i)
     {
         // element force vector
-        vector<double> fe;
-        vector<int> lm;
+        FEScopedWorkspace ws;
+        vector<double>& fe = ws->fe;
+        vector<int>& lm = ws->lm;
         
         // get the element
         FEShellElement& el = m_Elem[i];
@@ -440,8 +442,9 @@ void FEBiphasicSoluteShellDomain::InternalForcesSS(FEGlobalVector& R)
     for (int i=0; i<NE; ++i)
     {
         // element force vector
-        vector<double> fe;
-        vector<int> lm;
+        FEScopedWorkspace ws;
+        vector<double>& fe = ws->fe;
+        vector<int>& lm = ws->lm;
         
         // get the element
         FEShellElement& el = m_Elem[i];
@@ -564,20 +567,20 @@ void FEBiphasicSoluteShellDomain::StiffnessMatrix(FELinearSystem& LS, bool bsymm
 		FEShellElement& el = m_Elem[iel];
 
         // element stiffness matrix
-        FEElementMatrix ke(el);
+        FEScopedWorkspace ws;
         
         // allocate stiffness matrix
         int neln = el.Nodes();
         int ndof = neln*10;
-        ke.resize(ndof, ndof);
+        FEElementMatrix& ke = ws->ElementMatrix(el, ndof, ndof);
         
         // calculate the element stiffness matrix
         ElementBiphasicSoluteStiffness(el, ke, bsymm);
 
 		// get lm vector
-		vector<int> lm;
+		vector<int>& lm = ws->lm;
 		UnpackLM(el, lm);
-		ke.SetIndices(lm);
+		ke.SwapIndices(lm);
 
         // assemble element matrix in global stiffness matrix
 		LS.Assemble(ke);
@@ -598,18 +601,18 @@ void FEBiphasicSoluteShellDomain::StiffnessMatrixSS(FELinearSystem& LS, bool bsy
 		FEShellElement& el = m_Elem[iel];
 
         // element stiffness matrix
-        FEElementMatrix ke(el);
+        FEScopedWorkspace ws;
         int neln = el.Nodes();
         int ndof = neln*10;
-        ke.resize(ndof, ndof);
+        FEElementMatrix& ke = ws->ElementMatrix(el, ndof, ndof);
         
         // calculate the element stiffness matrix
         ElementBiphasicSoluteStiffnessSS(el, ke, bsymm);
 
 		// get lm vector
-		vector<int> lm;
+		vector<int>& lm = ws->lm;
 		UnpackLM(el, lm);
-		ke.SetIndices(lm);
+		ke.SwapIndices(lm);
 
         // assemble element matrix in global stiffness matrix
 		LS.Assemble(ke);
@@ -226,7 +226,7 @@ bool FEBiphasicSolver::Quasin()
 		}
 
 		// update all degrees of freedom
-		for (int i = 0; i<m_neq; ++i) m_Ui[i] += s*m_ui[i];
+		vadds(m_Ui, m_ui, s);
 
 		// update displacements
 		for (int i = 0; i<m_ndeq; ++i) m_Di[i] += s*m_di[i];
@@ -35,6 +35,7 @@ SOFTWARE.*/
 #include "FECore/DOFS.h"
 #include <FEBioMech/FEBioMech.h>
 #include <FECore/FELinearSystem.h>
+#include <FECore/FEElementWorkspace.h>
 
 #ifndef SQR
 #define SQR(x) ((x)*(x))
@@ -89,7 +90,7 @@ void FEMultiphasicShellDomain::UnpackLM(FEElement& el, vector<int>& lm)
         int n = el.m_node[i];
         FENode& node = m_pMesh->Node(n);
         
-        vector<int>& id = node.m_ID;
+        FENodeDofArray<int>& id = node.m_ID;
         
         // first the displacement dofs
         lm[ndpn*i  ] = id[m_dofU[0]];
@@ -137,7 +138,7 @@ void FEMultiphasicShellDomain::UnpackMembraneLM(FEShellElement& el, vector<int>&
         int n = el.m_node[i];
         
         FENode& node = mesh.Node(n);
-        vector<int>& id = node.m_ID;
+        FENodeDofArray<int>& id = node.m_ID;
         
         // first the displacement dofs
         lm[ndpn*i  ] = id[m_dofU[0]];
@@ -580,8 +581,9 @@ void FEMultiphasicShellDomain::InternalForces(FEGlobalVector& R)
     for (int i=0; i<NE; ++i)
     {
         // element force vector
-        vector<double> fe;
-        vector<int> lm;
+        FEScopedWorkspace ws;
+        vector<double>& fe = ws->fe;
+        vector<int>& lm = ws->lm;
         
         // get the element
         FEShellElement& el = m_Elem[i];
@@ -753,8 +755,9 @@ void FEMultiphasicShellDomain::InternalForcesSS(FEGlobalVector& R)
     for (int i=0; i<NE; ++i)
     {
         // element force vector
-        vector<double> fe;
-        vector<int> lm;
+        FEScopedWorkspace ws;
+        vector<double>& fe = ws->fe;
+        vector<int>& lm = ws->lm;
         
         // get the element
         FEShellElement& el = m_Elem[i];
@@ -919,18 +922,18 @@ void FEMultiphasicShellDomain::StiffnessMatrix(FELinearSystem& LS, bool bsymm)
 		FEShellElement& el = m_Elem[iel];
 
         // element stiffness matrix
-		FEElementMatrix ke(el);
+		FEScopedWorkspace ws;
 		int neln = el.Nodes();
         int ndof = neln*ndpn;
-        ke.resize(ndof, ndof);
+        FEElementMatrix& ke = ws->ElementMatrix(el, ndof, ndof);
         
         // calculate the element stiffness matrix
         ElementMultiphasicStiffness(el, ke, bsymm);
 
 		// get lm vector
-		vector<int> lm;
+		vector<int>& lm = ws->lm;
 		UnpackLM(el, lm);
-		ke.SetIndices(lm);
+		ke.SwapIndices(lm);
 
         // assemble element matrix in global stiffness matrix
 		LS.Assemble(ke);
@@ -954,17 +957,17 @@ void FEMultiphasicShellDomain::StiffnessMatrixSS(FELinearSystem& LS, bool bsymm)
 		FEShellElement& el = m_Elem[iel];
 
         // element stiffness matrix
-		FEElementMatrix ke(el);
+		FEScopedWorkspace ws;
         int neln = el.Nodes();
         int ndof = neln*ndpn;
-        ke.resize(ndof, ndof);
+        FEElementMatrix& ke = ws->ElementMatrix(el, ndof, ndof);
         
         // calculate the element stiffness matrix
         ElementMultiphasicStiffnessSS(el, ke, bsymm);
 
-		vector<int> lm;
+		vector<int>& lm = ws->lm;
 		UnpackLM(el, lm);
-		ke.SetIndices(lm);
+		ke.SwapIndices(lm);
 
         // assemble element matrix in global stiffness matrix
 		LS.Assemble(ke);
@@ -1964,8 +1967,9 @@ void FEMultiphasicShellDomain::MembraneReactionFluxes(FEGlobalVector& R)
     for (int i=0; i<NE; ++i)
     {
         // element force vector
-        vector<double> fe;
-        vector<int> lm;
+        FEScopedWorkspace ws;
+        vector<double>& fe = ws->fe;
+        vector<int>& lm = ws->lm;
         
         // get the element
         FEShellElement& el = m_Elem[i];
@@ -1999,7 +2003,7 @@ void FEMultiphasicShellDomain::ElementMembraneReactionFlux(FEShellElement& el, v
     // nr of element nodes
     int neln = el.Nodes();
     
-    fe.resize(neln*ndpn,0);
+    fe.assign(neln*ndpn,0);
     
     // get the element's nodal positions
     vec3d re[FEElement::MAX_NODES], ri[FEElement::MAX_NODES];
@@ -2090,11 +2094,11 @@ void FEMultiphasicShellDomain::MembraneReactionStiffnessMatrix(FELinearSystem& L
 		FEShellElement& el = m_Elem[iel];
 
         // element stiffness matrix
-        FEElementMatrix ke(el);
+        FEScopedWorkspace ws;
 
-		vector<int> lm;
+		vector<int>& lm = ws->lm;
         UnpackMembraneLM(el, lm);
-		ke.SetIndices(lm);
+		FEElementMatrix& ke = ws->ElementMatrix(el, lm);
         
         // calculate the element stiffness matrix
         ElementMembraneFluxStiffness(el, ke);
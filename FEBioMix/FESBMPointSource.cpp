@@ -300,8 +300,8 @@ void FESBMPointSource::FindIntInRadius(std::vector<FEMaterialPoint*> &possible_i
 		}
 
 		// Add neighboring element to the next buffer as long as they haven't been visited.
-		// get the global ID of the current element
-		int cur_id = cur->GetID()-1;
+		// get the index of the current element in the neighbor list
+		int cur_id = EEL.ElementIndex(*cur);
 		// for each neighboring element
 		for (int i = 0; i < EEL.NeighborSize(); i++)
 		{
@@ -378,8 +378,8 @@ void FESBMPointSource::FindNodesInRadius(std::vector<FEMaterialPoint*>& possible
 		}
 
 		// Add neighboring element to the next buffer as long as they haven't been visited.
-		// get the global ID of the current element
-		int cur_id = cur->GetID() - 1;
+		// get the index of the current element in the neighbor list
+		int cur_id = EEL.ElementIndex(*cur);
 		// for each neighboring element
 		for (int i = 0; i < EEL.NeighborSize(); i++)
 		{
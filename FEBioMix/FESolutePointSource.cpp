@@ -499,8 +499,8 @@ void FESolutePointSource::FindNodesInRadius(std::vector<FEElement*>& possible_no
 		}
 
 		// Add neighboring element to the next buffer as long as they haven't been visited.
-		// get the global ID of the current element
-		int cur_id = cur->GetID() - 1;
+		// get the index of the current element in the neighbor list
+		int cur_id = EEL.ElementIndex(*cur);
 		// for each neighboring element
 		for (int i = 0; i < EEL.NeighborSize(); i++)
 		{
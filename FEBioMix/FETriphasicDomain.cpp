@@ -33,6 +33,7 @@ SOFTWARE.*/
 #include "FECore/DOFS.h"
 #include <FEBioMech/FEBioMech.h>
 #include <FECore/FELinearSystem.h>
+#include <FECore/FEElementWorkspace.h>
 
 #ifndef SQR
 #define SQR(x) ((x)*(x))
@@ -89,7 +90,7 @@ void FETriphasicDomain::UnpackLM(FEElement& el, vector<int>& lm)
 		int n = el.m_node[i];
 		FENode& node = m_pMesh->Node(n);
 
-		vector<int>& id = node.m_ID;
+		FENodeDofArray<int>& id = node.m_ID;
 
 		// first the displacement dofs
 		lm[6*i  ] = id[m_dofU[0]];
@@ -306,8 +307,9 @@ void FETriphasicDomain::InternalForces(FEGlobalVector& R)
 	for (int i=0; i<NE; ++i)
 	{
 		// element force vector
-		vector<double> fe;
-		vector<int> lm;
+		FEScopedWorkspace ws;
+		vector<double>& fe = ws->fe;
+		vector<int>& lm = ws->lm;
 		
 		// get the element
 		FESolidElement& el = m_Elem[i];
@@ -426,8 +428,9 @@ void FETriphasicDomain::InternalForcesSS(FEGlobalVector& R)
     for (int i=0; i<NE; ++i)
     {
         // element force vector
-        vector<double> fe;
-        vector<int> lm;
+        FEScopedWorkspace ws;
+        vector<double>& fe = ws->fe;
+        vector<int>& lm = ws->lm;
         
         // get the element
         FESolidElement& el = m_Elem[i];
@@ -536,18 +539,17 @@ void FETriphasicDomain::StiffnessMatrix(FELinearSystem& LS, bool bsymm)
 		FESolidElement& el = m_Elem[iel];
 
 		// element stiffness matrix
-		FEElementMatrix ke(el);
+		FEScopedWorkspace ws;
 
 		// get the lm vector
-		vector<int> lm;
+		vector<int>& lm = ws->lm;
 		UnpackLM(el, lm);
-		ke.SetIndices(lm);
 		
 		// allocate stiffness matrix
 		int neln = el.Nodes();
 		int ndpn = 6;
 		int ndof = neln*ndpn;
-		ke.resize(ndof, ndof);
+		FEElementMatrix& ke = ws->ElementMatrix(el, lm, ndof, ndof);
 		
 		// calculate the element stiffness matrix
 		ElementTriphasicStiffness(el, ke, bsymm);
@@ -569,21 +571,21 @@ void FETriphasicDomain::StiffnessMatrixSS(FELinearSystem& LS, bool bsymm)
 		FESolidElement& el = m_Elem[iel];
 
 		// element stiffness matrix
-		FEElementMatrix ke(el);
+		FEScopedWorkspace ws;
 
 		// allocate stiffness matrix
 		int neln = el.Nodes();
 		int ndpn = 6;
 		int ndof = neln*ndpn;
-		ke.resize(ndof, ndof);
+		FEElementMatrix& ke = ws->ElementMatrix(el, ndof, ndof);
 		
 		// calculate the element stiffness matrix
 		ElementTriphasicStiffnessSS(el, ke, bsymm);
 
 		//  get the lm vector
-		vector<int> lm;
+		vector<int>& lm = ws->lm;
 		UnpackLM(el, lm);
-		ke.SetIndices(lm);
+		ke.SwapIndices(lm);
 
 		// assemble element matrix in global stiffness matrix
 		LS.Assemble(ke);
@@ -0,0 +1,196 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+#include "stdafx.h"
+#include "FEDomainDecompositionTest.h"
+#include <FECore/FEModel.h>
+#include <FECore/FEAnalysis.h>
+#include <FECore/FENewtonSolver.h>
+#include <FECore/FEGlobalMatrix.h>
+#include <FECore/LinearSolver.h>
+#include <FECore/FECoreKernel.h>
+#include <FECore/log.h>
+#include <math.h>
+using namespace std;
+
+//-----------------------------------------------------------------------------
+// Assemble the stiffness matrix of the nonlinear solver with the linear solver ls
+// and solve it for the right-hand side b. The solver's own linear solver and matrix 
+// are swapped out while doing this.
+static bool solve_linear_system(FENewtonSolver* nlsolve, LinearSolver* ls, vector<double>& b, vector<double>& x)
+{
+	bool bsymm = (nlsolve->MatrixSymmetryFlag() == REAL_SYMMETRIC);
+	SparseMatrix* pA = ls->CreateSparseMatrix(bsymm ? REAL_SYMMETRIC : REAL_UNSYMMETRIC);
+	if (pA == nullptr) return false;
+
+	LinearSolver* ls0 = nlsolve->m_plinsolve;
+	FEGlobalMatrix* K0 = nlsolve->m_pK;
+	vector<double> Fd(nlsolve->m_Fd);
+
+	FEGlobalMatrix K(pA);
+	nlsolve->m_plinsolve = ls;
+	nlsolve->m_pK = &K;
+
+	bool bret = false;
+	if (nlsolve->CreateStiffness(true))
+	{
+		K.Zero();
+		if (nlsolve->StiffnessMatrix() && ls->Factor())
+		{
+			x.assign(b.size(), 0.0);
+			bret = ls->BackSolve(&x[0], &b[0]);
+		}
+	}
+	ls->Destroy();
+
+	nlsolve->m_plinsolve = ls0;
+	nlsolve->m_pK = K0;
+	nlsolve->m_Fd = Fd;
+
+	return bret;
+}
+
+//-----------------------------------------------------------------------------
+FEDomainDecompositionTest::FEDomainDecompositionTest(FEModel* fem) : FECoreTask(fem)
+{
+	m_ranks = 2;
+	m_tol = 1e-6;
+	m_bdone = false;
+	m_bpass = false;
+}
+
+//-----------------------------------------------------------------------------
+bool FEDomainDecompositionTest::Init(const char* szarg)
+{
+	if (szarg && szarg[0])
+	{
+		m_ranks = atoi(szarg);
+		if (m_ranks < 2) return false;
+	}
+	return GetFEModel()->Init();
+}
+
+//-----------------------------------------------------------------------------
+bool dd_test_cb(FEModel* fem, unsigned int when, void* pd)
+{
+	FEDomainDecompositionTest* test = (FEDomainDecompositionTest*)pd;
+	return test->Diagnose();
+}
+
+//-----------------------------------------------------------------------------
+// Run the model until the first stiffness reformation, where the linear system
+// is solved with both solvers.
+bool FEDomainDecompositionTest::Run()
+{
+	FEModel& fem = *GetFEModel();
+	fem.AddCallback(dd_test_cb, CB_MATRIX_REFORM, (void*)this);
+
+	fem.BlockLog();
+	fem.Solve();
+	fem.UnBlockLog();
+
+	if (m_bdone == false)
+	{
+		feLogError("The linear system was never formed. Aborting test.\n");
+		return false;
+	}
+
+	printf("Domain decomposition test %s.\n", (m_bpass ? "passed" : "failed"));
+	return m_bpass;
+}
+
+//-----------------------------------------------------------------------------
+bool FEDomainDecompositionTest::Diagnose()
+{
+	// only check the first reformation
+	if (m_bdone) return true;
+	m_bdone = true;
+
+	FEModel* fem = GetFEModel();
+	FEAnalysis* step = fem->GetCurrentStep();
+	if (step == nullptr) return false;
+
+	FENewtonSolver* nlsolve = dynamic_cast<FENewtonSolver*>(step->GetFESolver());
+	if (nlsolve == nullptr) return false;
+
+	int neq = nlsolve->NumberOfEquations();
+	vector<double> b(neq, 0.0);
+	nlsolve->Residual(b);
+
+	// use a non-trivial right-hand side if the residual vanishes
+	double bn = 0.0;
+	for (int i = 0; i < neq; ++i) bn += b[i] * b[i];
+	if (bn == 0.0)
+	{
+		for (int i = 0; i < neq; ++i) b[i] = sin((double)i + 1.0);
+	}
+
+	// Solve with the (serial) solver of the model. If the model already uses the dd
+	// solver, we use the default solver instead.
+	FECoreKernel& fecore = FECoreKernel::GetInstance();
+	LinearSolver* ls0 = nullptr;
+	const char* sztype = nlsolve->GetLinearSolver()->GetTypeStr();
+	if (sztype && strcmp(sztype, "dd")) ls0 = fecore_new<LinearSolver>(sztype, fem);
+	if (ls0 == nullptr) ls0 = fecore.CreateDefaultLinearSolver(fem);
+	vector<double> x0;
+	bool b0 = (ls0 ? solve_linear_system(nlsolve, ls0, b, x0) : false);
+	delete ls0;
+
+	// solve with the domain decomposition solver
+	LinearSolver* ls1 = fecore_new<LinearSolver>("dd", fem);
+	vector<double> x1;
+	bool b1 = false;
+	if (ls1)
+	{
+		ls1->SetParameter("ranks", m_ranks);
+		ls1->SetParameter("tol", 1e-12);
+		b1 = solve_linear_system(nlsolve, ls1, b, x1);
+		delete ls1;
+	}
+
+	if ((b0 == false) || (b1 == false))
+	{
+		printf("Failed to solve the linear system (default: %s, dd: %s)\n", (b0 ? "ok" : "failed"), (b1 ? "ok" : "failed"));
+		return false;
+	}
+
+	// compare the solutions
+	double dx = 0.0, xn = 0.0;
+	for (int i = 0; i < neq; ++i)
+	{
+		dx += (x1[i] - x0[i])*(x1[i] - x0[i]);
+		xn += x0[i] * x0[i];
+	}
+	double err = (xn > 0.0 ? sqrt(dx / xn) : sqrt(dx));
+	m_bpass = (err <= m_tol);
+
+	printf("Domain decomposition test (%d ranks, %d equations): relative difference = %lg\n", m_ranks, neq, err);
+
+	// we don't need to continue the analysis
+	return false;
+}
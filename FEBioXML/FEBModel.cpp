@@ -33,7 +33,11 @@ SOFTWARE.*/
 #include <FECore/FEMaterial.h>
 #include <FECore/FEDomain.h>
 #include <FECore/FEShellDomain.h>
+#include <FECore/FEElementLibrary.h>
+#include <FECore/FEElementTraits.h>
 #include <FECore/log.h>
+#include <algorithm>
+#include <numeric>
 using namespace std;
 
 //=============================================================================
@@ -233,6 +237,196 @@ void FEBModel::Part::AddNodes(const std::vector<NODE>& nodes)
 	}
 }
 
+//-----------------------------------------------------------------------------
+// spread the lower 21 bits of n so that there are two zero bits between each bit
+static uint64_t spreadBits(uint64_t n)
+{
+	n &= 0x1fffff;
+	n = (n | n << 32) & 0x1f00000000ffff;
+	n = (n | n << 16) & 0x1f0000ff0000ff;
+	n = (n | n <<  8) & 0x100f00f00f00f00f;
+	n = (n | n <<  4) & 0x10c30c30c30c30c3;
+	n = (n | n <<  2) & 0x1249249249249249;
+	return n;
+}
+
+//-----------------------------------------------------------------------------
+// Sort the nodes along a Morton (Z-order) curve through the bounding box of the part.
+static void sfcOrder(const vector<FEBModel::NODE>& nodes, vector<int>& order)
+{
+	int NN = (int)nodes.size();
+	vec3d r0 = nodes[0].r, r1 = nodes[0].r;
+	for (int i = 1; i < NN; ++i)
+	{
+		const vec3d& r = nodes[i].r;
+		r0.x = min(r0.x, r.x); r1.x = max(r1.x, r.x);
+		r0.y = min(r0.y, r.y); r1.y = max(r1.y, r.y);
+		r0.z = min(r0.z, r.z); r1.z = max(r1.z, r.z);
+	}
+
+	// use the same scale in all directions so the curve does not get distorted
+	double L = max(r1.x - r0.x, max(r1.y - r0.y, r1.z - r0.z));
+	double s = (L > 0 ? (double)0x1fffff / L : 0.0);
+
+	vector<uint64_t> key(NN);
+	for (int i = 0; i < NN; ++i)
+	{
+		const vec3d& r = nodes[i].r;
+		uint64_t x = (uint64_t)((r.x - r0.x)*s);
+		uint64_t y = (uint64_t)((r.y - r0.y)*s);
+		uint64_t z = (uint64_t)((r.z - r0.z)*s);
+		key[i] = spreadBits(x) | (spreadBits(y) << 1) | (spreadBits(z) << 2);
+	}
+
+	order.resize(NN);
+	iota(order.begin(), order.end(), 0);
+	stable_sort(order.begin(), order.end(), [&](int a, int b) { return key[a] < key[b]; });
+}
+
+//-----------------------------------------------------------------------------
+// Reverse Cuthill-McKee ordering of the node graph. The graph is given by the element
+// connectivity (conn, with element i's nodes starting at eoff[i]). 
+static void rcmOrder(int NN, const vector<int>& conn, const vector<int>& eoff, vector<int>& order)
+{
+	int NE = (int)eoff.size() - 1;
+
+	// build the node-element list
+	vector<int> nval(NN + 1, 0);
+	for (int i = 0; i < (int)conn.size(); ++i) if (conn[i] >= 0) nval[conn[i] + 1]++;
+	for (int i = 0; i < NN; ++i) nval[i + 1] += nval[i];
+	vector<int> nel(nval[NN]);
+	vector<int> pos(nval.begin(), nval.end() - 1);
+	for (int i = 0; i < NE; ++i)
+		for (int j = eoff[i]; j < eoff[i + 1]; ++j)
+			if (conn[j] >= 0) nel[pos[conn[j]]++] = i;
+
+	// loops over the (unique) neighbors of node n
+	vector<int> tag(NN, -1);
+	auto forEachNeighbor = [&](int n, auto f) {
+		tag[n] = n;
+		for (int k = nval[n]; k < nval[n + 1]; ++k)
+		{
+			int e = nel[k];
+			for (int j = eoff[e]; j < eoff[e + 1]; ++j)
+			{
+				int m = conn[j];
+				if ((m >= 0) && (tag[m] != n)) { tag[m] = n; f(m); }
+			}
+		}
+	};
+
+	// calculate the node degrees
+	vector<int> degree(NN, 0);
+	for (int i = 0; i < NN; ++i) forEachNeighbor(i, [&](int m) { degree[i]++; });
+
+	// we start each component at the unvisited node with the lowest degree
+	vector<int> seed(NN);
+	iota(seed.begin(), seed.end(), 0);
+	stable_sort(seed.begin(), seed.end(), [&](int a, int b) { return degree[a] < degree[b]; });
+
+	order.clear(); order.reserve(NN);
+	vector<bool> visited(NN, false);
+	vector<int> nbr;
+	for (int i = 0; i < NN; ++i)
+	{
+		int n0 = seed[i];
+		if (visited[n0]) continue;
+
+		// Cuthill-McKee: breadth-first search, visiting neighbors by increasing degree
+		size_t head = order.size();
+		order.push_back(n0); visited[n0] = true;
+		while (head < order.size())
+		{
+			int n = order[head++];
+			nbr.clear();
+			forEachNeighbor(n, [&](int m) { if (visited[m] == false) nbr.push_back(m); });
+			stable_sort(nbr.begin(), nbr.end(), [&](int a, int b) { return degree[a] < degree[b]; });
+			for (int m : nbr) { visited[m] = true; order.push_back(m); }
+		}
+	}
+
+	// and reverse it
+	reverse(order.begin(), order.end());
+}
+
+//-----------------------------------------------------------------------------
+void FEBModel::Part::Reorder(int method)
+{
+	int NN = (int)m_Node.size();
+	if ((method == NO_REORDER) || (NN == 0)) return;
+
+	// build a node ID lookup table
+	int noff = m_Node[0].id, maxID = m_Node[0].id;
+	for (int i = 1; i < NN; ++i)
+	{
+		if (m_Node[i].id < noff) noff = m_Node[i].id;
+		if (m_Node[i].id > maxID) maxID = m_Node[i].id;
+	}
+	vector<int> NLT(maxID - noff + 1, -1);
+	for (int i = 0; i < NN; ++i) NLT[m_Node[i].id - noff] = i;
+
+	// collect the element connectivity in terms of node indices
+	vector<int> conn, eoff(1, 0);
+	for (Domain* dom : m_Dom)
+	{
+		FEElementTraits* traits = FEElementLibrary::GetElementTraits(dom->ElementSpec().etype);
+		if (traits == nullptr) return;
+		int neln = traits->m_neln;
+		for (int i = 0; i < dom->Elements(); ++i)
+		{
+			const ELEMENT& el = dom->GetElement(i);
+			for (int j = 0; j < neln; ++j)
+			{
+				int n = el.node[j] - noff;
+				conn.push_back((n >= 0) && (n < (int)NLT.size()) ? NLT[n] : -1);
+			}
+			eoff.push_back((int)conn.size());
+		}
+	}
+
+	// find the new node order
+	vector<int> order;
+	if      (method == RCM_REORDER) rcmOrder(NN, conn, eoff, order);
+	else if (method == SFC_REORDER) sfcOrder(m_Node, order);
+	else return;
+	assert((int)order.size() == NN);
+
+	// reorder the nodes
+	vector<NODE> node(NN);
+	vector<int> newIndex(NN);
+	for (int i = 0; i < NN; ++i)
+	{
+		node[i] = m_Node[order[i]];
+		newIndex[order[i]] = i;
+	}
+	m_Node.swap(node);
+
+	// Sort the elements of each domain by their lowest (new) node index. This way, element
+	// loops visit the nodes in (roughly) increasing order.
+	int ne = 0;
+	for (Domain* dom : m_Dom)
+	{
+		int NE = dom->Elements();
+		vector<int> key(NE, NN);
+		for (int i = 0; i < NE; ++i, ++ne)
+		{
+			for (int j = eoff[ne]; j < eoff[ne + 1]; ++j)
+			{
+				int n = conn[j];
+				if ((n >= 0) && (newIndex[n] < key[i])) key[i] = newIndex[n];
+			}
+		}
+
+		vector<int> elemOrder(NE);
+		iota(elemOrder.begin(), elemOrder.end(), 0);
+		stable_sort(elemOrder.begin(), elemOrder.end(), [&](int a, int b) { return key[a] < key[b]; });
+
+		vector<ELEMENT> elem(NE);
+		for (int i = 0; i < NE; ++i) elem[i] = dom->GetElement(elemOrder[i]);
+		dom->SetElementList(elem);
+	}
+}
+
 FEBModel::Domain* FEBModel::Part::FindDomain(const string& name)
 {
 	for (size_t i = 0; i<m_Dom.size(); ++i)
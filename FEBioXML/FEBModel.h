@@ -249,6 +249,13 @@ public:
 		std::vector<ELEM>	m_elem;
 	};
 
+	// node and element reordering options (see Part::Reorder)
+	enum ReorderMethod {
+		NO_REORDER,		// keep the input order
+		RCM_REORDER,	// reverse Cuthill-McKee ordering of the node graph
+		SFC_REORDER		// Morton (Z-order) space-filling curve through the node positions
+	};
+
 	class Part
 	{
 	public:
@@ -304,6 +311,11 @@ public:
 
 		NODE& GetNode(int i) { return m_Node[i]; }
 
+		// Reorder the nodes and the elements of each domain to improve memory locality.
+		// Only the storage order changes. The IDs are kept, so all sets and surfaces,
+		// which reference nodes and elements by ID, remain valid.
+		void Reorder(int method);
+
 	private:
 		std::string					m_name;
 		std::vector<NODE>			m_Node;
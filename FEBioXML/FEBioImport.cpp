@@ -29,6 +29,7 @@ SOFTWARE.*/
 #include "stdafx.h"
 #include "FEBioImport.h"
 #include "FEBioIncludeSection.h"
+#include "FEBioMeshFile.h"
 #include "FEBioModuleSection.h"
 #include "FEBioControlSection.h"
 #include "FEBioControlSection3.h"
@@ -444,21 +445,31 @@ bool FEBioImport::ReadFile(const char* szfile, bool broot)
 					// make sure this is a leaf
 					if (tag.isleaf() == false) return errf("FATAL ERROR: included sections may not have child sections.\n\n");
 
-					// read this section from an included file.
-					XMLReader xml2;
-					if (xml2.Open(szinc) == false) return errf("FATAL ERROR: failed opening input file %s\n\n", szinc);
-
-					// find the febio_spec tag
-					XMLTag tag2;
-					if (xml2.FindTag("febio_spec", tag2) == false) return errf("FATAL ERROR: febio_spec tag was not found. This is not a valid input file.\n\n");
-
-					// find the section we are looking for
-					char sz[512] = {0};
-					sprintf(sz, "febio_spec/%s", tag.Name());
-					if (xml2.FindTag(sz, tag2) == false) return errf("FATAL ERROR: Couldn't find %s section in file %s.\n\n", tag.Name(), szinc);
-
-					// parse the section
-					is->second->Parse(tag2);
+					// see if this is a binary mesh file
+					if (FEBioMeshFile::IsMeshFile(szinc))
+					{
+						FEBioMeshFile meshFile;
+						if (meshFile.Open(szinc) == false) return errf("FATAL ERROR: failed opening binary mesh file %s\n\n", szinc);
+						if (is->second->ParseBinary(meshFile) == false) return errf("FATAL ERROR: Couldn't read %s section from binary mesh file %s.\n\n", tag.Name(), szinc);
+					}
+					else
+					{
+						// read this section from an included file.
+						XMLReader xml2;
+						if (xml2.Open(szinc) == false) return errf("FATAL ERROR: failed opening input file %s\n\n", szinc);
+
+						// find the febio_spec tag
+						XMLTag tag2;
+						if (xml2.FindTag("febio_spec", tag2) == false) return errf("FATAL ERROR: febio_spec tag was not found. This is not a valid input file.\n\n");
+
+						// find the section we are looking for
+						char sz[512] = {0};
+						sprintf(sz, "febio_spec/%s", tag.Name());
+						if (xml2.FindTag(sz, tag2) == false) return errf("FATAL ERROR: Couldn't find %s section in file %s.\n\n", tag.Name(), szinc);
+
+						// parse the section
+						is->second->Parse(tag2);
+					}
 				}
 				else is->second->Parse(tag);
 			}
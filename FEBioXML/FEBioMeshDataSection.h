@@ -114,6 +114,7 @@ class FEBioMeshDataSection4: public FEBioFileSection
 public:
 	FEBioMeshDataSection4(FEBioImport* pim) : FEBioFileSection(pim) {}
 	void Parse(XMLTag& tag);
+	bool ParseBinary(FEBioMeshFile& file) override;
 
 protected:
 	void ParseNodalData(XMLTag& tag);
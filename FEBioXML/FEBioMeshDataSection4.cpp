@@ -28,6 +28,7 @@ SOFTWARE.*/
 
 #include "stdafx.h"
 #include "FEBioMeshDataSection.h"
+#include "FEBioMeshFile.h"
 #include "FECore/FEModel.h"
 #include <FECore/FEDataGenerator.h>
 #include <FECore/FECoreKernel.h>
@@ -73,6 +74,66 @@ void FEBioMeshDataSection4::Parse(XMLTag& tag)
 	while (!tag.isend());
 }
 
+//-----------------------------------------------------------------------------
+// Read the data maps from a binary mesh file. The data is copied directly into the 
+// map's buffer, so the map must have the same layout as when it was written.
+bool FEBioMeshDataSection4::ParseBinary(FEBioMeshFile& file)
+{
+	FEMesh& mesh = GetFEModel()->GetMesh();
+	if (mesh.Domains() == 0)
+	{
+		throw FEFileException("MeshData must appear after MeshDomain section.");
+	}
+
+	for (int i = 0; i < file.Chunks(); ++i)
+	{
+		const FEBioMeshFile::Chunk& c = file.GetChunk(i);
+		FEDataType dataType = (FEDataType)c.dataType;
+		FEDataMap* map = nullptr;
+		switch (c.type)
+		{
+		case FEBioMeshFile::NODE_DATA:
+		{
+			FENodeSet* set = mesh.FindNodeSet(c.info);
+			if (set == nullptr) return false;
+			FENodeDataMap* nodeMap = new FENodeDataMap(dataType);
+			nodeMap->Create(set);
+			map = nodeMap;
+		}
+		break;
+		case FEBioMeshFile::ELEM_DATA:
+		{
+			FEElementSet* set = mesh.FindElementSet(c.info);
+			if (set == nullptr) return false;
+			FEDomainMap* domMap = new FEDomainMap(dataType, (Storage_Fmt)c.format);
+			domMap->Create(set);
+			map = domMap;
+		}
+		break;
+		case FEBioMeshFile::SURFACE_DATA:
+		{
+			FEFacetSet* set = mesh.FindFacetSet(c.info);
+			if (set == nullptr) return false;
+			FESurfaceMap* surfMap = new FESurfaceMap(dataType);
+			surfMap->Create(set, 0.0, (Storage_Fmt)c.format);
+			map = surfMap;
+		}
+		break;
+		default:
+			continue;
+		}
+
+		// copy the data
+		if ((int64_t)map->BufferSize() != c.count * c.ncols) { delete map; return false; }
+		if (map->BufferSize() > 0) memcpy(map->data(), file.DoubleData(c), map->BufferSize() * sizeof(double));
+
+		map->SetName(c.name);
+		mesh.AddDataMap(map);
+	}
+
+	return true;
+}
+
 //-----------------------------------------------------------------------------
 void FEBioMeshDataSection4::ParseNodalData(XMLTag& tag)
 {
@@ -143,6 +204,33 @@ void FEBioMeshDataSection4::ParseNodeData(XMLTag& tag, FENodeDataMap& map)
 	int dataSize = map.DataSize();
 	double data[3]; // make sure this array is large enough to store any data map type (current 3 for FE_VEC3D)
 
+	// assign the value of node n. Returns false if the data is invalid.
+	auto setValue = [&](int n, const double* data, int nread) {
+		if ((n < 0) || (n >= nodes) || (nread != dataSize)) return false;
+		switch (dataType)
+		{
+		case FE_DOUBLE:	map.setValue(n, data[0]); break;
+		case FE_VEC2D:	map.setValue(n, vec2d(data[0], data[1])); break;
+		case FE_VEC3D:	map.setValue(n, vec3d(data[0], data[1], data[2])); break;
+		default:
+			assert(false);
+		}
+		return true;
+	};
+
+	// Try the bulk reader first. If that fails, we rewind and process the 
+	// tags one by one, which also reports the offending tag. 
+	XMLTag tag0(tag);
+	vector<int> lid, count;
+	vector<double> val;
+	if (tag.readLeafValues("lid", lid, count, val, dataSize))
+	{
+		bool bok = true;
+		for (int i = 0; bok && (i < (int)lid.size()); ++i) bok = setValue(lid[i] - 1, &val[i*dataSize], count[i]);
+		if (bok) return;
+		tag = tag0;
+	}
+
 	++tag;
 	do
 	{
@@ -154,18 +242,7 @@ void FEBioMeshDataSection4::ParseNodeData(XMLTag& tag, FENodeDataMap& map)
 		if ((n < 0) || (n >= nodes)) throw XMLReader::InvalidAttributeValue(tag, "lid", szlid);
 
 		int nread = tag.value(data, dataSize);
-		if (nread == dataSize)
-		{
-			switch (dataType)
-			{
-			case FE_DOUBLE:	map.setValue(n, data[0]); break;
-			case FE_VEC2D:	map.setValue(n, vec2d(data[0], data[1])); break;
-			case FE_VEC3D:	map.setValue(n, vec3d(data[0], data[1], data[2])); break;
-			default:
-				assert(false);
-			}
-		}
-		else throw XMLReader::InvalidValue(tag);
+		if (setValue(n, data, nread) == false) throw XMLReader::InvalidValue(tag);
 		++tag;
 	}
 	while (!tag.isend());
@@ -355,17 +432,9 @@ void FEBioMeshDataSection4::ParseSurfaceData(XMLTag& tag, FESurfaceMap& map)
 	int m = map.MaxNodes();
 	double data[3 * FEElement::MAX_NODES]; // make sure this array is large enough to store any data map type (current 3 for FE_VEC3D)
 
-	++tag;
-	do
-	{
-		// get the local element number
-		const char* szlid = tag.AttributeValue("lid");
-		int n = atoi(szlid) - 1;
-
-		// make sure the number is valid
-		if ((n < 0) || (n >= nelems)) throw XMLReader::InvalidAttributeValue(tag, "lid", szlid);
-
-		int nread = tag.value(data, m * dataSize);
+	// assign the value(s) of face n. Returns false if the data is invalid.
+	auto setValue = [&](int n, const double* data, int nread) {
+		if ((n < 0) || (n >= nelems)) return false;
 		if (nread == dataSize)
 		{
 			switch (dataType)
@@ -379,7 +448,7 @@ void FEBioMeshDataSection4::ParseSurfaceData(XMLTag& tag, FESurfaceMap& map)
 		}
 		else if (nread == m * dataSize)
 		{
-			double* pd = data;
+			const double* pd = data;
 			for (int i = 0; i < m; ++i, pd += dataSize)
 			{
 				switch (dataType)
@@ -392,7 +461,35 @@ void FEBioMeshDataSection4::ParseSurfaceData(XMLTag& tag, FESurfaceMap& map)
 				}
 			}
 		}
-		else throw XMLReader::InvalidValue(tag);
+		else return false;
+		return true;
+	};
+
+	// Try the bulk reader first. If that fails, we rewind and process the 
+	// tags one by one, which also reports the offending tag. 
+	XMLTag tag0(tag);
+	vector<int> lid, count;
+	vector<double> val;
+	if (tag.readLeafValues("lid", lid, count, val, m * dataSize))
+	{
+		bool bok = true;
+		for (int i = 0; bok && (i < (int)lid.size()); ++i) bok = setValue(lid[i] - 1, &val[i*m*dataSize], count[i]);
+		if (bok) return;
+		tag = tag0;
+	}
+
+	++tag;
+	do
+	{
+		// get the local element number
+		const char* szlid = tag.AttributeValue("lid");
+		int n = atoi(szlid) - 1;
+
+		// make sure the number is valid
+		if ((n < 0) || (n >= nelems)) throw XMLReader::InvalidAttributeValue(tag, "lid", szlid);
+
+		int nread = tag.value(data, m * dataSize);
+		if (setValue(n, data, nread) == false) throw XMLReader::InvalidValue(tag);
 		++tag;
 	} while (!tag.isend());
 }
@@ -483,21 +580,11 @@ void FEBioMeshDataSection4::ParseElementData(XMLTag& tag, FEDomainMap& map)
 
 	// TODO: For vec3d values, I sometimes need to normalize the vectors (e.g. for fibers). How can I do this?
 
-	int ncount = 0;
-	++tag;
-	do
-	{
-		// get the local element number
-		const char* szlid = tag.AttributeValue("lid");
-		int n = atoi(szlid) - 1;
-
-		// make sure the number is valid
-		if ((n < 0) || (n >= nelems)) throw XMLReader::InvalidAttributeValue(tag, "lid", szlid);
-
-		int nread = tag.value(data, m * dataSize);
+	// assign the value(s) of element n. Returns false if the data is invalid.
+	auto setValue = [&](int n, const double* v, int nread) {
+		if ((n < 0) || (n >= nelems)) return false;
 		if (nread == dataSize)
 		{
-			double* v = data;
 			switch (dataType)
 			{
 			case FE_DOUBLE:	map.setValue(n, v[0]); break;
@@ -511,7 +598,6 @@ void FEBioMeshDataSection4::ParseElementData(XMLTag& tag, FEDomainMap& map)
 		}
 		else if (nread == m * dataSize)
 		{
-			double* v = data;
 			for (int i = 0; i < m; ++i, v += dataSize)
 			{
 				switch (dataType)
@@ -524,7 +610,40 @@ void FEBioMeshDataSection4::ParseElementData(XMLTag& tag, FEDomainMap& map)
 				}
 			}
 		}
-		else throw XMLReader::InvalidValue(tag);
+		else return false;
+		return true;
+	};
+
+	// Try the bulk reader first. If that fails, we rewind and process the 
+	// tags one by one, which also reports the offending tag. 
+	XMLTag tag0(tag);
+	vector<int> lid, count;
+	vector<double> val;
+	if (tag.readLeafValues("lid", lid, count, val, m * dataSize))
+	{
+		bool bok = true;
+		for (int i = 0; bok && (i < (int)lid.size()); ++i) bok = setValue(lid[i] - 1, &val[i*m*dataSize], count[i]);
+		if (bok)
+		{
+			if ((int)lid.size() != nelems) throw FEBioImport::MeshDataError();
+			return;
+		}
+		tag = tag0;
+	}
+
+	int ncount = 0;
+	++tag;
+	do
+	{
+		// get the local element number
+		const char* szlid = tag.AttributeValue("lid");
+		int n = atoi(szlid) - 1;
+
+		// make sure the number is valid
+		if ((n < 0) || (n >= nelems)) throw XMLReader::InvalidAttributeValue(tag, "lid", szlid);
+
+		int nread = tag.value(data, m * dataSize);
+		if (setValue(n, data, nread) == false) throw XMLReader::InvalidValue(tag);
 		++tag;
 
 		ncount++;
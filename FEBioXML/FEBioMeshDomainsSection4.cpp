@@ -41,6 +41,22 @@ FEBioMeshDomainsSection4::FEBioMeshDomainsSection4(FEBioImport* pim) : FEBioFile
 
 void FEBioMeshDomainsSection4::Parse(XMLTag& tag)
 {
+	// see if the nodes and elements should be reordered for better memory locality
+	const char* szreorder = tag.AttributeValue("reorder", true);
+	if (szreorder)
+	{
+		int method = FEBModel::NO_REORDER;
+		if      (strcmp(szreorder, "none") == 0) method = FEBModel::NO_REORDER;
+		else if (strcmp(szreorder, "rcm" ) == 0) method = FEBModel::RCM_REORDER;
+		else if (strcmp(szreorder, "sfc" ) == 0) method = FEBModel::SFC_REORDER;
+		else throw XMLReader::InvalidAttributeValue(tag, "reorder", szreorder);
+
+		// This must be done before the domains are created, so the mesh's storage
+		// order follows the new order.
+		FEBModel& feb = GetBuilder()->GetFEBModel();
+		for (size_t i = 0; i < feb.Parts(); ++i) feb.GetPart((int)i)->Reorder(method);
+	}
+
 	// build the node ID lookup table
 	BuildNLT();
 	
@@ -0,0 +1,466 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+#include "stdafx.h"
+#include "FEBioMeshFile.h"
+#include <FECore/FEMesh.h>
+#include <FECore/FEDomain.h>
+#include <FECore/FENodeSet.h>
+#include <FECore/FEElementSet.h>
+#include <FECore/FEFacetSet.h>
+#include <FECore/FENodeDataMap.h>
+#include <FECore/FEDomainMap.h>
+#include <FECore/FESurfaceMap.h>
+#include <stdio.h>
+#include <string.h>
+#ifdef WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+using namespace std;
+
+//-----------------------------------------------------------------------------
+// file header
+struct FEBM_HEADER
+{
+	char	magic[4];	// "FEBM"
+	int32_t	version;	// file version
+	int32_t	chunks;		// number of chunks
+	int32_t	reserved;
+};
+
+static_assert(sizeof(FEBM_HEADER) == 16, "invalid header size");
+static_assert(sizeof(FEBioMeshFile::Chunk) == 160, "invalid chunk size");
+
+//-----------------------------------------------------------------------------
+// returns the size of a value of a chunk
+static size_t chunkValueSize(int type)
+{
+	switch (type)
+	{
+	case FEBioMeshFile::NODE_POS:
+	case FEBioMeshFile::NODE_DATA:
+	case FEBioMeshFile::ELEM_DATA:
+	case FEBioMeshFile::SURFACE_DATA:
+		return sizeof(double);
+	default:
+		return sizeof(int32_t);
+	}
+}
+
+//-----------------------------------------------------------------------------
+FEBioMeshFile::FEBioMeshFile()
+{
+	m_data = nullptr;
+	m_size = 0;
+	m_handle = nullptr;
+}
+
+FEBioMeshFile::~FEBioMeshFile()
+{
+	Close();
+}
+
+//-----------------------------------------------------------------------------
+bool FEBioMeshFile::IsMeshFile(const char* szfile)
+{
+	FILE* fp = fopen(szfile, "rb");
+	if (fp == nullptr) return false;
+	char magic[4] = { 0 };
+	size_t nread = fread(magic, 1, 4, fp);
+	fclose(fp);
+	return ((nread == 4) && (strncmp(magic, "FEBM", 4) == 0));
+}
+
+//-----------------------------------------------------------------------------
+bool FEBioMeshFile::Open(const char* szfile)
+{
+	Close();
+
+#ifdef WIN32
+	HANDLE hf = CreateFileA(szfile, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (hf != INVALID_HANDLE_VALUE)
+	{
+		LARGE_INTEGER size;
+		HANDLE hm = NULL;
+		if (GetFileSizeEx(hf, &size) && (size.QuadPart > 0)) hm = CreateFileMappingA(hf, NULL, PAGE_READONLY, 0, 0, NULL);
+		CloseHandle(hf);
+		if (hm)
+		{
+			m_data = (const char*)MapViewOfFile(hm, FILE_MAP_READ, 0, 0, 0);
+			if (m_data) { m_size = (size_t)size.QuadPart; m_handle = hm; }
+			else CloseHandle(hm);
+		}
+	}
+#else
+	int fd = open(szfile, O_RDONLY);
+	if (fd >= 0)
+	{
+		struct stat st;
+		if ((fstat(fd, &st) == 0) && (st.st_size > 0))
+		{
+			void* p = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+			if (p != MAP_FAILED)
+			{
+				m_data = (const char*)p;
+				m_size = (size_t)st.st_size;
+				m_handle = p;
+			}
+		}
+		close(fd);
+	}
+#endif
+
+	// if the file could not be mapped, we read it into memory
+	if (m_data == nullptr)
+	{
+		FILE* fp = fopen(szfile, "rb");
+		if (fp == nullptr) return false;
+		fseek(fp, 0, SEEK_END);
+		long size = ftell(fp);
+		fseek(fp, 0, SEEK_SET);
+		if (size <= 0) { fclose(fp); return false; }
+		m_buf.resize(size);
+		size_t nread = fread(&m_buf[0], 1, size, fp);
+		fclose(fp);
+		if (nread != (size_t)size) { m_buf.clear(); return false; }
+		m_data = &m_buf[0];
+		m_size = m_buf.size();
+	}
+
+	// read the header
+	if (m_size < sizeof(FEBM_HEADER)) { Close(); return false; }
+	const FEBM_HEADER* hdr = (const FEBM_HEADER*)m_data;
+	if ((strncmp(hdr->magic, "FEBM", 4) != 0) || (hdr->version != FILE_VERSION) || (hdr->chunks < 0)) { Close(); return false; }
+
+	// read the chunk table
+	if ((size_t)hdr->chunks > (m_size - sizeof(FEBM_HEADER)) / sizeof(Chunk)) { Close(); return false; }
+	const Chunk* pc = (const Chunk*)(m_data + sizeof(FEBM_HEADER));
+	m_chunk.assign(pc, pc + hdr->chunks);
+	for (Chunk& c : m_chunk)
+	{
+		c.name[63] = 0;
+		c.info[63] = 0;
+		if (isValid(c) == false) { Close(); return false; }
+	}
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+void FEBioMeshFile::Close()
+{
+	if (m_handle)
+	{
+#ifdef WIN32
+		UnmapViewOfFile(m_data);
+		CloseHandle((HANDLE)m_handle);
+#else
+		munmap(m_handle, m_size);
+#endif
+	}
+	m_handle = nullptr;
+	m_data = nullptr;
+	m_size = 0;
+	m_buf.clear();
+	m_chunk.clear();
+}
+
+//-----------------------------------------------------------------------------
+bool FEBioMeshFile::isValid(const Chunk& c) const
+{
+	if ((c.type < NODE_ID) || (c.type > SURFACE_DATA)) return false;
+	if ((c.count < 0) || (c.ncols <= 0) || (c.offset < 0) || (c.offset % 8 != 0)) return false;
+
+	// The items are indexed with ints, and the size of the data is checked against
+	// the remaining bytes with a division, so the counts in the file cannot overflow.
+	if ((c.count > INT32_MAX) || (c.count*c.ncols > INT32_MAX)) return false;
+	if ((uint64_t)c.offset > (uint64_t)m_size) return false;
+	uint64_t avail = (uint64_t)m_size - (uint64_t)c.offset;
+	uint64_t itemSize = (uint64_t)c.ncols * chunkValueSize(c.type);
+	return ((uint64_t)c.count <= avail / itemSize);
+}
+
+//-----------------------------------------------------------------------------
+const FEBioMeshFile::Chunk* FEBioMeshFile::FindChunk(int type, const char* szname) const
+{
+	for (const Chunk& c : m_chunk)
+	{
+		if ((c.type == type) && (strcmp(c.name, szname) == 0)) return &c;
+	}
+	return nullptr;
+}
+
+//-----------------------------------------------------------------------------
+const int* FEBioMeshFile::IntData(const Chunk& c) const
+{
+	assert(chunkValueSize(c.type) == sizeof(int32_t));
+	return (const int*)(m_data + c.offset);
+}
+
+const double* FEBioMeshFile::DoubleData(const Chunk& c) const
+{
+	assert(chunkValueSize(c.type) == sizeof(double));
+	return (const double*)(m_data + c.offset);
+}
+
+//=============================================================================
+// writing
+//=============================================================================
+
+// helper class for collecting the chunks
+class FEBioMeshFileWriter
+{
+public:
+	bool AddChunk(int type, const string& name, const string& info, int ncols, int64_t count, const void* data, int dataType = 0, int format = 0)
+	{
+		if ((name.size() >= 64) || (info.size() >= 64)) return false;
+		FEBioMeshFile::Chunk c;
+		memset(&c, 0, sizeof(c));
+		c.type = type;
+		c.ncols = ncols;
+		c.count = count;
+		c.offset = 0;
+		c.dataType = dataType;
+		c.format = format;
+		strcpy(c.name, name.c_str());
+		strcpy(c.info, info.c_str());
+
+		size_t bytes = (size_t)count * ncols * chunkValueSize(type);
+		vector<char> buf(bytes);
+		if (bytes > 0) memcpy(&buf[0], data, bytes);
+
+		m_chunk.push_back(c);
+		m_data.push_back(std::move(buf));
+		return true;
+	}
+
+	bool Write(const char* szfile)
+	{
+		// assign the offsets (8-byte aligned)
+		int64_t offset = sizeof(FEBM_HEADER) + m_chunk.size() * sizeof(FEBioMeshFile::Chunk);
+		for (size_t i = 0; i < m_chunk.size(); ++i)
+		{
+			offset = (offset + 7) & ~(int64_t)7;
+			m_chunk[i].offset = offset;
+			offset += (int64_t)m_data[i].size();
+		}
+
+		FILE* fp = fopen(szfile, "wb");
+		if (fp == nullptr) return false;
+
+		FEBM_HEADER hdr;
+		memcpy(hdr.magic, "FEBM", 4);
+		hdr.version = FEBioMeshFile::FILE_VERSION;
+		hdr.chunks = (int32_t)m_chunk.size();
+		hdr.reserved = 0;
+		fwrite(&hdr, sizeof(hdr), 1, fp);
+		if (m_chunk.empty() == false) fwrite(&m_chunk[0], sizeof(FEBioMeshFile::Chunk), m_chunk.size(), fp);
+
+		int64_t pos = sizeof(FEBM_HEADER) + m_chunk.size() * sizeof(FEBioMeshFile::Chunk);
+		const char zero[8] = { 0 };
+		for (size_t i = 0; i < m_chunk.size(); ++i)
+		{
+			fwrite(zero, 1, (size_t)(m_chunk[i].offset - pos), fp);
+			if (m_data[i].empty() == false) fwrite(&m_data[i][0], 1, m_data[i].size(), fp);
+			pos = m_chunk[i].offset + (int64_t)m_data[i].size();
+		}
+
+		bool bok = (ferror(fp) == 0);
+		fclose(fp);
+		return bok;
+	}
+
+private:
+	vector<FEBioMeshFile::Chunk>	m_chunk;
+	vector<vector<char> >			m_data;
+};
+
+//-----------------------------------------------------------------------------
+// returns the type string that identifies the element type in the input file
+static const char* elementTypeString(int etype)
+{
+	switch (etype)
+	{
+	case FE_HEX8G8         : return "HEX8G8";
+	case FE_HEX8G1         : return "HEX8G1";
+	case FE_TET4G1         : return "tet4";
+	case FE_TET4G4         : return "TET4G4";
+	case FE_TET5G4         : return "tet5";
+	case FE_PENTA6G6       : return "penta6";
+	case FE_TET10G4        : return "TET10G4";
+	case FE_TET10G8        : return "TET10G8";
+	case FE_TET10GL11      : return "TET10GL11";
+	case FE_TET15G8        : return "TET15G8";
+	case FE_TET15G11       : return "TET15G11";
+	case FE_TET15G15       : return "TET15G15";
+	case FE_TET20G15       : return "tet20";
+	case FE_HEX20G8        : return "HEX20G8";
+	case FE_HEX20G27       : return "hex20";
+	case FE_HEX27G27       : return "hex27";
+	case FE_PENTA15G8      : return "PENTA15G8";
+	case FE_PENTA15G21     : return "penta15";
+	case FE_PYRA5G8        : return "pyra5";
+	case FE_PYRA13G8       : return "pyra13";
+	case FE_SHELL_QUAD4G4  : return "q4s";
+	case FE_SHELL_QUAD4G8  : return "QUAD4G8";
+	case FE_SHELL_QUAD4G12 : return "QUAD4G12";
+	case FE_SHELL_QUAD8G18 : return "QUAD8G18";
+	case FE_SHELL_QUAD8G27 : return "QUAD8G27";
+	case FE_SHELL_TRI3G3   : return "tri3s";
+	case FE_SHELL_TRI3G6   : return "TRI3G6";
+	case FE_SHELL_TRI3G9   : return "TRI3G9";
+	case FE_SHELL_TRI6G14  : return "TRI6G14";
+	case FE_SHELL_TRI6G21  : return "TRI6G21";
+	case FE2D_TRI3G1       : return "TRI3G1_2D";
+	case FE2D_TRI6G3       : return "TRI6G3_2D";
+	case FE2D_QUAD4G4      : return "QUAD4G4_2D";
+	case FE2D_QUAD8G9      : return "QUAD8G9_2D";
+	case FE2D_QUAD9G9      : return "QUAD9G9_2D";
+	case FE_TRUSS          : return "truss2";
+	case FE_LINE2G1        : return "line2";
+	}
+	return nullptr;
+}
+
+//-----------------------------------------------------------------------------
+bool FEBioMeshFile::Write(FEMesh& mesh, const char* szfile)
+{
+	FEBioMeshFileWriter out;
+
+	// nodes
+	int NN = mesh.Nodes();
+	vector<int> nid(NN);
+	vector<double> r(3 * NN);
+	for (int i = 0; i < NN; ++i)
+	{
+		FENode& node = mesh.Node(i);
+		nid[i] = node.GetID();
+		r[3 * i] = node.m_r0.x; r[3 * i + 1] = node.m_r0.y; r[3 * i + 2] = node.m_r0.z;
+	}
+	out.AddChunk(NODE_ID, "", "", 1, NN, nid.data());
+	out.AddChunk(NODE_POS, "", "", 3, NN, r.data());
+
+	// domains
+	for (int i = 0; i < mesh.Domains(); ++i)
+	{
+		FEDomain& dom = mesh.Domain(i);
+		int NE = dom.Elements();
+		if (NE == 0) continue;
+
+		const char* sztype = elementTypeString(dom.ElementRef(0).Type());
+		if (sztype == nullptr) return false;
+
+		int neln = dom.ElementRef(0).Nodes();
+		vector<int> eid(NE), enode(NE * neln);
+		for (int j = 0; j < NE; ++j)
+		{
+			FEElement& el = dom.ElementRef(j);
+			if (el.Nodes() != neln) return false;
+			eid[j] = el.GetID();
+			for (int k = 0; k < neln; ++k) enode[j*neln + k] = mesh.Node(el.m_node[k]).GetID();
+		}
+		if (out.AddChunk(ELEM_ID, dom.GetName(), sztype, 1, NE, eid.data()) == false) return false;
+		if (out.AddChunk(ELEM_NODE, dom.GetName(), sztype, neln, NE, enode.data()) == false) return false;
+	}
+
+	// node sets
+	for (int i = 0; i < mesh.NodeSets(); ++i)
+	{
+		FENodeSet& set = *mesh.NodeSet(i);
+		vector<int> ids(set.Size());
+		for (int j = 0; j < set.Size(); ++j) ids[j] = mesh.Node(set[j]).GetID();
+		if (out.AddChunk(NODE_SET, set.GetName(), "", 1, ids.size(), ids.data()) == false) return false;
+	}
+
+	// element sets
+	for (int i = 0; i < mesh.ElementSets(); ++i)
+	{
+		FEElementSet& set = mesh.ElementSet(i);
+		const vector<int>& ids = set.GetElementIDList();
+		if (out.AddChunk(ELEM_SET, set.GetName(), "", 1, ids.size(), ids.data()) == false) return false;
+	}
+
+	// surfaces
+	for (int i = 0; i < mesh.FacetSets(); ++i)
+	{
+		FEFacetSet& set = mesh.FacetSet(i);
+		int NF = set.Faces();
+		int maxn = 0;
+		for (int j = 0; j < NF; ++j) if (set.Face(j).ntype > maxn) maxn = set.Face(j).ntype;
+		int ncols = 2 + maxn;
+		vector<int> data(NF * ncols, 0);
+		for (int j = 0; j < NF; ++j)
+		{
+			const FEFacetSet::FACET& f = set.Face(j);
+			int* d = &data[j*ncols];
+			d[0] = j + 1;
+			d[1] = f.ntype;
+			for (int k = 0; k < f.ntype; ++k) d[2 + k] = mesh.Node(f.node[k]).GetID();
+		}
+		if (out.AddChunk(SURFACE, set.GetName(), "", ncols, NF, data.data()) == false) return false;
+	}
+
+	// data maps
+	for (int i = 0; i < mesh.DataMaps(); ++i)
+	{
+		FEDataMap* map = mesh.GetDataMap(i);
+		const double* data = map->data();
+		int dataSize = map->DataSize();
+
+		if (dynamic_cast<FENodeDataMap*>(map))
+		{
+			FENodeDataMap& m = dynamic_cast<FENodeDataMap&>(*map);
+			const FENodeSet* set = m.GetNodeSet();
+			if ((set == nullptr) || (set->GetName().empty())) continue;
+			if (out.AddChunk(NODE_DATA, m.GetName(), set->GetName(), dataSize, m.DataCount(), data, m.DataType(), FMT_NODE) == false) return false;
+		}
+		else if (dynamic_cast<FEDomainMap*>(map))
+		{
+			FEDomainMap& m = dynamic_cast<FEDomainMap&>(*map);
+			const FEElementSet* set = m.GetElementSet();
+			if ((set == nullptr) || (set->GetName().empty()) || (set->Elements() == 0)) continue;
+			int ncols = m.BufferSize() / set->Elements();
+			if (out.AddChunk(ELEM_DATA, m.GetName(), set->GetName(), ncols, set->Elements(), data, m.DataType(), m.StorageFormat()) == false) return false;
+		}
+		else if (dynamic_cast<FESurfaceMap*>(map))
+		{
+			FESurfaceMap& m = dynamic_cast<FESurfaceMap&>(*map);
+			const FEFacetSet* set = m.GetFacetSet();
+			if ((set == nullptr) || (set->GetName().empty()) || (set->Faces() == 0)) continue;
+			int ncols = m.BufferSize() / set->Faces();
+			if (out.AddChunk(SURFACE_DATA, m.GetName(), set->GetName(), ncols, set->Faces(), data, m.DataType(), m.StorageFormat()) == false) return false;
+		}
+	}
+
+	return out.Write(szfile);
+}
@@ -0,0 +1,114 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+
+
+
+#pragma once
+#include "febioxml_api.h"
+#include <vector>
+#include <string>
+#include <stdint.h>
+
+class FEMesh;
+
+//-----------------------------------------------------------------------------
+// Binary mesh file (.febm). This is a container for the geometry of a model that
+// can be used instead of the Mesh and MeshData sections of a .feb file via the
+// "from" attribute, e.g. <Mesh from="model.febm"/>. 
+// The file consists of a header, a table of chunks, and the chunk data. Each chunk
+// is a raw array (int32 or float64, depending on the chunk type) of count x ncols values.
+// The data is stored in native byte order and each array starts on an 8-byte boundary,
+// so the arrays can be used directly from the memory-mapped file.
+class FEBIOXML_API FEBioMeshFile
+{
+public:
+	enum { FILE_VERSION = 1 };
+
+	enum ChunkType
+	{
+		NODE_ID,		// int   : node IDs
+		NODE_POS,		// double: nodal coordinates (ncols = 3)
+		ELEM_ID,		// int   : element IDs of a domain (info = element type)
+		ELEM_NODE,		// int   : element connectivity (node IDs) of a domain
+		NODE_SET,		// int   : node IDs
+		ELEM_SET,		// int   : element IDs
+		SURFACE,		// int   : facet ID, nr of nodes, node IDs (ncols = 2 + max nodes)
+		NODE_DATA,		// double: node data map (info = node set)
+		ELEM_DATA,		// double: element data map (info = element set)
+		SURFACE_DATA	// double: surface data map (info = surface)
+	};
+
+	struct Chunk
+	{
+		int32_t	type;		// chunk type
+		int32_t	ncols;		// number of values per item
+		int64_t	count;		// number of items
+		int64_t	offset;		// file offset of the data
+		int32_t	dataType;	// data type (data maps only)
+		int32_t	format;		// storage format (data maps only)
+		char	name[64];	// name of the domain, set, or data map
+		char	info[64];	// element type, or the set that a data map is defined on
+	};
+
+public:
+	FEBioMeshFile();
+	~FEBioMeshFile();
+
+	// see if a file is a binary mesh file
+	static bool IsMeshFile(const char* szfile);
+
+	// open (and memory-map) a binary mesh file
+	bool Open(const char* szfile);
+
+	// close the file
+	void Close();
+
+	int Chunks() const { return (int)m_chunk.size(); }
+	const Chunk& GetChunk(int i) const { return m_chunk[i]; }
+
+	// find a chunk of a particular type and name
+	const Chunk* FindChunk(int type, const char* szname) const;
+
+	// get a pointer to the chunk's data
+	const int* IntData(const Chunk& c) const;
+	const double* DoubleData(const Chunk& c) const;
+
+	// write the mesh (and its data maps) to a binary mesh file
+	static bool Write(FEMesh& mesh, const char* szfile);
+
+private:
+	bool isValid(const Chunk& c) const;
+
+private:
+	std::vector<Chunk>	m_chunk;
+	const char*			m_data;		// start of the mapped file
+	size_t				m_size;		// size of the mapped file
+	std::vector<char>	m_buf;		// used when the file could not be mapped
+	void*				m_handle;
+};
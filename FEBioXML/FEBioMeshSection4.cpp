@@ -28,7 +28,9 @@ SOFTWARE.*/
 
 #include "stdafx.h"
 #include "FEBioMeshSection4.h"
+#include "FEBioMeshFile.h"
 #include <FECore/FEModel.h>
+#include <FECore/log.h>
 #include <sstream>
 
 //-----------------------------------------------------------------------------
@@ -70,6 +72,140 @@ void FEBioMeshSection4::Parse(XMLTag& tag)
 	while (!tag.isend());
 }
 
+//-----------------------------------------------------------------------------
+//! Reads the mesh from a binary mesh file. 
+bool FEBioMeshSection4::ParseBinary(FEBioMeshFile& file)
+{
+	FEModelBuilder* builder = GetBuilder();
+	builder->m_maxid = 0;
+	m_maxNodeId = 0;
+
+	// create a default part
+	FEBModel& feb = builder->GetFEBModel();
+	assert(feb.Parts() == 0);
+	FEBModel::Part* part = feb.AddPart("");
+
+	for (int i = 0; i < file.Chunks(); ++i)
+	{
+		const FEBioMeshFile::Chunk& c = file.GetChunk(i);
+		int N = (int)c.count;
+		switch (c.type)
+		{
+		case FEBioMeshFile::NODE_ID:
+		{
+			const FEBioMeshFile::Chunk* pos = file.FindChunk(FEBioMeshFile::NODE_POS, c.name);
+			if ((pos == nullptr) || (pos->count != c.count) || (pos->ncols != 3)) return false;
+
+			const int* id = file.IntData(c);
+			const double* r = file.DoubleData(*pos);
+			vector<FEBModel::NODE> node(N);
+			for (int j = 0; j < N; ++j)
+			{
+				// make sure node IDs are incrementing
+				if (id[j] <= m_maxNodeId) return false;
+				m_maxNodeId = id[j];
+
+				node[j].id = id[j];
+				node[j].r = vec3d(r[3*j], r[3*j + 1], r[3*j + 2]);
+			}
+			part->AddNodes(node);
+		}
+		break;
+		case FEBioMeshFile::ELEM_ID:
+		{
+			const FEBioMeshFile::Chunk* con = file.FindChunk(FEBioMeshFile::ELEM_NODE, c.name);
+			if ((con == nullptr) || (con->count != c.count) || (con->ncols > FEElement::MAX_NODES)) return false;
+
+			FE_Element_Spec espec = builder->ElementSpec(c.info);
+			if (FEElementLibrary::IsValid(espec) == false) throw FEBioImport::InvalidElementType();
+
+			// the connectivity must match the element type
+			int neln = con->ncols;
+			if (FEElementLibrary::GetElementTraits(espec.etype)->m_neln != neln)
+			{
+				feLogErrorEx(GetFEModel(), "Invalid number of nodes for elements of domain %s.", c.name);
+				return false;
+			}
+
+			// as in the xml format, element IDs must be increasing within each domain
+			const int* id = file.IntData(c);
+			const int* node = file.IntData(*con);
+			for (int j = 0; j < N; ++j)
+			{
+				if ((j > 0) && (id[j] <= id[j - 1]))
+				{
+					feLogErrorEx(GetFEModel(), "Invalid element ID %d in domain %s: element IDs must be increasing.", id[j], c.name);
+					return false;
+				}
+
+				// make sure the nodes were defined
+				for (int k = 0; k < neln; ++k)
+				{
+					int nk = node[j*neln + k];
+					if ((nk < 1) || (nk > m_maxNodeId))
+					{
+						feLogErrorEx(GetFEModel(), "Invalid node ID %d of element %d in domain %s.", nk, id[j], c.name);
+						return false;
+					}
+				}
+			}
+
+			if (part->FindDomain(c.name)) return false;
+			FEBModel::Domain* dom = new FEBModel::Domain(espec);
+			dom->SetName(c.name);
+			part->AddDomain(dom);
+
+			dom->Create(N);
+			for (int j = 0; j < N; ++j)
+			{
+				FEBModel::ELEMENT& el = dom->GetElement(j);
+				el.id = id[j];
+				for (int k = 0; k < neln; ++k) el.node[k] = node[j*neln + k];
+			}
+		}
+		break;
+		case FEBioMeshFile::NODE_SET:
+		{
+			if (part->FindNodeSet(c.name)) throw FEBioImport::RepeatedNodeSet(c.name);
+			const int* id = file.IntData(c);
+			FEBModel::NodeSet* set = new FEBModel::NodeSet(c.name);
+			set->SetNodeList(vector<int>(id, id + N));
+			part->AddNodeSet(set);
+		}
+		break;
+		case FEBioMeshFile::ELEM_SET:
+		{
+			if (part->FindElementSet(c.name)) throw FEBioImport::RepeatedElementSet(c.name);
+			const int* id = file.IntData(c);
+			FEBModel::ElementSet* set = new FEBModel::ElementSet(c.name);
+			set->SetElementList(vector<int>(id, id + N));
+			part->AddElementSet(set);
+		}
+		break;
+		case FEBioMeshFile::SURFACE:
+		{
+			if (part->FindSurface(c.name)) throw FEBioImport::RepeatedSurface(c.name);
+			FEBModel::Surface* surf = new FEBModel::Surface(c.name);
+			part->AddSurface(surf);
+			surf->Create(N);
+
+			const int* d = file.IntData(c);
+			for (int j = 0; j < N; ++j, d += c.ncols)
+			{
+				FEBModel::FACET& face = surf->GetFacet(j);
+				face.id = d[0];
+				face.ntype = d[1];
+				if ((face.ntype < 3) || (face.ntype > c.ncols - 2) || (face.ntype > FEElement::MAX_NODES)) return false;
+				for (int k = 0; k < face.ntype; ++k) face.node[k] = d[2 + k];
+			}
+		}
+		break;
+		}
+	}
+
+	return true;
+}
+
 //-----------------------------------------------------------------------------
 //! Reads the Nodes section of the FEBio input file
 void FEBioMeshSection4::ParseNodeSection(XMLTag& tag, FEBModel::Part* part)
@@ -89,8 +225,46 @@ void FEBioMeshSection4::ParseNodeSection(XMLTag& tag, FEBModel::Part* part)
 
 	// allocate node
 
-	vector<FEBModel::NODE> node; node.reserve(10000);
-	vector<int> nodeList; nodeList.reserve(10000);
+	vector<FEBModel::NODE> node;
+	vector<int> nodeList;
+
+	// Try the bulk reader first. If it cannot process this section, or the node IDs
+	// are invalid, we rewind and parse the nodes one by one below.
+	XMLTag tag0(tag);
+	vector<int> ids, count;
+	vector<double> r;
+	if (tag.readLeafValues("id", ids, count, r, 3))
+	{
+		int maxId = m_maxNodeId;
+		bool bok = true;
+		for (int i = 0; i < (int)ids.size(); ++i)
+		{
+			if ((ids[i] <= maxId) || (count[i] != 3)) { bok = false; break; }
+			maxId = ids[i];
+		}
+
+		if (bok)
+		{
+			int nn = (int)ids.size();
+			node.resize(nn);
+			for (int i = 0; i < nn; ++i)
+			{
+				FEBModel::NODE& nd = node[i];
+				nd.id = ids[i];
+				nd.r = vec3d(r[3*i], r[3*i+1], r[3*i+2]);
+			}
+			m_maxNodeId = maxId;
+
+			part->AddNodes(node);
+			if (ps) ps->SetNodeList(ids);
+			return;
+		}
+
+		tag = tag0;
+	}
+
+	node.reserve(10000);
+	nodeList.reserve(10000);
 
 	// read nodal coordinates
 	++tag;
@@ -164,6 +338,38 @@ void FEBioMeshSection4::ParseElementSection(XMLTag& tag, FEBModel::Part* part)
 		part->AddElementSet(pg);
 	}
 
+	// Try the bulk reader first. If it cannot process this section, or the element IDs
+	// are not increasing, we rewind and parse the elements one by one below.
+	XMLTag tag0(tag);
+	vector<int> ids, count, nodes;
+	const int NMAX = FEElement::MAX_NODES;
+	if (tag.readLeafValues("id", ids, count, nodes, NMAX))
+	{
+		bool bok = true;
+		for (int i = 1; i < (int)ids.size(); ++i)
+		{
+			if (ids[i] <= ids[i - 1]) { bok = false; break; }
+		}
+
+		if (bok)
+		{
+			int ne = (int)ids.size();
+			dom->Reserve(ne);
+			for (int i = 0; i < ne; ++i)
+			{
+				FEBModel::ELEMENT el;
+				el.id = ids[i];
+				for (int j = 0; j < NMAX; ++j) el.node[j] = nodes[i*NMAX + j];
+				dom->AddElement(el);
+			}
+
+			if (pg) pg->SetElementList(ids);
+			return;
+		}
+
+		tag = tag0;
+	}
+
 	dom->Reserve(10000);
 	vector<int> elemList; elemList.reserve(10000);
 
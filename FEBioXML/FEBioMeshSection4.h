@@ -39,6 +39,8 @@ public:
 
 	void Parse(XMLTag& tag);
 
+	bool ParseBinary(FEBioMeshFile& file) override;
+
 protected:
 	void ParseNodeSection       (XMLTag& tag, FEBModel::Part* part);
 	void ParseSurfaceSection    (XMLTag& tag, FEBModel::Part* part);
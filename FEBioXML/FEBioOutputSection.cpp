@@ -136,6 +136,16 @@ void FEBioOutputSection::ParseLogfile(XMLTag &tag)
 		const char* szdelim = tag.AttributeValue("delim", true);
 		const char* szformat = tag.AttributeValue("format", true);
 
+		// get the (optional) file type
+		int fileFormat = DataRecord::TEXT_FILE;
+		const char* sztype = tag.AttributeValue("type", true);
+		if (sztype)
+		{
+			if      (strcmp(sztype, "text"  ) == 0) fileFormat = DataRecord::TEXT_FILE;
+			else if (strcmp(sztype, "binary") == 0) fileFormat = DataRecord::BINARY_FILE;
+			else throw XMLReader::InvalidAttributeValue(tag, "type", sztype);
+		}
+
 		bool bcomment = true;
 		const char* szcomment = tag.AttributeValue("comments", true);
 		if (szcomment != 0)
@@ -275,6 +285,7 @@ void FEBioOutputSection::ParseLogfile(XMLTag &tag)
 		{
 			pdr->SetData(szdata);
 			if (szname != 0) pdr->SetName(szname); else pdr->SetName(szdata);
+			pdr->SetFileFormat(fileFormat);
 			if (szfile) pdr->SetFileName(szfile);
 			if (szdelim != 0) pdr->SetDelim(szdelim);
 			if (szformat != 0) pdr->SetFormat(szformat);
@@ -375,12 +375,17 @@ FEModelBuilder::NodeSetSet* FEModelBuilder::FindNodeSetSet(const char* szname)
 void FEModelBuilder::BuildNodeList()
 {
 	// find the min, max ID
-	// (We assume that they are given by the first and last node)
+	// (The nodes need not be sorted by ID, e.g. when they were reordered.)
 	FEMesh& mesh = m_fem.GetMesh();
 	int NN = mesh.Nodes();
 	int nmin = mesh.Node(0).GetID();
-	int nmax = mesh.Node(NN - 1).GetID();
-	assert(nmax >= nmin);
+	int nmax = nmin;
+	for (int i = 1; i < NN; ++i)
+	{
+		int nid = mesh.Node(i).GetID();
+		if (nid < nmin) nmin = nid;
+		if (nid > nmax) nmax = nid;
+	}
 
 	// get the range
 	int nn = nmax - nmin + 1;
@@ -502,6 +507,7 @@ FE_Element_Spec FEModelBuilder::ElementSpec(const char* sztype)
 
 	// for shells, don't overwrite m_pim->m_ntri3/6 or m_nquad4/8, since they are needed for surface definitions
 	FE_Element_Type stype = FE_ELEM_INVALID_TYPE;
+	bool b2d = false;
 	if      (strcmp(sztype, "hex8"   ) == 0) eshape = ET_HEX8;
 	else if (strcmp(sztype, "hex20"  ) == 0) eshape = ET_HEX20;
 	else if (strcmp(sztype, "hex27"  ) == 0) eshape = ET_HEX27;
@@ -568,6 +574,12 @@ FE_Element_Spec FEModelBuilder::ElementSpec(const char* sztype)
 		else if (strcmp(sztype, "TRI6G21"     ) == 0) { eshape = ET_TRI6; stype = FE_SHELL_TRI6G21; }
 		else if (strcmp(sztype, "HEX8G1"      ) == 0) { eshape = ET_HEX8; m_nhex8 = FE_HEX8G1; }
 		else if (strcmp(sztype, "HEX8G8"      ) == 0) { eshape = ET_HEX8; m_nhex8 = FE_HEX8G8; }
+		// 2D elements (independent of the active module)
+		else if (strcmp(sztype, "TRI3G1_2D"   ) == 0) { eshape = ET_TRI3 ; b2d = true; }
+		else if (strcmp(sztype, "TRI6G3_2D"   ) == 0) { eshape = ET_TRI6 ; b2d = true; }
+		else if (strcmp(sztype, "QUAD4G4_2D"  ) == 0) { eshape = ET_QUAD4; b2d = true; }
+		else if (strcmp(sztype, "QUAD8G9_2D"  ) == 0) { eshape = ET_QUAD8; b2d = true; }
+		else if (strcmp(sztype, "QUAD9G9_2D"  ) == 0) { eshape = ET_QUAD9; b2d = true; }
 		else
 		{
 			assert(false);
@@ -578,7 +590,7 @@ FE_Element_Spec FEModelBuilder::ElementSpec(const char* sztype)
 	// NOTE: This is only used by quad/tri elements.
 	// TODO: find a better way
 	int NDIM = 3;
-	if (GetModuleName() == "fluid") NDIM = 2;
+	if ((GetModuleName() == "fluid") || b2d) NDIM = 2;
 
 	// determine the element type
 	FE_Element_Type etype = FE_ELEM_INVALID_TYPE;
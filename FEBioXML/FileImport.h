@@ -118,6 +118,9 @@ private:
 	vector<FEObsoleteParam>	m_param;
 };
 
+//-----------------------------------------------------------------------------
+class FEBioMeshFile;
+
 //-----------------------------------------------------------------------------
 // Base class for XML sections parsers
 class FEBIOXML_API FEFileSection
@@ -128,6 +131,10 @@ public:
 
 	virtual void Parse(XMLTag& tag) = 0;
 
+	// Read the section from a binary mesh file. Only sections that can be stored
+	// in a binary mesh file override this.
+	virtual bool ParseBinary(FEBioMeshFile& file) { return false; }
+
 	FEFileImport* GetFileReader() { return m_pim; }
 
 	FEModel* GetFEModel();
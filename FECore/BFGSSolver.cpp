@@ -102,6 +102,7 @@ bool BFGSSolver::Update(double s, vector<double>& ui, vector<double>& R0, vector
 
 	// calculate the BFGS update vectors
 	int neq = m_neq;
+#pragma omp parallel for if (neq > MIN_PARALLEL_SIZE)
 	for (int i = 0; i<neq; ++i)
 	{
 		m_D[i] = s*ui[i];
@@ -137,6 +138,7 @@ bool BFGSSolver::Update(double s, vector<double>& ui, vector<double>& R0, vector
 		double* vn = m_V[n];
 		double* wn = m_W[n];
 
+#pragma omp parallel for if (neq > MIN_PARALLEL_SIZE)
 		for (int i=0; i<neq; ++i)	
 		{
 			vn[i] = -m_H[i]*c - m_G[i];
@@ -174,17 +176,19 @@ void BFGSSolver::SolveEquations(vector<double>& x, vector<double>& b)
 	}
 
 	// loop over all update vectors
-	for (int i=nups-1; i>=0; --i)
+	// The update tmp += v_i*(w_i.tmp) is fused with the dot product
+	// that is needed by the next update, so each update takes one pass.
+	if (nups > 0)
 	{
-		int n = (n0 + i) % m_max_buf_size;
-
-		double* vi = m_V[n];
-		double* wi = m_W[n];
-
-		double wr = 0;
-		for (int j = 0; j<m_neq; j++) wr += wi[j] * tmp[j];
-
-		for (int j = 0; j<m_neq; j++) tmp[j] += vi[j] * wr;
+		int nl = (n0 + nups - 1) % m_max_buf_size;
+		double wr = vdot(m_W[nl], &tmp[0], m_neq);
+		for (int i = nups - 1; i > 0; --i)
+		{
+			int n = (n0 + i) % m_max_buf_size;
+			int m = (n0 + i - 1) % m_max_buf_size;
+			wr = vaxpy_dot(&tmp[0], wr, m_V[n], m_W[m], m_neq);
+		}
+		vaxpy(&tmp[0], wr, m_V[n0], m_neq);
 	}
 
 	// perform a backsubstitution
@@ -194,16 +198,16 @@ void BFGSSolver::SolveEquations(vector<double>& x, vector<double>& b)
 	}
 
 	// loop again over all update vectors
-	for (int i = 0; i<nups; ++i)
+	if (nups > 0)
 	{
-		int n = (n0 + i) % m_max_buf_size;
-
-		double* vi = m_V[n];
-		double* wi = m_W[n];
-
-		double vr = 0;
-		for (int j = 0; j<m_neq; ++j) vr += vi[j] * x[j];
-
-		for (int j = 0; j<m_neq; ++j) x[j] += wi[j] * vr;
+		double vr = vdot(m_V[n0], &x[0], m_neq);
+		for (int i = 0; i < nups - 1; ++i)
+		{
+			int n = (n0 + i) % m_max_buf_size;
+			int m = (n0 + i + 1) % m_max_buf_size;
+			vr = vaxpy_dot(&x[0], vr, m_W[n], m_V[m], m_neq);
+		}
+		int nl = (n0 + nups - 1) % m_max_buf_size;
+		vaxpy(&x[0], vr, m_W[nl], m_neq);
 	}
 }
@@ -266,6 +266,51 @@ void CompactSymmMatrix::Assemble(const matrix& ke, const vector<int>& LMi, const
 	}
 }
 
+//-----------------------------------------------------------------------------
+//! Since only the lower triangular part of the global matrix is stored, each
+//! pair (i,j) of the element matrix only has to be visited once, so we can 
+//! take the values directly from the upper triangular part of ke.
+void CompactSymmMatrix::AssembleUpper(const matrix& ke, const vector<int>& LM)
+{
+	const int N = ke.rows();
+
+	int* indices = Indices();
+	int* pointers = Pointers();
+	double* values = Values();
+
+	for (int i = 0; i<N; ++i)
+	{
+		int I = LM[i];
+		if (I < 0) continue;
+
+		for (int j = i; j<N; ++j)
+		{
+			int J = LM[j];
+			if (J < 0) continue;
+
+			// (I,J) is stored in the lower-diagonal part of stiffness matrix
+			int r = (I >= J ? I : J);
+			int c = (I >= J ? J : I);
+
+			// if two entries of lm refer to the same equation, the diagonal
+			// gets a contribution from both ke[i][j] and ke[j][i]
+			double v = ke[i][j];
+			if ((I == J) && (i != j)) v *= 2.0;
+
+			double* pv = values + (pointers[c] - m_offset);
+			int* pi = indices + (pointers[c] - m_offset);
+			int l = pointers[c + 1] - pointers[c];
+			for (int n = 0; n<l; ++n)
+				if (pi[n] - m_offset == r)
+				{
+					#pragma omp atomic
+					pv[n] += v;
+					break;
+				}
+		}
+	}
+}
+
 //-----------------------------------------------------------------------------
 //! add a matrix item
 void CompactSymmMatrix::add(int i, int j, double v)
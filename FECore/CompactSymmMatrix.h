@@ -51,6 +51,9 @@ public:
 	//! assemble a matrix into the sparse matrix
 	void Assemble(const matrix& ke, const std::vector<int>& lmi, const std::vector<int>& lmj) override;
 
+	//! assemble a symmetric matrix of which only the upper triangular part is defined
+	void AssembleUpper(const matrix& ke, const std::vector<int>& lm) override;
+
 	//! add a matrix item
 	void add(int i, int j, double v) override;
 
@@ -33,6 +33,7 @@ SOFTWARE.*/
 #include "FEAnalysis.h"
 #include "log.h"
 #include <sstream>
+#include <string.h>
 
 //-----------------------------------------------------------------------------
 UnknownDataField::UnknownDataField(const char* sz) : std::runtime_error(sz)
@@ -53,7 +54,8 @@ DataRecord::DataRecord(FEModel* pfem, int ntype) : FECoreBase(pfem), m_type(ntyp
 
 	m_fp = 0;
 	m_szfile[0] = 0;
-
+	m_fileFormat = TEXT_FILE;
+	m_bheader = false;
 }
 
 //-----------------------------------------------------------------------------
@@ -62,7 +64,8 @@ bool DataRecord::SetFileName(const char* szfile)
 	if (szfile == nullptr) return false;
 
 	strcpy(m_szfile, szfile);
-	m_fp = fopen(szfile, "wt");
+	m_fp = fopen(szfile, (m_fileFormat == BINARY_FILE ? "wb" : "wt"));
+	m_bheader = false;
 	if (m_fp == 0)
 	{
 		feLogError("FAILED CREATING DATA FILE %s\n\n", szfile);
@@ -108,26 +111,44 @@ bool DataRecord::Initialize()
 }
 
 //-----------------------------------------------------------------------------
-std::string DataRecord::printToString(int i)
+//! The default implementation calls Evaluate for each item and data field. 
+void DataRecord::EvaluateAll(std::vector<double>& data)
 {
-	std::stringstream ss;
-	ss.precision(12);
+	const int nitems = (int)m_item.size();
+	const int ndata = Size();
+	data.resize(nitems*ndata);
+	for (int i = 0; i < nitems; ++i)
+	{
+		double* v = &data[i*ndata];
+		for (int j = 0; j < ndata; ++j) v[j] = Evaluate(m_item[i], j);
+	}
+}
+
+//-----------------------------------------------------------------------------
+std::string DataRecord::printToString(int i, const double* val)
+{
+	char szval[64];
+	std::string s;
+	s.reserve(32*(Size() + 1));
 
-	ss << m_item[i] << m_szdelim;
+	snprintf(szval, sizeof(szval), "%d", m_item[i]);
+	s += szval;
+	s += m_szdelim;
 	int nd = Size();
 	for (int j = 0; j<nd; ++j)
 	{
-		double val = Evaluate(m_item[i], j);
-		ss << val;
-		if (j != nd - 1) ss << m_szdelim;
-		else ss << "\n";
+		// NOTE: this gives the same output as a stringstream with precision 12
+		snprintf(szval, sizeof(szval), "%.12lg", val[j]);
+		s += szval;
+		if (j != nd - 1) s += m_szdelim;
+		else s += "\n";
 	}
 
-	return ss.str();
+	return s;
 }
 
 //-----------------------------------------------------------------------------
-std::string DataRecord::printToFormatString(int i)
+std::string DataRecord::printToFormatString(int i, const double* val)
 {
 	int ndata = Size();
 	char szfmt[MAX_STRING];
@@ -164,8 +185,7 @@ std::string DataRecord::printToFormatString(int i)
 				*ch = '%'; sz = ch + 2;
 				if (j<ndata)
 				{
-					double val = Evaluate(nitem, j++);
-					ss << val;
+					ss << val[j++];
 				}
 			}
 			else if (ch[1] == 't')
@@ -210,8 +230,20 @@ bool DataRecord::Write()
 	feLog("Time = %.9lg\n", ftime);
 	feLog("Data = %s\n", m_szname);
 
-	// write some comments
+	// evaluate all the data
+	EvaluateAll(m_data);
+	const int ndata = Size();
+
+	// binary output goes straight to the file
 	FILE* fp = m_fp;
+	if (fp && (m_fileFormat == BINARY_FILE))
+	{
+		feLog("File = %s\n", m_szfile);
+		WriteBinary(nstep, ftime);
+		return true;
+	}
+
+	// write some comments
 	if (fp && m_bcomm)
 	{
 		// we save the data in a seperate file
@@ -228,9 +260,9 @@ bool DataRecord::Write()
 	{
 		for (size_t i=0; i<m_item.size(); ++i)
 		{
-			std::string out = printToString((int)i);
+			std::string out = printToString((int)i, &m_data[i*ndata]);
 
-			if (fp) fprintf(fp, "%s", out.c_str());
+			if (fp) fputs(out.c_str(), fp);
 			else feLog(out.c_str(),"");
 		}
 	}
@@ -239,9 +271,9 @@ bool DataRecord::Write()
 		// print using the format string
 		for (size_t i=0; i<m_item.size(); ++i)
 		{
-			std::string out = printToFormatString((int)i);
+			std::string out = printToFormatString((int)i, &m_data[i*ndata]);
 
-			if (fp) fprintf(fp, "%s", out.c_str());
+			if (fp) fputs(out.c_str(), fp);
 			else feLog(out.c_str(),"");
 		}
 	}
@@ -251,6 +283,58 @@ bool DataRecord::Write()
 	return true;
 }
 
+//-----------------------------------------------------------------------------
+// The binary file starts with a header:
+//   char[4]  "FEDR"
+//   int      version
+//   int      record type (FEDataRecordType)
+//   int      number of items
+//   int      number of data fields
+//   for each field: int length, followed by the field name (not null-terminated)
+//   int[]    item IDs
+// followed by a block for each time step that was written:
+//   int      time step
+//   double   time
+//   double[] data values (items x fields, i.e. all fields of the first item first)
+void DataRecord::WriteBinaryHeader()
+{
+	FILE* fp = m_fp;
+	const int version = 1;
+	const int nitems = (int)m_item.size();
+	const int ndata = Size();
+	fwrite("FEDR", 1, 4, fp);
+	fwrite(&version, sizeof(int), 1, fp);
+	fwrite(&m_type, sizeof(int), 1, fp);
+	fwrite(&nitems, sizeof(int), 1, fp);
+	fwrite(&ndata, sizeof(int), 1, fp);
+
+	// the field names are separated by semi-colons in the data string
+	const char* sz = m_szdata;
+	for (int i = 0; i < ndata; ++i)
+	{
+		const char* ch = strchr(sz, ';');
+		int l = (ch ? (int)(ch - sz) : (int)strlen(sz));
+		fwrite(&l, sizeof(int), 1, fp);
+		fwrite(sz, 1, l, fp);
+		sz = (ch ? ch + 1 : sz + l);
+	}
+
+	if (nitems > 0) fwrite(&m_item[0], sizeof(int), nitems, fp);
+	m_bheader = true;
+}
+
+//-----------------------------------------------------------------------------
+void DataRecord::WriteBinary(int nstep, double ftime)
+{
+	FILE* fp = m_fp;
+	if (m_bheader == false) WriteBinaryHeader();
+
+	fwrite(&nstep, sizeof(int), 1, fp);
+	fwrite(&ftime, sizeof(double), 1, fp);
+	if (m_data.empty() == false) fwrite(&m_data[0], sizeof(double), m_data.size(), fp);
+	fflush(fp);
+}
+
 //-----------------------------------------------------------------------------
 
 void DataRecord::SetItemList(const std::vector<int>& items)
@@ -279,6 +363,7 @@ void DataRecord::Serialize(DumpStream &ar)
 	ar & m_bcomm;
 	ar & m_item;
 	ar & m_szdata;
+	ar & m_fileFormat;
 
 	// when we're loading we need to reinitialize the file
 	if (ar.IsLoading())
@@ -290,7 +375,9 @@ void DataRecord::Serialize(DumpStream &ar)
 		if (m_szfile[0] != 0)
 		{
 			// reopen data file for appending
-			m_fp = fopen(m_szfile, "a+");
+			// (a binary file will already have its header)
+			m_fp = fopen(m_szfile, (m_fileFormat == BINARY_FILE ? "ab" : "a+"));
+			m_bheader = true;
 		}
 	}
 }
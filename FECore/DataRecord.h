@@ -69,6 +69,13 @@ class FECORE_API DataRecord : public FECoreBase
 
 public:
 	enum {MAX_DELIM=16, MAX_STRING=1024};
+
+	// output file formats
+	enum FileFormat {
+		TEXT_FILE,		// plain text (default)
+		BINARY_FILE		// binary file (see WriteBinary for layout)
+	};
+
 public:
 	DataRecord(FEModel* pfem, int ntype);
 	virtual ~DataRecord();
@@ -85,17 +92,28 @@ public:
 	void SetFormat(const char* sz);
 	void SetComments(bool b) { m_bcomm = b; }
 
+	// set the output file format (must be called before SetFileName)
+	void SetFileFormat(int fmt) { m_fileFormat = fmt; }
+	int FileFormat() const { return m_fileFormat; }
+
 public:
 	virtual bool Initialize();
 	virtual double Evaluate(int item, int ndata) = 0;
+
+	// Evaluate all data fields for all items. The values are stored in data as an
+	// items x fields array. Derived classes can override this for faster (e.g. parallel) evaluation.
+	virtual void EvaluateAll(std::vector<double>& data);
 	virtual void SelectAllItems() = 0;
 	virtual void Serialize(DumpStream& ar);
 	virtual void SetData(const char* sz) = 0;
 	virtual int Size() const = 0;
 
 private:
-	std::string printToString(int i);
-	std::string printToFormatString(int i);
+	std::string printToString(int i, const double* val);
+	std::string printToFormatString(int i, const double* val);
+
+	void WriteBinary(int nstep, double ftime);
+	void WriteBinaryHeader();
 
 public:
 	int					m_nid;		//!< ID of data record
@@ -112,6 +130,10 @@ protected:
 protected:
 	char	m_szfile[MAX_STRING];	//!< file name of data record
 	FILE*		m_fp;
+	int			m_fileFormat;		//!< output file format
+	bool		m_bheader;			//!< binary file header was written
+
+	std::vector<double>	m_data;		//!< buffer for evaluated values
 };
 
 //=========================================================================
@@ -0,0 +1,251 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+#include "stdafx.h"
+#include "EBEMatrix.h"
+#include "FENewtonSolver.h"
+#include "sys.h"
+
+EBEMatrix::EBEMatrix(FENewtonSolver* pns)
+{
+	m_nrow = m_ncol = pns->m_neq;
+	m_nsize = 0;
+}
+
+//! only the matrix size is taken from the profile
+void EBEMatrix::Create(SparseMatrixProfile& MP)
+{
+	// the profile is empty (see FEGlobalMatrix::Create), so only the row count is used
+	m_nrow = m_ncol = MP.Rows();
+	m_nsize = 0;
+
+	Zero();
+}
+
+void EBEMatrix::Zero()
+{
+	m_diag.assign(m_nrow, 0.0);
+	m_dset.assign(m_nrow, 0.0);
+	m_bset.assign(m_nrow, 0);
+
+	// one store per thread
+	int nthreads = 1;
+#pragma omp parallel
+	{
+#pragma omp single
+		nthreads = omp_get_num_threads();
+	}
+	if ((int)m_store.size() < nthreads) m_store.resize(nthreads);
+
+	// clear the stored matrices, but keep the memory for the next reformation
+	for (Store& s : m_store) s.clear();
+}
+
+void EBEMatrix::Clear()
+{
+	m_diag.clear();
+	m_dset.clear();
+	m_bset.clear();
+	std::vector<Store>().swap(m_store);
+}
+
+EBEMatrix::Store& EBEMatrix::ThreadStore()
+{
+	int n = omp_get_thread_num();
+	assert(n < (int)m_store.size());
+	return m_store[n];
+}
+
+bool EBEMatrix::mult_vector(double* x, double* r)
+{
+	const int neq = Rows();
+#pragma omp parallel for
+	for (int i = 0; i < neq; ++i) r[i] = 0.0;
+
+	// apply the stored element matrices
+	for (const Store& s : m_store) ApplyStore(s, x, r);
+
+	// The set entries replace the assembled diagonal
+	for (int i = 0; i < neq; ++i)
+	{
+		if (m_bset[i]) r[i] += (m_dset[i] - m_diag[i]) * x[i];
+	}
+
+	return true;
+}
+
+void EBEMatrix::ApplyStore(const Store& s, const double* x, double* r)
+{
+	const int nb = (int)s.blocks.size();
+#pragma omp parallel for schedule(dynamic, 64)
+	for (int n = 0; n < nb; ++n)
+	{
+		const Block& b = s.blocks[n];
+		const int* lmi = &s.ind[b.lm];
+		const int* lmj = lmi + b.nr;
+		const double* ke = &s.val[b.val];
+		if (b.upper)
+		{
+			// entry (i,j) with j >= i is stored at i*N - i*(i-1)/2 + (j-i)
+			const int N = b.nr;
+			for (int i = 0; i < N; ++i)
+			{
+				int I = lmi[i];
+				if (I >= 0)
+				{
+					double yi = 0.0;
+					for (int j = 0; j < N; ++j)
+					{
+						int J = lmi[j];
+						if (J >= 0)
+						{
+							int k = (j >= i ? i * N - i * (i - 1) / 2 + j - i : j * N - j * (j - 1) / 2 + i - j);
+							yi += ke[k] * x[J];
+						}
+					}
+#pragma omp atomic
+					r[I] += yi;
+				}
+			}
+		}
+		else
+		{
+			for (int i = 0; i < b.nr; ++i)
+			{
+				int I = lmi[i];
+				if (I >= 0)
+				{
+					const double* ki = ke + (size_t)i * b.nc;
+					double yi = 0.0;
+					for (int j = 0; j < b.nc; ++j)
+					{
+						int J = lmj[j];
+						if (J >= 0) yi += ki[j] * x[J];
+					}
+#pragma omp atomic
+					r[I] += yi;
+				}
+			}
+		}
+	}
+
+	// apply the single entries
+	for (const Entry& e : s.add) r[e.i] += e.v * x[e.j];
+}
+
+void EBEMatrix::Assemble(const matrix& ke, const std::vector<int>& lm)
+{
+	Assemble(ke, lm, lm);
+}
+
+void EBEMatrix::Assemble(const matrix& ke, const std::vector<int>& lmi, const std::vector<int>& lmj)
+{
+	const int N = (int)lmi.size();
+	const int M = (int)lmj.size();
+
+	// add the diagonal
+	for (int i = 0; i < N; ++i)
+	{
+		int I = lmi[i];
+		if (I >= 0)
+		{
+			for (int j = 0; j < M; ++j)
+			{
+				if (lmj[j] == I)
+				{
+#pragma omp atomic
+					m_diag[I] += ke[i][j];
+				}
+			}
+		}
+	}
+
+	// store the element matrix in the calling thread's store
+	Store& s = ThreadStore();
+	Block b;
+	b.lm = s.ind.size();
+	b.val = s.val.size();
+	b.nr = N;
+	b.nc = M;
+	b.upper = false;
+	s.blocks.push_back(b);
+
+	s.ind.insert(s.ind.end(), lmi.begin(), lmi.end());
+	s.ind.insert(s.ind.end(), lmj.begin(), lmj.end());
+	for (int i = 0; i < N; ++i) s.val.insert(s.val.end(), ke[i], ke[i] + M);
+}
+
+void EBEMatrix::AssembleUpper(const matrix& ke, const std::vector<int>& lm)
+{
+	const int N = (int)lm.size();
+
+	// add the diagonal
+	for (int i = 0; i < N; ++i)
+	{
+		int I = lm[i];
+		if (I >= 0)
+		{
+#pragma omp atomic
+			m_diag[I] += ke[i][i];
+		}
+	}
+
+	// store the upper triangular part, row by row
+	Store& s = ThreadStore();
+	Block b;
+	b.lm = s.ind.size();
+	b.val = s.val.size();
+	b.nr = b.nc = N;
+	b.upper = true;
+	s.blocks.push_back(b);
+
+	s.ind.insert(s.ind.end(), lm.begin(), lm.end());
+	for (int i = 0; i < N; ++i) s.val.insert(s.val.end(), ke[i] + i, ke[i] + N);
+}
+
+void EBEMatrix::set(int i, int j, double v)
+{
+	// Only the diagonal is ever set (e.g. for prescribed dofs). As in the 
+	// compact matrices, this replaces the diagonal entry only.
+	assert(i == j);
+	if (i != j) return;
+	m_dset[i] = v;
+	m_bset[i] = 1;
+}
+
+void EBEMatrix::add(int i, int j, double v)
+{
+	if (i == j)
+	{
+#pragma omp atomic
+		m_diag[i] += v;
+	}
+
+	Entry e = { i, j, v };
+	ThreadStore().add.push_back(e);
+}
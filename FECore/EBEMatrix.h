@@ -0,0 +1,126 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+#pragma once
+#include "SparseMatrix.h"
+
+class FENewtonSolver;
+
+//-----------------------------------------------------------------------------
+// Stored element-by-element (EBE) matrix. It is only used by the EBE Newton strategy.
+// No global sparse matrix (or its profile) is built. Instead, the element matrices
+// are stored as they are assembled (together with their equation numbers), and the 
+// product K*x is evaluated element by element from these stored matrices. 
+// Note that the stored element matrices usually take more memory than the assembled
+// global matrix, since the entries of shared nodes are not summed. Only the diagonal
+// and the set entries are stored per equation, so that a Jacobi preconditioner can be used.
+// Each thread stores its element matrices separately, so that the assembly does not 
+// need to be synchronized. The storage keeps its memory between reformations.
+class FECORE_API EBEMatrix : public SparseMatrix
+{
+public:
+	EBEMatrix(FENewtonSolver* pns);
+
+	//! multiply with vector (applies the stored element matrices)
+	bool mult_vector(double* x, double* r) override;
+
+	//! no profile is needed
+	bool NeedsProfile() const override { return false; }
+
+public:
+	//! clear the stored element matrices and the diagonal
+	void Zero() override;
+
+	//! only the matrix size is taken from the profile
+	void Create(SparseMatrixProfile& MP) override;
+
+	//! store an element matrix
+	void Assemble(const matrix& ke, const std::vector<int>& lm) override;
+
+	//! store an element matrix
+	void Assemble(const matrix& ke, const std::vector<int>& lmi, const std::vector<int>& lmj) override;
+
+	//! store a symmetric element matrix of which only the upper triangular part is defined
+	void AssembleUpper(const matrix& ke, const std::vector<int>& lm) override;
+
+	//! all entries can be addressed
+	bool check(int i, int j) override { return true; }
+
+	//! set entry to value (only diagonal entries are supported)
+	void set(int i, int j, double v) override;
+
+	//! add value to entry
+	void add(int i, int j, double v) override;
+
+	//! get the diagonal value
+	double diag(int i) override { return (m_bset[i] ? m_dset[i] : m_diag[i]); }
+
+	//! release memory for storing data
+	void Clear() override;
+
+private:
+	// a stored element matrix
+	struct Block
+	{
+		size_t	lm;		// offset of the row (followed by the column) indices in ind
+		size_t	val;	// offset of the values in val
+		int		nr, nc;	// number of rows and columns
+		bool	upper;	// only the upper triangular part is stored (row-wise, nr == nc)
+	};
+
+	// a single entry that was added
+	struct Entry
+	{
+		int		i, j;
+		double	v;
+	};
+
+	// the element matrices stored by one thread
+	struct Store
+	{
+		std::vector<Block>	blocks;	// the stored element matrices
+		std::vector<int>	ind;	// equation numbers of all blocks
+		std::vector<double>	val;	// values of all blocks
+		std::vector<Entry>	add;	// entries that were added
+
+		void clear() { blocks.clear(); ind.clear(); val.clear(); add.clear(); }
+	};
+
+	// get the store of the calling thread
+	Store& ThreadStore();
+
+	// apply the element matrices of one store
+	void ApplyStore(const Store& s, const double* x, double* r);
+
+private:
+	std::vector<double>	m_diag;		// the assembled diagonal (without the set entries)
+	std::vector<double>	m_dset;		// diagonal values that were set
+	std::vector<char>	m_bset;		// flags equations whose diagonal was set
+
+	std::vector<Store>	m_store;	// the stores of each thread
+};
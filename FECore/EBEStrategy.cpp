@@ -0,0 +1,92 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+#include "stdafx.h"
+#include "EBEStrategy.h"
+#include "FENewtonSolver.h"
+#include "EBEMatrix.h"
+#include "FEException.h"
+#include "LinearSolver.h"
+#include "log.h"
+
+EBEStrategy::EBEStrategy(FEModel* fem) : FENewtonStrategy(fem)
+{
+	// every iteration is a full Newton iteration
+	m_maxups = 0;
+
+	m_A = nullptr;
+	m_plinsolve = nullptr;
+}
+
+//! New initialization method
+bool EBEStrategy::Init()
+{
+	if (m_pns == nullptr) return false;
+	m_plinsolve = m_pns->GetLinearSolver();
+	return true;
+}
+
+SparseMatrix* EBEStrategy::CreateSparseMatrix(Matrix_Type mtype)
+{
+	// The matrix itself is owned (and deleted) by the FEGlobalMatrix
+	m_A = nullptr;
+
+	// make sure the linear solver is an iterative linear solver
+	IterativeLinearSolver* ls = dynamic_cast<IterativeLinearSolver*>(m_pns->m_plinsolve);
+	if (ls == nullptr)
+	{
+		feLogError("The EBE Newton strategy requires an iterative linear solver.");
+		return nullptr;
+	}
+
+	// Override the matrix used. The preconditioners only need the diagonal, 
+	// which the EBEMatrix assembles.
+	m_A = new EBEMatrix(m_pns);
+	ls->SetSparseMatrix(m_A);
+	if (ls->GetLeftPreconditioner()) ls->GetLeftPreconditioner()->SetSparseMatrix(m_A);
+	if (ls->GetRightPreconditioner()) ls->GetRightPreconditioner()->SetSparseMatrix(m_A);
+
+	return m_A;
+}
+
+//! there are no stiffness updates
+bool EBEStrategy::Update(double s, vector<double>& ui, vector<double>& R0, vector<double>& R1)
+{
+	// returning false will force a reformation, which evaluates and stores the element matrices
+	return false;
+}
+
+//! solve the equations
+void EBEStrategy::SolveEquations(vector<double>& x, vector<double>& b)
+{
+	// the Krylov solver applies the EBEMatrix in each iteration
+	if (m_plinsolve->BackSolve(x, b) == false)
+	{
+		throw LinearSolverFailed();
+	}
+}
@@ -86,6 +86,33 @@ double ElementDataRecord::Evaluate(int item, int ndata)
 	else return 0.0;
 }
 
+//-----------------------------------------------------------------------------
+//! Evaluates all the data in parallel. The element lookup is done once per item.
+void ElementDataRecord::EvaluateAll(std::vector<double>& data)
+{
+	// make sure we have an ELT (this must be done before the parallel loop)
+	if (m_ELT.empty()) BuildELT();
+
+	FEMesh& mesh = GetFEModel()->GetMesh();
+	const int nitems = (int)m_item.size();
+	const int ndata = Size();
+	data.resize(nitems*ndata);
+
+	#pragma omp parallel for
+	for (int i = 0; i < nitems; ++i)
+	{
+		double* v = &data[i*ndata];
+		int index = m_item[i] - m_offset;
+		if ((index >= 0) && (index < (int)m_ELT.size()))
+		{
+			ELEMREF& e = m_ELT[index];
+			FEElement& el = mesh.Domain(e.ndom).ElementRef(e.nid);
+			for (int j = 0; j < ndata; ++j) v[j] = m_Data[j]->value(el);
+		}
+		else for (int j = 0; j < ndata; ++j) v[j] = 0.0;
+	}
+}
+
 //-----------------------------------------------------------------------------
 void ElementDataRecord::BuildELT()
 {
@@ -59,6 +59,7 @@ class FECORE_API ElementDataRecord : public DataRecord
 public:
 	ElementDataRecord(FEModel* pfem);
 	double Evaluate(int item, int ndata);
+	void EvaluateAll(std::vector<double>& data) override;
 	void SetData(const char* sz) override;
 	void SelectAllItems();
 	int Size() const;
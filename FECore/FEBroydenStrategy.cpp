@@ -108,25 +108,20 @@ bool FEBroydenStrategy::Update(double s, vector<double>& ui, vector<double>& R0,
 		int n1 = (m_nups >= m_max_buf_size ? (m_nups) % m_max_buf_size : m_nups);
 
 		// loop over update vectors
-		for (int j = 0; j<nups; ++j)
-		{
-			int n = (n0 + j) % m_max_buf_size;
-
-			double w = 0.0;
-			for (int i = 0; i<m_neq; ++i) w += (m_D[n][i] * m_q[i]);
-
-			double g = m_rho[n] * w;
-			for (int i = 0; i<m_neq; ++i) m_q[i] += g*(m_D[n][i] - m_R[n][i]);
-		}
+		ApplyUpdates(n0, nups, nullptr);
 
 		// form and store the next update vector
 		double rhoi = 0.0;
-		for (int i = 0; i<m_neq; ++i)
+		double* Rn = m_R[n1];
+		double* Dn = m_D[n1];
+		const int neq = m_neq;
+#pragma omp parallel for reduction(+:rhoi) if (neq > MIN_PARALLEL_SIZE)
+		for (int i = 0; i<neq; ++i)
 		{
 			double ri = m_q[i] - ui[i];
 			double di = -s*ui[i];
-			m_R[n1][i] = ri;
-			m_D[n1][i] = di;
+			Rn[i] = ri;
+			Dn[i] = di;
 
 			rhoi += di*ri;
 		}
@@ -164,38 +159,55 @@ void FEBroydenStrategy::SolveEquations(vector<double>& x, vector<double>& b)
 			n1 = (m_nups - 1) % m_max_buf_size;
 		}
 
+		double rhoq = 0.0;
 		if (m_bnewStep)
 		{
 			m_q = x;
 			if (m_plinsolve->BackSolve(m_q, b) == false)
 				throw LinearSolverFailed();
 
-			for (int j = 0; j<nups - 1; ++j)
-			{
-				int n = (n0 + j) % m_max_buf_size;
-
-				double w = 0.0;
-				for (int i = 0; i<m_neq; ++i) w += (m_D[n][i] * m_q[i]);
-
-				double g = m_rho[n] * w;
-				for (int i = 0; i<m_neq; ++i) m_q[i] += g*(m_D[n][i] - m_R[n][i]);
-			}
+			// the last update is fused with the product below
+			rhoq = ApplyUpdates(n0, nups - 1, m_D[n1]);
 
 			m_bnewStep = false;
 		}
+		else rhoq = vdot(m_D[n1], &m_q[0], m_neq);
 
 		// calculate solution
-		double rho = 0.0;
-		for (int i = 0; i<m_neq; ++i) rho += m_D[n1][i] * m_q[i];
-		rho *= m_rho[n1];
+		double rho = rhoq * m_rho[n1];
 
-		for (int i = 0; i<m_neq; ++i)
+		const int neq = m_neq;
+		const double* Dn = m_D[n1];
+		const double* Rn = m_R[n1];
+#pragma omp parallel for if (neq > MIN_PARALLEL_SIZE)
+		for (int i = 0; i<neq; ++i)
 		{
-			x[i] = m_q[i] + rho*(m_D[n1][i] - m_R[n1][i]);
+			x[i] = m_q[i] + rho*(Dn[i] - Rn[i]);
 		}
 	}
 }
 
+//-----------------------------------------------------------------------------
+//! Apply the updates n0, ..., n0 + nups - 1 to m_q. Each update is fused with the
+//! dot product that the next one needs, so it only takes a single pass over m_q.
+//! If z is not null, the function returns z.q (after the updates).
+double FEBroydenStrategy::ApplyUpdates(int n0, int nups, const double* z)
+{
+	double* q = &m_q[0];
+	if (nups <= 0) return (z ? vdot(z, q, m_neq) : 0.0);
+
+	double w = vdot(m_D[n0 % m_max_buf_size], q, m_neq);
+	for (int j = 0; j < nups; ++j)
+	{
+		int n = (n0 + j) % m_max_buf_size;
+		double g = m_rho[n] * w;
+
+		const double* zn = (j < nups - 1 ? m_D[(n0 + j + 1) % m_max_buf_size] : z);
+		w = vaxmwy_dot(q, g, m_D[n], m_R[n], zn, m_neq);
+	}
+	return w;
+}
+
 /*
 //-----------------------------------------------------------------------------
 //! perform a quasi-Newton udpate
@@ -236,8 +248,8 @@ bool FEBroydenStrategy::Update(double s, vector<double>& ui, vector<double>& R0,
 		{
 			double ri = q[i] - ui[i];
 			double di = -s*ui[i];
-			m_R[n1][i] = ri;
-			m_D[n1][i] = di;
+			Rn[i] = ri;
+			Dn[i] = di;
 
 			rhoi += di*ri;
 		}
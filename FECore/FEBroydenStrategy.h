@@ -50,6 +50,10 @@ public:
 	//! Presolve update
 	virtual void PreSolveUpdate() override;
 
+private:
+	//! apply the Broyden updates to m_q
+	double ApplyUpdates(int n0, int nups, const double* z);
+
 private:
 	// keep a pointer to the linear solver
 	LinearSolver*	m_plinsolve;	//!< pointer to linear solver
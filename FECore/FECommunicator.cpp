@@ -0,0 +1,106 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+#include "stdafx.h"
+#include "FECommunicator.h"
+#include <assert.h>
+using namespace std;
+
+//-----------------------------------------------------------------------------
+void FELoopbackCommunicator::Send(int dest, int tag, const vector<double>& buf)
+{
+	assert(dest == 0);
+	m_queue[tag].push_back(buf);
+}
+
+//-----------------------------------------------------------------------------
+void FELoopbackCommunicator::Recv(int src, int tag, vector<double>& buf)
+{
+	assert(src == 0);
+	deque< vector<double> >& q = m_queue[tag];
+	assert(q.empty() == false);
+	if (q.empty()) { buf.clear(); return; }
+	buf.swap(q.front());
+	q.pop_front();
+}
+
+//=============================================================================
+FESharedMemoryHub::FESharedMemoryHub(int ranks) : m_ranks(ranks)
+{
+	m_count = 0;
+	m_generation = 0;
+	m_reduce.resize(ranks);
+}
+
+//-----------------------------------------------------------------------------
+void FESharedMemoryHub::Barrier()
+{
+	unique_lock<mutex> lock(m_mutex);
+	int gen = m_generation;
+	if (++m_count == m_ranks)
+	{
+		m_count = 0;
+		m_generation++;
+		m_cv.notify_all();
+	}
+	else m_cv.wait(lock, [&]() { return gen != m_generation; });
+}
+
+//-----------------------------------------------------------------------------
+void FESharedMemoryHub::AllReduceSum(int rank, double* v, int n)
+{
+	m_reduce[rank].assign(v, v + n);
+	Barrier();
+	for (int i = 0; i < n; ++i)
+	{
+		double s = 0.0;
+		for (int k = 0; k < m_ranks; ++k) s += m_reduce[k][i];
+		v[i] = s;
+	}
+	// make sure nobody overwrites its buffer before everybody is done reading
+	Barrier();
+}
+
+//-----------------------------------------------------------------------------
+void FESharedMemoryHub::Send(int src, int dest, int tag, const vector<double>& buf)
+{
+	assert((dest >= 0) && (dest < m_ranks));
+	lock_guard<mutex> lock(m_mutex);
+	m_mail[{src, dest, tag}].push_back(buf);
+	m_cv.notify_all();
+}
+
+//-----------------------------------------------------------------------------
+void FESharedMemoryHub::Recv(int src, int dest, int tag, vector<double>& buf)
+{
+	unique_lock<mutex> lock(m_mutex);
+	deque< vector<double> >& q = m_mail[{src, dest, tag}];
+	m_cv.wait(lock, [&]() { return (q.empty() == false); });
+	buf.swap(q.front());
+	q.pop_front();
+}
@@ -0,0 +1,136 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+#pragma once
+#include "fecore_api.h"
+#include <vector>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <condition_variable>
+
+//-----------------------------------------------------------------------------
+//! Abstract communication layer between the ranks of a domain-decomposed solve.
+//! Message passing implementations (e.g. MPI) derive from this class. Two 
+//! implementations are provided here: a single-rank loopback and a shared-memory
+//! transport where the ranks are threads of the same process.
+class FECORE_API FECommunicator
+{
+public:
+	FECommunicator() {}
+	virtual ~FECommunicator() {}
+
+	//! the rank of this process
+	virtual int Rank() const = 0;
+
+	//! the number of ranks
+	virtual int Size() const = 0;
+
+	//! wait until all ranks reach this point
+	virtual void Barrier() = 0;
+
+	//! sum the n values in v over all ranks (the result is returned in v on all ranks)
+	virtual void AllReduceSum(double* v, int n) = 0;
+
+	//! send a buffer to rank dest (this does not block)
+	virtual void Send(int dest, int tag, const std::vector<double>& buf) = 0;
+
+	//! receive a buffer from rank src (this blocks until the message arrived)
+	virtual void Recv(int src, int tag, std::vector<double>& buf) = 0;
+
+public:
+	double AllReduceSum(double v) { AllReduceSum(&v, 1); return v; }
+};
+
+//-----------------------------------------------------------------------------
+//! Communicator for a single rank. Messages can only be sent to itself.
+class FECORE_API FELoopbackCommunicator : public FECommunicator
+{
+public:
+	int Rank() const override { return 0; }
+	int Size() const override { return 1; }
+	void Barrier() override {}
+	void AllReduceSum(double* v, int n) override {}
+	void Send(int dest, int tag, const std::vector<double>& buf) override;
+	void Recv(int src, int tag, std::vector<double>& buf) override;
+
+private:
+	std::map<int, std::deque< std::vector<double> > >	m_queue;
+};
+
+//-----------------------------------------------------------------------------
+//! The shared state of the ranks that communicate through shared memory.
+//! Create one hub and one FESharedMemoryCommunicator per rank (i.e. per thread).
+class FECORE_API FESharedMemoryHub
+{
+public:
+	FESharedMemoryHub(int ranks);
+
+	int Ranks() const { return m_ranks; }
+
+private:
+	void Barrier();
+	void AllReduceSum(int rank, double* v, int n);
+	void Send(int src, int dest, int tag, const std::vector<double>& buf);
+	void Recv(int src, int dest, int tag, std::vector<double>& buf);
+
+private:
+	int		m_ranks;
+
+	// barrier
+	std::mutex				m_mutex;
+	std::condition_variable	m_cv;
+	int						m_count;
+	int						m_generation;
+
+	// reduction buffers (one per rank, summed in rank order so that all ranks get identical results)
+	std::vector< std::vector<double> >	m_reduce;
+
+	// mailboxes, indexed by (src, dest, tag)
+	std::map<std::vector<int>, std::deque< std::vector<double> > >	m_mail;
+
+	friend class FESharedMemoryCommunicator;
+};
+
+//-----------------------------------------------------------------------------
+class FECORE_API FESharedMemoryCommunicator : public FECommunicator
+{
+public:
+	FESharedMemoryCommunicator(FESharedMemoryHub& hub, int rank) : m_hub(hub), m_rank(rank) {}
+
+	int Rank() const override { return m_rank; }
+	int Size() const override { return m_hub.Ranks(); }
+	void Barrier() override { m_hub.Barrier(); }
+	void AllReduceSum(double* v, int n) override { m_hub.AllReduceSum(m_rank, v, n); }
+	void Send(int dest, int tag, const std::vector<double>& buf) override { m_hub.Send(m_rank, dest, tag, buf); }
+	void Recv(int src, int tag, std::vector<double>& buf) override { m_hub.Recv(src, m_rank, tag, buf); }
+
+private:
+	FESharedMemoryHub&	m_hub;
+	int					m_rank;
+};
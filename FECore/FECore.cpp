@@ -49,7 +49,9 @@ SOFTWARE.*/
 #include "FEAnalysis.h"
 #include "BFGSSolver.h"
 #include "FEBroydenStrategy.h"
+#include "FELBFGSStrategy.h"
 #include "JFNKStrategy.h"
+#include "EBEStrategy.h"
 #include "FENodeSet.h"
 #include "FEFacetSet.h"
 #include "FEElementSet.h"
@@ -173,9 +175,11 @@ REGISTER_FECORE_CLASS(FEPIDController         , "PID");
 // Newton strategies
 REGISTER_FECORE_CLASS(BFGSSolver       , "BFGS");
 REGISTER_FECORE_CLASS(FEBroydenStrategy, "Broyden");
+REGISTER_FECORE_CLASS(FELBFGSStrategy  , "L-BFGS");
 REGISTER_FECORE_CLASS(JFNKStrategy     , "JFNK");
 REGISTER_FECORE_CLASS(FEModifiedNewtonStrategy, "modified Newton");
 REGISTER_FECORE_CLASS(FEFullNewtonStrategy    , "full Newton");
+REGISTER_FECORE_CLASS(EBEStrategy             , "EBE Newton");
 
 // preconditioners
 REGISTER_FECORE_CLASS(DiagonalPreconditioner, "diagonal");
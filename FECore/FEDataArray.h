@@ -98,6 +98,10 @@ public:
 	//! return the buffer size (actual number of doubles)
 	int BufferSize() const { return (int) m_val.size(); }
 
+	//! direct access to the data buffer
+	double* data() { return (m_val.empty() ? nullptr : &m_val[0]); }
+	const double* data() const { return (m_val.empty() ? nullptr : &m_val[0]); }
+
 public:
 	//! serialization
 	virtual void Serialize(DumpStream& ar);
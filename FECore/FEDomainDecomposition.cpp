@@ -0,0 +1,149 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+#include "stdafx.h"
+#include "FEDomainDecomposition.h"
+#include "FEMesh.h"
+#include "FEDomain.h"
+#include <algorithm>
+using namespace std;
+
+//-----------------------------------------------------------------------------
+FEDomainDecomposition::FEDomainDecomposition()
+{
+	m_parts = 0;
+}
+
+//-----------------------------------------------------------------------------
+bool FEDomainDecomposition::Partition(FEMesh& mesh, int n)
+{
+	if (n < 1) return false;
+	m_parts = n;
+
+	// calculate the element centroids
+	int NE = mesh.Elements();
+	m_c.resize(3 * NE);
+	int ne = 0;
+	for (int i = 0; i < mesh.Domains(); ++i)
+	{
+		FEDomain& dom = mesh.Domain(i);
+		for (int j = 0; j < dom.Elements(); ++j, ++ne)
+		{
+			FEElement& el = dom.ElementRef(j);
+			vec3d c(0, 0, 0);
+			int neln = el.Nodes();
+			for (int k = 0; k < neln; ++k) c += mesh.Node(el.m_node[k]).m_r0;
+			if (neln > 0) c /= (double)neln;
+			m_c[3 * ne] = c.x; m_c[3 * ne + 1] = c.y; m_c[3 * ne + 2] = c.z;
+		}
+	}
+	assert(ne == NE);
+
+	// split the elements
+	vector<int> elem(NE);
+	for (int i = 0; i < NE; ++i) elem[i] = i;
+	m_elemPart.assign(NE, 0);
+	if (NE > 0) Bisect(&elem[0], NE, 0, n);
+	m_c.clear();
+
+	// assign the nodes
+	int NN = mesh.Nodes();
+	m_nodePart.assign(NN, n);
+	ne = 0;
+	for (int i = 0; i < mesh.Domains(); ++i)
+	{
+		FEDomain& dom = mesh.Domain(i);
+		for (int j = 0; j < dom.Elements(); ++j, ++ne)
+		{
+			FEElement& el = dom.ElementRef(j);
+			int p = m_elemPart[ne];
+			for (int k = 0; k < el.Nodes(); ++k)
+			{
+				int& np = m_nodePart[el.m_node[k]];
+				if (p < np) np = p;
+			}
+		}
+	}
+
+	// nodes without elements go to the first subdomain
+	for (int i = 0; i < NN; ++i) if (m_nodePart[i] == n) m_nodePart[i] = 0;
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+// split the elements along the longest axis of their bounding box
+void FEDomainDecomposition::Bisect(int* elem, int n, int part0, int parts)
+{
+	if (parts == 1)
+	{
+		for (int i = 0; i < n; ++i) m_elemPart[elem[i]] = part0;
+		return;
+	}
+
+	double r0[3], r1[3];
+	for (int k = 0; k < 3; ++k) r0[k] = r1[k] = m_c[3 * elem[0] + k];
+	for (int i = 1; i < n; ++i)
+	{
+		const double* c = &m_c[3 * elem[i]];
+		for (int k = 0; k < 3; ++k)
+		{
+			if (c[k] < r0[k]) r0[k] = c[k];
+			if (c[k] > r1[k]) r1[k] = c[k];
+		}
+	}
+	int axis = 0;
+	if (r1[1] - r0[1] > r1[axis] - r0[axis]) axis = 1;
+	if (r1[2] - r0[2] > r1[axis] - r0[axis]) axis = 2;
+
+	// the number of elements on each side is proportional to the number of subdomains
+	int p1 = parts / 2;
+	int n1 = (int)((long long)n * p1 / parts);
+	nth_element(elem, elem + n1, elem + n, [&](int a, int b) { return m_c[3 * a + axis] < m_c[3 * b + axis]; });
+
+	Bisect(elem, n1, part0, p1);
+	Bisect(elem + n1, n - n1, part0 + p1, parts - p1);
+}
+
+//-----------------------------------------------------------------------------
+void FEDomainDecomposition::EquationPartition(FEMesh& mesh, int neq, vector<int>& eqPart) const
+{
+	eqPart.assign(neq, 0);
+	int NN = mesh.Nodes();
+	for (int i = 0; i < NN; ++i)
+	{
+		FENode& node = mesh.Node(i);
+		int p = m_nodePart[i];
+		for (int j = 0; j < (int)node.m_ID.size(); ++j)
+		{
+			int id = node.m_ID[j];
+			int eq = (id >= 0 ? id : (id < -1 ? -id - 2 : -1));
+			if ((eq >= 0) && (eq < neq)) eqPart[eq] = p;
+		}
+	}
+}
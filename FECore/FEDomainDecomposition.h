@@ -0,0 +1,69 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+#pragma once
+#include "fecore_api.h"
+#include <vector>
+
+class FEMesh;
+
+//-----------------------------------------------------------------------------
+//! This class partitions the mesh into subdomains for a domain-decomposed solve.
+//! The elements are split by recursive coordinate bisection of their centroids.
+//! A node is owned by the lowest numbered subdomain of the elements it is 
+//! attached to. Each subdomain (rank) then owns the equations of its nodes.
+class FECORE_API FEDomainDecomposition
+{
+public:
+	FEDomainDecomposition();
+
+	//! partition the mesh in n subdomains
+	bool Partition(FEMesh& mesh, int n);
+
+	//! number of subdomains
+	int Partitions() const { return m_parts; }
+
+	//! subdomain of element i (index over all domains)
+	int ElementPartition(int i) const { return m_elemPart[i]; }
+
+	//! subdomain that owns node i
+	int NodePartition(int i) const { return m_nodePart[i]; }
+
+	//! Assign the neq equations to the subdomains. Equations that are not
+	//! attached to a node (e.g. rigid body dofs) are assigned to the first subdomain.
+	void EquationPartition(FEMesh& mesh, int neq, std::vector<int>& eqPart) const;
+
+private:
+	void Bisect(int* elem, int n, int part0, int parts);
+
+private:
+	int					m_parts;
+	std::vector<int>	m_elemPart;
+	std::vector<int>	m_nodePart;
+	std::vector<double>	m_c;	//!< element centroids (used during partitioning)
+};
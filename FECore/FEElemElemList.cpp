@@ -36,6 +36,7 @@ SOFTWARE.*/
 //-----------------------------------------------------------------------------
 FEElemElemList::FEElemElemList(void)
 {
+	m_pmesh = nullptr;
 }
 
 //-----------------------------------------------------------------------------
@@ -171,6 +172,26 @@ bool FEElemElemList::Create(FEMesh* pmesh)
 	return true;
 }
 
+//-----------------------------------------------------------------------------
+//! The elements are stored domain by domain, so the index of an element is
+//! its local index plus the number of elements in the preceding domains.
+//! Note that this need not be the same as the element's ID - 1.
+int FEElemElemList::ElementIndex(const FEElement& el) const
+{
+	if (m_pmesh == nullptr) return el.GetLocalID();
+
+	FEMesh& m = *m_pmesh;
+	int n = 0;
+	for (int i = 0; i < m.Domains(); ++i)
+	{
+		FEDomain& dom = m.Domain(i);
+		if (el.GetMeshPartition() == &dom) return n + el.GetLocalID();
+		n += dom.Elements();
+	}
+	assert(false);
+	return -1;
+}
+
 //-----------------------------------------------------------------------------
 //! Find the element neighbors for a surface. In this case, the elements are
 //! surface elements (i.e. FESurfaceElement).
@@ -59,6 +59,12 @@ public:
 	//! Find the j-th neighbor element of element n
 	int NeighborIndex(int n, int j) { return m_peli[m_ref[n] + j]; }
 
+	//! Find the j-th neighbor element of element el
+	FEElement* Neighbor(const FEElement& el, int j) { return Neighbor(ElementIndex(el), j); }
+
+	//! Return the index of an element in this list
+	int ElementIndex(const FEElement& el) const;
+
 	//! Return the size of the neighbor vector
 	int NeighborSize() { return (int)(m_pel.size()/m_ref.size()); }
 
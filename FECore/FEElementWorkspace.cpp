@@ -0,0 +1,104 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+#include "stdafx.h"
+#include "FEElementWorkspace.h"
+#include <assert.h>
+
+//-----------------------------------------------------------------------------
+FEElementMatrix& FEElementWorkspace::ElementMatrix(const FEElement& el, std::vector<int>& lm, int nr, int nc)
+{
+	ElementMatrix(el, nr, nc);
+	ke.SwapIndices(lm);
+	return ke;
+}
+
+//-----------------------------------------------------------------------------
+FEElementMatrix& FEElementWorkspace::ElementMatrix(const FEElement& el, std::vector<int>& lm)
+{
+	int n = (int)lm.size();
+	return ElementMatrix(el, lm, n, n);
+}
+
+//-----------------------------------------------------------------------------
+FEElementMatrix& FEElementWorkspace::ElementMatrix(const FEElement& el, int nr, int nc)
+{
+	ke.SetNodes(el.m_node);
+	ke.SetUpperTriangular(false);
+	ke.resize(nr, nc);
+	ke.zero();
+	return ke;
+}
+
+//-----------------------------------------------------------------------------
+std::vector<double>& FEElementWorkspace::ElementVector(int n)
+{
+	fe.assign(n, 0.0);
+	return fe;
+}
+
+//-----------------------------------------------------------------------------
+// The workspaces of a thread. They are only used by the owning thread, so no
+// locking is needed. 
+class FEWorkspacePool
+{
+public:
+	FEWorkspacePool() : m_used(0) {}
+	~FEWorkspacePool() { for (FEElementWorkspace* ws : m_ws) delete ws; }
+
+	FEElementWorkspace* Borrow()
+	{
+		if (m_used == (int)m_ws.size()) m_ws.push_back(new FEElementWorkspace);
+		return m_ws[m_used++];
+	}
+
+	void Return(FEElementWorkspace* ws)
+	{
+		// workspaces are returned in reverse order
+		assert((m_used > 0) && (m_ws[m_used - 1] == ws));
+		m_used--;
+	}
+
+private:
+	std::vector<FEElementWorkspace*>	m_ws;
+	int	m_used;
+};
+
+static thread_local FEWorkspacePool workspacePool;
+
+//-----------------------------------------------------------------------------
+FEScopedWorkspace::FEScopedWorkspace()
+{
+	m_ws = workspacePool.Borrow();
+}
+
+//-----------------------------------------------------------------------------
+FEScopedWorkspace::~FEScopedWorkspace()
+{
+	workspacePool.Return(m_ws);
+}
@@ -0,0 +1,87 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+#pragma once
+#include "FEGlobalMatrix.h"
+#include "FEElement.h"
+#include <vector>
+
+//-----------------------------------------------------------------------------
+//! Scratch buffers for element and surface kernels. 
+//! The buffers keep their memory between elements, so that the kernels do not 
+//! allocate on each element. Workspaces are borrowed from a per-thread pool
+//! with FEScopedWorkspace.
+class FECORE_API FEElementWorkspace
+{
+public:
+	FEElementWorkspace() {}
+
+	//! Prepare the element matrix for the element with the given LM vector. The 
+	//! LM vector is swapped into the matrix's indices, so its content is 
+	//! undefined afterwards.
+	FEElementMatrix& ElementMatrix(const FEElement& el, std::vector<int>& lm, int nr, int nc);
+
+	//! Same, for a square matrix with the size of the LM vector
+	FEElementMatrix& ElementMatrix(const FEElement& el, std::vector<int>& lm);
+
+	//! Prepare the element matrix, leaving the indices to be set by the caller
+	FEElementMatrix& ElementMatrix(const FEElement& el, int nr, int nc);
+
+	//! Prepare the element vector
+	std::vector<double>& ElementVector(int n);
+
+public:
+	FEElementMatrix		ke;		//!< element matrix
+	std::vector<double>	fe;		//!< element vector
+	std::vector<int>	lm;		//!< element LM vector
+	std::vector<double>	buf;	//!< general purpose buffer
+
+private:
+	FEElementWorkspace(const FEElementWorkspace&) = delete;
+	void operator = (const FEElementWorkspace&) = delete;
+};
+
+//-----------------------------------------------------------------------------
+//! Borrows a workspace from the pool of the calling thread for the lifetime of
+//! this object. Nested scopes get different workspaces.
+class FECORE_API FEScopedWorkspace
+{
+public:
+	FEScopedWorkspace();
+	~FEScopedWorkspace();
+
+	FEElementWorkspace* operator -> () { return m_ws; }
+	FEElementWorkspace& operator * () { return *m_ws; }
+
+private:
+	FEScopedWorkspace(const FEScopedWorkspace&) = delete;
+	void operator = (const FEScopedWorkspace&) = delete;
+
+private:
+	FEElementWorkspace*	m_ws;
+};
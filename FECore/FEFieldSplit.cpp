@@ -0,0 +1,283 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+
+
+
+#include "stdafx.h"
+#include "FEFieldSplit.h"
+#include "CompactUnSymmMatrix.h"
+#include "FEModel.h"
+#include "FEMesh.h"
+#include <algorithm>
+
+//-----------------------------------------------------------------------------
+FEFieldSplit::FEFieldSplit()
+{
+	m_A = nullptr;
+	m_D = nullptr;
+}
+
+//-----------------------------------------------------------------------------
+FEFieldSplit::~FEFieldSplit()
+{
+	Clear();
+}
+
+//-----------------------------------------------------------------------------
+void FEFieldSplit::Clear()
+{
+	delete m_A; m_A = nullptr;
+	delete m_D; m_D = nullptr;
+}
+
+//-----------------------------------------------------------------------------
+// Prescribed dofs are also marked, since their equation numbers can appear in
+// the matrix. Lagrange multipliers (if any) are kept with the first field.
+bool FEFieldSplit::SplitEquations(FEModel* fem, int neq, const std::vector<int>& dofs)
+{
+	m_field.assign(neq, 0);
+	FEMesh& mesh = fem->GetMesh();
+	for (int i = 0; i < mesh.Nodes(); ++i)
+	{
+		FENode& node = mesh.Node(i);
+		for (int dof : dofs)
+		{
+			if (dof < 0) continue;
+			int id = node.m_ID[dof];
+			int eq = (id >= 0 ? id : (id < -1 ? -id - 2 : -1));
+			if ((eq >= 0) && (eq < neq)) m_field[eq] = 1;
+		}
+	}
+
+	m_eq[0].clear();
+	m_eq[1].clear();
+	m_local.resize(neq);
+	for (int i = 0; i < neq; ++i)
+	{
+		std::vector<int>& eq = m_eq[m_field[i]];
+		m_local[i] = (int)eq.size();
+		eq.push_back(i);
+	}
+
+	return (m_eq[0].empty() == false) && (m_eq[1].empty() == false);
+}
+
+//-----------------------------------------------------------------------------
+void FEFieldSplit::BuildBlocks(CRSSparseMatrix* K)
+{
+	const int neq = K->Rows();
+	const int off = K->Offset();
+	const int* ptr = K->Pointers();
+	const int* ind = K->Indices();
+	const int n[2] = { (int)m_eq[0].size(), (int)m_eq[1].size() };
+
+	// count the entries of the blocks. Block b = 2*row field + column field
+	std::vector<int> bp[4], bc[4];
+	for (int b = 0; b < 4; ++b) bp[b].assign(n[b / 2] + 1, 0);
+	for (int r = 0; r < neq; ++r)
+	{
+		for (int k = ptr[r] - off; k < ptr[r + 1] - off; ++k)
+		{
+			int c = ind[k] - off;
+			bp[2 * m_field[r] + m_field[c]][m_local[r] + 1]++;
+		}
+	}
+	for (int b = 0; b < 4; ++b)
+	{
+		for (size_t i = 1; i < bp[b].size(); ++i) bp[b][i] += bp[b][i - 1];
+		bc[b].resize(bp[b].back());
+	}
+
+	// fill the column indices and store where each entry goes
+	// (the columns remain sorted since the local numbering preserves the global order)
+	m_dst.resize(ptr[neq] - off);
+	std::vector<int> pos[4];
+	for (int b = 0; b < 4; ++b) pos[b].assign(bp[b].begin(), bp[b].end() - 1);
+	for (int r = 0; r < neq; ++r)
+	{
+		for (int k = ptr[r] - off; k < ptr[r + 1] - off; ++k)
+		{
+			int c = ind[k] - off;
+			int b = 2 * m_field[r] + m_field[c];
+			int p = pos[b][m_local[r]]++;
+			bc[b][p] = m_local[c];
+			m_dst[k] = 4 * p + b;
+		}
+	}
+
+	// diagonal blocks
+	CRSSparseMatrix** M[2] = { &m_A, &m_D };
+	for (int l = 0; l < 2; ++l)
+	{
+		int b = 3 * l;
+		int nnz = (int)bc[b].size();
+		double* pv = new double[nnz];
+		int* pi = new int[nnz];
+		int* pp = new int[n[l] + 1];
+		for (int i = 0; i < nnz; ++i) { pv[i] = 0.0; pi[i] = bc[b][i] + off; }
+		for (int i = 0; i <= n[l]; ++i) pp[i] = bp[b][i] + off;
+
+		delete *M[l];
+		*M[l] = new CRSSparseMatrix(off);
+		(*M[l])->alloc(n[l], n[l], nnz, pv, pi, pp);
+	}
+
+	// coupling blocks
+	CSRMatrix* C[2] = { &m_B, &m_C };
+	for (int l = 0; l < 2; ++l)
+	{
+		int b = l + 1;
+		CSRMatrix& Cb = *C[l];
+		Cb.create(n[b / 2], n[b % 2], 0);
+		Cb.pointers() = bp[b];
+		Cb.indices() = bc[b];
+		Cb.values().assign(bc[b].size(), 0.0);
+	}
+}
+
+//-----------------------------------------------------------------------------
+void FEFieldSplit::UpdateBlocks(CRSSparseMatrix* K)
+{
+	double* bv[4] = { m_A->Values(), m_B.values().data(), m_C.values().data(), m_D->Values() };
+	const double* v = K->Values();
+	const int nnz = (int)m_dst.size();
+	for (int k = 0; k < nnz; ++k) bv[m_dst[k] & 3][m_dst[k] >> 2] = v[k];
+}
+
+//-----------------------------------------------------------------------------
+void FEFieldSplit::Gather(const double* y, double* y0, double* y1) const
+{
+	for (size_t i = 0; i < m_eq[0].size(); ++i) y0[i] = y[m_eq[0][i]];
+	for (size_t i = 0; i < m_eq[1].size(); ++i) y1[i] = y[m_eq[1][i]];
+}
+
+//-----------------------------------------------------------------------------
+void FEFieldSplit::Scatter(const double* x0, const double* x1, double* x) const
+{
+	for (size_t i = 0; i < m_eq[0].size(); ++i) x[m_eq[0][i]] = x0[i];
+	for (size_t i = 0; i < m_eq[1].size(); ++i) x[m_eq[1][i]] = x1[i];
+}
+
+//-----------------------------------------------------------------------------
+void FEFieldSplit::InverseDiagonal(std::vector<double>& Qi)
+{
+	const int n0 = (int)m_eq[0].size();
+	const int off = m_A->Offset();
+	const int* Ap = m_A->Pointers();
+	const int* Ai = m_A->Indices();
+	const double* Av = m_A->Values();
+	Qi.resize(n0);
+	for (int i = 0; i < n0; ++i)
+	{
+		double d = 0.0;
+		for (int p = Ap[i] - off; p < Ap[i + 1] - off; ++p)
+		{
+			if (Ai[p] - off == i) { d = Av[p]; break; }
+		}
+		Qi[i] = (d != 0.0 ? 1.0 / d : 0.0);
+	}
+}
+
+//-----------------------------------------------------------------------------
+void FEFieldSplit::SchurPattern(bool bD, std::vector<int>& ptr, std::vector<int>& col)
+{
+	const int n1 = (int)m_eq[1].size();
+	const int off = m_D->Offset();
+	const std::vector<int>& Bp = m_B.pointers(); const std::vector<int>& Bi = m_B.indices();
+	const std::vector<int>& Cp = m_C.pointers(); const std::vector<int>& Ci = m_C.indices();
+	const int* Dp = m_D->Pointers();
+	const int* Di = m_D->Indices();
+
+	ptr.assign(n1 + 1, 0);
+	col.clear();
+	std::vector<int> tag(n1, -1);
+	for (int i = 0; i < n1; ++i)
+	{
+		size_t s0 = col.size();
+
+		// always include the diagonal
+		tag[i] = i; col.push_back(i);
+
+		if (bD)
+		{
+			for (int p = Dp[i] - off; p < Dp[i + 1] - off; ++p)
+			{
+				int j = Di[p] - off;
+				if (tag[j] != i) { tag[j] = i; col.push_back(j); }
+			}
+		}
+
+		for (int p = Cp[i]; p < Cp[i + 1]; ++p)
+		{
+			int k = Ci[p];
+			for (int q = Bp[k]; q < Bp[k + 1]; ++q)
+			{
+				int j = Bi[q];
+				if (tag[j] != i) { tag[j] = i; col.push_back(j); }
+			}
+		}
+		std::sort(col.begin() + s0, col.end());
+		ptr[i + 1] = (int)col.size();
+	}
+}
+
+//-----------------------------------------------------------------------------
+// The product is evaluated row by row, using a dense work vector.
+void FEFieldSplit::SchurValues(const std::vector<double>& Qi, bool bD, const int* ptr, const int* col, double* val, int offset)
+{
+	const int n1 = (int)m_eq[1].size();
+	const int off = m_D->Offset();
+	const std::vector<int>& Bp = m_B.pointers(); const std::vector<int>& Bi = m_B.indices(); const std::vector<double>& Bv = m_B.values();
+	const std::vector<int>& Cp = m_C.pointers(); const std::vector<int>& Ci = m_C.indices(); const std::vector<double>& Cv = m_C.values();
+	const int* Dp = m_D->Pointers(); const int* Di = m_D->Indices(); const double* Dv = m_D->Values();
+
+	// w accumulates C*inv(Q)*B - D, so S is -w (bD = true) or w (bD = false)
+	m_w.assign(n1, 0.0);
+	std::vector<double>& w = m_w;
+	const double s = (bD ? -1.0 : 1.0);
+	for (int i = 0; i < n1; ++i)
+	{
+		if (bD)
+		{
+			for (int p = Dp[i] - off; p < Dp[i + 1] - off; ++p) w[Di[p] - off] -= Dv[p];
+		}
+		for (int p = Cp[i]; p < Cp[i + 1]; ++p)
+		{
+			int k = Ci[p];
+			double cik = Cv[p] * Qi[k];
+			for (int q = Bp[k]; q < Bp[k + 1]; ++q) w[Bi[q]] += cik * Bv[q];
+		}
+		for (int p = ptr[i] - offset; p < ptr[i + 1] - offset; ++p)
+		{
+			int j = col[p] - offset;
+			val[p] = s * w[j];
+			w[j] = 0.0;
+		}
+	}
+}
@@ -0,0 +1,105 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+#pragma once
+#include "CSRMatrix.h"
+#include <vector>
+
+class FEModel;
+class CRSSparseMatrix;
+
+//-----------------------------------------------------------------------------
+//! Splits a (row-based, unsymmetric) global matrix into two fields
+//!
+//!   | A  B |
+//!   | C  D |
+//!
+//! where the second field is defined by a list of nodal degrees of freedom. 
+//! The equations do not need to be numbered blockwise. The diagonal blocks are 
+//! stored as compact matrices (with the offset of the global matrix) so that 
+//! they can be passed to other linear solvers. The coupling blocks are kept in 
+//! zero-based CSR format.
+//! This is used by block preconditioners and segregated solvers.
+class FECORE_API FEFieldSplit
+{
+public:
+	FEFieldSplit();
+	~FEFieldSplit();
+
+	//! assign the equations of the given dofs to the second field (all others go to the first)
+	//! Returns false if one of the fields is empty.
+	bool SplitEquations(FEModel* fem, int neq, const std::vector<int>& dofs);
+
+	//! allocate the blocks from the structure of the global matrix (call after SplitEquations)
+	void BuildBlocks(CRSSparseMatrix* K);
+
+	//! copy the values of the global matrix into the blocks
+	void UpdateBlocks(CRSSparseMatrix* K);
+
+	//! split a global vector into the field vectors
+	void Gather(const double* y, double* y0, double* y1) const;
+
+	//! assemble the field vectors into a global vector
+	void Scatter(const double* x0, const double* x1, double* x) const;
+
+	//! number of equations of a field
+	int Equations(int n) const { return (int)m_eq[n].size(); }
+
+	//! release the blocks
+	void Clear();
+
+public:
+	//! inverse of the diagonal of A (zero where the diagonal is zero)
+	void InverseDiagonal(std::vector<double>& Qi);
+
+	//! zero-based structure of the Schur approximation. This is the structure of C*B
+	//! and the diagonal, and the structure of D if bD is true.
+	void SchurPattern(bool bD, std::vector<int>& ptr, std::vector<int>& col);
+
+	//! Evaluate S = D - C*inv(Q)*B (bD = true) or S = C*inv(Q)*B (bD = false), 
+	//! where Qi is the inverse of Q. The structure must be the one returned by SchurPattern, 
+	//! but can be stored with an offset.
+	void SchurValues(const std::vector<double>& Qi, bool bD, const int* ptr, const int* col, double* val, int offset = 0);
+
+public:
+	CRSSparseMatrix* A() { return m_A; }
+	CRSSparseMatrix* D() { return m_D; }
+	CSRMatrix& B() { return m_B; }
+	CSRMatrix& C() { return m_C; }
+
+private:
+	CRSSparseMatrix*	m_A;		//!< first diagonal block
+	CRSSparseMatrix*	m_D;		//!< second diagonal block
+	CSRMatrix			m_B, m_C;	//!< coupling blocks
+
+	std::vector<int>	m_eq[2];	//!< global equations of each field
+	std::vector<int>	m_field;	//!< field of each global equation
+	std::vector<int>	m_local;	//!< local equation number in its field
+	std::vector<int>	m_dst;		//!< target of each global entry (4*position + block)
+	std::vector<double>	m_w;		//!< work vector for the Schur evaluation
+};
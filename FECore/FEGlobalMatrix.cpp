@@ -33,7 +33,7 @@ SOFTWARE.*/
 #include "FESurface.h"
 
 //-----------------------------------------------------------------------------
-FEElementMatrix::FEElementMatrix(const FEElement& el)
+FEElementMatrix::FEElementMatrix(const FEElement& el) : m_bupper(false), m_bsymlm(false)
 {
 	m_node = el.m_node;
 }
@@ -41,17 +41,21 @@ FEElementMatrix::FEElementMatrix(const FEElement& el)
 //-----------------------------------------------------------------------------
 FEElementMatrix::FEElementMatrix(const FEElementMatrix& ke) : matrix(ke)
 {
+	m_bupper = ke.m_bupper;
 	m_node = ke.m_node;
 	m_lmi = ke.m_lmi;
 	m_lmj = ke.m_lmj;
+	m_bsymlm = ke.m_bsymlm;
 }
 
 //-----------------------------------------------------------------------------
 FEElementMatrix::FEElementMatrix(const FEElementMatrix& ke, double scale)
 {
+	m_bupper = ke.m_bupper;
 	m_node = ke.m_node;
 	m_lmi = ke.m_lmi;
 	m_lmj = ke.m_lmj;
+	m_bsymlm = ke.m_bsymlm;
 	matrix& T = *this;
 	const matrix& K = ke;
 	T = (scale == 1.0 ? K : K*scale);
@@ -60,17 +64,20 @@ FEElementMatrix::FEElementMatrix(const FEElementMatrix& ke, double scale)
 //-----------------------------------------------------------------------------
 FEElementMatrix::FEElementMatrix(const FEElement& el, const vector<int>& lmi) : matrix((int)lmi.size(), (int)lmi.size())
 {
+	m_bupper = false;
 	m_node = el.m_node;
 	m_lmi = lmi;
-	m_lmj = lmi;
+	m_bsymlm = true;
 }
 
 //-----------------------------------------------------------------------------
 FEElementMatrix::FEElementMatrix(const FEElement& el, vector<int>& lmi, vector<int>& lmj) : matrix((int)lmi.size(), (int)lmj.size())
 {
+	m_bupper = false;
 	m_node = el.m_node;
 	m_lmi = lmi;
 	m_lmj = lmj;
+	m_bsymlm = false;
 };
 
 //-----------------------------------------------------------------------------
@@ -80,6 +87,20 @@ void FEElementMatrix::operator = (const matrix& ke)
 	matrix::operator=(ke);
 }
 
+//-----------------------------------------------------------------------------
+//! copy the upper triangular part to the lower triangular part
+void FEElementMatrix::Symmetrize()
+{
+	if (m_bupper == false) return;
+	assert(rows() == columns());
+	matrix& ke = *this;
+	const int N = rows();
+	for (int i = 0; i < N; ++i)
+		for (int j = i + 1; j < N; ++j)
+			ke[j][i] = ke[i][j];
+	m_bupper = false;
+}
+
 
 //-----------------------------------------------------------------------------
 //! Takes a SparseMatrix structure that defines the structure of the global matrix.
@@ -182,6 +203,18 @@ bool FEGlobalMatrix::Create(FEModel* pfem, int neq, bool breset)
 	// reconstructing it every time we come here saves us a lot of time. The 
 	// static profile is stored in the variable m_MPs.
 
+	// Matrices that don't store any entries only need the number of equations,
+	// so we pass an empty profile and don't keep any profile around.
+	if (m_pA->NeedsProfile() == false)
+	{
+		if (m_pMP) delete m_pMP;
+		m_pMP = nullptr;
+		m_MPs.Clear();
+		SparseMatrixProfile MP(neq, 0);
+		m_pA->Create(MP);
+		return true;
+	}
+
 	// begin building the profile
 	build_begin(neq);
 	{
@@ -316,5 +349,10 @@ bool FEGlobalMatrix::Create(const FESurface& surf, const std::vector<int>& equat
 
 void FEGlobalMatrix::Assemble(const FEElementMatrix& ke)
 {
-	m_pA->Assemble(ke, ke.RowIndices(), ke.ColumnsIndices());
+	if (ke.IsUpperTriangular())
+	{
+		assert(ke.RowIndices() == ke.ColumnsIndices());
+		m_pA->AssembleUpper(ke, ke.RowIndices());
+	}
+	else m_pA->Assemble(ke, ke.RowIndices(), ke.ColumnsIndices());
 }
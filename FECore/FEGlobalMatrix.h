@@ -45,8 +45,8 @@ class FECORE_API FEElementMatrix : public matrix
 {
 public:
 	// default constructor
-	FEElementMatrix(){}
-	FEElementMatrix(int nr, int nc) : matrix(nr, nc) {}
+	FEElementMatrix() : m_bupper(false), m_bsymlm(false) {}
+	FEElementMatrix(int nr, int nc) : matrix(nr, nc), m_bupper(false), m_bsymlm(false) {}
 	FEElementMatrix(const FEElement& el);
 
 	// constructor for symmetric matrices
@@ -67,14 +67,19 @@ public:
 	const std::vector<int>& RowIndices() const { return m_lmi; }
 
 	// column indices
-	std::vector<int>& ColumnsIndices() { return m_lmj; }
-	const std::vector<int>& ColumnsIndices() const { return m_lmj; }
+	// (the non-const version gives the column indices their own storage, since the caller may change them)
+	std::vector<int>& ColumnsIndices() { if (m_bsymlm) { m_lmj = m_lmi; m_bsymlm = false; } return m_lmj; }
+	const std::vector<int>& ColumnsIndices() const { return (m_bsymlm ? m_lmi : m_lmj); }
 
 	// set the row and columnd indices (assuming they are the same)
-	void SetIndices(const std::vector<int>& lm) { m_lmi = m_lmj = lm; }
+	void SetIndices(const std::vector<int>& lm) { m_lmi = lm; m_bsymlm = true; }
+
+	// Same, but swaps the lm vector into the row indices instead of copying it. 
+	// The content of lm is undefined afterwards.
+	void SwapIndices(std::vector<int>& lm) { m_lmi.swap(lm); m_bsymlm = true; }
 
 	// set the row and columnd indices
-	void SetIndices(const std::vector<int>& lmr, const std::vector<int>& lmc) { m_lmi = lmr; m_lmj = lmc; }
+	void SetIndices(const std::vector<int>& lmr, const std::vector<int>& lmc) { m_lmi = lmr; m_lmj = lmc; m_bsymlm = false; }
 
 	// Set the node indices
 	void SetNodes(const std::vector<int>& en) { m_node = en; }
@@ -82,10 +87,23 @@ public:
 	// get the nodes
 	const std::vector<int>& Nodes() const { return m_node; }
 
+	// Flag that only the upper triangular part (j >= i) of this symmetric matrix was evaluated.
+	// The lower triangular part is then undefined and should not be accessed directly.
+	void SetUpperTriangular(bool b) { m_bupper = b; }
+	bool IsUpperTriangular() const { return m_bupper; }
+
+	// get an element, taking the upper triangular storage into account
+	double value(int i, int j) const { return ((m_bupper && (i > j)) ? (*this)[j][i] : (*this)[i][j]); }
+
+	// fill in the lower triangular part from the upper triangular part
+	void Symmetrize();
+
 private:
 	std::vector<int>	m_node;	//!< node indices
 	std::vector<int>	m_lmi;	//!< row indices
-	std::vector<int>	m_lmj;	//!< column indices
+	std::vector<int>	m_lmj;	//!< column indices (not used when m_bsymlm is set)
+	bool				m_bupper;	//!< only upper triangular part is stored
+	bool				m_bsymlm;	//!< the column indices are the row indices
 };
 
 //-----------------------------------------------------------------------------
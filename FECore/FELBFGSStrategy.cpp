@@ -0,0 +1,167 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+#include "stdafx.h"
+#include "FELBFGSStrategy.h"
+#include "LinearSolver.h"
+#include "FEException.h"
+#include "FENewtonSolver.h"
+#include "log.h"
+
+//-----------------------------------------------------------------------------
+BEGIN_FECORE_CLASS(FELBFGSStrategy, FENewtonStrategy)
+	ADD_PARAMETER(m_maxups, "max_ups");
+	ADD_PARAMETER(m_max_buf_size, FE_RANGE_GREATER(0), "max_buffer_size");
+END_FECORE_CLASS();
+
+//-----------------------------------------------------------------------------
+//! constructor
+FELBFGSStrategy::FELBFGSStrategy(FEModel* fem) : FENewtonStrategy(fem)
+{
+	// Since old pairs are dropped, we can do many more updates than
+	// we store before a reformation is needed.
+	m_maxups = 100;
+	m_max_buf_size = 10;
+
+	m_neq = 0;
+	m_plinsolve = nullptr;
+}
+
+//-----------------------------------------------------------------------------
+//! Initialization
+bool FELBFGSStrategy::Init()
+{
+	if (m_pns == nullptr) return false;
+
+	int neq = m_pns->m_neq;
+
+	// allocate storage for the update pairs
+	m_S.resize(m_max_buf_size, neq);
+	m_Y.resize(m_max_buf_size, neq);
+	m_rho.resize(m_max_buf_size);
+	m_alpha.resize(m_max_buf_size);
+	m_q.resize(neq, 0.0);
+
+	m_neq = neq;
+	m_nups = 0;
+
+	m_plinsolve = m_pns->GetLinearSolver();
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+//! perform a quasi-Newton udpate
+bool FELBFGSStrategy::Update(double s, vector<double>& ui, vector<double>& R0, vector<double>& R1)
+{
+	// for full-Newton, we skip QN update
+	if (m_maxups == 0) return false;
+
+	// make sure we didn't reach max updates
+	if (m_nups >= m_maxups - 1)
+	{
+		feLogWarning("Max nr of iterations reached.\nStiffness matrix will now be reformed.");
+		return false;
+	}
+
+	// store the new pair in the oldest slot
+	int n = m_nups % m_max_buf_size;
+	double* sn = m_S[n];
+	double* yn = m_Y[n];
+
+	double sy = 0.0;
+	const int neq = m_neq;
+#pragma omp parallel for reduction(+:sy) if (neq > MIN_PARALLEL_SIZE)
+	for (int i = 0; i < neq; ++i)
+	{
+		double si = s*ui[i];
+		double yi = R0[i] - R1[i];
+		sn[i] = si;
+		yn[i] = yi;
+		sy += si*yi;
+	}
+
+	// the update is only valid if it keeps the approximation positive definite
+	if (sy <= 0.0) return false;
+	m_rho[n] = 1.0 / sy;
+
+	m_nups++;
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+//! solve the equations, using the two-loop recursion.
+//! Each update of the recursion is fused with the dot product that the next
+//! update needs, so that it only takes a single pass over the vector.
+void FELBFGSStrategy::SolveEquations(vector<double>& x, vector<double>& b)
+{
+	// number of stored pairs
+	int npairs = (m_nups > m_max_buf_size ? m_max_buf_size : m_nups);
+	if (npairs == 0)
+	{
+		if (m_plinsolve->BackSolve(x, b) == false)
+			throw LinearSolverFailed();
+		return;
+	}
+
+	// buffer index of the oldest pair
+	int n0 = (m_nups - npairs) % m_max_buf_size;
+	const int neq = m_neq;
+
+	// first loop, from newest to oldest
+	m_q = b;
+	double* q = &m_q[0];
+	int n = (n0 + npairs - 1) % m_max_buf_size;
+	double a = m_rho[n] * vdot(m_S[n], q, neq);
+	for (int j = npairs - 1; j >= 0; --j)
+	{
+		n = (n0 + j) % m_max_buf_size;
+		m_alpha[n] = a;
+
+		int m = (n0 + j - 1) % m_max_buf_size;
+		double sq = vaxpy_dot(q, -a, m_Y[n], (j > 0 ? m_S[m] : nullptr), neq);
+		if (j > 0) a = m_rho[m] * sq;
+	}
+
+	// apply the initial inverse Hessian
+	if (m_plinsolve->BackSolve(x, m_q) == false)
+		throw LinearSolverFailed();
+
+	// second loop, from oldest to newest
+	double* r = &x[0];
+	double beta = m_rho[n0] * vdot(m_Y[n0], r, neq);
+	for (int j = 0; j < npairs; ++j)
+	{
+		n = (n0 + j) % m_max_buf_size;
+
+		int m = (n0 + j + 1) % m_max_buf_size;
+		double yr = vaxpy_dot(r, m_alpha[n] - beta, m_S[n], (j < npairs - 1 ? m_Y[m] : nullptr), neq);
+		if (j < npairs - 1) beta = m_rho[m] * yr;
+	}
+}
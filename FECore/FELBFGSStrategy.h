@@ -0,0 +1,68 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+#pragma once
+#include "matrix.h"
+#include "FENewtonStrategy.h"
+
+//-----------------------------------------------------------------------------
+//! This class implements a limited-memory BFGS (L-BFGS) strategy. 
+//! It stores at most max_buffer_size pairs of update vectors. When the buffer 
+//! is full, the oldest pair is dropped instead of forcing a reformation.
+//! The initial inverse Hessian is the linear solver's factorization of the
+//! last reformed stiffness matrix. Selecting an incomplete factorization
+//! (e.g. "ilu0" or "ichol") as the linear solver makes the reformations cheap.
+class FECORE_API FELBFGSStrategy : public FENewtonStrategy
+{
+public:
+	//! constructor
+	FELBFGSStrategy(FEModel* fem);
+
+	//! Initialization
+	bool Init() override;
+
+	//! perform a quasi-Newton udpate
+	bool Update(double s, vector<double>& ui, vector<double>& R0, vector<double>& R1) override;
+
+	//! solve the equations
+	void SolveEquations(vector<double>& x, vector<double>& b) override;
+
+private:
+	// keep a pointer to the linear solver
+	LinearSolver*	m_plinsolve;	//!< pointer to linear solver
+	int				m_neq;			//!< number of equations
+
+	// L-BFGS update pairs
+	matrix			m_S;		//!< solution increments
+	matrix			m_Y;		//!< residual increments
+	vector<double>	m_rho;		//!< 1/(s.y) for each pair
+	vector<double>	m_alpha;	//!< temp storage for the two-loop recursion
+	vector<double>	m_q;		//!< temp storage for q
+
+	DECLARE_FECORE_CLASS();
+};
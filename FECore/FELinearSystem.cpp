@@ -63,6 +63,19 @@ void FELinearSystem::Assemble(const FEElementMatrix& ke)
 {
 	if ((ke.rows() == 0) || (ke.columns() == 0)) return;
 
+	// linear constraints need the full element matrix
+	if (ke.IsUpperTriangular())
+	{
+		FEModel* fem = m_solver->GetFEModel();
+		if (fem->GetLinearConstraintManager().LinearConstraints())
+		{
+			FEElementMatrix kf(ke);
+			kf.Symmetrize();
+			Assemble(kf);
+			return;
+		}
+	}
+
 	// assemble into the global stiffness
 	m_K.Assemble(ke);
 
@@ -89,7 +102,7 @@ void FELinearSystem::Assemble(const FEElementMatrix& ke)
 				{
 					// dof i is not a prescribed degree of freedom
 #pragma omp atomic
-					m_F[I] -= ke[i][j] * m_u[J];
+					m_F[I] -= ke.value(i, j) * m_u[J];
 				}
 			}
 
@@ -98,6 +98,10 @@ void FEMesh::Serialize(DumpStream& ar)
 	}
 	ar.UnlockPointerTable();
 
+	// store the nodal dof data
+	m_NodeDofs.Serialize(ar);
+	if (ar.IsLoading()) AttachNodeDofs();
+
 	// stream domain data
 	ar & m_Domain;
 
@@ -243,6 +247,10 @@ void FEMesh::CreateNodes(int nodes)
 	assert(nodes);
 	m_Node.resize(nodes);
 
+	// allocate the dof storage
+	m_NodeDofs.Resize(nodes);
+	AttachNodeDofs();
+
 	// set the default node IDs
 	for (int i=0; i<nodes; ++i) Node(i).SetID(i+1);
 
@@ -264,13 +272,25 @@ void FEMesh::AddNodes(int nodes)
 
 	m_Node.resize(N0 + nodes);
 	for (int i=0; i<nodes; ++i) m_Node[i+N0].SetID(n0+i);
+
+	// grow the dof storage (this may move the data, so reattach all nodes)
+	m_NodeDofs.Resize(N0 + nodes);
+	AttachNodeDofs();
 }
 
 //-----------------------------------------------------------------------------
 void FEMesh::SetDOFS(int n)
+{
+	m_NodeDofs.Create(Nodes(), n);
+	AttachNodeDofs();
+}
+
+//-----------------------------------------------------------------------------
+void FEMesh::AttachNodeDofs()
 {
 	int NN = Nodes();
-	for (int i=0; i<NN; ++i) m_Node[i].SetDOFS(n);
+	assert(m_NodeDofs.Nodes() == NN);
+	for (int i=0; i<NN; ++i) m_NodeDofs.Attach(m_Node[i], i);
 }
 
 //-----------------------------------------------------------------------------
@@ -370,6 +390,7 @@ void FEMesh::InitMaterialPoints()
 void FEMesh::Clear()
 {
 	m_Node.clear();
+	m_NodeDofs.Clear();
 	for (size_t i=0; i<m_Domain.size (); ++i) delete m_Domain [i];
 
 	// TODO: Surfaces are currently managed by the classes that use them so don't delete them
@@ -796,7 +817,7 @@ FESurface* FEMesh::ElementBoundarySurface(std::vector<FEDomain*> domains, bool b
 			int nf = el.Faces();
 			for (int k = 0; k<nf; ++k)
 			{
-				FEElement* pen = EEL.Neighbor(el.GetID()-1, k);
+				FEElement* pen = EEL.Neighbor(el, k);
 				if ((pen == nullptr) && boutside) ++NF;
 				else if (pen && (std::find(domains.begin(), domains.end(), pen->GetMeshPartition()) == domains.end()) && boutside) ++NF;
 				if ((pen != nullptr) && (el.GetID() < pen->GetID()) && binside && (std::find(domains.begin(), domains.end(), pen->GetMeshPartition()) != domains.end())) ++NF;
@@ -820,7 +841,7 @@ FESurface* FEMesh::ElementBoundarySurface(std::vector<FEDomain*> domains, bool b
 			int nf = el.Faces();
 			for (int k = 0; k < nf; ++k)
 			{
-				FEElement* pen = EEL.Neighbor(el.GetID()-1, k);
+				FEElement* pen = EEL.Neighbor(el, k);
 				if (((pen == nullptr) && boutside) ||
 					(pen && (std::find(domains.begin(), domains.end(), pen->GetMeshPartition()) == domains.end()) && boutside) ||
 					((pen != nullptr) && (el.GetID() < pen->GetID()) && binside && (std::find(domains.begin(), domains.end(), pen->GetMeshPartition()) != domains.end())))
@@ -883,7 +904,7 @@ FEFacetSet* FEMesh::DomainBoundary(std::vector<FEDomain*> domains, bool boutside
 			int nf = el.Faces();
 			for (int k = 0; k < nf; ++k)
 			{
-				FEElement* pen = EEL.Neighbor(el.GetID() - 1, k);
+				FEElement* pen = EEL.Neighbor(el, k);
 				if ((pen == nullptr) && boutside) ++NF;
 				else if (pen && (std::find(domains.begin(), domains.end(), pen->GetMeshPartition()) == domains.end()) && boutside) ++NF;
 				if ((pen != nullptr) && (el.GetID() < pen->GetID()) && binside && (std::find(domains.begin(), domains.end(), pen->GetMeshPartition()) != domains.end())) ++NF;
@@ -907,7 +928,7 @@ FEFacetSet* FEMesh::DomainBoundary(std::vector<FEDomain*> domains, bool boutside
 			int nf = el.Faces();
 			for (int k = 0; k < nf; ++k)
 			{
-				FEElement* pen = EEL.Neighbor(el.GetID() - 1, k);
+				FEElement* pen = EEL.Neighbor(el, k);
 				if (((pen == nullptr) && boutside) ||
 					(pen && (std::find(domains.begin(), domains.end(), pen->GetMeshPartition()) == domains.end()) && boutside) ||
 					((pen != nullptr) && (el.GetID() < pen->GetID()) && binside && (std::find(domains.begin(), domains.end(), pen->GetMeshPartition()) != domains.end())))
@@ -1140,6 +1161,7 @@ void FEMesh::CopyFrom(FEMesh& mesh)
 
 	int N0 = mesh.Nodes();
 	CreateNodes(N0);
+	SetDOFS(mesh.NodeDOFS());
 	for (int i = 0; i < N0; ++i)
 	{
 		Node(i) = mesh.Node(i);
@@ -103,6 +103,12 @@ public:
 	//! Set the number of degrees of freedom on this mesh
 	void SetDOFS(int n);
 
+	//! return the number of degrees of freedom per node
+	int NodeDOFS() const { return m_NodeDofs.DOFS(); }
+
+	//! return the (structure-of-arrays) nodal dof storage
+	FENodeDofStore& NodeDofStore() { return m_NodeDofs; }
+
 	//! update bounding box
 	void UpdateBox();
 
@@ -282,6 +288,14 @@ private:
 	FEElementLUT*	m_LUT;
 
 	FEModel*	m_fem;
+
+private:
+	//! attach all nodes to their data in the nodal dof storage
+	void AttachNodeDofs();
+
+private:
+	FENodeDofStore	m_NodeDofs;	//!< contiguous storage for nodal dof data
+
 private:
 	//! hide the copy constructor
 	FEMesh(FEMesh& m){}
@@ -2081,6 +2081,7 @@ void FEModel::CopyFrom(FEModel& fem)
 	FEMesh& mesh = GetMesh();
 	int N = sourceMesh.Nodes();
 	mesh.CreateNodes(N);
+	mesh.SetDOFS(sourceMesh.NodeDOFS());
 	for (int i=0; i<N; ++i)
 	{
 		mesh.Node(i) = sourceMesh.Node(i);
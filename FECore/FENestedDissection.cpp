@@ -0,0 +1,211 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+#include "stdafx.h"
+#include "FENestedDissection.h"
+#include "FEMesh.h"
+using namespace std;
+
+//-----------------------------------------------------------------------------
+FENestedDissection::FENestedDissection()
+{
+	m_P = nullptr;
+	m_leafSize = 64;
+}
+
+//-----------------------------------------------------------------------------
+void FENestedDissection::Apply(FEMesh& mesh, vector<int>& P)
+{
+	int N = mesh.Nodes();
+	P.resize(N);
+	if (N == 0) return;
+
+	// create the node-node list
+	m_NL.Create(mesh);
+
+	m_label.assign(N, 0);
+	m_level.assign(N, -1);
+	m_P = &P[0];
+
+	vector<int> nodes(N);
+	for (int i = 0; i < N; ++i) nodes[i] = i;
+
+	#pragma omp parallel
+	#pragma omp single
+	Dissect(nodes, 0);
+
+	m_label.clear();
+	m_level.clear();
+	m_P = nullptr;
+}
+
+//-----------------------------------------------------------------------------
+// Nodes are only visited if they carry the given label and were not visited yet
+// (i.e. m_level < 0). Returns the number of levels.
+int FENestedDissection::Traverse(int root, int label, vector<int>& order)
+{
+	size_t head = order.size();
+	order.push_back(root);
+	m_level[root] = 0;
+	int levels = 1;
+	while (head < order.size())
+	{
+		int n = order[head++];
+		int l = m_level[n] + 1;
+		int nval = m_NL.Valence(n);
+		int* pn = m_NL.NodeList(n);
+		for (int j = 0; j < nval; ++j)
+		{
+			int m = pn[j];
+			if ((m_label[m] == label) && (m_level[m] < 0))
+			{
+				m_level[m] = l;
+				if (l >= levels) levels = l + 1;
+				order.push_back(m);
+			}
+		}
+	}
+	return levels;
+}
+
+//-----------------------------------------------------------------------------
+void FENestedDissection::Number(const vector<int>& nodes, int begin)
+{
+	for (int i = 0; i < (int)nodes.size(); ++i)
+	{
+		m_P[begin + i] = nodes[i];
+		m_label[nodes[i]] = -1;
+	}
+}
+
+//-----------------------------------------------------------------------------
+// Subgraphs that are processed concurrently never share an edge, since they are
+// either different components or separated by a separator that is already numbered.
+// That is why the tasks below can share the label and level arrays.
+void FENestedDissection::Dissect(vector<int>& nodes, int begin)
+{
+	const int n = (int)nodes.size();
+	const int label = begin;
+	if (n == 0) return;
+
+	// find the connected components
+	vector<int> order; order.reserve(n);
+	for (int i : nodes) m_level[i] = -1;
+	int levels = Traverse(nodes[0], label, order);
+	if ((int)order.size() < n)
+	{
+		vector< vector<int> > comp;
+		size_t c0 = 0;
+		for (int i = 0; i < n; ++i)
+		{
+			if (m_level[nodes[i]] < 0) 
+			{
+				comp.push_back(vector<int>(order.begin() + c0, order.end()));
+				c0 = order.size();
+				Traverse(nodes[i], label, order);
+			}
+		}
+		comp.push_back(vector<int>(order.begin() + c0, order.end()));
+
+		// Small components are numbered right away. The others get their own label
+		// and are dissected independently.
+		int offset = begin;
+		for (vector<int>& c : comp)
+		{
+			int nc = (int)c.size();
+			if (nc <= m_leafSize) Number(c, offset);
+			else
+			{
+				for (int i : c) m_label[i] = offset;
+				#pragma omp task shared(c) firstprivate(offset)
+				Dissect(c, offset);
+			}
+			offset += nc;
+		}
+		#pragma omp taskwait
+		return;
+	}
+
+	// small subgraphs are numbered in breadth-first order
+	if (n <= m_leafSize) { Number(order, begin); return; }
+
+	// find a pseudo-peripheral node by repeated traversals from the last node reached
+	for (int k = 0; k < 2; ++k)
+	{
+		int root = order.back();
+		for (int i : nodes) m_level[i] = -1;
+		order.clear();
+		int l = Traverse(root, label, order);
+		bool bdone = (l <= levels);
+		levels = l;
+		if (bdone) break;
+	}
+
+	// pick the level that splits the subgraph in two halves
+	vector<int> cnt(levels, 0);
+	for (int i : order) cnt[m_level[i]]++;
+	int k = 0, sum = cnt[0];
+	while ((k < levels - 1) && (2*sum < n)) sum += cnt[++k];
+
+	// The separator consists of the nodes in level k that are connected to level k+1. 
+	vector<int> A, B, S;
+	A.reserve(n); B.reserve(n);
+	for (int i : order)
+	{
+		int l = m_level[i];
+		if (l < k) A.push_back(i);
+		else if (l > k) B.push_back(i);
+		else
+		{
+			bool bsep = false;
+			int nval = m_NL.Valence(i);
+			int* pn = m_NL.NodeList(i);
+			for (int j = 0; j < nval; ++j)
+			{
+				int m = pn[j];
+				if ((m_label[m] == label) && (m_level[m] == k + 1)) { bsep = true; break; }
+			}
+			if (bsep) S.push_back(i); else A.push_back(i);
+		}
+	}
+
+	// if we could not split the graph, we just number it
+	if (A.empty() || B.empty()) { Number(order, begin); return; }
+
+	// the separator is numbered last
+	int na = (int)A.size();
+	int nb = (int)B.size();
+	Number(S, begin + na + nb);
+	for (int i : B) m_label[i] = begin + na;
+
+	// process the two halves (A keeps the current label)
+	#pragma omp task shared(A) if (na > 16*m_leafSize)
+	Dissect(A, begin);
+	Dissect(B, begin + na);
+	#pragma omp taskwait
+}
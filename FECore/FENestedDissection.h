@@ -0,0 +1,74 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+#pragma once
+#include "FENodeNodeList.h"
+#include <vector>
+
+class FEMesh;
+
+//-----------------------------------------------------------------------------
+//! This class calculates a fill-reducing permutation of the node numbering 
+//! using nested dissection. 
+
+//! The node graph is split recursively by a separator, which is taken from the 
+//! middle level of a level structure rooted at a pseudo-peripheral node. The two 
+//! halves are numbered first, then the separator. Independent subgraphs are 
+//! processed in parallel (using OpenMP tasks). Unlike FENodeReorder, which 
+//! minimizes the bandwidth and is best suited for skyline storage, this ordering 
+//! reduces the fill-in of sparse direct solvers.
+class FECORE_API FENestedDissection
+{
+public:
+	//! default constructor
+	FENestedDissection();
+
+	//! set the size of subgraphs that are no longer split
+	void SetLeafSize(int n) { m_leafSize = n; }
+
+	//! calculates the permutation vector
+	//! (P stores for each new node the old node that corresponds to this node.)
+	void Apply(FEMesh& mesh, std::vector<int>& P);
+
+private:
+	//! order the nodes, all of which have label begin, into P[begin ...]
+	void Dissect(std::vector<int>& nodes, int begin);
+
+	//! number the nodes in the order they are stored
+	void Number(const std::vector<int>& nodes, int begin);
+
+	//! breadth-first traversal of the subgraph with the given label
+	int Traverse(int root, int label, std::vector<int>& order);
+
+private:
+	FENodeNodeList		m_NL;
+	std::vector<int>	m_label;	//!< subgraph each node belongs to (-1 when numbered)
+	std::vector<int>	m_level;	//!< level of each node in the last traversal
+	int*				m_P;
+	int					m_leafSize;
+};
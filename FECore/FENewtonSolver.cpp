@@ -39,6 +39,7 @@ SOFTWARE.*/
 #include "FEDomain.h"
 #include "DumpStream.h"
 #include "FELinearSystem.h"
+#include <float.h>
 
 //-----------------------------------------------------------------------------
 // define the parameter list
@@ -57,6 +58,7 @@ BEGIN_FECORE_CLASS(FENewtonSolver, FESolver)
 		ADD_PARAMETER(m_breformtimestep     , "reform_each_time_step");
 		ADD_PARAMETER(m_breformAugment      , "reform_augment");
 		ADD_PARAMETER(m_bdivreform          , "diverge_reform");
+		ADD_PARAMETER(m_badaptiveReform     , "adaptive_reform");
 //		ADD_PARAMETER(m_bdoreforms          , "do_reforms"  );
 		ADD_PARAMETER(m_Rmin, FE_RANGE_GREATER_OR_EQUAL(0.0), "min_residual");
 		ADD_PARAMETER(m_Rmax, FE_RANGE_GREATER_OR_EQUAL(0.0), "max_residual");
@@ -99,6 +101,15 @@ FENewtonSolver::FENewtonSolver(FEModel* pfem) : FESolver(pfem)
 	m_force_partition = 0;
 	m_breformtimestep = true;
 	m_breformAugment = false;
+
+	m_badaptiveReform = false;
+	m_reformTime = 0.0;
+	m_iterTime = 0.0;
+	m_lnRateReformed = 0.0;
+	m_lnReduction = 0.0;
+	m_lnR0 = 0.0;
+	m_bfirstAfterReform = false;
+	m_nadaptref = 0;
 }
 
 //-----------------------------------------------------------------------------
@@ -501,6 +512,7 @@ bool FENewtonSolver::SolveStep()
 	m_nref = 0;		// nr of stiffness reformations
 	m_ntotref = 0;
 	m_naug = 0;		// nr of augmentations
+	m_nadaptref = 0;	// nr of adaptive reformations
 
 	try
 	{
@@ -522,6 +534,14 @@ bool FENewtonSolver::SolveStep()
 		feLog("\nconvergence summary\n");
 		feLog("    number of iterations   : %d\n", m_niter);
 		feLog("    number of reformations : %d\n", m_nref);
+		if (m_badaptiveReform)
+		{
+			feLog("    adaptive reformations  : %d\n", m_nadaptref);
+
+			// remember how much the residual had to be reduced to converge
+			double r1 = l2_norm(m_R1);
+			if (r1 > 0.0) m_lnReduction = m_lnR0 - log(r1);
+		}
 	}
 
 	// if we don't want to hold on to the stiffness matrix, let's clean it up
@@ -571,7 +591,7 @@ bool FENewtonSolver::Quasin()
 		double ls = QNSolve();
 
 		// update solution vector
-		for (int i = 0; i<m_neq; ++i) m_Ui[i] += ls*m_ui[i];
+		vadds(m_Ui, m_ui, ls);
 
 		feLog(" Nonlinear solution status: time= %lg\n", tp.currentTime);
 		feLog("\tstiffness updates             = %d\n", m_qnstrategy->m_nups);
@@ -793,8 +813,11 @@ bool FENewtonSolver::QNInit()
 	if (breform)
 	{
 		// do the first stiffness formation
+		Timer reformTimer; reformTimer.start();
 		if (m_qnstrategy->ReformStiffness() == false) return false;
+		m_reformTime = reformTimer.peek();
 	}
+	m_bfirstAfterReform = breform;
 
 	// calculate initial residual
 	if (m_qnstrategy->Residual(m_R0, true) == false) return false;
@@ -808,6 +831,12 @@ bool FENewtonSolver::QNInit()
 
 	//	double r0 = m_R0*m_R0;
 
+	// store the initial residual norm and start timing the first iteration
+	double r0 = l2_norm(m_R0);
+	m_lnR0 = (r0 > 0.0 ? log(r0) : 0.0);
+	m_iterTimer.reset();
+	m_iterTimer.start();
+
 	// do callback (we do it here since we want the RHS to be formed as well)
 	GetFEModel()->DoCallback(CB_MATRIX_REFORM);
 
@@ -917,6 +946,13 @@ bool FENewtonSolver::QNUpdate()
 	// see if the force reform flag was set
 	bool breform = m_bforceReform; m_bforceReform = false;
 
+	// see if reforming now is expected to pay off
+	if ((breform == false) && m_badaptiveReform && m_bdoreforms)
+	{
+		breform = AdaptiveReform();
+		if (breform) m_nadaptref++;
+	}
+
 	// do a QN update
 	if (breform == false)
 	{
@@ -935,18 +971,69 @@ bool FENewtonSolver::QNUpdate()
 	zero(m_ui);
 
 	// reform stiffness matrices if necessary
+	m_bfirstAfterReform = false;
 	if (breform && m_bdoreforms)
 	{
 		// reform the matrix
+		Timer reformTimer; reformTimer.start();
 		if (m_qnstrategy->ReformStiffness() == false) return false;
+		m_reformTime = reformTimer.peek();
+		m_bfirstAfterReform = true;
 	}
 
 	// copy last calculated residual
 	m_R0 = m_R1;
 
+	// start timing the next iteration
+	m_iterTimer.reset();
+	m_iterTimer.start();
+
 	return true;
 }
 
+//-----------------------------------------------------------------------------
+//! This function decides if a reformation should be done, by comparing the
+//! expected time to convergence with and without reforming. The estimates are
+//! based on the measured times of the last reformation and of the iterations,
+//! and on the measured residual reductions of the iterations.
+bool FENewtonSolver::AdaptiveReform()
+{
+	// measured time of the last iteration
+	double titer = m_iterTimer.peek();
+	m_iterTime = (m_iterTime > 0.0 ? 0.5*(m_iterTime + titer) : titer);
+
+	// measured residual reduction of the last iteration
+	double r0 = l2_norm(m_R0);
+	double r1 = l2_norm(m_R1);
+	if ((r0 <= 0.0) || (r1 <= 0.0)) return false;
+	double lnRate = log(r1 / r0);
+
+	// the first iteration after a reformation tells us how well a new matrix does
+	if (m_bfirstAfterReform)
+	{
+		m_lnRateReformed = (m_lnRateReformed != 0.0 ? 0.5*(m_lnRateReformed + lnRate) : lnRate);
+	}
+
+	// the remaining reduction of the residual. If we don't know how far we need to 
+	// go yet, we estimate it from the residual tolerance (which is on the squared norm).
+	double lnReduction = m_lnReduction;
+	if (lnReduction <= 0.0) lnReduction = (m_Rtol > 0.0 ? -0.5*log(m_Rtol) : log(1000.0));
+	double lnRemain = lnReduction - (m_lnR0 - log(r1));
+	if (lnRemain < log(2.0)) lnRemain = log(2.0);
+
+	// expected time without reforming (we assume the current rate continues)
+	double tkeep = (lnRate < 0.0 ? m_iterTime*lnRemain / (-lnRate) : DBL_MAX);
+
+	// expected time when we reform now
+	double lnRateRef = (m_lnRateReformed < 0.0 ? m_lnRateReformed : log(0.1));
+	double tref = m_reformTime + m_iterTime*lnRemain / (-lnRateRef);
+
+	bool breform = (tref < tkeep);
+	feLog("\tadaptive reform: est. time %lg s (update), %lg s (reform)%s\n", tkeep, tref, (breform ? " => reforming" : ""));
+
+	return breform;
+}
+
 //-----------------------------------------------------------------------------
 bool FENewtonSolver::DoAugmentations()
 {
@@ -31,6 +31,7 @@ SOFTWARE.*/
 #include "FENewtonStrategy.h"
 #include "FETimeInfo.h"
 #include "FELineSearch.h"
+#include "Timer.h"
 
 //-----------------------------------------------------------------------------
 // forward declarations
@@ -231,6 +232,7 @@ public:
 	bool				m_bforceReform;		//!< forces a reform in QNInit
 	bool				m_bdivreform;		//!< reform when diverging
 	bool				m_bdoreforms;		//!< do reformations
+	bool				m_badaptiveReform;	//!< decide on reformations from the measured cost of reforming vs. iterating
 
 	// counters
 	int		m_nref;			//!< nr of stiffness retormations
@@ -257,6 +259,20 @@ public:
 private:
 	double	m_ls;	//!< line search factor calculated in last call to QNSolve
 
+private:
+	//! decide if reforming now is expected to reduce the time to convergence
+	bool AdaptiveReform();
+
+	// data for the adaptive reformation policy
+	Timer	m_iterTimer;		//!< times each iteration (excluding reformations)
+	double	m_reformTime;		//!< measured time of the last reformation (in seconds)
+	double	m_iterTime;			//!< averaged time of an iteration (in seconds)
+	double	m_lnRateReformed;	//!< averaged log of residual reduction of the first iteration after a reformation (zero if unknown)
+	double	m_lnReduction;		//!< log of the residual reduction that was needed to converge the last time step (zero if unknown)
+	double	m_lnR0;				//!< log of the residual norm at the start of the time step
+	bool	m_bfirstAfterReform;//!< was the last iteration the first one after a reformation
+	int		m_nadaptref;		//!< nr of reformations chosen by the adaptive policy
+
 private:
 	ConvergenceInfo			m_residuNorm;	// residual convergence info
 	ConvergenceInfo			m_energyNorm;	// energy convergence info
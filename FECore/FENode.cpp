@@ -29,9 +29,21 @@ SOFTWARE.*/
 #include "stdafx.h"
 #include "FENode.h"
 #include "DumpStream.h"
+#include "FEException.h"
 
 //=============================================================================
 // FENode
+//-----------------------------------------------------------------------------
+// dof storage of a node that is not attached to a mesh
+struct FENode::DofData
+{
+	std::vector<int>	id;
+	std::vector<int>	bc;
+	std::vector<double>	val_t;
+	std::vector<double>	val_p;
+	std::vector<double>	Fr;
+};
+
 //-----------------------------------------------------------------------------
 FENode::FENode()
 {
@@ -43,45 +55,96 @@ FENode::FENode()
 
 	// default ID
 	m_nID = -1;
+
+	// the dof data is attached by the mesh
+	m_own = nullptr;
+	m_BC = nullptr;
+	m_val_t = nullptr;
+	m_val_p = nullptr;
+	m_Fr = nullptr;
+}
+
+//-----------------------------------------------------------------------------
+FENode::~FENode()
+{
+	delete m_own;
+}
+
+//-----------------------------------------------------------------------------
+void FENode::AttachDOFS(int ndofs, int* id, int* bc, double* val_t, double* val_p, double* Fr)
+{
+	// the storage is now owned by the mesh
+	delete m_own;
+	m_own = nullptr;
+
+	m_ID.attach(id, ndofs);
+	m_BC = bc;
+	m_val_t = val_t;
+	m_val_p = val_p;
+	m_Fr = Fr;
+}
+
+//-----------------------------------------------------------------------------
+void FENode::AllocDOFS(int n)
+{
+	DofData* d = new DofData;
+	d->id.assign(n, -1);
+	d->bc.assign(n, 0);
+	d->val_t.assign(n, 0.0);
+	d->val_p.assign(n, 0.0);
+	d->Fr.assign(n, 0.0);
+
+	AttachDOFS(n, d->id.data(), d->bc.data(), d->val_t.data(), d->val_p.data(), d->Fr.data());
+	m_own = d;
 }
 
 //-----------------------------------------------------------------------------
 void FENode::SetDOFS(int n)
 {
-	// initialize dof stuff
-	m_ID.assign(n, -1);
-	m_BC.assign(n, 0);
-	m_val_t.assign(n, 0.0);
-	m_val_p.assign(n, 0.0);
-	m_Fr.assign(n, 0.0);
+	if (n != dofs())
+	{
+		// the storage of the mesh cannot be resized from here
+		if ((m_own == nullptr) && (dofs() > 0)) throw FEException("Cannot change the number of dofs of a mesh node.");
+		AllocDOFS(n);
+		return;
+	}
+
+	for (int i = 0; i < n; ++i)
+	{
+		m_ID[i] = -1;
+		m_BC[i] = 0;
+		m_val_t[i] = 0.0;
+		m_val_p[i] = 0.0;
+		m_Fr[i] = 0.0;
+	}
 }
 
 //-----------------------------------------------------------------------------
-FENode::FENode(const FENode& n)
+// The copy is not attached to the mesh, but gets its own copy of the dof data.
+FENode::FENode(const FENode& n) : FENode()
 {
-	m_r0 = n.m_r0;
-	m_rt = n.m_rt;
-	m_at = n.m_at;
-	m_rp = n.m_rp;
-	m_vp = n.m_vp;
-	m_ap = n.m_ap;
-	m_d0 = n.m_d0;
-    m_dt = n.m_dt;
-    m_dp = n.m_dp;
+	*this = n;
+}
 
-	m_nID = n.m_nID;
-	m_rid = n.m_rid;
-	m_nstate = n.m_nstate;
+//-----------------------------------------------------------------------------
+FENode::FENode(FENode&& n) noexcept : FENode()
+{
+	CopyNodeData(n);
 
+	// take over the dof storage
+	m_own = n.m_own;
 	m_ID = n.m_ID;
 	m_BC = n.m_BC;
 	m_val_t = n.m_val_t;
 	m_val_p = n.m_val_p;
 	m_Fr = n.m_Fr;
+
+	n.m_own = nullptr;
+	n.AttachDOFS(0, nullptr, nullptr, nullptr, nullptr, nullptr);
 }
 
 //-----------------------------------------------------------------------------
-FENode& FENode::operator = (const FENode& n)
+void FENode::CopyNodeData(const FENode& n)
 {
 	m_r0 = n.m_r0;
 	m_rt = n.m_rt;
@@ -96,31 +159,48 @@ FENode& FENode::operator = (const FENode& n)
 	m_nID = n.m_nID;
 	m_rid = n.m_rid;
 	m_nstate = n.m_nstate;
+}
 
-	m_ID = n.m_ID;
-	m_BC = n.m_BC;
-	m_val_t = n.m_val_t;
-	m_val_p = n.m_val_p;
-	m_Fr = n.m_Fr;
+//-----------------------------------------------------------------------------
+FENode& FENode::operator = (const FENode& n)
+{
+	if (this == &n) return (*this);
+
+	CopyNodeData(n);
+
+	// copy the dof values into our own storage
+	int ndofs = n.dofs();
+	if (dofs() != ndofs)
+	{
+		// the storage of the mesh cannot be resized from here
+		if ((m_own == nullptr) && (dofs() > 0)) throw FEException("Cannot assign a node with a different number of dofs to a mesh node.");
+		AllocDOFS(ndofs);
+	}
+
+	for (int i = 0; i < ndofs; ++i)
+	{
+		m_ID[i] = n.m_ID[i];
+		m_BC[i] = n.m_BC[i];
+		m_val_t[i] = n.m_val_t[i];
+		m_val_p[i] = n.m_val_p[i];
+		m_Fr[i] = n.m_Fr[i];
+	}
 
 	return (*this);
 }
 
 //-----------------------------------------------------------------------------
 // Serialize
+// NOTE: The dof data is serialized by the mesh's FENodeDofStore.
 void FENode::Serialize(DumpStream& ar)
 {
 	ar & m_nID;
 	ar & m_rt & m_at;
 	ar & m_rp & m_vp & m_ap;
-	ar & m_Fr;
-	ar & m_val_t & m_val_p;
     ar & m_dt & m_dp;
 	if (ar.IsShallow() == false)
 	{
 		ar & m_nstate;
-		ar & m_ID;
-		ar & m_BC;
 		ar & m_r0;
 		ar & m_ra;
 		ar & m_rid;
@@ -131,6 +211,95 @@ void FENode::Serialize(DumpStream& ar)
 //-----------------------------------------------------------------------------
 //! Update nodal values, which copies the current values to the previous array
 void FENode::UpdateValues()
+{
+	int ndofs = dofs();
+	for (int i = 0; i < ndofs; ++i) m_val_p[i] = m_val_t[i];
+}
+
+//=============================================================================
+// FENodeDofStore
+//-----------------------------------------------------------------------------
+FENodeDofStore::FENodeDofStore()
+{
+	m_nodes = 0;
+	m_ndofs = 0;
+}
+
+//-----------------------------------------------------------------------------
+void FENodeDofStore::Create(int nodes, int ndofs)
+{
+	m_nodes = nodes;
+	m_ndofs = ndofs;
+
+	size_t N = (size_t)nodes * (size_t)ndofs;
+	m_ID.assign(N, -1);
+	m_BC.assign(N, 0);
+	m_val_t.assign(N, 0.0);
+	m_val_p.assign(N, 0.0);
+	m_Fr.assign(N, 0.0);
+}
+
+//-----------------------------------------------------------------------------
+void FENodeDofStore::Resize(int nodes)
+{
+	m_nodes = nodes;
+
+	size_t N = (size_t)nodes * (size_t)m_ndofs;
+	m_ID.resize(N, -1);
+	m_BC.resize(N, 0);
+	m_val_t.resize(N, 0.0);
+	m_val_p.resize(N, 0.0);
+	m_Fr.resize(N, 0.0);
+}
+
+//-----------------------------------------------------------------------------
+void FENodeDofStore::Clear()
+{
+	m_nodes = 0;
+	m_ndofs = 0;
+	m_ID.clear();
+	m_BC.clear();
+	m_val_t.clear();
+	m_val_p.clear();
+	m_Fr.clear();
+}
+
+//-----------------------------------------------------------------------------
+void FENodeDofStore::Attach(FENode& node, int n)
+{
+	assert((n >= 0) && (n < m_nodes));
+	if (m_ndofs == 0)
+	{
+		node.AttachDOFS(0, nullptr, nullptr, nullptr, nullptr, nullptr);
+		return;
+	}
+
+	size_t offset = (size_t)n * (size_t)m_ndofs;
+	node.AttachDOFS(m_ndofs, &m_ID[offset], &m_BC[offset], &m_val_t[offset], &m_val_p[offset], &m_Fr[offset]);
+}
+
+//-----------------------------------------------------------------------------
+void FENodeDofStore::UpdateValues()
 {
 	m_val_p = m_val_t;
 }
+
+//-----------------------------------------------------------------------------
+void FENodeDofStore::Serialize(DumpStream& ar)
+{
+	if (ar.IsSaving())
+	{
+		ar << m_nodes << m_ndofs;
+		ar << m_val_t << m_val_p << m_Fr;
+		if (ar.IsShallow() == false) ar << m_ID << m_BC;
+	}
+	else
+	{
+		int nodes, ndofs;
+		ar >> nodes >> ndofs;
+		if (ar.IsShallow() == false) Create(nodes, ndofs);
+		assert((nodes == m_nodes) && (ndofs == m_ndofs));
+		ar >> m_val_t >> m_val_p >> m_Fr;
+		if (ar.IsShallow() == false) ar >> m_ID >> m_BC;
+	}
+}
@@ -31,14 +31,56 @@ SOFTWARE.*/
 #include "DOFS.h"
 #include "vec3d.h"
 #include <vector>
+#include <assert.h>
 
 class DumpStream;
 
+//-----------------------------------------------------------------------------
+//! Light-weight view of a contiguous block of nodal dof data. 
+
+//! The data itself is owned by the FENodeDofStore of the mesh that the node 
+//! belongs to. The view only stores a pointer to the first entry and the size.
+template <typename T> class FENodeDofArray
+{
+public:
+	FENodeDofArray() : m_pd(nullptr), m_n(0) {}
+
+	void attach(T* pd, int n) { m_pd = pd; m_n = n; }
+
+	T& operator [] (int i) { assert((i >= 0) && (i < m_n)); return m_pd[i]; }
+	const T& operator [] (int i) const { assert((i >= 0) && (i < m_n)); return m_pd[i]; }
+
+	size_t size() const { return (size_t) m_n; }
+	bool empty() const { return (m_n == 0); }
+
+	T* data() { return m_pd; }
+	const T* data() const { return m_pd; }
+
+	T* begin() { return m_pd; }
+	T* end() { return m_pd + m_n; }
+	const T* begin() const { return m_pd; }
+	const T* end() const { return m_pd + m_n; }
+
+private:
+	T*	m_pd;	//!< pointer to first dof entry
+	int	m_n;	//!< number of dofs
+};
+
 //-----------------------------------------------------------------------------
 //! This class defines a finite element node
 
 //! It stores nodal positions and nodal equations numbers and more.
 //!
+//! The nodal dof data (equation numbers, bc flags, current and previous values,
+//! and nodal loads) is not stored in the node itself, but in a structure-of-arrays 
+//! store (FENodeDofStore) that is owned by the mesh. The node only keeps pointers
+//! into this store. A copy of a node is not attached to the mesh, but owns a 
+//! copy of the dof data.
+//! The geometry data (positions, directors, and their history) is still stored in 
+//! the node. It is accessed as public vec3d members (and passed by reference) in 
+//! more than a thousand places in all modules, so it can only move to the store once
+//! those call sites go through accessor functions.
+//!
 //! The m_ID array will store the equation number for the corresponding
 //! degree of freedom. Its values can be (a) non-negative (0 or higher) which
 //! gives the equation number in the linear system of equations, (b) -1 if the
@@ -60,15 +102,25 @@ public:
 	//! default constructor
 	FENode();
 
-	//! copy constructor
+	//! copy constructor (the copy owns its dof data)
 	FENode(const FENode& n);
 
-	//! assignment operator
+	//! move constructor (takes over the dof storage)
+	FENode(FENode&& n) noexcept;
+
+	//! destructor
+	~FENode();
+
+	//! assignment operator (copies dof values into this node's dof storage)
 	FENode& operator = (const FENode& n);
 
-	//! Set the number of DOFS
+	//! Reset the dof data. For nodes that are attached to a mesh, the number of 
+	//! dofs must match the dof storage of the mesh.
 	void SetDOFS(int n);
 
+	//! attach the node to its dof storage
+	void AttachDOFS(int ndofs, int* id, int* bc, double* val_t, double* val_p, double* Fr);
+
 	//! Get the nodal ID
 	int GetID() const { return m_nID; }
 
@@ -156,11 +208,76 @@ public:
     vec3d sp() const { return m_rp - m_dp; }
 
 private:
-	std::vector<int>		m_BC;		//!< boundary condition array
+	// copy all data, except the dof data
+	void CopyNodeData(const FENode& n);
+
+	// allocate dof storage that is owned by this node
+	void AllocDOFS(int n);
+
+private:
+	struct DofData;		// dof storage of a node that is not attached to a mesh
+	DofData*	m_own;		//!< owned dof storage (null when attached to a mesh)
+
+	int*		m_BC;		//!< boundary condition array
+	double*		m_val_t;	//!< current nodal DOF values
+	double*		m_val_p;	//!< previous nodal DOF values
+	double*		m_Fr;		//!< equivalent nodal forces
+
+public:
+	FENodeDofArray<int>	m_ID;	//!< nodal equation numbers
+};
+
+//-----------------------------------------------------------------------------
+//! Structure-of-arrays storage for the nodal dof data of a mesh.
+
+//! All nodes of a mesh store their dof data in one contiguous block per 
+//! quantity, with a fixed stride (the number of dofs per node). This avoids 
+//! a separate heap allocation per node and quantity and keeps nodal gathers 
+//! contiguous in memory.
+class FECORE_API FENodeDofStore
+{
+public:
+	FENodeDofStore();
+
+	//! allocate storage for nodes and dofs (all data is reset)
+	void Create(int nodes, int ndofs);
+
+	//! change the number of nodes (existing data is preserved)
+	void Resize(int nodes);
+
+	//! clear all data
+	void Clear();
+
+	//! number of nodes
+	int Nodes() const { return m_nodes; }
+
+	//! number of dofs per node
+	int DOFS() const { return m_ndofs; }
+
+	//! attach a node to its data in the store
+	void Attach(FENode& node, int n);
+
+	//! copies current values to previous values for all nodes
+	void UpdateValues();
+
+	//! serialize data
+	void Serialize(DumpStream& ar);
+
+public:
+	// direct access to the contiguous arrays (stride is DOFS())
+	int* ID() { return m_ID.data(); }
+	int* BC() { return m_BC.data(); }
+	double* Values() { return m_val_t.data(); }
+	double* PrevValues() { return m_val_p.data(); }
+	double* Loads() { return m_Fr.data(); }
+
+private:
+	int		m_nodes;	//!< number of nodes
+	int		m_ndofs;	//!< number of dofs per node
+
+	std::vector<int>		m_ID;		//!< nodal equation numbers
+	std::vector<int>		m_BC;		//!< boundary condition flags
 	std::vector<double>		m_val_t;	//!< current nodal DOF values
 	std::vector<double>		m_val_p;	//!< previous nodal DOF values
 	std::vector<double>		m_Fr;		//!< equivalent nodal forces
-
-public:
-	std::vector<int>		m_ID;	//!< nodal equation numbers
 };
@@ -211,12 +211,8 @@ void FEShellElementNew::SetTraits(FEElementTraits* ptraits)
 void FEShellElementNew::Serialize(DumpStream &ar)
 {
 	FEShellElement::Serialize(ar);
-	ar & m_fa;
-	ar & m_Kaai;
 	ar & m_alpha;
 	ar & m_alphai;
 	ar & m_alphat;
-	ar & m_Kua;
-	ar & m_Kwa;
 	ar & m_E;
 }
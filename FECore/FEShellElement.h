@@ -127,13 +127,9 @@ public:
 
 public: // EAS parameters
 
-	matrix          m_Kaai;
-	matrix          m_fa;
 	matrix          m_alpha;
 	matrix          m_alphat;
 	matrix          m_alphai;
-	std::vector<matrix>  m_Kua;
-	std::vector<matrix>  m_Kwa;
 	std::vector<mat3ds>  m_E;
 };
 
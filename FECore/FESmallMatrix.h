@@ -0,0 +1,473 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+#pragma once
+#include <math.h>
+
+//-----------------------------------------------------------------------------
+// This file defines small dense matrices whose size is known at compile time, 
+// and kernels that operate on them. The data is stored on the stack, so unlike 
+// the general matrix class these do not allocate. This is intended for the 
+// element-level algebra in the inner loops of the element kernels.
+//
+// The batched kernels (batch_xxx) factor and solve W systems of the same size 
+// at once. The data is stored lane-interleaved (structure-of-arrays): entry (i,j)
+// of the matrix in lane w is stored at A[(i*N + j)*W + w]. The loops over the 
+// lanes are innermost so that the compiler can vectorize them. Pivoting would 
+// make the lanes diverge, so the batched factorizations do not pivot. Instead, they
+// return a bit mask of the lanes that encountered a small pivot, which the caller 
+// should then redo with the (pivoting) scalar kernels.
+
+//-----------------------------------------------------------------------------
+//! R x C matrix with stack storage
+template <int R, int C> class small_matrix
+{
+public:
+	enum { ROWS = R, COLS = C };
+
+public:
+	small_matrix() {}
+
+	void zero() { double* a = &d[0][0]; for (int i = 0; i < R*C; ++i) a[i] = 0.0; }
+
+	double& operator () (int i, int j) { return d[i][j]; }
+	double operator () (int i, int j) const { return d[i][j]; }
+
+	double* operator [] (int i) { return d[i]; }
+	const double* operator [] (int i) const { return d[i]; }
+
+	small_matrix<C, R> transpose() const
+	{
+		small_matrix<C, R> t;
+		for (int i = 0; i < R; ++i)
+			for (int j = 0; j < C; ++j) t.d[j][i] = d[i][j];
+		return t;
+	}
+
+	small_matrix& operator *= (double s)
+	{
+		double* a = &d[0][0];
+		for (int i = 0; i < R*C; ++i) a[i] *= s;
+		return *this;
+	}
+
+	small_matrix& operator += (const small_matrix& m)
+	{
+		double* a = &d[0][0];
+		const double* b = &m.d[0][0];
+		for (int i = 0; i < R*C; ++i) a[i] += b[i];
+		return *this;
+	}
+
+public:
+	double	d[R][C];
+};
+
+//-----------------------------------------------------------------------------
+template <int R, int K, int C>
+inline small_matrix<R, C> operator * (const small_matrix<R, K>& A, const small_matrix<K, C>& B)
+{
+	small_matrix<R, C> P;
+	for (int i = 0; i < R; ++i)
+	{
+		for (int j = 0; j < C; ++j) P.d[i][j] = 0.0;
+		for (int k = 0; k < K; ++k)
+		{
+			const double a = A.d[i][k];
+			for (int j = 0; j < C; ++j) P.d[i][j] += a*B.d[k][j];
+		}
+	}
+	return P;
+}
+
+//-----------------------------------------------------------------------------
+// Calls f.run<N>() for 3 <= n <= 24. Returns false for all other sizes, in which
+// case the caller should use a runtime-sized code path.
+template <class F> inline bool FEDispatchSmallSize(int n, F& f)
+{
+	switch (n)
+	{
+	case  3: f.template run< 3>(); return true;
+	case  4: f.template run< 4>(); return true;
+	case  5: f.template run< 5>(); return true;
+	case  6: f.template run< 6>(); return true;
+	case  7: f.template run< 7>(); return true;
+	case  8: f.template run< 8>(); return true;
+	case  9: f.template run< 9>(); return true;
+	case 10: f.template run<10>(); return true;
+	case 11: f.template run<11>(); return true;
+	case 12: f.template run<12>(); return true;
+	case 13: f.template run<13>(); return true;
+	case 14: f.template run<14>(); return true;
+	case 15: f.template run<15>(); return true;
+	case 16: f.template run<16>(); return true;
+	case 17: f.template run<17>(); return true;
+	case 18: f.template run<18>(); return true;
+	case 19: f.template run<19>(); return true;
+	case 20: f.template run<20>(); return true;
+	case 21: f.template run<21>(); return true;
+	case 22: f.template run<22>(); return true;
+	case 23: f.template run<23>(); return true;
+	case 24: f.template run<24>(); return true;
+	}
+	return false;
+}
+
+namespace FESmallLA {
+
+//-----------------------------------------------------------------------------
+//! P = A*B^T
+template <int R, int K, int C>
+inline void mult_abt(const small_matrix<R, K>& A, const small_matrix<C, K>& B, small_matrix<R, C>& P)
+{
+	for (int i = 0; i < R; ++i)
+		for (int j = 0; j < C; ++j)
+		{
+			double s = 0.0;
+			for (int k = 0; k < K; ++k) s += A.d[i][k] * B.d[j][k];
+			P.d[i][j] = s;
+		}
+}
+
+//-----------------------------------------------------------------------------
+//! P += s*A*B, where B is a K x n (row-major) matrix and P is R x n with row stride ldp.
+template <int R, int K>
+inline void mult_add(const small_matrix<R, K>& A, const double* B, int n, double* P, int ldp, double s)
+{
+	for (int i = 0; i < R; ++i)
+	{
+		double* pi = P + i*ldp;
+		for (int k = 0; k < K; ++k)
+		{
+			const double a = s*A.d[i][k];
+			const double* bk = B + k*n;
+			for (int j = 0; j < n; ++j) pi[j] += a*bk[j];
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+//! LU factorization with partial pivoting. Returns false if A is singular.
+template <int N>
+inline bool lu_factor(small_matrix<N, N>& A, int (&piv)[N])
+{
+	for (int k = 0; k < N; ++k)
+	{
+		int p = k;
+		double amax = fabs(A.d[k][k]);
+		for (int i = k + 1; i < N; ++i)
+		{
+			double a = fabs(A.d[i][k]);
+			if (a > amax) { amax = a; p = i; }
+		}
+		if (amax == 0.0) return false;
+		piv[k] = p;
+		if (p != k)
+		{
+			for (int j = 0; j < N; ++j) { double t = A.d[k][j]; A.d[k][j] = A.d[p][j]; A.d[p][j] = t; }
+		}
+
+		const double dkk = 1.0 / A.d[k][k];
+		for (int i = k + 1; i < N; ++i)
+		{
+			const double l = (A.d[i][k] *= dkk);
+			for (int j = k + 1; j < N; ++j) A.d[i][j] -= l*A.d[k][j];
+		}
+	}
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+//! Solve A*X = B with the factorization of lu_factor. B is N x m (row-major) and 
+//! is overwritten with the solution.
+template <int N>
+inline void lu_solve(const small_matrix<N, N>& LU, const int (&piv)[N], double* B, int m)
+{
+	for (int k = 0; k < N; ++k)
+	{
+		const int p = piv[k];
+		if (p != k)
+		{
+			for (int j = 0; j < m; ++j) { double t = B[k*m + j]; B[k*m + j] = B[p*m + j]; B[p*m + j] = t; }
+		}
+	}
+
+	for (int i = 1; i < N; ++i)
+		for (int k = 0; k < i; ++k)
+		{
+			const double l = LU.d[i][k];
+			for (int j = 0; j < m; ++j) B[i*m + j] -= l*B[k*m + j];
+		}
+
+	for (int i = N - 1; i >= 0; --i)
+	{
+		for (int k = i + 1; k < N; ++k)
+		{
+			const double u = LU.d[i][k];
+			for (int j = 0; j < m; ++j) B[i*m + j] -= u*B[k*m + j];
+		}
+		const double d = 1.0 / LU.d[i][i];
+		for (int j = 0; j < m; ++j) B[i*m + j] *= d;
+	}
+}
+
+//-----------------------------------------------------------------------------
+//! Cholesky factorization A = L*L^T of a symmetric positive definite matrix. 
+//! Only the lower triangle of A is used and it is overwritten with L, where the 
+//! diagonal stores the inverse of the diagonal of L. Returns false if A is not 
+//! positive definite.
+template <int N>
+inline bool chol_factor(small_matrix<N, N>& A)
+{
+	for (int k = 0; k < N; ++k)
+	{
+		double dkk = A.d[k][k];
+		for (int j = 0; j < k; ++j) dkk -= A.d[k][j] * A.d[k][j];
+		if (dkk <= 0.0) return false;
+		dkk = 1.0 / sqrt(dkk);
+		A.d[k][k] = dkk;
+
+		for (int i = k + 1; i < N; ++i)
+		{
+			double s = A.d[i][k];
+			for (int j = 0; j < k; ++j) s -= A.d[i][j] * A.d[k][j];
+			A.d[i][k] = s*dkk;
+		}
+	}
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+//! Solve A*X = B with the factorization of chol_factor. B is N x m (row-major) 
+//! and is overwritten with the solution.
+template <int N>
+inline void chol_solve(const small_matrix<N, N>& L, double* B, int m)
+{
+	for (int i = 0; i < N; ++i)
+	{
+		for (int k = 0; k < i; ++k)
+		{
+			const double l = L.d[i][k];
+			for (int j = 0; j < m; ++j) B[i*m + j] -= l*B[k*m + j];
+		}
+		const double d = L.d[i][i];
+		for (int j = 0; j < m; ++j) B[i*m + j] *= d;
+	}
+
+	for (int i = N - 1; i >= 0; --i)
+	{
+		for (int k = i + 1; k < N; ++k)
+		{
+			const double l = L.d[k][i];
+			for (int j = 0; j < m; ++j) B[i*m + j] -= l*B[k*m + j];
+		}
+		const double d = L.d[i][i];
+		for (int j = 0; j < m; ++j) B[i*m + j] *= d;
+	}
+}
+
+//-----------------------------------------------------------------------------
+// relative size below which a pivot of the batched factorizations is considered too small
+const double batch_pivot_tol = 1e-12;
+
+//-----------------------------------------------------------------------------
+//! Batched LU factorization without pivoting of W lane-interleaved N x N matrices.
+//! Returns the mask of the lanes with a small pivot. The factors of these lanes 
+//! are not usable.
+template <int N, int W>
+inline unsigned int batch_lu_factor(double* A)
+{
+	// the pivot threshold of each lane is relative to the largest entry of its matrix
+	double tol[W];
+	for (int w = 0; w < W; ++w) tol[w] = 0.0;
+	for (int i = 0; i < N*N; ++i)
+		for (int w = 0; w < W; ++w) { double a = fabs(A[i*W + w]); if (a > tol[w]) tol[w] = a; }
+	for (int w = 0; w < W; ++w) tol[w] *= batch_pivot_tol;
+
+	unsigned int mask = 0;
+	for (int k = 0; k < N; ++k)
+	{
+		double* akk = A + (k*N + k)*W;
+		double dkk[W];
+		for (int w = 0; w < W; ++w)
+		{
+			if (fabs(akk[w]) <= tol[w]) { mask |= (1u << w); dkk[w] = 0.0; }
+			else dkk[w] = 1.0 / akk[w];
+		}
+
+		for (int i = k + 1; i < N; ++i)
+		{
+			double* aik = A + (i*N + k)*W;
+			for (int w = 0; w < W; ++w) aik[w] *= dkk[w];
+			for (int j = k + 1; j < N; ++j)
+			{
+				double* aij = A + (i*N + j)*W;
+				const double* akj = A + (k*N + j)*W;
+				for (int w = 0; w < W; ++w) aij[w] -= aik[w] * akj[w];
+			}
+		}
+	}
+	return mask;
+}
+
+//-----------------------------------------------------------------------------
+//! Solve the W lane-interleaved systems A*X = B with the factors of batch_lu_factor.
+//! B is N x m per lane, with entry (i,j) of lane w at B[(i*m + j)*W + w].
+template <int N, int W>
+inline void batch_lu_solve(const double* LU, double* B, int m)
+{
+	for (int i = 1; i < N; ++i)
+		for (int k = 0; k < i; ++k)
+		{
+			const double* l = LU + (i*N + k)*W;
+			for (int j = 0; j < m; ++j)
+			{
+				double* bi = B + (i*m + j)*W;
+				const double* bk = B + (k*m + j)*W;
+				for (int w = 0; w < W; ++w) bi[w] -= l[w] * bk[w];
+			}
+		}
+
+	for (int i = N - 1; i >= 0; --i)
+	{
+		for (int k = i + 1; k < N; ++k)
+		{
+			const double* u = LU + (i*N + k)*W;
+			for (int j = 0; j < m; ++j)
+			{
+				double* bi = B + (i*m + j)*W;
+				const double* bk = B + (k*m + j)*W;
+				for (int w = 0; w < W; ++w) bi[w] -= u[w] * bk[w];
+			}
+		}
+
+		const double* uii = LU + (i*N + i)*W;
+		double d[W];
+		for (int w = 0; w < W; ++w) d[w] = (uii[w] != 0.0 ? 1.0 / uii[w] : 0.0);
+		for (int j = 0; j < m; ++j)
+		{
+			double* bi = B + (i*m + j)*W;
+			for (int w = 0; w < W; ++w) bi[w] *= d[w];
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+//! Batched Cholesky factorization of W lane-interleaved symmetric N x N matrices
+//! (same storage of L as chol_factor). Returns the mask of the lanes that are not 
+//! (numerically) positive definite. The factors of these lanes are not usable.
+template <int N, int W>
+inline unsigned int batch_chol_factor(double* A)
+{
+	double tol[W];
+	for (int w = 0; w < W; ++w) tol[w] = 0.0;
+	for (int k = 0; k < N; ++k)
+	{
+		const double* akk = A + (k*N + k)*W;
+		for (int w = 0; w < W; ++w) { double a = fabs(akk[w]); if (a > tol[w]) tol[w] = a; }
+	}
+	for (int w = 0; w < W; ++w) tol[w] *= batch_pivot_tol;
+
+	unsigned int mask = 0;
+	for (int k = 0; k < N; ++k)
+	{
+		double* akk = A + (k*N + k)*W;
+		for (int j = 0; j < k; ++j)
+		{
+			const double* akj = A + (k*N + j)*W;
+			for (int w = 0; w < W; ++w) akk[w] -= akj[w] * akj[w];
+		}
+		for (int w = 0; w < W; ++w)
+		{
+			if (akk[w] <= tol[w]) { mask |= (1u << w); akk[w] = 0.0; }
+			else akk[w] = 1.0 / sqrt(akk[w]);
+		}
+
+		for (int i = k + 1; i < N; ++i)
+		{
+			double* aik = A + (i*N + k)*W;
+			for (int j = 0; j < k; ++j)
+			{
+				const double* aij = A + (i*N + j)*W;
+				const double* akj = A + (k*N + j)*W;
+				for (int w = 0; w < W; ++w) aik[w] -= aij[w] * akj[w];
+			}
+			for (int w = 0; w < W; ++w) aik[w] *= akk[w];
+		}
+	}
+	return mask;
+}
+
+//-----------------------------------------------------------------------------
+//! Solve the W lane-interleaved systems A*X = B with the factors of batch_chol_factor.
+//! B is stored as in batch_lu_solve.
+template <int N, int W>
+inline void batch_chol_solve(const double* L, double* B, int m)
+{
+	for (int i = 0; i < N; ++i)
+	{
+		for (int k = 0; k < i; ++k)
+		{
+			const double* l = L + (i*N + k)*W;
+			for (int j = 0; j < m; ++j)
+			{
+				double* bi = B + (i*m + j)*W;
+				const double* bk = B + (k*m + j)*W;
+				for (int w = 0; w < W; ++w) bi[w] -= l[w] * bk[w];
+			}
+		}
+		const double* d = L + (i*N + i)*W;
+		for (int j = 0; j < m; ++j)
+		{
+			double* bi = B + (i*m + j)*W;
+			for (int w = 0; w < W; ++w) bi[w] *= d[w];
+		}
+	}
+
+	for (int i = N - 1; i >= 0; --i)
+	{
+		for (int k = i + 1; k < N; ++k)
+		{
+			const double* l = L + (k*N + i)*W;
+			for (int j = 0; j < m; ++j)
+			{
+				double* bi = B + (i*m + j)*W;
+				const double* bk = B + (k*m + j)*W;
+				for (int w = 0; w < W; ++w) bi[w] -= l[w] * bk[w];
+			}
+		}
+		const double* d = L + (i*N + i)*W;
+		for (int j = 0; j < m; ++j)
+		{
+			double* bi = B + (i*m + j)*W;
+			for (int w = 0; w < W; ++w) bi[w] *= d[w];
+		}
+	}
+}
+
+} // namespace FESmallLA
@@ -32,10 +32,20 @@ SOFTWARE.*/
 #include "tools.h"
 #include "log.h"
 #include "FEModel.h"
+#include "FEElementWorkspace.h"
+
+//-----------------------------------------------------------------------------
+BEGIN_FECORE_CLASS(FESolidDomain, FEDomain)
+	ADD_PARAMETER(m_bkinCache, "kinematics_cache");
+END_FECORE_CLASS();
 
 //-----------------------------------------------------------------------------
 FESolidDomain::FESolidDomain(FEModel* pfem) : FEDomain(FE_DOMAIN_SOLID, pfem), m_dofU(pfem), m_dofSU(pfem)
 {
+	m_bkinCache = false;
+	m_kinCacheValid = false;
+	m_kinCacheAlpha = 1.0;
+
 	if (pfem)
 	{
 		m_dofU.AddDof(pfem->GetDOFIndex("x"));
@@ -96,6 +106,8 @@ void FESolidDomain::CopyFrom(FEMeshPartition* pd)
 	FESolidDomain* psd = dynamic_cast<FESolidDomain*>(pd);
     m_Elem = psd->m_Elem;
 	ForEachElement([=](FEElement& el) { el.SetMeshPartition(this); });
+	m_bkinCache = psd->m_bkinCache;
+	InvalidateKinematicsCache();
 }
 
 //-----------------------------------------------------------------------------
@@ -152,6 +164,8 @@ bool FESolidDomain::Init()
 // Reset data
 void FESolidDomain::Reset()
 {
+	InvalidateKinematicsCache();
+
 	// re-evaluate the material points initial position and jacobian
 	ForEachSolidElement([=](FESolidElement& el) {
 
@@ -2326,6 +2340,93 @@ void FESolidDomain::gradTgradShape(FESolidElement& el, int j, vector<mat3d>& mn)
     }
 }
 
+//-----------------------------------------------------------------------------
+void FESolidDomain::UpdateKinematicsCache(double alpha)
+{
+	if (m_bkinCache == false) return;
+
+	// build the offset table
+	int NE = Elements();
+	if (m_kinCacheOffset.size() != NE + 1)
+	{
+		m_kinCacheOffset.resize(NE + 1);
+		m_kinCacheOffset[0] = 0;
+		for (int i = 0; i < NE; ++i) m_kinCacheOffset[i + 1] = m_kinCacheOffset[i] + m_Elem[i].GaussPoints();
+		m_kinCache.resize(m_kinCacheOffset[NE]);
+	}
+
+	#pragma omp parallel for
+	for (int i = 0; i < NE; ++i)
+	{
+		FESolidElement& el = m_Elem[i];
+		KINEMATICS* kc = &m_kinCache[m_kinCacheOffset[i]];
+		int nint = el.GaussPoints();
+		if (el.isActive() == false)
+		{
+			for (int n = 0; n < nint; ++n) kc[n].detJ = 0.0;
+			continue;
+		}
+
+		// gather the nodal coordinates only once per element
+		vec3d rt[FEElement::MAX_NODES];
+		GetCurrentNodalCoordinates(el, rt, alpha);
+
+		try {
+			for (int n = 0; n < nint; ++n) kc[n].detJ = invjact(el, kc[n].Ji, n, rt);
+		}
+		catch (NegativeJacobian)
+		{
+			// We don't throw here, but leave it to the element loops to
+			// reevaluate (and report) this element. 
+			for (int n = 0; n < nint; ++n) kc[n].detJ = 0.0;
+		}
+	}
+
+	m_kinCacheAlpha = alpha;
+	m_kinCacheValid = true;
+}
+
+//-----------------------------------------------------------------------------
+double FESolidDomain::CachedInvJact(FESolidElement& el, double Ji[3][3], int n, double alpha)
+{
+	if (m_kinCacheValid && (alpha == m_kinCacheAlpha))
+	{
+		const KINEMATICS& kc = m_kinCache[m_kinCacheOffset[el.GetLocalID()] + n];
+		if (kc.detJ > 0.0)
+		{
+			for (int i = 0; i < 3; ++i)
+				for (int j = 0; j < 3; ++j) Ji[i][j] = kc.Ji[i][j];
+			return kc.detJ;
+		}
+	}
+
+	return (alpha == 1.0 ? invjact(el, Ji, n) : invjact(el, Ji, n, alpha));
+}
+
+//-----------------------------------------------------------------------------
+double FESolidDomain::CachedShapeGradient(FESolidElement& el, int n, vec3d* GradH, double alpha)
+{
+	// calculate jacobian
+	double Ji[3][3];
+	double detJt = CachedInvJact(el, Ji, n, alpha);
+
+	// evaluate shape function derivatives
+	int ne = el.Nodes();
+	const double* Gr = el.Gr(n);
+	const double* Gs = el.Gs(n);
+	const double* Gt = el.Gt(n);
+	for (int i = 0; i<ne; ++i)
+	{
+		// calculate global gradient of shape functions
+		// note that we need the transposed of Ji, not Ji itself !
+		GradH[i].x = Ji[0][0] * Gr[i] + Ji[1][0] * Gs[i] + Ji[2][0] * Gt[i];
+		GradH[i].y = Ji[0][1] * Gr[i] + Ji[1][1] * Gs[i] + Ji[2][1] * Gt[i];
+		GradH[i].z = Ji[0][2] * Gr[i] + Ji[1][2] * Gs[i] + Ji[2][2] * Gt[i];
+	}
+
+	return detJt;
+}
+
 //-----------------------------------------------------------------------------
 double FESolidDomain::ShapeGradient(FESolidElement& el, int n, vec3d* GradH)
 {
@@ -2562,146 +2663,11 @@ void FESolidDomain::LoadVector(
 	FEVolumeVectorIntegrand f	// the actual integrand function
 )
 {
-	FEMesh& mesh = *GetMesh();
-
-	// degrees of freedom per node
-	int dofPerNode = dofList.Size();
-
-	// loop over all the elements
-	int NE = Elements();
-	#pragma omp parallel for 
-	for (int i = 0; i<NE; ++i)
-	{
-		// get the next element
-		FESolidElement& el = Element(i);
-		int neln = el.Nodes();
-
-		// only consider active elements
-		if (el.isActive()) 
-		{
-			std::vector<double> val(dofPerNode, 0.0);
-
-			// total size of the element vector
-			int ndof = dofPerNode * el.Nodes();
-
-			// setup the element vector
-			vector<double> fe;
-			fe.assign(ndof, 0);
-
-			// loop over integration points
-			double* w = el.GaussWeights();
-			int nint = el.GaussPoints();
-			for (int n = 0; n<nint; ++n)
-			{
-				FEMaterialPoint& mp = *el.GetMaterialPoint(n);
-
-				mp.m_Jt = detJt(el, n);
-				mp.m_shape = el.H(n);
-
-				// loop over all nodes
-				for (int j = 0; j<neln; ++j)
-				{
-					// get the value of the integrand for this node
-					f(mp, j, val);
-
-					// add it all up
-					for (int k=0; k<dofPerNode; ++k)
-					{
-						fe[dofPerNode*j + k] += val[k] * w[n];
-					}
-				}
-			}
-
-			// get the element's LM vector
-			vector<int> lm(ndof, -1);
-			for (int j = 0; j < neln; ++j)
-			{
-				FENode& node = mesh.Node(el.m_node[j]);
-				vector<int>& ID = node.m_ID;
-				for (int k = 0; k < dofPerNode; ++k)
-				{
-					lm[dofPerNode*j + k] = ID[dofList[k]];
-				}
-			}
-
-			// Assemble into global vector
-			R.Assemble(el.m_node, lm, fe);
-		}
-	}
+	LoadVector<FEVolumeVectorIntegrand>(R, dofList, f);
 }
 
 //-----------------------------------------------------------------------------
 void FESolidDomain::LoadStiffness(FELinearSystem& LS, const FEDofList& dofList_a, const FEDofList& dofList_b, FEVolumeMatrixIntegrand f)
 {
-	FEElementMatrix ke;
-
-	int dofPerNode_a = dofList_a.Size();
-	int dofPerNode_b = dofList_b.Size();
-
-	FEMesh& mesh = *GetMesh();
-	vec3d rt[FEElement::MAX_NODES];
-
-	matrix kab(dofPerNode_a, dofPerNode_b);
-
-	int NE = Elements();
-	for (int m = 0; m<NE; ++m)
-	{
-		// get the element
-		FESolidElement& el = Element(m);
-
-		// calculate nodal normal tractions
-		int neln = el.Nodes();
-
-		// get the element stiffness matrix
-		ke.SetNodes(el.m_node);
-		int ndof_a = dofPerNode_a * neln;
-		int ndof_b = dofPerNode_b * neln;
-		ke.resize(ndof_a, ndof_b);
-
-		// calculate element stiffness
-		int nint = el.GaussPoints();
-
-		// gauss weights
-		double* w = el.GaussWeights();
-
-		// repeat over integration points
-		ke.zero();
-		for (int n = 0; n<nint; ++n)
-		{
-			FEMaterialPoint& pt = *el.GetMaterialPoint(n);
-
-			// set the shape function values
-			pt.m_shape = el.H(n);
-
-			// calculate stiffness component
-			for (int i = 0; i<neln; ++i)
-				for (int j = 0; j<neln; ++j)
-				{
-					// evaluate integrand
-					kab.zero();
-					f(pt, i, j, kab);
-					ke.adds(dofPerNode_a * i, dofPerNode_b * j, kab, w[n]);
-				}
-		}
-
-		// get the element's LM vector
-		std::vector<int>& lma = ke.RowIndices();
-		std::vector<int>& lmb = ke.ColumnsIndices();
-		lma.assign(ndof_a, -1);
-		lmb.assign(ndof_b, -1);
-		for (int j = 0; j < neln; ++j)
-		{
-			FENode& node = mesh.Node(el.m_node[j]);
-			std::vector<int>& ID = node.m_ID;
-
-			for (int k = 0; k < dofPerNode_a; ++k)
-				lma[dofPerNode_a*j + k] = ID[dofList_a[k]];
-
-			for (int k = 0; k < dofPerNode_b; ++k)
-				lmb[dofPerNode_b*j + k] = ID[dofList_b[k]];
-		}
-
-		// assemble element matrix in global stiffness matrix
-		LS.Assemble(ke);
-	}
+	LoadStiffness<FEVolumeMatrixIntegrand>(LS, dofList_a, dofList_b, f);
 }
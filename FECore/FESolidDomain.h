@@ -250,6 +250,24 @@ public:
 	//! calculate the volume of an element in current frame
 	double CurrentVolume(FESolidElement& el);
 
+public: // kinematics cache
+	//! see if the kinematics cache is enabled
+	bool UseKinematicsCache() const { return m_bkinCache; }
+
+	//! Evaluate the inverse jacobians and jacobian determinants at all integration points
+	//! for the current (or intermediate, when alpha != 1) configuration and store them in the cache.
+	//! This should be called once per update of the nodal positions. Does nothing if the cache is not enabled.
+	void UpdateKinematicsCache(double alpha = 1.0);
+
+	//! mark the cache as out of date
+	void InvalidateKinematicsCache() { m_kinCacheValid = false; }
+
+	//! Same as invjact, but reads the values from the kinematics cache when the cache is valid
+	double CachedInvJact(FESolidElement& el, double Ji[3][3], int n, double alpha = 1.0);
+
+	//! Same as ShapeGradient, but uses the kinematics cache when the cache is valid
+	double CachedShapeGradient(FESolidElement& el, int n, vec3d* GradH, double alpha = 1.0);
+
 public:
 	//! get the current nodal coordinates
 	void GetCurrentNodalCoordinates(const FESolidElement& el, vec3d* rt);
@@ -269,20 +287,32 @@ public:
 	virtual int GetElementDofs(FESolidElement& el);
 
 public:
+	// NOTE: Deprecated. The std::function versions below are kept for plugins that pass
+	// an FEVolumeVectorIntegrand or FEVolumeMatrixIntegrand, and call the template versions.
+	// They are final, since lambdas resolve to the template versions, which would skip an override.
+
 	// Evaluate an integral over the domain and assemble into global load vector
+	[[deprecated("pass the integrand directly to the template version")]]
 	virtual void LoadVector(
 		FEGlobalVector& R,			// the global vector to assembe the load vector in
 		const FEDofList& dofList,	// the degree of freedom list
 		FEVolumeVectorIntegrand f	// the actual integrand function
-	);
+	) final;
 
 	//! Evaluate the stiffness matrix of a load
+	[[deprecated("pass the integrand directly to the template version")]]
 	virtual void LoadStiffness(
 		FELinearSystem& LS,			// The solver does the assembling
 		const FEDofList& dofList_a,	// The degree of freedom list of node a
 		const FEDofList& dofList_b,	// The degree of freedom list of node b
 		FEVolumeMatrixIntegrand f	// the matrix function to evaluate
-	);
+	) final;
+
+	// Same as above, but the integrand's type is a template parameter so that it can
+	// be inlined in the integration loop. Lambdas passed to LoadVector and LoadStiffness
+	// resolve to these overloads.
+	template <class F> void LoadVector(FEGlobalVector& R, const FEDofList& dofList, F f);
+	template <class F> void LoadStiffness(FELinearSystem& LS, const FEDofList& dofList_a, const FEDofList& dofList_b, F f);
 
 protected:
     vector<FESolidElement>	m_Elem;		//!< array of elements
@@ -290,4 +320,24 @@ protected:
 
 	FEDofList	m_dofU;
 	FEDofList	m_dofSU;
+
+	bool	m_bkinCache;	//!< use the kinematics cache
+
+private:
+	// cached kinematics data at an integration point
+	struct KINEMATICS
+	{
+		double	Ji[3][3];	// inverse jacobian (current frame)
+		double	detJ;		// jacobian determinant (current frame), zero if not evaluated
+	};
+
+	bool				m_kinCacheValid;	//!< is the cache up to date?
+	double				m_kinCacheAlpha;	//!< configuration for which the cache was evaluated
+	vector<int>			m_kinCacheOffset;	//!< index of first integration point of each element
+	vector<KINEMATICS>	m_kinCache;			//!< the cached data
+
+	DECLARE_FECORE_CLASS();
 };
+
+// The following file contains the definition of the template functions
+#include "FESolidDomain.hpp"
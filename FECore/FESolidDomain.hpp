@@ -0,0 +1,156 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+#pragma once
+// NOTE: This file is automatically included from FESolidDomain.h
+#include "FEElementWorkspace.h"
+
+//-----------------------------------------------------------------------------
+// Evaluate an integral over the domain and assemble into global load vector
+template <class F> void FESolidDomain::LoadVector(
+	FEGlobalVector& R,			// the global vector to assembe the load vector in
+	const FEDofList& dofList,	// the degree of freedom list
+	F f						// the actual integrand function
+)
+{
+	// degrees of freedom per node
+	int dofPerNode = dofList.Size();
+
+	// loop over all the elements
+	int NE = Elements();
+	#pragma omp parallel for 
+	for (int i = 0; i<NE; ++i)
+	{
+		// get the next element
+		FESolidElement& el = Element(i);
+		int neln = el.Nodes();
+
+		// only consider active elements
+		if (el.isActive()) 
+		{
+			FEScopedWorkspace ws;
+			std::vector<double>& val = ws->buf;
+			val.assign(dofPerNode, 0.0);
+
+			// total size of the element vector
+			int ndof = dofPerNode * el.Nodes();
+
+			// setup the element vector
+			vector<double>& fe = ws->ElementVector(ndof);
+
+			// loop over integration points
+			double* w = el.GaussWeights();
+			int nint = el.GaussPoints();
+			for (int n = 0; n<nint; ++n)
+			{
+				FEMaterialPoint& mp = *el.GetMaterialPoint(n);
+
+				mp.m_Jt = detJt(el, n);
+				mp.m_shape = el.H(n);
+
+				// loop over all nodes
+				for (int j = 0; j<neln; ++j)
+				{
+					// get the value of the integrand for this node
+					f(mp, j, val);
+
+					// add it all up
+					for (int k=0; k<dofPerNode; ++k)
+					{
+						fe[dofPerNode*j + k] += val[k] * w[n];
+					}
+				}
+			}
+
+			// get the element's LM vector
+			vector<int>& lm = ws->lm;
+			FEDomain::UnpackLM(el, dofList, lm);
+
+			// Assemble into global vector
+			R.Assemble(el.m_node, lm, fe);
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+template <class F> void FESolidDomain::LoadStiffness(FELinearSystem& LS, const FEDofList& dofList_a, const FEDofList& dofList_b, F f)
+{
+	FEScopedWorkspace ws;
+
+	int dofPerNode_a = dofList_a.Size();
+	int dofPerNode_b = dofList_b.Size();
+
+	matrix kab(dofPerNode_a, dofPerNode_b);
+
+	int NE = Elements();
+	for (int m = 0; m<NE; ++m)
+	{
+		// get the element
+		FESolidElement& el = Element(m);
+
+		// calculate nodal normal tractions
+		int neln = el.Nodes();
+
+		// get the element stiffness matrix
+		int ndof_a = dofPerNode_a * neln;
+		int ndof_b = dofPerNode_b * neln;
+		FEElementMatrix& ke = ws->ElementMatrix(el, ndof_a, ndof_b);
+
+		// calculate element stiffness
+		int nint = el.GaussPoints();
+
+		// gauss weights
+		double* w = el.GaussWeights();
+
+		// repeat over integration points
+		for (int n = 0; n<nint; ++n)
+		{
+			FEMaterialPoint& pt = *el.GetMaterialPoint(n);
+
+			// set the shape function values
+			pt.m_shape = el.H(n);
+
+			// calculate stiffness component
+			for (int i = 0; i<neln; ++i)
+				for (int j = 0; j<neln; ++j)
+				{
+					// evaluate integrand
+					kab.zero();
+					f(pt, i, j, kab);
+					ke.adds(dofPerNode_a * i, dofPerNode_b * j, kab, w[n]);
+				}
+		}
+
+		// get the element's LM vector
+		FEDomain::UnpackLM(el, dofList_a, ke.RowIndices());
+		FEDomain::UnpackLM(el, dofList_b, ke.ColumnsIndices());
+
+		// assemble element matrix in global stiffness matrix
+		LS.Assemble(ke);
+	}
+}
@@ -0,0 +1,162 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+#pragma once
+#include "FEElementTraits.h"
+#include "mat3d.h"
+
+//-----------------------------------------------------------------------------
+// This file defines element kernels for solid elements where the number of 
+// nodes and integration points are known at compile time. This allows the compiler 
+// to fully unroll (and vectorize) the loops over the element nodes. 
+//
+// The FESolidElementKernel class template maps an element type to its traits
+// class (see FEElementTraits.h). Only the most common element types are 
+// specialized. For all other types, FESolidElementKernel<type>::supported is false
+// and the caller should use the general (runtime-sized) code path.
+
+template <FE_Element_Type ET> struct FESolidElementKernel { enum { supported = 0 }; };
+
+#define FESOLID_ELEMENT_KERNEL(theType, theTraits) \
+	template <> struct FESolidElementKernel<theType> { \
+		enum { supported = 1 }; \
+		enum { NELN = theTraits::NELN }; \
+		enum { NINT = theTraits::NINT }; \
+	};
+
+FESOLID_ELEMENT_KERNEL(FE_HEX8G8  , FEHex8G8  );
+FESOLID_ELEMENT_KERNEL(FE_HEX8G1  , FEHex8G1  );
+FESOLID_ELEMENT_KERNEL(FE_TET4G1  , FETet4G1  );
+FESOLID_ELEMENT_KERNEL(FE_TET4G4  , FETet4G4  );
+FESOLID_ELEMENT_KERNEL(FE_PENTA6G6, FEPenta6G6);
+FESOLID_ELEMENT_KERNEL(FE_TET10G4 , FETet10G4 );
+FESOLID_ELEMENT_KERNEL(FE_TET10G8 , FETet10G8 );
+FESOLID_ELEMENT_KERNEL(FE_HEX20G8 , FEHex20G8 );
+FESOLID_ELEMENT_KERNEL(FE_HEX20G27, FEHex20G27);
+
+#undef FESOLID_ELEMENT_KERNEL
+
+//-----------------------------------------------------------------------------
+// Calls f.run<ET>() for the element type et if a specialized kernel exists
+// for this type. Returns false if there is no specialized kernel.
+template <class F> inline bool FEDispatchSolidElementKernel(int et, F& f)
+{
+	switch (et)
+	{
+	case FE_HEX8G8  : f.template run<FE_HEX8G8  >(); return true;
+	case FE_HEX8G1  : f.template run<FE_HEX8G1  >(); return true;
+	case FE_TET4G1  : f.template run<FE_TET4G1  >(); return true;
+	case FE_TET4G4  : f.template run<FE_TET4G4  >(); return true;
+	case FE_PENTA6G6: f.template run<FE_PENTA6G6>(); return true;
+	case FE_TET10G4 : f.template run<FE_TET10G4 >(); return true;
+	case FE_TET10G8 : f.template run<FE_TET10G8 >(); return true;
+	case FE_HEX20G8 : f.template run<FE_HEX20G8 >(); return true;
+	case FE_HEX20G27: f.template run<FE_HEX20G27>(); return true;
+	}
+	return false;
+}
+
+namespace FESolidKernel {
+
+//-----------------------------------------------------------------------------
+//! Add the material stiffness B^T*D*B*w of one integration point to the element matrix ke.
+//! G are the spatial shape function gradients, D the 6x6 (Voigt) material tangent.
+//! Here, ke is assumed to have row access through operator [] (e.g. matrix).
+//! If upper is true, only the node blocks on or above the diagonal are evaluated.
+template <int NELN, class M> inline void MaterialStiffness(const vec3d* G, const double D[6][6], double w, M& ke, bool upper = false)
+{
+	// first, evaluate D*B for all nodes
+	double DB[NELN][6][3];
+	for (int j = 0; j < NELN; ++j)
+	{
+		const double Gx = G[j].x, Gy = G[j].y, Gz = G[j].z;
+		for (int k = 0; k < 6; ++k)
+		{
+			DB[j][k][0] = D[k][0]*Gx + D[k][3]*Gy + D[k][5]*Gz;
+			DB[j][k][1] = D[k][1]*Gy + D[k][3]*Gx + D[k][4]*Gz;
+			DB[j][k][2] = D[k][2]*Gz + D[k][4]*Gy + D[k][5]*Gx;
+		}
+	}
+
+	// then, evaluate B^T*(D*B)
+	for (int i = 0; i < NELN; ++i)
+	{
+		const double Gxi = G[i].x*w, Gyi = G[i].y*w, Gzi = G[i].z*w;
+		double* k0 = ke[3*i  ];
+		double* k1 = ke[3*i+1];
+		double* k2 = ke[3*i+2];
+		for (int j = (upper ? i : 0); j < NELN; ++j)
+		{
+			const double (&d)[6][3] = DB[j];
+			for (int l = 0; l < 3; ++l)
+			{
+				k0[3*j + l] += Gxi*d[0][l] + Gyi*d[3][l] + Gzi*d[5][l];
+				k1[3*j + l] += Gyi*d[1][l] + Gxi*d[3][l] + Gzi*d[4][l];
+				k2[3*j + l] += Gzi*d[2][l] + Gyi*d[4][l] + Gxi*d[5][l];
+			}
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+//! Add the geometrical (initial stress) stiffness of one integration point to ke.
+template <int NELN, class M> inline void GeometricalStiffness(const vec3d* G, const mat3ds& s, double w, M& ke, bool upper = false)
+{
+	// evaluate s*G for all nodes
+	vec3d sG[NELN];
+	for (int j = 0; j < NELN; ++j) sG[j] = s*G[j];
+
+	for (int i = 0; i < NELN; ++i)
+	{
+		double* k0 = ke[3*i  ];
+		double* k1 = ke[3*i+1];
+		double* k2 = ke[3*i+2];
+		for (int j = (upper ? i : 0); j < NELN; ++j)
+		{
+			double kab = (G[i]*sG[j])*w;
+			k0[3*j  ] += kab;
+			k1[3*j+1] += kab;
+			k2[3*j+2] += kab;
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+//! Subtract the internal force contribution of one integration point from fe.
+template <int NELN> inline void InternalForce(const vec3d* G, const mat3ds& s, double w, double* fe)
+{
+	for (int i = 0; i < NELN; ++i)
+	{
+		vec3d f = (s*G[i])*w;
+		fe[3*i  ] -= f.x;
+		fe[3*i+1] -= f.y;
+		fe[3*i+2] -= f.z;
+	}
+}
+
+} // namespace FESolidKernel
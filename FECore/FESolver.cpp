@@ -30,6 +30,7 @@ SOFTWARE.*/
 #include "FESolver.h"
 #include "FEModel.h"
 #include "FENodeReorder.h"
+#include "FENestedDissection.h"
 #include "DumpStream.h"
 #include "FEDomain.h"
 #include "FESurfacePairConstraint.h"
@@ -44,6 +45,7 @@ BEGIN_FECORE_CLASS(FESolver, FECoreBase)
 		ADD_PARAMETER(m_eq_scheme, "equation_scheme", 0, "staggered\0block\0");
 		ADD_PARAMETER(m_eq_order , "equation_order", 0, "default\0reverse\0febio2\0");
 		ADD_PARAMETER(m_bwopt    , "optimize_bw");
+		ADD_PARAMETER(m_nodeOrder, "node_ordering", 0, "default\0bandwidth\0nested_dissection\0");
 	END_PARAM_GROUP();
 END_FECORE_CLASS();
 
@@ -61,6 +63,7 @@ FESolver::FESolver(FEModel* fem) : FECoreBase(fem)
 	m_neq = 0;
 
 	m_bwopt = false;
+	m_nodeOrder = NODE_ORDERING::DEFAULT_NODE_ORDER;
 
 	m_eq_scheme = EQUATION_SCHEME::STAGGERED;
 	m_eq_order = EQUATION_ORDER::NORMAL_ORDER;
@@ -153,12 +156,17 @@ Matrix_Type FESolver::MatrixType() const
 double FESolver::ExtractSolutionNorm(const vector<double>& v, const FEDofList& dofs) const
 {
 	assert(v.size() == m_dofMap.size());
+	// single pass over the vector (the dof list is short)
+	const int N = (int)v.size();
+	const int ndofs = dofs.Size();
 	double norm = 0;
-	for (int n = 0; n < dofs.Size(); ++n)
+#pragma omp parallel for reduction(+:norm) if (N > MIN_PARALLEL_SIZE)
+	for (int i = 0; i < N; ++i)
 	{
-		for (int i = 0; i < v.size(); ++i)
+		int dof_i = m_dofMap[i];
+		for (int n = 0; n < ndofs; ++n)
 		{
-			if (m_dofMap[i] == dofs[n]) norm += v[i] * v[i];
+			if (dof_i == dofs[n]) { norm += v[i] * v[i]; break; }
 		}
 	}
 	return norm;
@@ -319,6 +327,37 @@ bool FESolver::InitStep(double time)
 	return true;
 }
 
+//-----------------------------------------------------------------------------
+//! P stores for each new position the (mesh index of the) node that is numbered there.
+//! The optimize_bw flag is still honored for older input files.
+void FESolver::NodeOrdering(std::vector<int>& P)
+{
+	FEMesh& mesh = GetFEModel()->GetMesh();
+	int NN = mesh.Nodes();
+	P.resize(NN);
+
+	int order = m_nodeOrder;
+	if (m_bwopt && (order == NODE_ORDERING::DEFAULT_NODE_ORDER)) order = NODE_ORDERING::BANDWIDTH_ORDER;
+
+	switch (order)
+	{
+	case NODE_ORDERING::BANDWIDTH_ORDER:
+	{
+		FENodeReorder mod;
+		mod.Apply(mesh, P);
+	}
+	break;
+	case NODE_ORDERING::NESTED_DISSECTION:
+	{
+		FENestedDissection mod;
+		mod.Apply(mesh, P);
+	}
+	break;
+	default:
+		for (int i = 0; i < NN; ++i) P[i] = i;
+	}
+}
+
 //-----------------------------------------------------------------------------
 //!	This function initializes the equation system.
 //! It is assumed that all free dofs up until now have been given an ID >= 0
@@ -345,15 +384,8 @@ bool FESolver::InitEquations()
 
 	// reorder the node numbers
 	int NN = mesh.Nodes();
-	vector<int> P(NN);
-    
-    // see if we need to optimize the bandwidth
-	if (m_bwopt)
-	{
-		FENodeReorder mod;
-		mod.Apply(mesh, P);
-	}
-	else for (int i = 0; i < NN; ++i) P[i] = i;
+	vector<int> P;
+	NodeOrdering(P);
 
 	for (int i = 0; i < mesh.Nodes(); ++i)
 	{
@@ -546,15 +578,8 @@ bool FESolver::InitEquations2()
 
 	// reorder the node numbers
 	int NN = mesh.Nodes();
-	vector<int> P(NN);
-
-	// see if we need to optimize the bandwidth
-	if (m_bwopt)
-	{
-		FENodeReorder mod;
-		mod.Apply(mesh, P);
-	}
-	else for (int i = 0; i < NN; ++i) P[i] = i;
+	vector<int> P;
+	NodeOrdering(P);
 
 	// reset all equation numbers
 	// first, on all nodes
@@ -801,7 +826,7 @@ FENodalDofInfo FESolver::GetDOFInfoFromEquation(int ieq)
 	for (int i = 0; i < mesh.Nodes(); ++i)
 	{
 		FENode& node = mesh.Node(i);
-		vector<int>& id = node.m_ID;
+		FENodeDofArray<int>& id = node.m_ID;
 		for (int j = 0; j < id.size(); ++j)
 		{
 			if (id[j] == ieq)
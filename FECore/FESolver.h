@@ -52,6 +52,18 @@ enum EQUATION_ORDER
 	FEBIO2_ORDER
 };
 
+//-----------------------------------------------------------------------------
+// Ordering of the nodes when assigning equation numbers
+// DEFAULT_NODE_ORDER: nodes are numbered in the order they are stored
+// BANDWIDTH_ORDER   : bandwidth minimizing order (best for skyline solver)
+// NESTED_DISSECTION : fill reducing order (for sparse direct solvers that don't reorder)
+enum NODE_ORDERING
+{
+	DEFAULT_NODE_ORDER,
+	BANDWIDTH_ORDER,
+	NESTED_DISSECTION
+};
+
 //-----------------------------------------------------------------------------
 // Solution variable
 class FESolutionVariable
@@ -179,6 +191,10 @@ public:
 	// return the node (mesh index) from an equation number
 	FENodalDofInfo GetDOFInfoFromEquation(int ieq);
 
+protected:
+	// calculate the order in which the nodes are assigned equation numbers
+	void NodeOrdering(std::vector<int>& P);
+
 public:
 	// extract the (square) norm of a solution vector
 	double ExtractSolutionNorm(const vector<double>& v, const FEDofList& dofs) const;
@@ -188,6 +204,7 @@ public:
 
 public: //TODO Move these parameters elsewhere
 	bool				m_bwopt;	    //!< bandwidth optimization flag
+	int					m_nodeOrder;	//!< node ordering for equation numbers (see NODE_ORDERING)
 	int					m_msymm;		//!< matrix symmetry flag for linear solver allocation
 	int					m_eq_scheme;	//!< equation number scheme (used in InitEquations)
 	int					m_eq_order;		//!< normal or reverse ordering
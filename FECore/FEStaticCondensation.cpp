@@ -0,0 +1,332 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+#include "stdafx.h"
+#include "FEStaticCondensation.h"
+#include "DumpStream.h"
+#include "FESmallMatrix.h"
+#include <algorithm>
+#include <math.h>
+#include <assert.h>
+
+//-----------------------------------------------------------------------------
+// LU factorization with partial pivoting of the n x n (row-major) matrix A.
+static bool lu_factor(double* A, int* piv, int n)
+{
+	for (int k = 0; k < n; ++k)
+	{
+		int p = k;
+		double amax = fabs(A[k*n + k]);
+		for (int i = k + 1; i < n; ++i)
+		{
+			double a = fabs(A[i*n + k]);
+			if (a > amax) { amax = a; p = i; }
+		}
+		if (amax == 0.0) return false;
+		piv[k] = p;
+		if (p != k) std::swap_ranges(A + k*n, A + (k + 1)*n, A + p*n);
+
+		const double* rk = A + k*n;
+		double dki = 1.0 / rk[k];
+		for (int i = k + 1; i < n; ++i)
+		{
+			double* ri = A + i*n;
+			double l = (ri[k] *= dki);
+			for (int j = k + 1; j < n; ++j) ri[j] -= l*rk[j];
+		}
+	}
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+// Solve LU*X = P*B for the n x m (row-major) right-hand sides B, in place.
+static void lu_solve(const double* LU, const int* piv, double* B, int n, int m)
+{
+	for (int k = 0; k < n; ++k)
+	{
+		if (piv[k] != k) std::swap_ranges(B + k*m, B + (k + 1)*m, B + piv[k]*m);
+	}
+
+	for (int i = 1; i < n; ++i)
+	{
+		double* bi = B + i*m;
+		for (int k = 0; k < i; ++k)
+		{
+			double l = LU[i*n + k];
+			const double* bk = B + k*m;
+			for (int j = 0; j < m; ++j) bi[j] -= l*bk[j];
+		}
+	}
+
+	for (int i = n - 1; i >= 0; --i)
+	{
+		double* bi = B + i*m;
+		for (int k = i + 1; k < n; ++k)
+		{
+			double u = LU[i*n + k];
+			const double* bk = B + k*m;
+			for (int j = 0; j < m; ++j) bi[j] -= u*bk[j];
+		}
+		double d = 1.0 / LU[i*n + i];
+		for (int j = 0; j < m; ++j) bi[j] *= d;
+	}
+}
+
+//-----------------------------------------------------------------------------
+FEStaticCondensation::FEStaticCondensation()
+{
+	m_nel = m_nu = m_na = 0;
+}
+
+//-----------------------------------------------------------------------------
+void FEStaticCondensation::Create(int elems, int nu, int na)
+{
+	m_nel = elems;
+	m_nu = nu;
+	m_na = na;
+	m_Kua.assign((size_t)elems*nu*na, 0.0);
+	m_X.assign((size_t)elems*na*nu, 0.0);
+	m_y.assign((size_t)elems*na, 0.0);
+}
+
+//-----------------------------------------------------------------------------
+void FEStaticCondensation::Clear()
+{
+	m_nel = m_nu = m_na = 0;
+	m_Kua.clear();
+	m_X.clear();
+	m_y.clear();
+}
+
+//-----------------------------------------------------------------------------
+void FEStaticCondensation::StoreBlocks(int iel, const double* Kua, const double* Kau, const double* fa)
+{
+	const int nu = m_nu, na = m_na;
+	double* kua = &m_Kua[(size_t)iel*nu*na];
+	double* X = &m_X[(size_t)iel*na*nu];
+	double* y = &m_y[(size_t)iel*na];
+
+	std::copy(Kua, Kua + nu*na, kua);
+	if (Kau) std::copy(Kau, Kau + na*nu, X);
+	else
+	{
+		for (int i = 0; i < na; ++i)
+			for (int j = 0; j < nu; ++j) X[i*nu + j] = Kua[j*na + i];
+	}
+	std::copy(fa, fa + na, y);
+}
+
+//-----------------------------------------------------------------------------
+bool FEStaticCondensation::FactorElement(int iel, double* Kaa)
+{
+	const int nu = m_nu, na = m_na;
+	double* X = &m_X[(size_t)iel*na*nu];
+	double* y = &m_y[(size_t)iel*na];
+
+	std::vector<int> piv(na);
+	if (lu_factor(Kaa, &piv[0], na) == false) return false;
+	lu_solve(Kaa, &piv[0], X, na, nu);
+	lu_solve(Kaa, &piv[0], y, na, 1);
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+bool FEStaticCondensation::SetElementBlocks(int iel, const double* Kaa, const double* Kua, const double* Kau, const double* fa)
+{
+	Batch batch(*this);
+	batch.Add(iel, Kaa, Kua, Kau, fa);
+	return batch.Factor();
+}
+
+//-----------------------------------------------------------------------------
+void FEStaticCondensation::CondenseStiffness(int iel, matrix& ke) const
+{
+	const int nu = m_nu, na = m_na;
+	const double* kua = &m_Kua[(size_t)iel*nu*na];
+	const double* X = &m_X[(size_t)iel*na*nu];
+	for (int i = 0; i < nu; ++i)
+	{
+		double* ki = ke[i];
+		for (int k = 0; k < na; ++k)
+		{
+			double a = kua[i*na + k];
+			const double* xk = X + k*nu;
+			for (int j = 0; j < nu; ++j) ki[j] -= a*xk[j];
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+void FEStaticCondensation::CondenseResidual(int iel, std::vector<double>& fe) const
+{
+	const int nu = m_nu, na = m_na;
+	const double* kua = &m_Kua[(size_t)iel*nu*na];
+	const double* y = &m_y[(size_t)iel*na];
+	for (int i = 0; i < nu; ++i)
+	{
+		double s = 0.0;
+		for (int k = 0; k < na; ++k) s += kua[i*na + k] * y[k];
+		fe[i] += s;
+	}
+}
+
+//-----------------------------------------------------------------------------
+void FEStaticCondensation::Recover(int iel, const double* du, double* da) const
+{
+	const int nu = m_nu, na = m_na;
+	const double* X = &m_X[(size_t)iel*na*nu];
+	const double* y = &m_y[(size_t)iel*na];
+	for (int k = 0; k < na; ++k)
+	{
+		const double* xk = X + k*nu;
+		double s = y[k];
+		for (int j = 0; j < nu; ++j) s += xk[j] * du[j];
+		da[k] = s;
+	}
+}
+
+//-----------------------------------------------------------------------------
+// Factors the interleaved Kaa blocks of a batch and solves for the right-hand sides.
+struct FEStaticCondensationBatchKernel
+{
+	double*	A;
+	double*	B;
+	int		m;
+	bool	sym;
+	unsigned int	mask;
+
+	template <int N> void run()
+	{
+		const int W = FEStaticCondensation::LANES;
+		if (sym)
+		{
+			mask = FESmallLA::batch_chol_factor<N, W>(A);
+			FESmallLA::batch_chol_solve<N, W>(A, B, m);
+		}
+		else
+		{
+			mask = FESmallLA::batch_lu_factor<N, W>(A);
+			FESmallLA::batch_lu_solve<N, W>(A, B, m);
+		}
+	}
+};
+
+//-----------------------------------------------------------------------------
+FEStaticCondensation::Batch::Batch(FEStaticCondensation& sc) : m_sc(sc)
+{
+	m_n = 0;
+	m_sym = true;
+}
+
+//-----------------------------------------------------------------------------
+void FEStaticCondensation::Batch::Add(int iel, const double* Kaa, const double* Kua, const double* Kau, const double* fa)
+{
+	assert(m_n < LANES);
+	const int na = m_sc.m_na;
+	if (m_Kaa.empty()) m_Kaa.resize(LANES*na*na);
+
+	m_sc.StoreBlocks(iel, Kua, Kau, fa);
+	std::copy(Kaa, Kaa + na*na, &m_Kaa[m_n*na*na]);
+	if (Kau) m_sym = false;
+	m_iel[m_n++] = iel;
+}
+
+//-----------------------------------------------------------------------------
+bool FEStaticCondensation::Batch::Factor()
+{
+	if (m_n == 0) return true;
+
+	const int W = LANES;
+	const int nu = m_sc.m_nu, na = m_sc.m_na;
+	const int m = nu + 1;
+
+	// the lanes that still need to be factored
+	unsigned int mask = (1u << m_n) - 1;
+
+	if ((na >= 3) && (na <= 24))
+	{
+		// interleave the blocks. Unused lanes get an identity matrix.
+		m_A.assign(na*na*W, 0.0);
+		m_B.assign(na*m*W, 0.0);
+		for (int w = 0; w < W; ++w)
+		{
+			if (w < m_n)
+			{
+				const double* Kaa = &m_Kaa[w*na*na];
+				const double* X = &m_sc.m_X[(size_t)m_iel[w]*na*nu];
+				const double* y = &m_sc.m_y[(size_t)m_iel[w]*na];
+				for (int i = 0; i < na*na; ++i) m_A[i*W + w] = Kaa[i];
+				for (int i = 0; i < na; ++i)
+				{
+					for (int j = 0; j < nu; ++j) m_B[(i*m + j)*W + w] = X[i*nu + j];
+					m_B[(i*m + nu)*W + w] = y[i];
+				}
+			}
+			else for (int i = 0; i < na; ++i) m_A[(i*na + i)*W + w] = 1.0;
+		}
+
+		FEStaticCondensationBatchKernel k = { &m_A[0], &m_B[0], m, m_sym, 0 };
+		FEDispatchSmallSize(na, k);
+
+		// copy the solutions of the lanes that were factored successfully
+		for (int w = 0; w < m_n; ++w)
+		{
+			if (k.mask & (1u << w)) continue;
+			double* X = &m_sc.m_X[(size_t)m_iel[w]*na*nu];
+			double* y = &m_sc.m_y[(size_t)m_iel[w]*na];
+			for (int i = 0; i < na; ++i)
+			{
+				for (int j = 0; j < nu; ++j) X[i*nu + j] = m_B[(i*m + j)*W + w];
+				y[i] = m_B[(i*m + nu)*W + w];
+			}
+		}
+		mask &= k.mask;
+	}
+
+	// redo the remaining lanes with pivoting
+	bool bok = true;
+	for (int w = 0; w < m_n; ++w)
+	{
+		if (mask & (1u << w))
+		{
+			if (m_sc.FactorElement(m_iel[w], &m_Kaa[w*na*na]) == false) bok = false;
+		}
+	}
+
+	m_n = 0;
+	m_sym = true;
+	return bok;
+}
+
+//-----------------------------------------------------------------------------
+void FEStaticCondensation::Serialize(DumpStream& ar)
+{
+	ar & m_nel & m_nu & m_na;
+	ar & m_Kua & m_X & m_y;
+}
@@ -0,0 +1,129 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+#pragma once
+#include "fecore_api.h"
+#include "matrix.h"
+#include <vector>
+
+class DumpStream;
+
+//-----------------------------------------------------------------------------
+//! Static condensation of element-internal degrees of freedom. 
+//! For each element, the linearized system is partitioned into the retained (u)
+//! and condensed (a) degrees of freedom:
+//!
+//!   | Kuu  Kua | |du|   |fu|
+//!   | Kau  Kaa | |da| = |fa|
+//!
+//! Once the blocks of an element are set, Kaa is factored and inv(Kaa)*Kau and 
+//! inv(Kaa)*fa are stored, so that the element matrix and vector can be condensed
+//! before assembly and the condensed dofs recovered after the global solve.
+//! The data of all elements of a domain is stored contiguously. 
+//! Elements can be collected in a Batch so that their Kaa blocks are factored 
+//! together with the batched kernels of FESmallMatrix.h.
+class FECORE_API FEStaticCondensation
+{
+public:
+	//! number of elements that are factored together
+	enum { LANES = 4 };
+
+	//! Collects the blocks of up to LANES elements, which are then factored together.
+	//! If all Kau blocks of the batch are null, Kaa is assumed symmetric and a 
+	//! Cholesky factorization is used. Elements for which the batched factorization 
+	//! fails are redone with a pivoting LU factorization.
+	class FECORE_API Batch
+	{
+	public:
+		explicit Batch(FEStaticCondensation& sc);
+
+		int Size() const { return m_n; }
+		bool Full() const { return (m_n == LANES); }
+
+		//! add the blocks of element iel (see SetElementBlocks)
+		void Add(int iel, const double* Kaa, const double* Kua, const double* Kau, const double* fa);
+
+		//! factor the Kaa blocks of all elements in the batch and empty the batch.
+		//! Returns false if any Kaa block is singular.
+		bool Factor();
+
+	private:
+		FEStaticCondensation&	m_sc;
+		int		m_n;				//!< number of elements in batch
+		int		m_iel[LANES];		//!< elements in batch
+		bool	m_sym;				//!< all Kaa blocks are symmetric
+		std::vector<double>	m_Kaa;	//!< Kaa blocks (row-major, one after the other)
+		std::vector<double>	m_A;	//!< Kaa blocks (interleaved)
+		std::vector<double>	m_B;	//!< right-hand sides [Kau fa] (interleaved)
+	};
+
+public:
+	FEStaticCondensation();
+
+	//! allocate storage for elems elements with nu retained and na condensed dofs each
+	void Create(int elems, int nu, int na);
+
+	//! release all storage
+	void Clear();
+
+	int Elements() const { return m_nel; }
+	int RetainedDofs() const { return m_nu; }
+	int CondensedDofs() const { return m_na; }
+
+	//! Set the blocks of element iel (all row-major) and factor Kaa (na x na).
+	//! If Kau is null, it is taken as the transpose of Kua (nu x na).
+	//! Returns false if Kaa is singular.
+	bool SetElementBlocks(int iel, const double* Kaa, const double* Kua, const double* Kau, const double* fa);
+
+	//! ke -= Kua*inv(Kaa)*Kau
+	void CondenseStiffness(int iel, matrix& ke) const;
+
+	//! fe += Kua*inv(Kaa)*fa
+	void CondenseResidual(int iel, std::vector<double>& fe) const;
+
+	//! da = inv(Kaa)*(fa + Kau*du)
+	void Recover(int iel, const double* du, double* da) const;
+
+	void Serialize(DumpStream& ar);
+
+private:
+	//! copy the blocks of element iel; m_X and m_y then hold Kau and fa
+	void StoreBlocks(int iel, const double* Kua, const double* Kau, const double* fa);
+
+	//! factor Kaa (overwritten) and solve for m_X and m_y of element iel
+	bool FactorElement(int iel, double* Kaa);
+
+private:
+	int		m_nel;		//!< number of elements
+	int		m_nu;		//!< retained dofs per element
+	int		m_na;		//!< condensed dofs per element
+
+	std::vector<double>	m_Kua;	//!< Kua blocks (nu x na)
+	std::vector<double>	m_X;	//!< inv(Kaa)*Kau (na x nu)
+	std::vector<double>	m_y;	//!< inv(Kaa)*fa (na)
+};
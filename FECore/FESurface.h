@@ -291,20 +291,32 @@ public:
     double Evaluate(int nface, int dof);
 
 public:
+	// NOTE: Deprecated. The std::function versions below are kept for plugins that pass
+	// an FESurfaceVectorIntegrand or FESurfaceMatrixIntegrand, and call the template versions.
+	// They are final, since lambdas resolve to the template versions, which would skip an override.
+
 	//! Evaluate a load vector. 
+	[[deprecated("pass the integrand directly to the template version")]]
 	virtual void LoadVector(
 		FEGlobalVector& R,				// The global vector into which the loads are assembled
 		const FEDofList& dofList,		// The degree of freedom list
 		bool breference,				// integrate over reference (true) or current (false) configuration
-		FESurfaceVectorIntegrand f);	// the function that evaluates the integrand
+		FESurfaceVectorIntegrand f) final;	// the function that evaluates the integrand
 
 	//! Evaluate the stiffness matrix of a load
+	[[deprecated("pass the integrand directly to the template version")]]
 	virtual void LoadStiffness(
 		FELinearSystem& LS,			// The linear system does the assembling
 		const FEDofList& dofList_a,	// The degree of freedom list of node a
 		const FEDofList& dofList_b,	// The degree of freedom list of node b
 		FESurfaceMatrixIntegrand f	// the matrix function to evaluate
-	);
+	) final;
+
+	// Same as above, but the integrand's type is a template parameter so that it can
+	// be inlined in the integration loop. Lambdas passed to LoadVector and LoadStiffness
+	// resolve to these overloads.
+	template <class F> void LoadVector(FEGlobalVector& R, const FEDofList& dofList, bool breference, F f);
+	template <class F> void LoadStiffness(FELinearSystem& LS, const FEDofList& dofList_a, const FEDofList& dofList_b, F f);
 
 public:
 	void CreateMaterialPointData();
@@ -317,3 +329,6 @@ protected:
     double                      m_alpha;    //!< intermediate time fraction
 	bool						m_bshellb;	//!< true if this surface is the bottom of a shell domain
 };
+
+// The following file contains the definition of the template functions
+#include "FESurface.hpp"
@@ -0,0 +1,204 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+#pragma once
+// NOTE: This file is automatically included from FESurface.h
+#include "FELinearSystem.h"
+#include "FEElementWorkspace.h"
+
+//-----------------------------------------------------------------------------
+template <class F> void FESurface::LoadVector(FEGlobalVector& R, const FEDofList& dofList, bool breference, F f)
+{
+	int dofPerNode = dofList.Size();
+	int order = (dofPerNode == 1 ? dofList.InterpolationOrder(0) : -1);
+
+	int NE = Elements();
+	#pragma omp parallel for shared(R, dofList, f)
+	for (int i = 0; i < NE; ++i)
+	{
+		FEScopedWorkspace ws;
+		vector<double>& fe = ws->fe;
+		vector<int>& lm = ws->lm;
+		vec3d re[FEElement::MAX_NODES];
+		std::vector<double>& G = ws->buf;
+		G.assign(dofPerNode, 0.0);
+
+		// get the next element
+		FESurfaceElement& el = Element(i);
+
+		// init the element vector
+		int neln = el.ShapeFunctions(order);
+		int ndof = dofPerNode * neln;
+		fe.assign(ndof, 0.0);
+
+		// get the nodal coordinates
+		if (breference)
+			GetReferenceNodalCoordinates(el, re);
+		else
+			GetNodalCoordinates(el, re);
+
+		// calculate element vector
+		FESurfaceDofShape dof_a;
+		double* w = el.GaussWeights();
+		int nint = el.GaussPoints();
+		for (int n = 0; n < nint; ++n)
+		{
+			FESurfaceMaterialPoint& pt = static_cast<FESurfaceMaterialPoint&>(*el.GetMaterialPoint(n));
+
+			// kinematics at integration points
+			pt.dxr = el.eval_deriv1(re, n);
+			pt.dxs = el.eval_deriv2(re, n);
+
+			pt.m_shape = el.H(n);
+
+			double* H = el.H(order, n);
+			double* Hr = el.Gr(order, n);
+			double* Hs = el.Gr(order, n);
+
+			// put it all together
+			for (int j = 0; j<neln; ++j)
+			{
+				// shape function and derivatives
+				dof_a.index = j;
+				dof_a.shape = H[j];
+				dof_a.shape_deriv_r = Hr[j];
+				dof_a.shape_deriv_s = Hs[j];
+
+				// evaluate the integrand
+				f(pt, dof_a, G);
+
+				for (int k = 0; k < dofPerNode; ++k)
+				{
+					fe[dofPerNode * j + k] += G[k] * w[n];
+				}
+			}
+		}
+
+		// get the corresponding LM vector
+		UnpackLM(el, dofList, lm);
+
+		// Assemble into global vector
+		R.Assemble(el.m_node, lm, fe);
+	}
+}
+
+//-----------------------------------------------------------------------------
+template <class F> void FESurface::LoadStiffness(FELinearSystem& LS, const FEDofList& dofList_a, const FEDofList& dofList_b, F f)
+{
+	FEScopedWorkspace ws;
+
+	int dofPerNode_a = dofList_a.Size();
+	int dofPerNode_b = dofList_b.Size();
+
+	int order_a = (dofPerNode_a == 1 ? dofList_a.InterpolationOrder(0) : -1);
+	int order_b = (dofPerNode_b == 1 ? dofList_b.InterpolationOrder(0) : -1);
+
+	vec3d rt[FEElement::MAX_NODES];
+
+	matrix kab(dofPerNode_a, dofPerNode_b);
+	FESurfaceDofShape dof_a, dof_b;
+
+	int NE = Elements();
+	for (int m = 0; m<NE; ++m)
+	{
+		// get the surface element
+		FESurfaceElement& el = Element(m);
+
+		// shape functions
+		int neln = el.Nodes();
+		int nn_a = el.ShapeFunctions(dofPerNode_a);
+		int nn_b = el.ShapeFunctions(dofPerNode_b);
+
+		// get the element stiffness matrix
+		int ndof_a = dofPerNode_a * nn_a;
+		int ndof_b = dofPerNode_b * nn_b;
+		FEElementMatrix& ke = ws->ElementMatrix(el, ndof_a, ndof_b);
+
+		// calculate element stiffness
+		int nint = el.GaussPoints();
+
+		// gauss weights
+		double* w = el.GaussWeights();
+
+		// nodal coordinates
+		GetNodalCoordinates(el, rt);
+
+		// repeat over integration points
+		for (int n = 0; n<nint; ++n)
+		{
+			FESurfaceMaterialPoint& pt = static_cast<FESurfaceMaterialPoint&>(*el.GetMaterialPoint(n));
+
+			double* Gr = el.Gr(n);
+			double* Gs = el.Gs(n);
+
+			// tangents at integration point
+			pt.dxr = vec3d(0, 0, 0);
+			pt.dxs = vec3d(0, 0, 0);
+			for (int i = 0; i<neln; ++i)
+			{
+				pt.dxr += rt[i] * Gr[i];
+				pt.dxs += rt[i] * Gs[i];
+			}
+
+			// calculate stiffness component
+			for (int i = 0; i < nn_a; ++i)
+			{
+				// shape function values
+				dof_a.index = i;
+				dof_a.shape = el.H(order_a, n)[i];
+				dof_a.shape_deriv_r = el.Gr(order_a, n)[i];
+				dof_a.shape_deriv_s = el.Gs(order_a, n)[i];
+
+				for (int j = 0; j < nn_b; ++j)
+				{
+					// shape function values
+					dof_b.index = j;
+					dof_b.shape = el.H(order_b, n)[j];
+					dof_b.shape_deriv_r = el.Gr(order_b, n)[j];
+					dof_b.shape_deriv_s = el.Gs(order_b, n)[j];
+
+					// evaluate integrand
+					kab.zero();
+					f(pt, dof_a, dof_b, kab);
+
+					// add it to the local element matrix
+					ke.adds(dofPerNode_a * i, dofPerNode_b * j, kab, w[n]);
+				}
+			}
+		}
+
+		// get the element's LM vector
+		std::vector<int>& lma = ke.RowIndices();
+		std::vector<int>& lmb = ke.ColumnsIndices();
+		UnpackLM(el, dofList_a, lma);
+		UnpackLM(el, dofList_b, lmb);
+
+		// assemble element matrix in global stiffness matrix
+		LS.Assemble(ke);
+	}
+}
@@ -39,7 +39,7 @@ FELogNodeData::FELogNodeData(FEModel* fem) : FELogData(fem) {}
 FELogNodeData::~FELogNodeData() {}
 
 //-----------------------------------------------------------------------------
-NodeDataRecord::NodeDataRecord(FEModel* pfem) : DataRecord(pfem, FE_DATA_NODE) {}
+NodeDataRecord::NodeDataRecord(FEModel* pfem) : DataRecord(pfem, FE_DATA_NODE) { m_offset = 0; }
 
 //-----------------------------------------------------------------------------
 int NodeDataRecord::Size() const { return (int)m_Data.size(); }
@@ -79,8 +79,13 @@ void NodeDataRecord::SetData(const char* szexpr)
 //-----------------------------------------------------------------------------
 double NodeDataRecord::Evaluate(int item, int ndata)
 {
+	// make sure we have an NLT
+	if (m_NLT.empty()) BuildNLT();
+
+	// find the node index
 	FEMesh& mesh = GetFEModel()->GetMesh();
-	int nnode = item - 1;
+	int index = item - m_offset;
+	int nnode = ((index >= 0) && (index < (int)m_NLT.size()) ? m_NLT[index] : -1);
 	assert((nnode>=0)&&(nnode<mesh.Nodes()));
 	if ((nnode < 0) || (nnode >= mesh.Nodes())) return 0;
 
@@ -88,12 +93,41 @@ double NodeDataRecord::Evaluate(int item, int ndata)
 	return m_Data[ndata]->value(node);
 }
 
+//-----------------------------------------------------------------------------
+//! Evaluates all the data in parallel.
+void NodeDataRecord::EvaluateAll(std::vector<double>& data)
+{
+	// make sure we have an NLT (this must be done before the parallel loop)
+	if (m_NLT.empty()) BuildNLT();
+
+	FEMesh& mesh = GetFEModel()->GetMesh();
+	const int N = (int)m_NLT.size();
+	const int nitems = (int)m_item.size();
+	const int ndata = Size();
+	data.resize(nitems*ndata);
+
+	#pragma omp parallel for
+	for (int i = 0; i < nitems; ++i)
+	{
+		double* v = &data[i*ndata];
+		int index = m_item[i] - m_offset;
+		int nnode = ((index >= 0) && (index < N) ? m_NLT[index] : -1);
+		if (nnode >= 0)
+		{
+			FENode& node = mesh.Node(nnode);
+			for (int j = 0; j < ndata; ++j) v[j] = m_Data[j]->value(node);
+		}
+		else for (int j = 0; j < ndata; ++j) v[j] = 0.0;
+	}
+}
+
 //-----------------------------------------------------------------------------
 void NodeDataRecord::SelectAllItems()
 {
-	int n = GetFEModel()->GetMesh().Nodes();
+	FEMesh& mesh = GetFEModel()->GetMesh();
+	int n = mesh.Nodes();
 	m_item.resize(n);
-	for (int i=0; i<n; ++i) m_item[i] = i+1;
+	for (int i=0; i<n; ++i) m_item[i] = mesh.Node(i).GetID();
 }
 
 //-----------------------------------------------------------------------------
@@ -102,9 +136,34 @@ void NodeDataRecord::SetItemList(FEItemList* items, const std::vector<int>& sele
 	// TODO: We don't support using a selection of a node set yet. 
 	assert(selection.empty());
 	FENodeSet* pns = dynamic_cast<FENodeSet*>(items); assert(pns);
+	FEMesh& mesh = GetFEModel()->GetMesh();
 	int n = pns->Size();
 	m_item.resize(n);
-	for (int i = 0; i < n; ++i) m_item[i] = (*pns)[i] + 1;
+	for (int i = 0; i < n; ++i) m_item[i] = mesh.Node((*pns)[i]).GetID();
+}
+
+//-----------------------------------------------------------------------------
+// The items are node IDs, which need not match the node's position in the mesh
+// (e.g. when the nodes were reordered), so we build a lookup table.
+void NodeDataRecord::BuildNLT()
+{
+	m_NLT.clear();
+	FEMesh& mesh = GetFEModel()->GetMesh();
+	int NN = mesh.Nodes();
+	if (NN == 0) return;
+
+	int minID = mesh.Node(0).GetID();
+	int maxID = minID;
+	for (int i = 1; i < NN; ++i)
+	{
+		int nid = mesh.Node(i).GetID();
+		if (nid < minID) minID = nid;
+		if (nid > maxID) maxID = nid;
+	}
+
+	m_offset = minID;
+	m_NLT.assign(maxID - minID + 1, -1);
+	for (int i = 0; i < NN; ++i) m_NLT[mesh.Node(i).GetID() - minID] = i;
 }
 
 //-----------------------------------------------------------------------------
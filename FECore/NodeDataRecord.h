@@ -54,14 +54,21 @@ class FECORE_API NodeDataRecord : public DataRecord
 public:
 	NodeDataRecord(FEModel* pfem);
 	double Evaluate(int item, int ndata);
+	void EvaluateAll(std::vector<double>& data) override;
 	void SetData(const char* sz) override;
 	void SelectAllItems();
 	int Size() const;
 
 	void SetItemList(FEItemList* items, const std::vector<int>& selection) override;
 
+protected:
+	void BuildNLT();
+
 private:
 	vector<FELogNodeData*>	m_Data;
+	vector<int>				m_NLT;		//!< node ID to node index lookup table
+	int						m_offset;	//!< min node ID
+
 };
 
 //-----------------------------------------------------------------------------
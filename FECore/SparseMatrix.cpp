@@ -48,6 +48,18 @@ void SparseMatrix::Clear()
 	m_nsize = 0;
 }
 
+//! The default implementation fills in the lower triangular part of a copy of ke
+//! and then calls the regular assembly routine.
+void SparseMatrix::AssembleUpper(const matrix& ke, const std::vector<int>& lm)
+{
+	matrix kf(ke);
+	const int N = kf.rows();
+	for (int i = 0; i < N; ++i)
+		for (int j = i + 1; j < N; ++j)
+			kf[j][i] = kf[i][j];
+	Assemble(kf, lm);
+}
+
 //! scale matrix
 void SparseMatrix::scale(const vector<double>& L, const vector<double>& R)
 {
@@ -74,6 +74,9 @@ public: // functions to be overwritten in derived classes
 	//! assemble a matrix into the sparse matrix
 	virtual void Assemble(const matrix& ke, const std::vector<int>& lmi, const std::vector<int>& lmj) = 0;
 
+	//! assemble a symmetric matrix of which only the upper triangular part is defined
+	virtual void AssembleUpper(const matrix& ke, const std::vector<int>& lm);
+
 	//! check if an entry was allocated
 	virtual bool check(int i, int j) = 0;
 
@@ -95,6 +98,9 @@ public: // functions to be overwritten in derived classes
 	//! scale matrix
 	virtual void scale(const std::vector<double>& L, const std::vector<double>& R);
 
+	//! does the matrix need a sparsity profile (false for matrices that don't store their entries)
+	virtual bool NeedsProfile() const { return true; }
+
 public:
 	//! multiply with vector
 	bool mult_vector(double* x, double* r) override { assert(false); return false; }
@@ -31,6 +31,8 @@ SOFTWARE.*/
 #include "mortar.h"
 #include <math.h>
 #include "FEMesh.h"
+#include <unordered_map>
+#include <algorithm>
 
 //-----------------------------------------------------------------------------
 // subtract operator for POINT2D
@@ -541,29 +543,158 @@ bool CalculateMortarIntersection(FESurface& ss, FESurface& ms, int k, int l, Pat
 	return (patch.Empty() == false);
 }
 
-void CalculateMortarSurface(FESurface& ss, FESurface& ms, MortarSurface& mortar)
+//-----------------------------------------------------------------------------
+// axis-aligned bounding box of a surface facet
+struct FACET_BOX
+{
+	vec3d	r0, r1;
+
+	bool overlaps(const FACET_BOX& b) const
+	{
+		return ((r0.x <= b.r1.x) && (b.r0.x <= r1.x) &&
+				(r0.y <= b.r1.y) && (b.r0.y <= r1.y) &&
+				(r0.z <= b.r1.z) && (b.r0.z <= r1.z));
+	}
+};
+
+static void FacetBoxes(FESurface& s, double R, std::vector<FACET_BOX>& box, double& maxSize)
+{
+	int NF = s.Elements();
+	box.resize(NF);
+	maxSize = 0.0;
+	for (int i = 0; i < NF; ++i)
+	{
+		FESurfaceElement& el = s.Element(i);
+		FACET_BOX& b = box[i];
+		b.r0 = b.r1 = s.Node(el.m_lnode[0]).m_rt;
+		for (int j = 1; j < el.Nodes(); ++j)
+		{
+			vec3d& r = s.Node(el.m_lnode[j]).m_rt;
+			b.r0.x = std::min(b.r0.x, r.x); b.r1.x = std::max(b.r1.x, r.x);
+			b.r0.y = std::min(b.r0.y, r.y); b.r1.y = std::max(b.r1.y, r.y);
+			b.r0.z = std::min(b.r0.z, r.z); b.r1.z = std::max(b.r1.z, r.z);
+		}
+
+		double d = (b.r1 - b.r0).norm();
+		if (d > maxSize) maxSize = d;
+
+		b.r0 -= vec3d(R, R, R);
+		b.r1 += vec3d(R, R, R);
+	}
+}
+
+double MortarSearchRadius(FESurface& ss, FESurface& ms)
+{
+	std::vector<FACET_BOX> box;
+	double hs, hm;
+	FacetBoxes(ss, 0.0, box, hs);
+	FacetBoxes(ms, 0.0, box, hm);
+	return (hs > hm ? hs : hm);
+}
+
+void CalculateMortarSurface(FESurface& ss, FESurface& ms, MortarSurface& mortar, double searchRadius)
 {
-	// loop over all non-mortar facets
 	int NSF = ss.Elements();
 	int NMF = ms.Elements();
-	for (int i=0; i<NSF; ++i)
+
+	// Broad phase: find the candidate mortar facets of each non-mortar facet.
+	// The mortar facets are stored in a uniform grid of which the cells are at 
+	// least as large as the (inflated) facet boxes. 
+	const bool bcull = (searchRadius >= 0.0);
+	std::vector<FACET_BOX> sbox, mbox;
+	std::unordered_map<long long, std::vector<int> > grid;
+	double h = 0.0;
+	vec3d rmin;
+	int imax = 0, jmax = 0, kmax = 0;
+	if (bcull)
+	{
+		double hs, hm;
+		FacetBoxes(ss, searchRadius, sbox, hs);
+		FacetBoxes(ms, searchRadius, mbox, hm);
+
+		h = hm + 2.0*searchRadius;
+		if (h <= 0.0) h = 1.0;
+		rmin = (NMF > 0 ? mbox[0].r0 : vec3d(0, 0, 0));
+		for (int j = 1; j < NMF; ++j)
+		{
+			const vec3d& r = mbox[j].r0;
+			if (r.x < rmin.x) rmin.x = r.x;
+			if (r.y < rmin.y) rmin.y = r.y;
+			if (r.z < rmin.z) rmin.z = r.z;
+		}
+
+		for (int j = 0; j < NMF; ++j)
+		{
+			const FACET_BOX& b = mbox[j];
+			int i0 = (int)((b.r0.x - rmin.x) / h), i1 = (int)((b.r1.x - rmin.x) / h);
+			int j0 = (int)((b.r0.y - rmin.y) / h), j1 = (int)((b.r1.y - rmin.y) / h);
+			int k0 = (int)((b.r0.z - rmin.z) / h), k1 = (int)((b.r1.z - rmin.z) / h);
+			if (i1 > imax) imax = i1;
+			if (j1 > jmax) jmax = j1;
+			if (k1 > kmax) kmax = k1;
+			for (int k = k0; k <= k1; ++k)
+				for (int jj = j0; jj <= j1; ++jj)
+					for (int ii = i0; ii <= i1; ++ii)
+					{
+						long long key = ((long long)ii << 42) | ((long long)jj << 21) | (long long)k;
+						grid[key].push_back(j);
+					}
+		}
+	}
+
+	// Narrow phase: calculate the patches of triangles, representing the intersection
+	// of the non-mortar facets with the mortar facets. Empty patches are not stored.
+	std::vector< std::vector<Patch> > patches(NSF);
+#pragma omp parallel
 	{
-		// get the non-mortar surface element
-		FESurfaceElement& se = ss.Element(i);
+		std::vector<int> tag(NMF, -1);
+		std::vector<int> cand;
 
-		// loop over all the mortar surface elements
-		for (int j=0; j<NMF; ++j)
+#pragma omp for schedule(dynamic, 16)
+		for (int i = 0; i < NSF; ++i)
 		{
-			// get the next surface element
-			FESurfaceElement& me = ms.Element(j);
-
-			// calculate the patch of triangles, representing the intersection
-			// of the non-mortar facet with the mortar facet
-			Patch patch(i,j);
-			CalculateMortarIntersection(ss, ms, i, j, patch);
-			mortar.AddPatch(patch);
+			// collect the candidates
+			cand.clear();
+			if (bcull)
+			{
+				const FACET_BOX& b = sbox[i];
+				int i0 = (int)floor((b.r0.x - rmin.x) / h), i1 = (int)floor((b.r1.x - rmin.x) / h);
+				int j0 = (int)floor((b.r0.y - rmin.y) / h), j1 = (int)floor((b.r1.y - rmin.y) / h);
+				int k0 = (int)floor((b.r0.z - rmin.z) / h), k1 = (int)floor((b.r1.z - rmin.z) / h);
+				i0 = std::max(i0, 0); i1 = std::min(i1, imax);
+				j0 = std::max(j0, 0); j1 = std::min(j1, jmax);
+				k0 = std::max(k0, 0); k1 = std::min(k1, kmax);
+				for (int k = k0; k <= k1; ++k)
+					for (int jj = j0; jj <= j1; ++jj)
+						for (int ii = i0; ii <= i1; ++ii)
+						{
+							long long key = ((long long)ii << 42) | ((long long)jj << 21) | (long long)k;
+							auto it = grid.find(key);
+							if (it == grid.end()) continue;
+							for (int j : it->second)
+							{
+								if ((tag[j] != i) && b.overlaps(mbox[j])) { tag[j] = i; cand.push_back(j); }
+							}
+						}
+				std::sort(cand.begin(), cand.end());
+			}
+			else
+			{
+				cand.resize(NMF);
+				for (int j = 0; j < NMF; ++j) cand[j] = j;
+			}
+
+			for (int j : cand)
+			{
+				Patch patch(i, j);
+				if (CalculateMortarIntersection(ss, ms, i, j, patch))
+					patches[i].push_back(patch);
+			}
 		}
 	}
+
+	for (int i = 0; i < NSF; ++i)
+		for (Patch& p : patches[i]) mortar.AddPatch(p);
 }
 
 bool ExportMortar(MortarSurface& mortar, const char* szfile)
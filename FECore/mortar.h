@@ -131,8 +131,14 @@ private:
 FECORE_API bool CalculateMortarIntersection(FESurface& ss, FESurface& ms, int k, int l, Patch& patch);
 
 //-----------------------------------------------------------------------------
-// Calculates the mortar intersection between two surfaces
-FECORE_API void CalculateMortarSurface(FESurface& ss, FESurface& ms, MortarSurface& s);
+// Calculates the mortar intersection between two surfaces.
+// Only facet pairs of which the bounding boxes overlap, after being inflated by 
+// the search radius, are intersected. A negative search radius tests all pairs.
+FECORE_API void CalculateMortarSurface(FESurface& ss, FESurface& ms, MortarSurface& s, double searchRadius = -1.0);
+
+//-----------------------------------------------------------------------------
+// Returns a default search radius for CalculateMortarSurface (the largest facet size)
+FECORE_API double MortarSearchRadius(FESurface& ss, FESurface& ms);
 
 //-----------------------------------------------------------------------------
 // Stores the mortar surface in STL format
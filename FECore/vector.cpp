@@ -33,72 +33,144 @@ using namespace std;
 
 double operator*(const vector<double>& a, const vector<double>& b)
 {
-	// This algorithm sums positive and negative products separately, 
-	// which is more accurate then just doing the running sum.
 	assert(a.size() == b.size());
-	double sum_p = 0, sum_n = 0;
-	size_t n = a.size();
-	for (size_t i = 0; i < n; i++)
-	{
-		double ab = a[i] * b[i];
-		if (ab >= 0.0) sum_p += ab; else sum_n += ab;
-	}
-	return sum_p + sum_n;
+	return vdot(a.data(), b.data(), (int)a.size());
 }
 
 vector<double> operator - (vector<double>& a, vector<double>& b)
 {
 	vector<double> c(a);
-	size_t n = c.size();
-	for (size_t i=0; i<n; ++i) c[i] -= b[i];
+	c -= b;
 	return c;
 }
 
 void operator += (vector<double>& a, const vector<double>& b)
 {
 	assert(a.size() == b.size());
-	for (size_t i = 0; i < a.size(); ++i) a[i] += b[i];
+	vaxpy(a.data(), 1.0, b.data(), (int)a.size());
 }
 
 void operator -= (vector<double>& a, const vector<double>& b)
 {
 	assert(a.size() == b.size());
-	for (size_t i = 0; i < a.size(); ++i) a[i] -= b[i];
+	vaxpy(a.data(), -1.0, b.data(), (int)a.size());
 }
 
 void operator *= (vector<double>& a, double b)
 {
-	for (size_t i=0; i<a.size(); ++i) a[i] *= b;
+	const int n = (int)a.size();
+	double* pa = a.data();
+#pragma omp parallel for if (n > MIN_PARALLEL_SIZE)
+	for (int i = 0; i < n; ++i) pa[i] *= b;
 }
 
 void vcopys(vector<double>& a, const vector<double>& b, double s)
 {
 	assert(a.size() == b.size());
-	for (size_t i=0; i<a.size(); ++i) a[i] = b[i]*s;
+	const int n = (int)a.size();
+	double* pa = a.data();
+	const double* pb = b.data();
+#pragma omp parallel for if (n > MIN_PARALLEL_SIZE)
+	for (int i = 0; i < n; ++i) pa[i] = pb[i]*s;
 }
 
 void vadds(vector<double>& a, const vector<double>& b, double s)
 {
 	assert(a.size() == b.size());
-	for (size_t i = 0; i<a.size(); ++i) a[i] += b[i] * s;
+	vaxpy(a.data(), s, b.data(), (int)a.size());
 }
 
 void vsubs(vector<double>& a, const vector<double>& b, double s)
 {
 	assert(a.size() == b.size());
-	for (size_t i = 0; i<a.size(); ++i) a[i] -= b[i] * s;
+	vaxpy(a.data(), -s, b.data(), (int)a.size());
 }
 
 void vscale(vector<double>& a, const vector<double>& s)
 {
 	assert(a.size() == s.size());
-	for (size_t i = 0; i<a.size(); ++i) a[i] *= s[i];
+	const int n = (int)a.size();
+	double* pa = a.data();
+	const double* ps = s.data();
+#pragma omp parallel for if (n > MIN_PARALLEL_SIZE)
+	for (int i = 0; i < n; ++i) pa[i] *= ps[i];
 }
 
 void vsub(vector<double>& a, const vector<double>& l, const vector<double>& r)
 {
 	assert((a.size()==l.size())&&(a.size()==r.size()));
-	for (size_t i=0; i<a.size(); ++i) a[i] = l[i] - r[i];
+	const int n = (int)a.size();
+	double* pa = a.data();
+	const double* pl = l.data();
+	const double* pr = r.data();
+#pragma omp parallel for if (n > MIN_PARALLEL_SIZE)
+	for (int i = 0; i < n; ++i) pa[i] = pl[i] - pr[i];
+}
+
+double vdot(const double* a, const double* b, int n)
+{
+	// This algorithm sums positive and negative products separately, 
+	// which is more accurate then just doing the running sum.
+	double sum_p = 0, sum_n = 0;
+#pragma omp parallel for simd reduction(+:sum_p, sum_n) if (parallel: n > MIN_PARALLEL_SIZE)
+	for (int i = 0; i < n; i++)
+	{
+		double ab = a[i] * b[i];
+		sum_p += (ab > 0.0 ? ab : 0.0);
+		sum_n += (ab < 0.0 ? ab : 0.0);
+	}
+	return sum_p + sum_n;
+}
+
+void vaxpy(double* y, double a, const double* x, int n)
+{
+#pragma omp parallel for simd if (parallel: n > MIN_PARALLEL_SIZE)
+	for (int i = 0; i < n; ++i) y[i] += a*x[i];
+}
+
+double vaxpy_dot(double* y, double a, const double* x, const double* z, int n)
+{
+	if (z == nullptr)
+	{
+		vaxpy(y, a, x, n);
+		return 0.0;
+	}
+
+	double sum_p = 0, sum_n = 0;
+#pragma omp parallel for simd reduction(+:sum_p, sum_n) if (parallel: n > MIN_PARALLEL_SIZE)
+	for (int i = 0; i < n; i++)
+	{
+		double yi = y[i] + a*x[i];
+		y[i] = yi;
+
+		double zy = z[i] * yi;
+		sum_p += (zy > 0.0 ? zy : 0.0);
+		sum_n += (zy < 0.0 ? zy : 0.0);
+	}
+	return sum_p + sum_n;
+}
+
+double vaxmwy_dot(double* y, double a, const double* x, const double* w, const double* z, int n)
+{
+	if (z == nullptr)
+	{
+#pragma omp parallel for simd if (parallel: n > MIN_PARALLEL_SIZE)
+		for (int i = 0; i < n; ++i) y[i] += a*(x[i] - w[i]);
+		return 0.0;
+	}
+
+	double sum_p = 0, sum_n = 0;
+#pragma omp parallel for simd reduction(+:sum_p, sum_n) if (parallel: n > MIN_PARALLEL_SIZE)
+	for (int i = 0; i < n; i++)
+	{
+		double yi = y[i] + a*(x[i] - w[i]);
+		y[i] = yi;
+
+		double zy = z[i] * yi;
+		sum_p += (zy > 0.0 ? zy : 0.0);
+		sum_n += (zy < 0.0 ? zy : 0.0);
+	}
+	return sum_p + sum_n;
 }
 
 vector<double> operator + (const vector<double>& a, const vector<double>& b)
@@ -188,21 +260,23 @@ void scatter(vector<double>& v, FEMesh& mesh, const FEDofList& dofs)
 
 double l2_norm(const vector<double>& v)
 {
-	double s = 0.0;
-	for (auto vi : v) s += vi*vi;
-	return sqrt(s);
+	return sqrt(l2_sqrnorm(v));
 }
 
 double l2_sqrnorm(const vector<double>& v)
 {
+	const int n = (int)v.size();
+	const double* pv = v.data();
 	double s = 0.0;
-	for (auto vi : v) s += vi*vi;
+#pragma omp parallel for reduction(+:s) if (n > MIN_PARALLEL_SIZE)
+	for (int i = 0; i < n; ++i) s += pv[i]*pv[i];
 	return s;
 }
 
 double l2_norm(double* x, int n)
 {
 	double s = 0.0;
+#pragma omp parallel for reduction(+:s) if (n > MIN_PARALLEL_SIZE)
 	for (int i = 0; i < n; ++i) s += x[i]*x[i];
 	return sqrt(s);
 }
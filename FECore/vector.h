@@ -37,6 +37,10 @@ SOFTWARE.*/
 class FEMesh;
 class FEDofList;
 
+// Vectors smaller than this are processed serially, since the threading overhead
+// would outweigh the gain.
+#define MIN_PARALLEL_SIZE	8192
+
 double FECORE_API operator*(const std::vector<double>& a, const std::vector<double>& b);
 std::vector<double> FECORE_API operator - (std::vector<double>& a, std::vector<double>& b);
 template<typename T> void zero(std::vector<T>& a) { std::fill(a.begin(), a.end(), T(0)); }
@@ -62,6 +66,16 @@ void FECORE_API vsub(std::vector<double>& a, const std::vector<double>& l, const
 // scale each component of a vector
 void FECORE_API vscale(std::vector<double>& a, const std::vector<double>& s);
 
+// BLAS-1 kernels on raw arrays of length n (these run in parallel for large n)
+// dot product: returns a.b
+double FECORE_API vdot(const double* a, const double* b, int n);
+// y += a*x
+void FECORE_API vaxpy(double* y, double a, const double* x, int n);
+// fused update and dot product: y += a*x, returns z.y (z can be null, in which case only y is updated)
+double FECORE_API vaxpy_dot(double* y, double a, const double* x, const double* z, int n);
+// fused update and dot product: y += a*(x - w), returns z.y (z can be null, in which case only y is updated)
+double FECORE_API vaxmwy_dot(double* y, double a, const double* x, const double* w, const double* z, int n);
+
 // gather operation (copy mesh data to vector)
 void FECORE_API gather(std::vector<double>& v, FEMesh& mesh, int ndof);
 void FECORE_API gather(std::vector<double>& v, FEMesh& mesh, const std::vector<int>& dof);
@@ -0,0 +1,636 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+#include "stdafx.h"
+#include "DomainDecompositionSolver.h"
+#include <FECore/FECommunicator.h>
+#include <FECore/FEModel.h>
+#include <FECore/FEMesh.h>
+#include <FECore/FEException.h>
+#include <FECore/log.h>
+#include <unordered_map>
+#include <thread>
+#include <algorithm>
+using namespace std;
+
+// message tag for ghost exchanges
+#define GHOST_TAG	1
+
+//-----------------------------------------------------------------------------
+BEGIN_FECORE_CLASS(DomainDecompositionSolver, IterativeLinearSolver)
+	ADD_PARAMETER(m_ranks, "ranks");
+	ADD_PARAMETER(m_print_level, "print_level");
+	ADD_PARAMETER(m_tol, "tol");
+	ADD_PARAMETER(m_maxiter, "max_iter");
+	ADD_PARAMETER(m_fail_max_iter, "fail_max_iters");
+	ADD_PARAMETER(m_precondition, "precondition");
+END_FECORE_CLASS();
+
+//-----------------------------------------------------------------------------
+DomainDecompositionSolver::DomainDecompositionSolver(FEModel* fem) : IterativeLinearSolver(fem), m_pA(nullptr)
+{
+	m_ranks = 2;
+	m_maxiter = 0;
+	m_tol = 1e-8;
+	m_print_level = 0;
+	m_fail_max_iter = true;
+	m_precondition = true;
+	m_bsymm = false;
+}
+
+//-----------------------------------------------------------------------------
+DomainDecompositionSolver::~DomainDecompositionSolver()
+{
+}
+
+//-----------------------------------------------------------------------------
+// Sparse matrix that stores the owned rows of each rank in the subdomains of the
+// solver. Entries are routed to the rank that owns the row when they are assembled,
+// so the global matrix is never stored. The rows are always stored in full, also
+// for symmetric matrices.
+class DomainDecompositionSolver::RankMatrix : public SparseMatrix
+{
+public:
+	RankMatrix(DomainDecompositionSolver* solver) : m_solver(solver) {}
+
+	void Zero() override
+	{
+		vector<Subdomain>& sub = m_solver->m_sub;
+		#pragma omp parallel for
+		for (int p = 0; p < (int)sub.size(); ++p)
+		{
+			vector<double>& val = sub[p].val;
+			std::fill(val.begin(), val.end(), 0.0);
+		}
+	}
+
+	void Create(SparseMatrixProfile& MP) override
+	{
+		m_nrow = MP.Rows();
+		m_ncol = MP.Columns();
+		m_nsize = 0;
+		if (m_solver->Partition(m_nrow) == false) throw FEException("Failed to partition the mesh.");
+		m_solver->BuildRows(MP);
+		for (Subdomain& sub : m_solver->m_sub) m_nsize += (int)sub.gcol.size();
+	}
+
+	void Assemble(const matrix& ke, const std::vector<int>& lm) override
+	{
+		Assemble(ke, lm, lm);
+	}
+
+	void Assemble(const matrix& ke, const std::vector<int>& lmi, const std::vector<int>& lmj) override
+	{
+		const int N = ke.rows();
+		const int M = ke.columns();
+		for (int i = 0; i < N; ++i)
+		{
+			int I = lmi[i];
+			if (I < 0) continue;
+			for (int j = 0; j < M; ++j)
+			{
+				int J = lmj[j];
+				if (J >= 0) add(I, J, ke[i][j]);
+			}
+		}
+	}
+
+	void AssembleUpper(const matrix& ke, const std::vector<int>& lm) override
+	{
+		const int N = ke.rows();
+		for (int i = 0; i < N; ++i)
+		{
+			int I = lm[i];
+			if (I < 0) continue;
+			for (int j = i; j < N; ++j)
+			{
+				int J = lm[j];
+				if (J < 0) continue;
+				add(I, J, ke[i][j]);
+				if (j != i) add(J, I, ke[i][j]);
+			}
+		}
+	}
+
+	bool check(int i, int j) override { return (find(i, j) != nullptr); }
+
+	void set(int i, int j, double v) override
+	{
+		double* pv = find(i, j);
+		assert(pv);
+		if (pv) *pv = v;
+	}
+
+	void add(int i, int j, double v) override
+	{
+		double* pv = find(i, j);
+		assert(pv);
+		if (pv)
+		{
+			#pragma omp atomic
+			*pv += v;
+		}
+	}
+
+	double get(int i, int j) override
+	{
+		double* pv = find(i, j);
+		return (pv ? *pv : 0.0);
+	}
+
+	double diag(int i) override { return get(i, i); }
+
+private:
+	// find the entry in the owned row of equation i (binary search on the global columns)
+	double* find(int i, int j)
+	{
+		Subdomain& sub = m_solver->m_sub[m_solver->m_eqPart[i]];
+		int l = m_solver->m_eqLocal[i];
+		const int* pc = sub.gcol.data();
+		const int* p0 = pc + sub.ptr[l];
+		const int* p1 = pc + sub.ptr[l + 1];
+		const int* pj = std::lower_bound(p0, p1, j);
+		if ((pj == p1) || (*pj != j)) return nullptr;
+		return sub.val.data() + (pj - pc);
+	}
+
+private:
+	DomainDecompositionSolver*	m_solver;
+};
+
+//-----------------------------------------------------------------------------
+SparseMatrix* DomainDecompositionSolver::CreateSparseMatrix(Matrix_Type ntype)
+{
+	m_bsymm = (ntype == REAL_SYMMETRIC);
+	m_pA = new RankMatrix(this);
+	return m_pA;
+}
+
+//-----------------------------------------------------------------------------
+// The rows are assembled directly into the subdomains, so this solver only works
+// with its own matrix.
+bool DomainDecompositionSolver::SetSparseMatrix(SparseMatrix* A)
+{
+	m_pA = dynamic_cast<RankMatrix*>(A);
+	return (m_pA != nullptr);
+}
+
+//-----------------------------------------------------------------------------
+bool DomainDecompositionSolver::HasPreconditioner() const
+{
+	return m_precondition;
+}
+
+//-----------------------------------------------------------------------------
+// Partition the mesh and assign the equations to the ranks.
+bool DomainDecompositionSolver::Partition(int neq)
+{
+	if (m_ranks < 1) m_ranks = 1;
+
+	FEMesh& mesh = GetFEModel()->GetMesh();
+	if (m_dd.Partition(mesh, m_ranks) == false) return false;
+
+	m_dd.EquationPartition(mesh, neq, m_eqPart);
+
+	// number the equations of each rank
+	m_sub.assign(m_ranks, Subdomain());
+	m_eqLocal.resize(neq);
+	for (int i = 0; i < neq; ++i)
+	{
+		Subdomain& sub = m_sub[m_eqPart[i]];
+		m_eqLocal[i] = (int)sub.eq.size();
+		sub.eq.push_back(i);
+	}
+	for (Subdomain& sub : m_sub) sub.nown = (int)sub.eq.size();
+
+	if (m_print_level > 0)
+	{
+		feLog("Domain decomposition: %d ranks\n", m_ranks);
+		for (int i = 0; i < m_ranks; ++i) feLog("\trank %d: %d equations\n", i, m_sub[i].nown);
+	}
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+// Build the owned rows of each rank from the (column-based) matrix profile, 
+// number the ghost equations and set up the communication pattern.
+void DomainDecompositionSolver::BuildRows(SparseMatrixProfile& MP)
+{
+	int nc = MP.Columns();
+
+	// count the entries of the owned rows
+	for (Subdomain& sub : m_sub) sub.ptr.assign(sub.nown + 1, 0);
+	for (int c = 0; c < nc; ++c)
+	{
+		SparseMatrixProfile::ColumnProfile& a = MP.Column(c);
+		for (size_t k = 0; k < a.size(); ++k)
+		{
+			for (int r = a[k].start; r <= a[k].end; ++r) m_sub[m_eqPart[r]].ptr[m_eqLocal[r] + 1]++;
+		}
+	}
+
+	// The profile is processed column by column, so the columns of each row are sorted.
+	vector< vector<int> > pos(m_ranks);
+	for (int p = 0; p < m_ranks; ++p)
+	{
+		Subdomain& sub = m_sub[p];
+		for (int i = 0; i < sub.nown; ++i) sub.ptr[i + 1] += sub.ptr[i];
+		sub.gcol.resize(sub.ptr[sub.nown]);
+		sub.val.assign(sub.ptr[sub.nown], 0.0);
+		pos[p].assign(sub.ptr.begin(), sub.ptr.end() - 1);
+	}
+	for (int c = 0; c < nc; ++c)
+	{
+		SparseMatrixProfile::ColumnProfile& a = MP.Column(c);
+		for (size_t k = 0; k < a.size(); ++k)
+		{
+			for (int r = a[k].start; r <= a[k].end; ++r)
+			{
+				int p = m_eqPart[r];
+				m_sub[p].gcol[pos[p][m_eqLocal[r]]++] = c;
+			}
+		}
+	}
+	pos.clear();
+
+	// convert to local column indices and number the ghost equations
+	#pragma omp parallel for schedule(dynamic)
+	for (int p = 0; p < m_ranks; ++p)
+	{
+		Subdomain& sub = m_sub[p];
+		int nown = sub.nown;
+		sub.col.resize(sub.gcol.size());
+
+		unordered_map<int, int> ghost;
+		for (int i = 0; i < nown; ++i)
+		{
+			for (int j = sub.ptr[i]; j < sub.ptr[i + 1]; ++j)
+			{
+				int c = sub.gcol[j];
+				int lc;
+				if (m_eqPart[c] == p) lc = m_eqLocal[c];
+				else
+				{
+					auto it = ghost.find(c);
+					if (it == ghost.end())
+					{
+						lc = (int)sub.eq.size();
+						ghost[c] = lc;
+						sub.eq.push_back(c);
+					}
+					else lc = it->second;
+				}
+				sub.col[j] = lc;
+			}
+		}
+	}
+
+	// Set up the communication pattern. In a distributed setting each rank would 
+	// send its ghost list to the owners instead.
+	for (int p = 0; p < m_ranks; ++p)
+	{
+		Subdomain& sub = m_sub[p];
+		vector<int> slot(m_ranks, -1);
+		for (int i = sub.nown; i < (int)sub.eq.size(); ++i)
+		{
+			int g = sub.eq[i];
+			int q = m_eqPart[g];
+			if (slot[q] < 0)
+			{
+				slot[q] = (int)sub.recvFrom.size();
+				sub.recvFrom.push_back(q);
+				sub.recvIdx.push_back(vector<int>());
+
+				Subdomain& owner = m_sub[q];
+				owner.sendTo.push_back(p);
+				owner.sendIdx.push_back(vector<int>());
+			}
+			sub.recvIdx[slot[q]].push_back(i);
+
+			// the owner's send list is in the same order
+			Subdomain& owner = m_sub[q];
+			int n = (int)(find(owner.sendTo.begin(), owner.sendTo.end(), p) - owner.sendTo.begin());
+			owner.sendIdx[n].push_back(m_eqLocal[g]);
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+// The subdomains are set up when the matrix is created.
+bool DomainDecompositionSolver::PreProcess()
+{
+	if (m_pA == nullptr) return false;
+	return ((int)m_sub.size() == m_ranks) && ((int)m_eqPart.size() == m_pA->Rows());
+}
+
+//-----------------------------------------------------------------------------
+// The rows were assembled directly into the subdomains, so only the diagonals
+// for the preconditioner need to be extracted.
+bool DomainDecompositionSolver::Factor()
+{
+	if ((int)m_sub.size() != m_ranks) return false;
+
+	#pragma omp parallel for
+	for (int p = 0; p < m_ranks; ++p)
+	{
+		Subdomain& sub = m_sub[p];
+		sub.diag.assign(sub.nown, 0.0);
+		for (int i = 0; i < sub.nown; ++i)
+		{
+			for (int j = sub.ptr[i]; j < sub.ptr[i + 1]; ++j)
+			{
+				if (sub.col[j] == i) sub.diag[i] += sub.val[j];
+			}
+		}
+	}
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+bool DomainDecompositionSolver::BackSolve(double* x, double* b)
+{
+	if ((int)m_sub.size() != m_ranks) return false;
+
+	vector<int> iters(m_ranks, 0);
+	vector<char> bconv(m_ranks, 0);
+	if (m_ranks == 1)
+	{
+		FELoopbackCommunicator comm;
+		bconv[0] = Solve(comm, m_sub[0], b, x, iters[0]);
+	}
+	else
+	{
+		// each rank runs in its own thread
+		FESharedMemoryHub hub(m_ranks);
+		vector<thread> ranks;
+		for (int p = 0; p < m_ranks; ++p)
+		{
+			ranks.push_back(thread([&, p]() {
+				FESharedMemoryCommunicator comm(hub, p);
+				int n = 0;
+				bconv[p] = Solve(comm, m_sub[p], b, x, n);
+				iters[p] = n;
+			}));
+		}
+		for (thread& t : ranks) t.join();
+	}
+
+	// all ranks do the same number of iterations
+	if (m_print_level > 0) feLog("Domain decomposition solve: %d iterations\n", iters[0]);
+
+	UpdateStats(iters[0]);
+
+	return (m_fail_max_iter ? (bconv[0] != 0) : true);
+}
+
+//-----------------------------------------------------------------------------
+bool DomainDecompositionSolver::Solve(FECommunicator& comm, Subdomain& sub, const double* b, double* x, int& iters)
+{
+	// get the rank's part of the right-hand side
+	int n = sub.nown;
+	vector<double> bl(n), xl(sub.eq.size(), 0.0);
+	for (int i = 0; i < n; ++i) bl[i] = b[sub.eq[i]];
+
+	bool bconv = false;
+	if (m_bsymm) bconv = SolveCG(comm, sub, bl, xl, iters);
+	else bconv = SolveBiCGStab(comm, sub, bl, xl, iters);
+
+	// the ranks write disjoint parts of the solution
+	for (int i = 0; i < n; ++i) x[sub.eq[i]] = xl[i];
+
+	return bconv;
+}
+
+//-----------------------------------------------------------------------------
+void DomainDecompositionSolver::Exchange(FECommunicator& comm, Subdomain& sub, vector<double>& v)
+{
+	vector<double> buf;
+	for (size_t k = 0; k < sub.sendTo.size(); ++k)
+	{
+		const vector<int>& idx = sub.sendIdx[k];
+		buf.resize(idx.size());
+		for (size_t i = 0; i < idx.size(); ++i) buf[i] = v[idx[i]];
+		comm.Send(sub.sendTo[k], GHOST_TAG, buf);
+	}
+
+	for (size_t k = 0; k < sub.recvFrom.size(); ++k)
+	{
+		comm.Recv(sub.recvFrom[k], GHOST_TAG, buf);
+		const vector<int>& idx = sub.recvIdx[k];
+		assert(buf.size() == idx.size());
+		for (size_t i = 0; i < idx.size(); ++i) v[idx[i]] = buf[i];
+	}
+}
+
+//-----------------------------------------------------------------------------
+void DomainDecompositionSolver::MatVec(Subdomain& sub, const vector<double>& x, vector<double>& y)
+{
+	for (int i = 0; i < sub.nown; ++i)
+	{
+		double s = 0.0;
+		for (int j = sub.ptr[i]; j < sub.ptr[i + 1]; ++j) s += sub.val[j] * x[sub.col[j]];
+		y[i] = s;
+	}
+}
+
+//-----------------------------------------------------------------------------
+// Symmetric Gauss-Seidel on the owned block, i.e. z = (D+U)^-1 D (D+L)^-1 r. 
+// Couplings to ghost equations are ignored, which makes this a block Jacobi 
+// preconditioner over the subdomains.
+void DomainDecompositionSolver::Precondition(Subdomain& sub, const vector<double>& r, vector<double>& z)
+{
+	int n = sub.nown;
+	if (m_precondition == false)
+	{
+		for (int i = 0; i < n; ++i) z[i] = r[i];
+		return;
+	}
+
+	// forward sweep
+	for (int i = 0; i < n; ++i)
+	{
+		double s = r[i];
+		for (int j = sub.ptr[i]; j < sub.ptr[i + 1]; ++j)
+		{
+			int c = sub.col[j];
+			if (c < i) s -= sub.val[j] * z[c];
+		}
+		double d = sub.diag[i];
+		z[i] = (d != 0.0 ? s / d : s);
+	}
+
+	// backward sweep
+	for (int i = n - 1; i >= 0; --i)
+	{
+		double s = 0.0;
+		for (int j = sub.ptr[i]; j < sub.ptr[i + 1]; ++j)
+		{
+			int c = sub.col[j];
+			if ((c > i) && (c < n)) s += sub.val[j] * z[c];
+		}
+		double d = sub.diag[i];
+		if (d != 0.0) z[i] -= s / d;
+	}
+}
+
+//-----------------------------------------------------------------------------
+bool DomainDecompositionSolver::SolveCG(FECommunicator& comm, Subdomain& sub, vector<double>& b, vector<double>& x, int& iters)
+{
+	int n = sub.nown;
+	int nl = (int)sub.eq.size();
+	int neq = m_pA->Rows();
+	int maxiter = (m_maxiter > 0 ? m_maxiter : neq);
+
+	vector<double> r(b), z(n), p(nl, 0.0), q(n);
+
+	double norm0 = 0.0;
+	for (int i = 0; i < n; ++i) norm0 += r[i] * r[i];
+	norm0 = sqrt(comm.AllReduceSum(norm0));
+	iters = 0;
+	if (norm0 == 0.0) return true;
+	double tol = m_tol*norm0;
+
+	Precondition(sub, r, z);
+	double rz = 0.0;
+	for (int i = 0; i < n; ++i) { p[i] = z[i]; rz += r[i] * z[i]; }
+	rz = comm.AllReduceSum(rz);
+
+	bool bconv = false;
+	while (iters < maxiter)
+	{
+		Exchange(comm, sub, p);
+		MatVec(sub, p, q);
+
+		double pq = 0.0;
+		for (int i = 0; i < n; ++i) pq += p[i] * q[i];
+		pq = comm.AllReduceSum(pq);
+		if (pq == 0.0) break;
+		double alpha = rz / pq;
+
+		for (int i = 0; i < n; ++i)
+		{
+			x[i] += alpha*p[i];
+			r[i] -= alpha*q[i];
+		}
+		++iters;
+
+		Precondition(sub, r, z);
+
+		// do both reductions at once
+		double d[2] = { 0.0, 0.0 };
+		for (int i = 0; i < n; ++i) { d[0] += r[i] * r[i]; d[1] += r[i] * z[i]; }
+		comm.AllReduceSum(d, 2);
+
+		if (sqrt(d[0]) <= tol) { bconv = true; break; }
+
+		double beta = d[1] / rz;
+		rz = d[1];
+		for (int i = 0; i < n; ++i) p[i] = z[i] + beta*p[i];
+	}
+
+	return bconv;
+}
+
+//-----------------------------------------------------------------------------
+// right-preconditioned BiCGStab
+bool DomainDecompositionSolver::SolveBiCGStab(FECommunicator& comm, Subdomain& sub, vector<double>& b, vector<double>& x, int& iters)
+{
+	int n = sub.nown;
+	int nl = (int)sub.eq.size();
+	int neq = m_pA->Rows();
+	int maxiter = (m_maxiter > 0 ? m_maxiter : neq);
+
+	vector<double> r(b), rt(b), p(n, 0.0), v(n, 0.0), s(n), t(n), y(nl, 0.0), z(nl, 0.0);
+
+	double norm0 = 0.0;
+	for (int i = 0; i < n; ++i) norm0 += r[i] * r[i];
+	norm0 = sqrt(comm.AllReduceSum(norm0));
+	iters = 0;
+	if (norm0 == 0.0) return true;
+	double tol = m_tol*norm0;
+
+	double rho = 1.0, alpha = 1.0, w = 1.0;
+	bool bconv = false;
+	while (iters < maxiter)
+	{
+		double rho1 = 0.0;
+		for (int i = 0; i < n; ++i) rho1 += rt[i] * r[i];
+		rho1 = comm.AllReduceSum(rho1);
+		if (rho1 == 0.0) break;
+
+		double beta = (rho1 / rho)*(alpha / w);
+		for (int i = 0; i < n; ++i) p[i] = r[i] + beta*(p[i] - w*v[i]);
+
+		Precondition(sub, p, y);
+		Exchange(comm, sub, y);
+		MatVec(sub, y, v);
+
+		double rv = 0.0;
+		for (int i = 0; i < n; ++i) rv += rt[i] * v[i];
+		rv = comm.AllReduceSum(rv);
+		if (rv == 0.0) break;
+		alpha = rho1 / rv;
+
+		for (int i = 0; i < n; ++i) s[i] = r[i] - alpha*v[i];
+
+		Precondition(sub, s, z);
+		Exchange(comm, sub, z);
+		MatVec(sub, z, t);
+
+		double d[2] = { 0.0, 0.0 };
+		for (int i = 0; i < n; ++i) { d[0] += t[i] * s[i]; d[1] += t[i] * t[i]; }
+		comm.AllReduceSum(d, 2);
+		w = (d[1] != 0.0 ? d[0] / d[1] : 0.0);
+
+		double rr = 0.0;
+		for (int i = 0; i < n; ++i)
+		{
+			x[i] += alpha*y[i] + w*z[i];
+			r[i] = s[i] - w*t[i];
+			rr += r[i] * r[i];
+		}
+		rr = comm.AllReduceSum(rr);
+		++iters;
+
+		if (sqrt(rr) <= tol) { bconv = true; break; }
+		if (w == 0.0) break;
+		rho = rho1;
+	}
+
+	return bconv;
+}
+
+//-----------------------------------------------------------------------------
+void DomainDecompositionSolver::Destroy()
+{
+	m_sub.clear();
+	m_eqPart.clear();
+	m_eqLocal.clear();
+}
@@ -0,0 +1,118 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+#pragma once
+#include <FECore/LinearSolver.h>
+#include <FECore/FEDomainDecomposition.h>
+
+class FECommunicator;
+
+//-----------------------------------------------------------------------------
+//! Domain-decomposed iterative solver. The mesh is partitioned into subdomains 
+//! (see FEDomainDecomposition) and each rank owns the rows of the equations of
+//! its subdomain. The ranks solve the system together with a parallel Krylov method
+//! (CG for symmetric, BiCGStab for non-symmetric matrices) preconditioned with
+//! a block Jacobi (subdomain SSOR) preconditioner. Ghost values are exchanged 
+//! through an FECommunicator. The ranks currently run as threads that communicate
+//! through shared memory, but the solve itself only uses the communicator interface.
+//! The solver provides its own sparse matrix, which assembles the element matrices
+//! directly into the owned rows of each rank, so the global matrix is never stored.
+class DomainDecompositionSolver : public IterativeLinearSolver
+{
+	// The part of the linear system that is owned by one rank. Owned equations 
+	// are numbered first, followed by the ghost equations (owned by other ranks).
+	struct Subdomain
+	{
+		std::vector<int>	eq;			// global equation number of local equations
+		int					nown;		// number of owned equations
+		std::vector<int>	ptr;		// row pointers of the owned rows
+		std::vector<int>	gcol;		// global column indices (sorted per row, used for assembly)
+		std::vector<int>	col;		// local column indices
+		std::vector<double>	val;		// matrix values
+		std::vector<double>	diag;		// diagonal of the owned rows
+		std::vector<int>	sendTo, recvFrom;
+		std::vector< std::vector<int> >	sendIdx, recvIdx;	// local indices of values to send/receive
+	};
+
+	// the sparse matrix that stores the rows of each rank
+	class RankMatrix;
+
+public:
+	DomainDecompositionSolver(FEModel* fem);
+	~DomainDecompositionSolver();
+
+	bool PreProcess() override;
+	bool Factor() override;
+	bool BackSolve(double* x, double* b) override;
+	void Destroy() override;
+
+	SparseMatrix* CreateSparseMatrix(Matrix_Type ntype) override;
+	bool SetSparseMatrix(SparseMatrix* A) override;
+
+	bool HasPreconditioner() const override;
+
+	void SetPrintLevel(int n) override { m_print_level = n; }
+
+private:
+	// partition the mesh and assign the equations to the ranks
+	bool Partition(int neq);
+
+	// build the rows of each rank from the matrix profile
+	void BuildRows(SparseMatrixProfile& MP);
+
+	// the solve that is executed on each rank
+	bool Solve(FECommunicator& comm, Subdomain& sub, const double* b, double* x, int& iters);
+	bool SolveCG(FECommunicator& comm, Subdomain& sub, std::vector<double>& b, std::vector<double>& x, int& iters);
+	bool SolveBiCGStab(FECommunicator& comm, Subdomain& sub, std::vector<double>& b, std::vector<double>& x, int& iters);
+
+	// update the ghost values of v
+	void Exchange(FECommunicator& comm, Subdomain& sub, std::vector<double>& v);
+
+	// y = A*x for the owned rows (x must have up-to-date ghost values)
+	void MatVec(Subdomain& sub, const std::vector<double>& x, std::vector<double>& y);
+
+	// apply the preconditioner to the owned entries: z = M^-1 r
+	void Precondition(Subdomain& sub, const std::vector<double>& r, std::vector<double>& z);
+
+private:
+	int		m_ranks;		// number of subdomains
+	int		m_maxiter;		// max nr of iterations
+	double	m_tol;			// residual relative tolerance
+	int		m_print_level;	// output level
+	bool	m_fail_max_iter;
+	bool	m_precondition;	// use the subdomain preconditioner
+
+	SparseMatrix*			m_pA;
+	bool					m_bsymm;	// is the matrix symmetric (use CG)
+	FEDomainDecomposition	m_dd;
+	std::vector<int>		m_eqPart;	// owning rank of each equation
+	std::vector<int>		m_eqLocal;	// local index of each equation in its owning rank
+	std::vector<Subdomain>	m_sub;
+
+	DECLARE_FECORE_CLASS();
+};
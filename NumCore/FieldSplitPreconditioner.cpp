@@ -0,0 +1,298 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+#include "stdafx.h"
+#include "FieldSplitPreconditioner.h"
+#include <FECore/CompactUnSymmMatrix.h>
+#include <FECore/FEModel.h>
+#include <FECore/log.h>
+#include <algorithm>
+
+//-----------------------------------------------------------------------------
+BEGIN_FECORE_CLASS(FieldSplitPreconditioner, Preconditioner)
+	ADD_PARAMETER(m_var        , "split_variable");
+	ADD_PARAMETER(m_schurApprox, "schur_approx", 0, "SIMPLE\0LSC\0");
+
+	ADD_PROPERTY(m_Asolver, "A_solver")->SetFlags(FEProperty::Optional);
+END_FECORE_CLASS();
+
+//-----------------------------------------------------------------------------
+// ILU(0) factorization (IKJ variant). Small pivots are replaced with a value 
+// relative to the largest entry, since the Schur approximations can be singular
+// (e.g. pure Neumann conditions on the dilatation).
+bool FieldSplitPreconditioner::ILU0::Factor()
+{
+	int n = (int)ptr.size() - 1;
+	if (n <= 0) return true;
+
+	double amax = 0.0;
+	for (double v : val) amax = std::max(amax, fabs(v));
+	if (amax == 0.0) return false;
+	const double tiny = 1e-12 * amax;
+
+	diag.assign(n, -1);
+	std::vector<int> iw(n, -1);
+	for (int i = 0; i < n; ++i)
+	{
+		for (int p = ptr[i]; p < ptr[i + 1]; ++p) iw[col[p]] = p;
+
+		for (int p = ptr[i]; p < ptr[i + 1]; ++p)
+		{
+			int k = col[p];
+			if (k >= i) break;
+
+			val[p] /= val[diag[k]];
+			double lik = val[p];
+			for (int q = diag[k] + 1; q < ptr[k + 1]; ++q)
+			{
+				int j = iw[col[q]];
+				if (j >= 0) val[j] -= lik * val[q];
+			}
+		}
+
+		int d = iw[i];
+		if (d < 0) return false;	// no diagonal entry
+		if (fabs(val[d]) < tiny) val[d] = (val[d] < 0.0 ? -tiny : tiny);
+		diag[i] = d;
+
+		for (int p = ptr[i]; p < ptr[i + 1]; ++p) iw[col[p]] = -1;
+	}
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+void FieldSplitPreconditioner::ILU0::Solve(const double* b, double* x) const
+{
+	int n = (int)ptr.size() - 1;
+
+	// forward substitution with unit lower triangle
+	for (int i = 0; i < n; ++i)
+	{
+		double s = b[i];
+		for (int p = ptr[i]; p < diag[i]; ++p) s -= val[p] * x[col[p]];
+		x[i] = s;
+	}
+
+	// backward substitution with upper triangle
+	for (int i = n - 1; i >= 0; --i)
+	{
+		double s = x[i];
+		for (int p = diag[i] + 1; p < ptr[i + 1]; ++p) s -= val[p] * x[col[p]];
+		x[i] = s / val[diag[i]];
+	}
+}
+
+//-----------------------------------------------------------------------------
+FieldSplitPreconditioner::FieldSplitPreconditioner(FEModel* fem) : Preconditioner(fem)
+{
+	m_var = "fluid dilatation";
+	m_schurApprox = SCHUR_SIMPLE;
+	m_Asolver = nullptr;
+
+	m_K = nullptr;
+}
+
+//-----------------------------------------------------------------------------
+FieldSplitPreconditioner::~FieldSplitPreconditioner()
+{
+}
+
+//-----------------------------------------------------------------------------
+SparseMatrix* FieldSplitPreconditioner::CreateSparseMatrix(Matrix_Type ntype)
+{
+	if (ntype != REAL_UNSYMMETRIC) return nullptr;
+	m_K = new CRSSparseMatrix(1);
+	return m_K;
+}
+
+//-----------------------------------------------------------------------------
+bool FieldSplitPreconditioner::PreProcess()
+{
+	if (m_K == nullptr) m_K = dynamic_cast<CRSSparseMatrix*>(GetSparseMatrix());
+	if (m_K == nullptr) return false;
+
+	if (SplitEquations() == false) return false;
+
+	BuildBlocks();
+
+	if (m_Asolver)
+	{
+		m_Asolver->SetFEModel(GetFEModel());
+		if (m_Asolver->SetSparseMatrix(m_split.A()) == false) return false;
+		if (m_Asolver->PreProcess() == false) return false;
+	}
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+bool FieldSplitPreconditioner::SplitEquations()
+{
+	FEModel* fem = GetFEModel();
+	if (fem == nullptr) return false;
+
+	DOFS& dofs = fem->GetDOFS();
+	int nvar = dofs.GetVariableIndex(m_var.c_str());
+	if (nvar < 0)
+	{
+		feLogError("fieldsplit: variable \"%s\" is not defined.", m_var.c_str());
+		return false;
+	}
+	std::vector<int> dofList;
+	dofs.GetDOFList(nvar, dofList);
+
+	// assign the equations of the split variable (including prescribed dofs) to the second block
+	if (m_split.SplitEquations(fem, m_K->Rows(), dofList) == false)
+	{
+		feLogError("fieldsplit: the equations cannot be split with variable \"%s\".", m_var.c_str());
+		return false;
+	}
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+void FieldSplitPreconditioner::BuildBlocks()
+{
+	m_split.BuildBlocks(m_K);
+	const int n0 = m_split.Equations(0);
+	const int n1 = m_split.Equations(1);
+
+	if (m_Asolver == nullptr)
+	{
+		CRSSparseMatrix* A = m_split.A();
+		const int off = A->Offset();
+		const int nnzA = A->NonZeroes();
+		m_Ailu.ptr.resize(n0 + 1);
+		m_Ailu.col.resize(nnzA);
+		m_Ailu.val.resize(nnzA);
+		for (int i = 0; i <= n0; ++i) m_Ailu.ptr[i] = A->Pointers()[i] - off;
+		for (int i = 0; i < nnzA; ++i) m_Ailu.col[i] = A->Indices()[i] - off;
+	}
+
+	// The pattern of the Schur approximation is that of C*B (and D for SIMPLE)
+	m_split.SchurPattern(m_schurApprox == SCHUR_SIMPLE, m_S.ptr, m_S.col);
+	m_S.val.resize(m_S.col.size());
+
+	m_Qi.resize(n0);
+	m_r0.resize(n0); m_z0.resize(n0); m_t0.resize(n0);
+	m_r1.resize(n1); m_z1.resize(n1); m_t1.resize(n1);
+}
+
+//-----------------------------------------------------------------------------
+bool FieldSplitPreconditioner::Factor()
+{
+	CRSSparseMatrix* A = m_split.A();
+	if ((m_K == nullptr) || (A == nullptr)) return false;
+
+	// copy the values into the blocks
+	m_split.UpdateBlocks(m_K);
+
+	// inverse of the diagonal of A
+	m_split.InverseDiagonal(m_Qi);
+
+	// factor the A block
+	if (m_Asolver)
+	{
+		if (m_Asolver->Factor() == false) return false;
+	}
+	else
+	{
+		const double* Av = A->Values();
+		std::copy(Av, Av + m_Ailu.val.size(), m_Ailu.val.begin());
+		if (m_Ailu.Factor() == false)
+		{
+			feLogError("fieldsplit: failed to factor the A block.");
+			return false;
+		}
+	}
+
+	// evaluate S = D - C*inv(Q)*B (SIMPLE) or F = C*inv(Q)*B (LSC)
+	m_split.SchurValues(m_Qi, (m_schurApprox == SCHUR_SIMPLE), m_S.ptr.data(), m_S.col.data(), m_S.val.data());
+
+	if (m_S.Factor() == false)
+	{
+		feLogError("fieldsplit: failed to factor the Schur complement approximation.");
+		return false;
+	}
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+void FieldSplitPreconditioner::SolveSchur(const double* r, double* z)
+{
+	if (m_schurApprox == SCHUR_SIMPLE)
+	{
+		m_S.Solve(r, z);
+	}
+	else
+	{
+		// inv(S) ~ -inv(F)*(C*inv(Q)*A*inv(Q)*B)*inv(F), with F = C*inv(Q)*B
+		const int n0 = m_split.Equations(0);
+		const int n1 = m_split.Equations(1);
+		m_S.Solve(r, &m_t1[0]);
+		m_split.B().multv(&m_t1[0], &m_t0[0]);
+		for (int i = 0; i < n0; ++i) m_t0[i] *= m_Qi[i];
+		m_split.A()->mult_vector(&m_t0[0], &m_z0[0]);
+		for (int i = 0; i < n0; ++i) m_z0[i] *= m_Qi[i];
+		m_split.C().multv(&m_z0[0], &m_t1[0]);
+		m_S.Solve(&m_t1[0], z);
+		for (int i = 0; i < n1; ++i) z[i] = -z[i];
+	}
+}
+
+//-----------------------------------------------------------------------------
+bool FieldSplitPreconditioner::BackSolve(double* x, double* y)
+{
+	const int n0 = m_split.Equations(0);
+	m_split.Gather(y, &m_r0[0], &m_r1[0]);
+
+	// z1 = inv(S)*r1
+	SolveSchur(&m_r1[0], &m_z1[0]);
+
+	// z0 = inv(A)*(r0 - B*z1)
+	m_split.B().multv(&m_z1[0], &m_t0[0]);
+	for (int i = 0; i < n0; ++i) m_t0[i] = m_r0[i] - m_t0[i];
+	if (m_Asolver)
+	{
+		if (m_Asolver->BackSolve(&m_z0[0], &m_t0[0]) == false) return false;
+	}
+	else m_Ailu.Solve(&m_t0[0], &m_z0[0]);
+
+	m_split.Scatter(&m_z0[0], &m_z1[0], x);
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+void FieldSplitPreconditioner::Destroy()
+{
+	if (m_Asolver) m_Asolver->Destroy();
+	m_split.Clear();
+}
@@ -0,0 +1,116 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+#pragma once
+#include <FECore/Preconditioner.h>
+#include <FECore/FEFieldSplit.h>
+#include <string>
+
+class CRSSparseMatrix;
+
+//-----------------------------------------------------------------------------
+// Block preconditioner for two-field problems, such as the velocity-dilatation
+// systems of the fluid solver. The equations of the split variable form the 
+// second block. All other equations form the first block, so the equations do
+// not need to be numbered blockwise.
+// The preconditioner is the upper block triangular matrix
+//
+//     P = | A  B |
+//         | 0  S |
+//
+// where S approximates the Schur complement D - C*inv(A)*B. The A block is 
+// solved with an ILU(0) factorization, or with the (optional) A_solver, e.g. AMG. 
+// This is the way to run a SIMPLE-type segregated velocity/dilatation solve with
+// the (monolithic) fluid solver, e.g.
+//
+//   <linear_solver type="fgmres">
+//     <pc_right type="fieldsplit">
+//       <split_variable>fluid dilatation</split_variable>
+//       <schur_approx>SIMPLE</schur_approx>
+//     </pc_right>
+//   </linear_solver>
+//
+// The Krylov iterations converge to the solution of the coupled system, so the
+// Newton convergence of the fluid solver is not affected by the splitting.
+class FieldSplitPreconditioner : public Preconditioner
+{
+public:
+	// Schur complement approximations
+	enum Schur_Approx {
+		SCHUR_SIMPLE,	// S = D - C*inv(diag(A))*B
+		SCHUR_LSC		// least-squares commutator (for nearly incompressible flow)
+	};
+
+	// ILU(0) factorization of a zero-based CSR matrix with sorted columns
+	struct ILU0
+	{
+		std::vector<int>	ptr, col, diag;
+		std::vector<double>	val;
+
+		bool Factor();
+		void Solve(const double* b, double* x) const;
+	};
+
+public:
+	FieldSplitPreconditioner(FEModel* fem);
+	~FieldSplitPreconditioner();
+
+	SparseMatrix* CreateSparseMatrix(Matrix_Type ntype) override;
+
+	bool PreProcess() override;
+	bool Factor() override;
+	bool BackSolve(double* x, double* y) override;
+	void Destroy() override;
+
+private:
+	// find the equations of the two fields
+	bool SplitEquations();
+
+	// extract the structure of the blocks
+	void BuildBlocks();
+
+	// apply the Schur complement approximation: z = inv(S)*r
+	void SolveSchur(const double* r, double* z);
+
+private:
+	std::string		m_var;			//!< name of variable of the second field
+	int				m_schurApprox;	//!< Schur complement approximation
+	LinearSolver*	m_Asolver;		//!< (optional) solver for the A block
+
+private:
+	CRSSparseMatrix*	m_K;		//!< the global matrix
+	FEFieldSplit		m_split;	//!< the blocks of the two fields
+	std::vector<double>	m_Qi;		//!< inverse of the diagonal of A
+
+	ILU0	m_Ailu;		//!< ILU(0) of A (if no A solver is defined)
+	ILU0	m_S;		//!< ILU(0) of the Schur approximation (SIMPLE) or of C*inv(Q)*B (LSC)
+
+	std::vector<double>	m_r0, m_r1, m_z0, m_z1, m_t0, m_t1;
+
+	DECLARE_FECORE_CLASS();
+};
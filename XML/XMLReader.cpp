@@ -1198,6 +1198,284 @@ char XMLReader::GetNextChar()
 	return ch;
 }
 
+//=============================================================================
+// XMLReader - bulk reader
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+// Locale independent number parsing for the bulk reader. These functions parse
+// a number in [sz, end) and return a pointer to the first character after the 
+// number, or nullptr if no valid number was found. 
+static const char* parse_number(const char* sz, const char* end, int& v)
+{
+	const char* ch = sz;
+	bool neg = false;
+	if ((ch < end) && ((*ch == '-') || (*ch == '+'))) { neg = (*ch == '-'); ch++; }
+
+	long long n = 0;
+	const char* ch0 = ch;
+	while ((ch < end) && (*ch >= '0') && (*ch <= '9'))
+	{
+		n = 10 * n + (*ch - '0');
+		if (n > 2147483647LL) return nullptr;
+		ch++;
+	}
+	if (ch == ch0) return nullptr;
+
+	v = (int)(neg ? -n : n);
+	return ch;
+}
+
+static const char* parse_number(const char* sz, const char* end, double& v)
+{
+	// powers of ten that are exactly representable as doubles
+	static const double p10[] = {
+		1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+		1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+
+	const char* ch = sz;
+	bool neg = false;
+	if ((ch < end) && ((*ch == '-') || (*ch == '+'))) { neg = (*ch == '-'); ch++; }
+
+	// mantissa
+	unsigned long long m = 0;
+	int ndigits = 0;	// significant digits
+	int nread = 0;		// total digits
+	int e = 0;
+	while ((ch < end) && (*ch >= '0') && (*ch <= '9'))
+	{
+		if ((m != 0) || (*ch != '0')) 
+		{
+			if (ndigits < 19) m = 10 * m + (*ch - '0'); else e++;
+			ndigits++;
+		}
+		nread++; ch++;
+	}
+	if ((ch < end) && (*ch == '.'))
+	{
+		ch++;
+		while ((ch < end) && (*ch >= '0') && (*ch <= '9'))
+		{
+			if ((m != 0) || (*ch != '0'))
+			{
+				if (ndigits < 19) { m = 10 * m + (*ch - '0'); e--; }
+				ndigits++;
+			}
+			else e--;
+			nread++; ch++;
+		}
+	}
+	if (nread == 0) return nullptr;
+
+	// exponent
+	if ((ch < end) && ((*ch == 'e') || (*ch == 'E')))
+	{
+		ch++;
+		int ne = 0;
+		if (ch == end) return nullptr;
+		ch = parse_number(ch, end, ne);
+		if (ch == nullptr) return nullptr;
+		if ((ne > 10000) || (ne < -10000)) return nullptr;
+		e += ne;
+	}
+
+	if ((ndigits <= 15) && (e >= -22) && (e <= 22))
+	{
+		// The mantissa and the power of ten are exact, so a single multiplication
+		// or division gives the correctly rounded result.
+		double d = (double)m;
+		d = (e < 0 ? d / p10[-e] : d * p10[e]);
+		v = (neg ? -d : d);
+	}
+	else
+	{
+		// let the C library deal with the hard cases. 
+		// Note that the number is followed by a non-numeric character.
+		v = strtod(sz, nullptr);
+	}
+	return ch;
+}
+
+//-----------------------------------------------------------------------------
+bool XMLReader::ReadLeafValues(XMLTag& tag, const char* szatt, std::vector<int>& att, std::vector<int>& count, std::vector<double>& val, int nmax)
+{
+	return readLeafValues(tag, szatt, att, count, val, nmax);
+}
+
+bool XMLReader::ReadLeafValues(XMLTag& tag, const char* szatt, std::vector<int>& att, std::vector<int>& count, std::vector<int>& val, int nmax)
+{
+	return readLeafValues(tag, szatt, att, count, val, nmax);
+}
+
+//-----------------------------------------------------------------------------
+template <typename T> bool XMLReader::readLeafValues(XMLTag& tag, const char* szatt, std::vector<int>& att, std::vector<int>& count, std::vector<T>& val, int nmax)
+{
+	assert(tag.m_preader == this);
+	att.clear();
+	count.clear();
+	val.clear();
+
+	// this only makes sense for tags with child elements
+	if (tag.isend() || tag.isempty() || tag.isleaf() || (nmax <= 0)) return false;
+
+	// Position the stream at the first child. We bypass the character buffer,
+	// so invalidate it. This also forces NextTag to reposition the stream, so
+	// the caller can continue with the tag if we fail. 
+	m_stream->clear();
+	m_stream->seekg(tag.m_fpos, ios_base::beg);
+	m_bufIndex = m_bufSize = 0;
+	m_eof = false;
+	m_currentPos = -1;
+
+	const size_t natt = strlen(szatt);
+	int nline = tag.m_ncurrent_line;
+	int64_t fpos = tag.m_fpos;	// file position of buf[head]
+
+	std::vector<char> buf;
+	size_t head = 0;
+	bool eof = false;
+	std::vector<T> tmp(nmax);
+
+	// read the next block, keeping the unprocessed data
+	auto fill = [&]() -> bool {
+		if (eof) return false;
+		buf.erase(buf.begin(), buf.begin() + head);
+		head = 0;
+		size_t n0 = buf.size();
+		buf.resize(n0 + BLOCK_SIZE);
+		m_stream->read(&buf[n0], BLOCK_SIZE);
+		size_t nread = (size_t)m_stream->gcount();
+		m_stream->clear();
+		buf.resize(n0 + nread);
+		eof = (nread != BLOCK_SIZE);
+		return (nread > 0);
+	};
+
+	while (true)
+	{
+		const char* b = buf.data() + head;
+		const char* e = buf.data() + buf.size();
+
+		// skip whitespace
+		const char* p = b;
+		while ((p < e) && isspace(*p)) { if (*p == '\n') nline++; p++; }
+		if (p + 1 >= e) 
+		{
+			head += (p - b); fpos += (p - b);
+			if (fill() == false) return false; 
+			continue; 
+		}
+		if (*p != '<') return false;
+
+		if (p[1] == '/')
+		{
+			// this should be the end tag of the section
+			const char* gt = (const char*)memchr(p, '>', e - p);
+			if (gt == nullptr) 
+			{
+				head += (p - b); fpos += (p - b);
+				if (fill() == false) return false; 
+				continue; 
+			}
+
+			const char* c = p + 2;
+			while ((c < gt) && isspace(*c)) c++;
+			size_t l = tag.m_sztag.size();
+			if (((size_t)(gt - c) < l) || (strncmp(c, tag.m_sztag.c_str(), l) != 0)) return false;
+			c += l;
+			while ((c < gt) && isspace(*c)) c++;
+			if (c != gt) return false;
+			for (const char* q = p; q < gt; ++q) if (*q == '\n') nline++;
+
+			// Set the tag as if it was read by NextTag
+			std::string name = tag.m_sztag;
+			tag.m_path.push_back(name);
+			tag.clear();
+			tag.m_sztag = name;
+			tag.m_bend = true;
+			tag.m_nstart_line = nline;
+			tag.m_ncurrent_line = nline;
+			tag.m_fpos = fpos + (gt - b) + 1;
+			m_comment.clear();
+			m_nline = nline;
+
+			// position the stream at the end of the section
+			m_stream->clear();
+			m_stream->seekg(tag.m_fpos, ios_base::beg);
+			m_currentPos = tag.m_fpos;
+			return true;
+		}
+
+		// find the end of the child element
+		const char* gt1 = (const char*)memchr(p, '>', e - p);
+		const char* lt = (gt1 ? (const char*)memchr(gt1, '<', e - gt1) : nullptr);
+		const char* gt2 = (lt ? (const char*)memchr(lt, '>', e - lt) : nullptr);
+		if (gt2 == nullptr)
+		{
+			head += (p - b); fpos += (p - b);
+			if (fill() == false) return false;
+			continue;
+		}
+
+		// tag name
+		const char* c = p + 1;
+		const char* szname = c;
+		while ((c < gt1) && isvalid(*c)) c++;
+		size_t lname = c - szname;
+		if ((lname == 0) || !isspace(*c)) return false;
+
+		// the attribute (this must be the only one)
+		while ((c < gt1) && isspace(*c)) c++;
+		if (((size_t)(gt1 - c) < natt) || (strncmp(c, szatt, natt) != 0)) return false;
+		c += natt;
+		while ((c < gt1) && isspace(*c)) c++;
+		if ((c == gt1) || (*c != '=')) return false;
+		c++;
+		while ((c < gt1) && isspace(*c)) c++;
+		if ((c == gt1) || ((*c != '"') && (*c != '\''))) return false;
+		char quot = *c++;
+		int n = 0;
+		c = parse_number(c, gt1, n);
+		if ((c == nullptr) || (c == gt1) || (*c != quot)) return false;
+		c++;
+		while ((c < gt1) && isspace(*c)) c++;
+		if (c != gt1) return false;
+
+		// end tag
+		c = lt + 1;
+		if ((c == gt2) || (*c != '/')) return false;
+		c++;
+		while ((c < gt2) && isspace(*c)) c++;
+		if (((size_t)(gt2 - c) < lname) || (strncmp(c, szname, lname) != 0)) return false;
+		c += lname;
+		while ((c < gt2) && isspace(*c)) c++;
+		if (c != gt2) return false;
+
+		// the comma-separated values (at most nmax are processed, like XMLTag::value)
+		int nval = 0;
+		c = gt1 + 1;
+		while (nval < nmax)
+		{
+			while ((c < lt) && isspace(*c)) c++;
+			c = parse_number(c, lt, tmp[nval]);
+			if (c == nullptr) return false;
+			nval++;
+			while ((c < lt) && isspace(*c)) c++;
+			if (c == lt) break;
+			if (*c != ',') return false;
+			c++;
+		}
+
+		att.push_back(n);
+		count.push_back(nval);
+		for (int i = 0; i < nmax; ++i) val.push_back(i < nval ? tmp[i] : T(0));
+
+		for (const char* q = p; q < gt2; ++q) if (*q == '\n') nline++;
+		head += (gt2 + 1 - b);
+		fpos += (gt2 + 1 - b);
+	}
+}
+
 ifstream* XMLReader::GetFileStream()
 {
     return dynamic_cast<ifstream*>(m_stream);
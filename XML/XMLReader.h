@@ -150,6 +150,11 @@ public:
 
 	template <class T> void value(T& v);
 
+	// Fast path for reading all the children of this tag when they are homogeneous leaf
+	// tags of the form <name att="n">v1,v2,...</name>. See XMLReader::ReadLeafValues.
+	bool readLeafValues(const char* szatt, std::vector<int>& att, std::vector<int>& count, std::vector<double>& val, int nmax);
+	bool readLeafValues(const char* szatt, std::vector<int>& att, std::vector<int>& count, std::vector<int>& val, int nmax);
+
 	const char* szvalue() { return m_szval.c_str(); }
 
 	std::string relpath(const char* szroot) const;
@@ -186,6 +191,7 @@ class XMLReader
 {
 public:
 	enum {BUF_SIZE = 32768};
+	enum {BLOCK_SIZE = 1048576};	// block size used by the bulk reader
 
 public:
 	// Base class for Exceptions
@@ -289,8 +295,20 @@ public:
 
 	const std::string& GetLastComment();
 
+	//! Read the children of tag in bulk. This is a fast path for large sections
+	//! (e.g. Nodes, Elements) and only handles children of the form
+	//! <name att="n">v1,v2,...</name>. The attribute values are stored in att, the number
+	//! of values of each child in count, and the values in val (with a stride of nmax). 
+	//! On success, tag is set to the end tag of the section. If anything else is 
+	//! encountered, the function returns false and the tag is left unchanged so the 
+	//! caller can fall back to processing the children one by one.
+	bool ReadLeafValues(XMLTag& tag, const char* szatt, std::vector<int>& att, std::vector<int>& count, std::vector<double>& val, int nmax);
+	bool ReadLeafValues(XMLTag& tag, const char* szatt, std::vector<int>& att, std::vector<int>& count, std::vector<int>& val, int nmax);
+
 protected: // helper functions
 
+	template <typename T> bool readLeafValues(XMLTag& tag, const char* szatt, std::vector<int>& att, std::vector<int>& count, std::vector<T>& val, int nmax);
+
 	//! Get the next character in the file
 	char GetChar();
 
@@ -336,6 +354,9 @@ inline void XMLTag::skip() { m_preader->SkipTag(*this); }
 
 inline const std::string& XMLTag::comment() { return m_preader->GetLastComment(); }
 
+inline bool XMLTag::readLeafValues(const char* szatt, std::vector<int>& att, std::vector<int>& count, std::vector<double>& val, int nmax) { return m_preader->ReadLeafValues(*this, szatt, att, count, val, nmax); }
+inline bool XMLTag::readLeafValues(const char* szatt, std::vector<int>& att, std::vector<int>& count, std::vector<int>& val, int nmax) { return m_preader->ReadLeafValues(*this, szatt, att, count, val, nmax); }
+
 //-----------------------------------------------------------------------------
 // mechanism for using custom types with XMLReader. 
 template <class T> void string_to_type(const std::string& s, T& v) { assert(false); }